@@ -43,6 +43,9 @@ private:
 
     bool m_value_function_changed;
     bool m_isovalue_changed;
+
+    // The values of the value function at all positions, kept to avoid reallocations
+    std::vector<float> m_values;
 };
 
 namespace Utilities {
@@ -56,6 +59,7 @@ struct Options::Option<IsosurfaceRenderer::Option::LIGHTING_IMPLEMENTATION> {
     std::string default_value = "float lighting(vec3 position, vec3 normal) { return 1.0; }";
 };
 
+// The value function is evaluated for many positions concurrently, so it needs to be thread-safe
 template<>
 struct Options::Option<IsosurfaceRenderer::Option::VALUE_FUNCTION> {
     IsosurfaceRenderer::value_function_type default_value = [] (const glm::vec3& position, const glm::vec3& direction) {
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <array>
+#include <functional>
 #include <glm/glm.hpp>
 #include <glm/vec3.hpp>
 
@@ -11,11 +12,26 @@
 namespace VFRendering {
 class VectorfieldIsosurface {
 public:
+    typedef std::function<float(const glm::vec3&, const glm::vec3&)> value_function_type;
+
     std::vector<glm::vec3> positions;
     std::vector<glm::vec3> directions;
     std::vector<glm::vec3> normals;
     std::vector<int> triangle_indices;
-    static VectorfieldIsosurface calculate(const std::vector<glm::vec3>&, const std::vector<glm::vec3>& directions, const std::vector<float>& values, float isovalue, const std::vector<std::array<Geometry::index_type, 4>>& tetrahedra);
+
+    /** Extracts the isosurface from the tetrahedra using multiple threads.
+     *
+     *  The isopoints are ordered by the indices of the points at the ends of
+     *  their edges and the triangles are ordered like the tetrahedra, so the
+     *  result does not depend on the number of threads. If max_threads is 0,
+     *  up to one thread per hardware thread is used.
+     */
+    static VectorfieldIsosurface calculate(const std::vector<glm::vec3>&, const std::vector<glm::vec3>& directions, const std::vector<float>& values, float isovalue, const std::vector<std::array<Geometry::index_type, 4>>& tetrahedra, unsigned int max_threads = 0);
+
+    /** Evaluates the value function for all points using multiple threads,
+     *  so it may be called concurrently. The values vector is reused.
+     */
+    static void calculateValues(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& directions, const value_function_type& value_function, std::vector<float>& values);
 };
 }
 
@@ -94,7 +94,8 @@ PYBIND11_MODULE(pyVFRendering, m)
         // Constructor
         .def(py::init<>())
         // Actions
-        .def("draw", &View::draw,
+        // The GIL is released, as the value function of an IsosurfaceRenderer may be called from other threads
+        .def("draw", &View::draw, py::call_guard<py::gil_scoped_release>(),
             "Draw into current OpenGL context")
         .def("updateOptions", &View::updateOptions,
             "Update the set of options given to the View")
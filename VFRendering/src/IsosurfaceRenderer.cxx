@@ -173,14 +173,9 @@ void IsosurfaceRenderer::updateIsosurfaceIndices() {
         return;
     }
 
-    std::vector<float> values;
-    for (Geometry::index_type i = 0; i < positions().size(); i++) {
-        const glm::vec3& position = positions()[i];
-        const glm::vec3& direction = directions()[i];
-        values.push_back(value_function(position, direction));
-    }
+    VectorfieldIsosurface::calculateValues(positions(), directions(), value_function, m_values);
 
-    VectorfieldIsosurface isosurface(VectorfieldIsosurface::calculate(positions(), directions(), values, isovalue, volume_indices));
+    VectorfieldIsosurface isosurface(VectorfieldIsosurface::calculate(positions(), directions(), m_values, isovalue, volume_indices));
 
     const std::vector<GLuint> surface_indices(isosurface.triangle_indices.begin(), isosurface.triangle_indices.end());
 
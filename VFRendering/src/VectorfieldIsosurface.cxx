@@ -1,78 +1,266 @@
 #include "VectorfieldIsosurface.hxx"
 
-#include <iostream>
-#include <map>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <limits>
+#include <thread>
 
 #include <glm/glm.hpp>
 
 namespace VFRendering {
+namespace {
+typedef Geometry::index_type index_type;
+// The indices of the two points of an edge, the smaller one in the upper bits
+typedef std::uint64_t edge_type;
+
+edge_type makeEdge(index_type i1, index_type i2) {
+    if (i1 > i2) {
+        std::swap(i1, i2);
+    }
+    return (edge_type(i1) << 32) | edge_type(i2);
+}
+
+unsigned int numChunks(std::size_t n, unsigned int max_threads = 0) {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    (void)n;
+    (void)max_threads;
+    return 1;
+#else
+    // Smaller chunks are not worth starting a thread for
+    const std::size_t min_chunk_size = 16384;
+    std::size_t num_threads = max_threads > 0 ? max_threads : std::max(1u, std::thread::hardware_concurrency());
+    return std::max<std::size_t>(1, std::min(num_threads, n / min_chunk_size));
+#endif
+}
+
+// Calls function(chunk, begin, end) for num_chunks contiguous parts of [0, n), each on its own thread
+template<typename Function>
+void forEachChunk(std::size_t n, unsigned int num_chunks, const Function& function) {
+    std::vector<std::thread> threads;
+    for (unsigned int chunk = 1; chunk < num_chunks; chunk++) {
+        threads.emplace_back(function, chunk, n * chunk / num_chunks, n * (chunk + 1) / num_chunks);
+    }
+    function(0u, std::size_t(0), n / num_chunks);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// How the isosurface intersects a tetrahedron
+struct TetrahedronCase {
+    int num_triangles = 0;
+    bool flip_normal = false;
+    index_type in_i1 = -1;
+    index_type in_i2 = -1;
+    index_type out_i1 = -1;
+    index_type out_i2 = -1;
+    index_type out_i3 = -1;
+};
+
+TetrahedronCase classifyTetrahedron(const std::array<index_type, 4>& t, const std::vector<float>& values, float isovalue) {
+    int index = 0;
+    for (int i = 0; i < 4; i++) {
+        if (values[t[i]] > isovalue) {
+            index += (1 << i);
+        }
+    }
+    TetrahedronCase c;
+    c.flip_normal = (index >= 8);
+    if (c.flip_normal) {
+        index = 15 - index;
+    }
+    c.num_triangles = 1;
+    switch (index) {
+    case 0:
+        c.num_triangles = 0;
+        return c;
+    case 1:
+        c.in_i1 = t[0];
+        c.out_i1 = t[1];
+        c.out_i2 = t[2];
+        c.out_i3 = t[3];
+        break;
+    case 2:
+        c.in_i1 = t[1];
+        c.out_i1 = t[0];
+        c.out_i2 = t[2];
+        c.out_i3 = t[3];
+        break;
+    case 3:
+        c.in_i1 = t[0];
+        c.in_i2 = t[1];
+        c.out_i1 = t[2];
+        c.out_i2 = t[3];
+        c.num_triangles = 2;
+        break;
+    case 4:
+        c.in_i1 = t[2];
+        c.out_i1 = t[0];
+        c.out_i2 = t[1];
+        c.out_i3 = t[3];
+        break;
+    case 5:
+        c.in_i1 = t[0];
+        c.in_i2 = t[2];
+        c.out_i1 = t[1];
+        c.out_i2 = t[3];
+        c.num_triangles = 2;
+        break;
+    case 6:
+        c.in_i1 = t[1];
+        c.in_i2 = t[2];
+        c.out_i1 = t[0];
+        c.out_i2 = t[3];
+        c.num_triangles = 2;
+        break;
+    case 7:
+        c.flip_normal = !c.flip_normal;
+        c.in_i1 = t[3];
+        c.out_i1 = t[0];
+        c.out_i2 = t[1];
+        c.out_i3 = t[2];
+        break;
+    }
+    if (c.num_triangles == 1 && values[c.in_i1] == isovalue) {
+        c.num_triangles = 0;
+    }
+    return c;
+}
+
+// Writes the edges on which the isopoints of the triangles of a tetrahedron lie
+int tetrahedronEdges(const TetrahedronCase& c, std::array<edge_type, 4>& edges) {
+    if (c.num_triangles == 1) {
+        edges[0] = makeEdge(c.in_i1, c.out_i1);
+        edges[1] = makeEdge(c.in_i1, c.out_i2);
+        edges[2] = makeEdge(c.in_i1, c.out_i3);
+        return 3;
+    } else if (c.num_triangles == 2) {
+        edges[0] = makeEdge(c.in_i1, c.out_i1);
+        edges[1] = makeEdge(c.in_i1, c.out_i2);
+        edges[2] = makeEdge(c.in_i2, c.out_i1);
+        edges[3] = makeEdge(c.in_i2, c.out_i2);
+        return 4;
+    }
+    return 0;
+}
+
 class VectorfieldIsosurfaceCalculation {
 public:
-    VectorfieldIsosurfaceCalculation(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& directions, const std::vector<float>& values, float isovalue) : in_positions(positions), in_directions(directions), in_values(values), in_isovalue(isovalue) {}
+    VectorfieldIsosurfaceCalculation(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& directions, const std::vector<float>& values, float isovalue, const std::vector<std::array<index_type, 4>>& tetrahedra, unsigned int max_threads) : in_positions(positions), in_directions(directions), in_values(values), in_isovalue(isovalue), in_tetrahedra(tetrahedra), max_threads(max_threads), num_chunks(numChunks(tetrahedra.size(), max_threads)) {}
 
-    void addTetrahedron(std::array<Geometry::index_type, 4> t);
-    VectorfieldIsosurface getResultAndReset();
+    VectorfieldIsosurface calculate();
 
 private:
-    typedef Geometry::index_type index_type;
-    typedef std::pair<index_type, index_type> edge_type;
-
-    template<int NUM_INSIDE_POINTS>
-    void generateTriangle(index_type i1, index_type i2, index_type i3, const std::array<glm::vec3, NUM_INSIDE_POINTS>& inside_points, bool flip_normal);
+    void collectEdges();
+    void calculateIsopoints();
+    void generateTriangles();
+    void accumulateNormals();
 
-    index_type getIsopointIndex(const edge_type& edge);
-
-    void generateOneTetrahedronTriangle(index_type in_i1, index_type out_i1, index_type out_i2, index_type out_i3, bool flip_normal);
-    void generateTwoTetrahedronTriangles(index_type in_i1, index_type in_i2, index_type out_i1, index_type out_i2, bool flip_normal);
+    index_type getIsopointIndex(index_type i1, index_type i2) const;
+    void generateTriangle(std::size_t triangle, index_type i1, index_type i2, index_type i3, const glm::vec3* inside_points, int num_inside_points, bool flip_normal);
 
     // input
     const std::vector<glm::vec3>& in_positions;
     const std::vector<glm::vec3>& in_directions;
     const std::vector<float>& in_values;
     float in_isovalue;
+    const std::vector<std::array<index_type, 4>>& in_tetrahedra;
 
     // internal
-    std::map<edge_type, index_type> edge_indices;
+    const unsigned int max_threads;
+    const unsigned int num_chunks;
+    // The sorted edges on which the isopoints lie, the index of an edge is the index of its isopoint
+    std::vector<edge_type> edges;
+    // The index of the first triangle of each chunk of tetrahedra
+    std::vector<std::size_t> chunk_triangle_offsets;
+    std::vector<glm::vec3> triangle_normals;
 
     // output
-    std::vector<glm::vec3> positions;
-    std::vector<glm::vec3> directions;
-    std::vector<glm::vec3> normals;
-    std::vector<int> triangle_indices;
+    VectorfieldIsosurface isosurface;
 };
 
+VectorfieldIsosurface VectorfieldIsosurfaceCalculation::calculate() {
+    collectEdges();
+    calculateIsopoints();
+    generateTriangles();
+    accumulateNormals();
+    return std::move(isosurface);
+}
 
-VectorfieldIsosurface VectorfieldIsosurfaceCalculation::getResultAndReset() {
-    for (auto& normal : normals) {
-        normal = glm::normalize(normal);
-        if (glm::any(glm::isnan(normal))) {
-            normal = glm::vec3(0, 0, 0);
+void VectorfieldIsosurfaceCalculation::collectEdges() {
+    // Every chunk collects and sorts the edges of its tetrahedra, then the chunks are merged
+    std::vector<std::vector<edge_type>> chunk_edges(num_chunks);
+    std::vector<std::size_t> chunk_num_triangles(num_chunks, 0);
+    forEachChunk(in_tetrahedra.size(), num_chunks, [&](unsigned int chunk, std::size_t begin, std::size_t end) {
+        auto& local_edges = chunk_edges[chunk];
+        std::array<edge_type, 4> tetrahedron_edges;
+        for (std::size_t i = begin; i < end; i++) {
+            const TetrahedronCase c = classifyTetrahedron(in_tetrahedra[i], in_values, in_isovalue);
+            local_edges.insert(local_edges.end(), tetrahedron_edges.begin(), tetrahedron_edges.begin() + tetrahedronEdges(c, tetrahedron_edges));
+            chunk_num_triangles[chunk] += c.num_triangles;
         }
+        std::sort(local_edges.begin(), local_edges.end());
+        local_edges.erase(std::unique(local_edges.begin(), local_edges.end()), local_edges.end());
+    });
+
+    chunk_triangle_offsets.assign(num_chunks + 1, 0);
+    std::vector<std::size_t> chunk_edge_offsets(num_chunks + 1, 0);
+    for (unsigned int chunk = 0; chunk < num_chunks; chunk++) {
+        chunk_triangle_offsets[chunk + 1] = chunk_triangle_offsets[chunk] + chunk_num_triangles[chunk];
+        chunk_edge_offsets[chunk + 1] = chunk_edge_offsets[chunk] + chunk_edges[chunk].size();
     }
-    for (auto& direction : directions) {
-        direction = glm::normalize(direction);
+
+    edges.clear();
+    edges.reserve(chunk_edge_offsets[num_chunks]);
+    for (auto& local_edges : chunk_edges) {
+        edges.insert(edges.end(), local_edges.begin(), local_edges.end());
+        std::vector<edge_type>().swap(local_edges);
     }
+    for (unsigned int width = 1; width < num_chunks; width *= 2) {
+        for (unsigned int chunk = 0; chunk + width < num_chunks; chunk += 2 * width) {
+            std::inplace_merge(edges.begin() + chunk_edge_offsets[chunk], edges.begin() + chunk_edge_offsets[chunk + width], edges.begin() + chunk_edge_offsets[std::min(chunk + 2 * width, num_chunks)]);
+        }
+    }
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+}
 
-    VectorfieldIsosurface isosurface;
-    isosurface.positions.swap(positions);
-    isosurface.directions.swap(directions);
-    isosurface.normals.swap(normals);
-    isosurface.triangle_indices.swap(triangle_indices);
+void VectorfieldIsosurfaceCalculation::calculateIsopoints() {
+    isosurface.positions.resize(edges.size());
+    isosurface.directions.resize(edges.size());
+    isosurface.normals.assign(edges.size(), glm::vec3(0.0f, 0.0f, 0.0f));
+    forEachChunk(edges.size(), numChunks(edges.size(), max_threads), [&](unsigned int, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const index_type first = index_type(edges[i] >> 32);
+            const index_type second = index_type(edges[i] & 0xffffffffu);
+            float left_value = in_values[first];
+            float right_value = in_values[second];
+            float alpha;
+            if (std::abs(left_value - right_value) < std::numeric_limits<float>::min()) {
+                alpha = 0.5;
+            } else {
+                alpha = (in_isovalue - left_value) / (right_value - left_value);
+                if (alpha < 0) {
+                    alpha = 0;
+                } else if (alpha > 1) {
+                    alpha = 1;
+                }
+            }
+
+            isosurface.positions[i] = glm::mix(in_positions[first], in_positions[second], alpha);
+            isosurface.directions[i] = glm::normalize(glm::mix(in_directions[first], in_directions[second], alpha));
+        }
+    });
+}
 
-    edge_indices.clear();
-    positions.clear();
-    directions.clear();
-    normals.clear();
-    triangle_indices.clear();
-    return isosurface;
+index_type VectorfieldIsosurfaceCalculation::getIsopointIndex(index_type i1, index_type i2) const {
+    return index_type(std::lower_bound(edges.begin(), edges.end(), makeEdge(i1, i2)) - edges.begin());
 }
 
-template<int NUM_INSIDE_POINTS>
-void VectorfieldIsosurfaceCalculation::generateTriangle(index_type i1, index_type i2, index_type i3, const std::array<glm::vec3, NUM_INSIDE_POINTS>& inside_points, bool flip_normal) {
-    glm::vec3 p1 = positions[i1];
-    glm::vec3 p2 = positions[i2];
-    glm::vec3 p3 = positions[i3];
+void VectorfieldIsosurfaceCalculation::generateTriangle(std::size_t triangle, index_type i1, index_type i2, index_type i3, const glm::vec3* inside_points, int num_inside_points, bool flip_normal) {
+    glm::vec3 p1 = isosurface.positions[i1];
+    glm::vec3 p2 = isosurface.positions[i2];
+    glm::vec3 p3 = isosurface.positions[i3];
 
     glm::vec3 n = glm::normalize(glm::cross(p2 - p1, p3 - p1));
     if (glm::any(glm::isnan(n))) {
@@ -84,8 +272,8 @@ void VectorfieldIsosurfaceCalculation::generateTriangle(index_type i1, index_typ
     // that other point should be used to determine whether the normal should
     // be flipped.
     float absmax_flip_normal_indicator = 0;
-    for (const auto& inside_point : inside_points) {
-        float flip_normal_indicator = glm::dot(n, inside_point - (p1 + p2 + p3) / 3.0f);
+    for (int i = 0; i < num_inside_points; i++) {
+        float flip_normal_indicator = glm::dot(n, inside_points[i] - (p1 + p2 + p3) / 3.0f);
         if (glm::abs(flip_normal_indicator) > glm::abs(absmax_flip_normal_indicator)) {
             absmax_flip_normal_indicator = flip_normal_indicator;
         }
@@ -94,158 +282,80 @@ void VectorfieldIsosurfaceCalculation::generateTriangle(index_type i1, index_typ
         flip_normal = !flip_normal;
     }
 
+    int* indices = &isosurface.triangle_indices[3 * triangle];
     if (flip_normal) {
         n = -n;
-        triangle_indices.push_back(i2);
-        triangle_indices.push_back(i1);
-        triangle_indices.push_back(i3);
+        indices[0] = i2;
+        indices[1] = i1;
+        indices[2] = i3;
     } else {
-        triangle_indices.push_back(i1);
-        triangle_indices.push_back(i2);
-        triangle_indices.push_back(i3);
-    }
-    normals[i1] += n;
-    normals[i2] += n;
-    normals[i3] += n;
-}
-
-VectorfieldIsosurfaceCalculation::index_type VectorfieldIsosurfaceCalculation::getIsopointIndex(const VectorfieldIsosurfaceCalculation::edge_type& edge) {
-    if (edge.first > edge.second) {
-        return getIsopointIndex({edge.second, edge.first});
-    }
-    auto it = edge_indices.find(edge);
-    if (it == edge_indices.end()) {
-        float left_value = in_values[edge.first];
-        float right_value = in_values[edge.second];
-        float alpha;
-        if (std::abs(left_value - right_value) < std::numeric_limits<float>::min()) {
-            alpha = 0.5;
-        } else {
-            alpha = (in_isovalue - left_value) / (right_value - left_value);
-            if (alpha < 0) {
-                alpha = 0;
-            } else if (alpha > 1) {
-                alpha = 1;
+        indices[0] = i1;
+        indices[1] = i2;
+        indices[2] = i3;
+    }
+    triangle_normals[triangle] = n;
+}
+
+void VectorfieldIsosurfaceCalculation::generateTriangles() {
+    const std::size_t num_triangles = chunk_triangle_offsets[num_chunks];
+    isosurface.triangle_indices.resize(3 * num_triangles);
+    triangle_normals.resize(num_triangles);
+    forEachChunk(in_tetrahedra.size(), num_chunks, [&](unsigned int chunk, std::size_t begin, std::size_t end) {
+        std::size_t triangle = chunk_triangle_offsets[chunk];
+        for (std::size_t i = begin; i < end; i++) {
+            const TetrahedronCase c = classifyTetrahedron(in_tetrahedra[i], in_values, in_isovalue);
+            if (c.num_triangles == 1) {
+                index_type i1 = getIsopointIndex(c.in_i1, c.out_i1);
+                index_type i2 = getIsopointIndex(c.in_i1, c.out_i2);
+                index_type i3 = getIsopointIndex(c.in_i1, c.out_i3);
+                const glm::vec3 inside_points[] = {in_positions[c.in_i1]};
+                generateTriangle(triangle++, i1, i2, i3, inside_points, 1, c.flip_normal);
+            } else if (c.num_triangles == 2) {
+                index_type i1 = getIsopointIndex(c.in_i1, c.out_i1);
+                index_type i2 = getIsopointIndex(c.in_i1, c.out_i2);
+                index_type i3 = getIsopointIndex(c.in_i2, c.out_i1);
+                index_type i4 = getIsopointIndex(c.in_i2, c.out_i2);
+                const glm::vec3 inside_points[] = {in_positions[c.in_i1], in_positions[c.in_i2]};
+                generateTriangle(triangle++, i1, i4, i2, inside_points, 2, c.flip_normal);
+                generateTriangle(triangle++, i1, i4, i3, inside_points, 2, c.flip_normal);
             }
         }
+    });
+}
 
-        glm::vec3 left_point = in_positions[edge.first];
-        glm::vec3 right_point = in_positions[edge.second];
-        glm::vec3 isopoint = glm::mix(left_point, right_point, alpha);
-
-        glm::vec3 left_direction = in_directions[edge.first];
-        glm::vec3 right_direction = in_directions[edge.second];
-        glm::vec3 isodirection = glm::normalize(glm::mix(left_direction, right_direction, alpha));
-
-        index_type isopoint_index = positions.size();
-        edge_indices[edge] = isopoint_index;
-        positions.push_back(isopoint);
-        directions.push_back(isodirection);
-        normals.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-        return isopoint_index;
-    } else {
-        return it->second;
+void VectorfieldIsosurfaceCalculation::accumulateNormals() {
+    // The normals of the triangles are summed up in the order of the triangles,
+    // so that the result is deterministic
+    for (std::size_t triangle = 0; triangle < triangle_normals.size(); triangle++) {
+        const glm::vec3& n = triangle_normals[triangle];
+        isosurface.normals[isosurface.triangle_indices[3 * triangle]] += n;
+        isosurface.normals[isosurface.triangle_indices[3 * triangle + 1]] += n;
+        isosurface.normals[isosurface.triangle_indices[3 * triangle + 2]] += n;
     }
+    forEachChunk(edges.size(), numChunks(edges.size(), max_threads), [&](unsigned int, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            auto& normal = isosurface.normals[i];
+            normal = glm::normalize(normal);
+            if (glm::any(glm::isnan(normal))) {
+                normal = glm::vec3(0, 0, 0);
+            }
+            isosurface.directions[i] = glm::normalize(isosurface.directions[i]);
+        }
+    });
 }
-
-void VectorfieldIsosurfaceCalculation::generateOneTetrahedronTriangle(index_type in_i1, index_type out_i1, index_type out_i2, index_type out_i3, bool flip_normal) {
-    index_type i1 = getIsopointIndex({in_i1, out_i1});
-    index_type i2 = getIsopointIndex({in_i1, out_i2});
-    index_type i3 = getIsopointIndex({in_i1, out_i3});
-    generateTriangle<1>(i1, i2, i3, {{in_positions[in_i1]}}, flip_normal);
 }
 
-void VectorfieldIsosurfaceCalculation::generateTwoTetrahedronTriangles(index_type in_i1, index_type in_i2, index_type out_i1, index_type out_i2, bool flip_normal) {
-    index_type i1 = getIsopointIndex({in_i1, out_i1});
-    index_type i2 = getIsopointIndex({in_i1, out_i2});
-    index_type i3 = getIsopointIndex({in_i2, out_i1});
-    index_type i4 = getIsopointIndex({in_i2, out_i2});
-    generateTriangle<2>(i1, i4, i2, {{in_positions[in_i1], in_positions[in_i2]}}, flip_normal);
-    generateTriangle<2>(i1, i4, i3, {{in_positions[in_i1], in_positions[in_i2]}}, flip_normal);
+VectorfieldIsosurface VectorfieldIsosurface::calculate(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& directions, const std::vector<float>& values, float isovalue, const std::vector<std::array<Geometry::index_type, 4>>& tetrahedra, unsigned int max_threads) {
+    VectorfieldIsosurfaceCalculation calculation(positions, directions, values, isovalue, tetrahedra, max_threads);
+    return calculation.calculate();
 }
 
-void VectorfieldIsosurfaceCalculation::addTetrahedron(std::array<Geometry::index_type, 4> t) {
-    int index = 0;
-    for (int i = 0; i < 4; i++) {
-        if (in_values[t[i]] > in_isovalue) {
-            index += (1 << i);
+void VectorfieldIsosurface::calculateValues(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& directions, const value_function_type& value_function, std::vector<float>& values) {
+    values.resize(positions.size());
+    forEachChunk(positions.size(), numChunks(positions.size()), [&](unsigned int, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            values[i] = value_function(positions[i], directions[i]);
         }
-    }
-    bool flip_normal = (index >= 8);
-    if (flip_normal) {
-        index = 15 - index;
-    }
-    index_type in_i1 = -1;
-    index_type in_i2 = -1;
-    index_type out_i1 = -1;
-    index_type out_i2 = -1;
-    index_type out_i3 = -1;
-    index_type result_tri = 1;
-    switch (index) {
-    case 0:
-        return;
-    case 1:
-        in_i1 = t[0];
-        out_i1 = t[1];
-        out_i2 = t[2];
-        out_i3 = t[3];
-        break;
-    case 2:
-        in_i1 = t[1];
-        out_i1 = t[0];
-        out_i2 = t[2];
-        out_i3 = t[3];
-        break;
-    case 3:
-        in_i1 = t[0];
-        in_i2 = t[1];
-        out_i1 = t[2];
-        out_i2 = t[3];
-        result_tri = 2;
-        break;
-    case 4:
-        in_i1 = t[2];
-        out_i1 = t[0];
-        out_i2 = t[1];
-        out_i3 = t[3];
-        break;
-    case 5:
-        in_i1 = t[0];
-        in_i2 = t[2];
-        out_i1 = t[1];
-        out_i2 = t[3];
-        result_tri = 2;
-        break;
-    case 6:
-        in_i1 = t[1];
-        in_i2 = t[2];
-        out_i1 = t[0];
-        out_i2 = t[3];
-        result_tri = 2;
-        break;
-    case 7:
-        flip_normal = !flip_normal;
-        in_i1 = t[3];
-        out_i1 = t[0];
-        out_i2 = t[1];
-        out_i3 = t[2];
-        break;
-    }
-    if (result_tri == 1) {
-        if (in_values[in_i1] == in_isovalue) {
-            return;
-        }
-        generateOneTetrahedronTriangle(in_i1, out_i1, out_i2, out_i3, flip_normal);
-    } else {
-        generateTwoTetrahedronTriangles(in_i1, in_i2, out_i1, out_i2, flip_normal);
-    }
-}
-
-VectorfieldIsosurface VectorfieldIsosurface::calculate(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& directions, const std::vector<float>& values, float isovalue, const std::vector<std::array<Geometry::index_type, 4>>& tetrahedra) {
-    VectorfieldIsosurfaceCalculation calculation(positions, directions, values, isovalue);
-    for (auto& t : tetrahedra) {
-        calculation.addTetrahedron(t);
-    }
-    return calculation.getResultAndReset();
+    });
 }
 }
@@ -0,0 +1,241 @@
+#include <catch.hpp>
+
+#include <VectorfieldIsosurface.hxx>
+#include <VFRendering/Geometry.hxx>
+
+#include <cmath>
+#include <limits>
+#include <map>
+
+using VFRendering::Geometry;
+using VFRendering::VectorfieldIsosurface;
+
+namespace {
+typedef Geometry::index_type index_type;
+
+// The previous, single-threaded extraction, against which the current one is compared
+class ReferenceIsosurfaceCalculation {
+public:
+    ReferenceIsosurfaceCalculation(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& directions, const std::vector<float>& values, float isovalue) : in_positions(positions), in_directions(directions), in_values(values), in_isovalue(isovalue) {}
+
+    VectorfieldIsosurface calculate(const std::vector<std::array<index_type, 4>>& tetrahedra) {
+        for (auto& t : tetrahedra) {
+            addTetrahedron(t);
+        }
+        for (auto& normal : normals) {
+            normal = glm::normalize(normal);
+            if (glm::any(glm::isnan(normal))) {
+                normal = glm::vec3(0, 0, 0);
+            }
+        }
+        for (auto& direction : directions) {
+            direction = glm::normalize(direction);
+        }
+        VectorfieldIsosurface isosurface;
+        isosurface.positions.swap(positions);
+        isosurface.directions.swap(directions);
+        isosurface.normals.swap(normals);
+        isosurface.triangle_indices.swap(triangle_indices);
+        return isosurface;
+    }
+
+private:
+    typedef std::pair<index_type, index_type> edge_type;
+
+    void generateTriangle(index_type i1, index_type i2, index_type i3, const std::vector<glm::vec3>& inside_points, bool flip_normal) {
+        glm::vec3 p1 = positions[i1];
+        glm::vec3 p2 = positions[i2];
+        glm::vec3 p3 = positions[i3];
+        glm::vec3 n = glm::normalize(glm::cross(p2 - p1, p3 - p1));
+        if (glm::any(glm::isnan(n))) {
+            n = glm::vec3(0, 0, 0);
+        }
+        float absmax_flip_normal_indicator = 0;
+        for (const auto& inside_point : inside_points) {
+            float flip_normal_indicator = glm::dot(n, inside_point - (p1 + p2 + p3) / 3.0f);
+            if (glm::abs(flip_normal_indicator) > glm::abs(absmax_flip_normal_indicator)) {
+                absmax_flip_normal_indicator = flip_normal_indicator;
+            }
+        }
+        if (absmax_flip_normal_indicator > 0) {
+            flip_normal = !flip_normal;
+        }
+        if (flip_normal) {
+            n = -n;
+            triangle_indices.insert(triangle_indices.end(), {int(i2), int(i1), int(i3)});
+        } else {
+            triangle_indices.insert(triangle_indices.end(), {int(i1), int(i2), int(i3)});
+        }
+        normals[i1] += n;
+        normals[i2] += n;
+        normals[i3] += n;
+    }
+
+    index_type getIsopointIndex(const edge_type& edge) {
+        if (edge.first > edge.second) {
+            return getIsopointIndex({edge.second, edge.first});
+        }
+        auto it = edge_indices.find(edge);
+        if (it != edge_indices.end()) {
+            return it->second;
+        }
+        float left_value = in_values[edge.first];
+        float right_value = in_values[edge.second];
+        float alpha;
+        if (std::abs(left_value - right_value) < std::numeric_limits<float>::min()) {
+            alpha = 0.5;
+        } else {
+            alpha = (in_isovalue - left_value) / (right_value - left_value);
+            if (alpha < 0) {
+                alpha = 0;
+            } else if (alpha > 1) {
+                alpha = 1;
+            }
+        }
+        index_type isopoint_index = positions.size();
+        edge_indices[edge] = isopoint_index;
+        positions.push_back(glm::mix(in_positions[edge.first], in_positions[edge.second], alpha));
+        directions.push_back(glm::normalize(glm::mix(in_directions[edge.first], in_directions[edge.second], alpha)));
+        normals.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
+        return isopoint_index;
+    }
+
+    void addTetrahedron(std::array<index_type, 4> t) {
+        int index = 0;
+        for (int i = 0; i < 4; i++) {
+            if (in_values[t[i]] > in_isovalue) {
+                index += (1 << i);
+            }
+        }
+        bool flip_normal = (index >= 8);
+        if (flip_normal) {
+            index = 15 - index;
+        }
+        // For each case: the inside points followed by the outside points
+        static const int cases[8][4] = {{0, 0, 0, 0}, {0, 1, 2, 3}, {1, 0, 2, 3}, {0, 1, 2, 3}, {2, 0, 1, 3}, {0, 2, 1, 3}, {1, 2, 0, 3}, {3, 0, 1, 2}};
+        if (index == 0) {
+            return;
+        }
+        const int* c = cases[index];
+        if (index == 7) {
+            flip_normal = !flip_normal;
+        }
+        if (index == 3 || index == 5 || index == 6) {
+            index_type i1 = getIsopointIndex({t[c[0]], t[c[2]]});
+            index_type i2 = getIsopointIndex({t[c[0]], t[c[3]]});
+            index_type i3 = getIsopointIndex({t[c[1]], t[c[2]]});
+            index_type i4 = getIsopointIndex({t[c[1]], t[c[3]]});
+            generateTriangle(i1, i4, i2, {in_positions[t[c[0]]], in_positions[t[c[1]]]}, flip_normal);
+            generateTriangle(i1, i4, i3, {in_positions[t[c[0]]], in_positions[t[c[1]]]}, flip_normal);
+        } else {
+            if (in_values[t[c[0]]] == in_isovalue) {
+                return;
+            }
+            index_type i1 = getIsopointIndex({t[c[0]], t[c[1]]});
+            index_type i2 = getIsopointIndex({t[c[0]], t[c[2]]});
+            index_type i3 = getIsopointIndex({t[c[0]], t[c[3]]});
+            generateTriangle(i1, i2, i3, {in_positions[t[c[0]]]}, flip_normal);
+        }
+    }
+
+    const std::vector<glm::vec3>& in_positions;
+    const std::vector<glm::vec3>& in_directions;
+    const std::vector<float>& in_values;
+    float in_isovalue;
+
+    std::map<edge_type, index_type> edge_indices;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> directions;
+    std::vector<glm::vec3> normals;
+    std::vector<int> triangle_indices;
+};
+
+// The isopoints may be ordered differently, but the triangles have to be the same, in the same order
+void requireSameIsosurface(const VectorfieldIsosurface& isosurface, const VectorfieldIsosurface& reference) {
+    REQUIRE(isosurface.positions.size() == reference.positions.size());
+    REQUIRE(isosurface.directions.size() == reference.directions.size());
+    REQUIRE(isosurface.normals.size() == reference.normals.size());
+    REQUIRE(isosurface.triangle_indices.size() == reference.triangle_indices.size());
+    for (std::size_t i = 0; i < reference.triangle_indices.size(); i++) {
+        const int index = isosurface.triangle_indices[i];
+        const int reference_index = reference.triangle_indices[i];
+        INFO("triangle " << i / 3 << ", corner " << i % 3);
+        REQUIRE(isosurface.positions[index] == reference.positions[reference_index]);
+        REQUIRE(isosurface.directions[index] == reference.directions[reference_index]);
+        REQUIRE(isosurface.normals[index] == reference.normals[reference_index]);
+    }
+}
+
+struct Field {
+    Geometry geometry;
+    std::vector<glm::vec3> directions;
+    std::vector<float> values;
+
+    explicit Field(int n) : geometry(Geometry::cartesianGeometry({n, n, n}, {-1, -1, -1}, {1, 1, 1})) {
+        for (const auto& position : geometry.positions()) {
+            // A skyrmion tube along z, which is twisted, so that the directions vary along z as well
+            float r = glm::length(glm::vec2(position));
+            float theta = 3.14159265f * std::min(r / 0.7f, 1.0f);
+            float phi = std::atan2(position.y, position.x) + 2 * position.z;
+            directions.push_back({std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)});
+        }
+    }
+};
+}
+
+TEST_CASE("Isosurface is the same as the one of the previous extraction", "[isosurface]") {
+    // Large enough to be split among several threads
+    Field field(48);
+    const auto& positions = field.geometry.positions();
+    const auto& tetrahedra = field.geometry.volumeIndices();
+    REQUIRE(tetrahedra.size() > 100000);
+
+    SECTION("z component of the directions") {
+        VectorfieldIsosurface::calculateValues(positions, field.directions, [](const glm::vec3&, const glm::vec3& direction) { return direction.z; }, field.values);
+        REQUIRE(field.values.size() == positions.size());
+        for (float isovalue : {0.0f, 0.5f, -0.9f}) {
+            auto reference = ReferenceIsosurfaceCalculation(positions, field.directions, field.values, isovalue).calculate(tetrahedra);
+            REQUIRE(reference.triangle_indices.size() > 0);
+            for (unsigned int max_threads : {1u, 3u, 8u}) {
+                INFO("isovalue " << isovalue << ", " << max_threads << " threads");
+                requireSameIsosurface(VectorfieldIsosurface::calculate(positions, field.directions, field.values, isovalue, tetrahedra, max_threads), reference);
+            }
+        }
+    }
+
+    SECTION("values which are equal to the isovalue") {
+        // Integer values, many of which lie exactly on the isosurface
+        VectorfieldIsosurface::calculateValues(positions, field.directions, [](const glm::vec3& position, const glm::vec3&) { return std::round(4 * position.x + 2 * position.y); }, field.values);
+        for (float isovalue : {0.0f, 1.0f}) {
+            auto reference = ReferenceIsosurfaceCalculation(positions, field.directions, field.values, isovalue).calculate(tetrahedra);
+            REQUIRE(reference.triangle_indices.size() > 0);
+            for (unsigned int max_threads : {1u, 4u}) {
+                INFO("isovalue " << isovalue << ", " << max_threads << " threads");
+                requireSameIsosurface(VectorfieldIsosurface::calculate(positions, field.directions, field.values, isovalue, tetrahedra, max_threads), reference);
+            }
+        }
+    }
+
+    SECTION("no isosurface") {
+        field.values.assign(positions.size(), 1.0f);
+        auto isosurface = VectorfieldIsosurface::calculate(positions, field.directions, field.values, 2.0f, tetrahedra);
+        REQUIRE(isosurface.positions.empty());
+        REQUIRE(isosurface.triangle_indices.empty());
+    }
+}
+
+TEST_CASE("Isosurface of a small geometry", "[isosurface]") {
+    Field field(3);
+    VectorfieldIsosurface::calculateValues(field.geometry.positions(), field.directions, [](const glm::vec3& position, const glm::vec3&) { return position.x; }, field.values);
+    auto isosurface = VectorfieldIsosurface::calculate(field.geometry.positions(), field.directions, field.values, 0.5f, field.geometry.volumeIndices());
+    auto reference = ReferenceIsosurfaceCalculation(field.geometry.positions(), field.directions, field.values, 0.5f).calculate(field.geometry.volumeIndices());
+    requireSameIsosurface(isosurface, reference);
+    // The plane x = 0.5 intersects the cube
+    REQUIRE(isosurface.triangle_indices.size() > 0);
+    for (const auto& position : isosurface.positions) {
+        REQUIRE(position.x == Approx(0.5f));
+    }
+    for (const auto& normal : isosurface.normals) {
+        REQUIRE(std::abs(normal.x) == Approx(1.0f));
+    }
+}
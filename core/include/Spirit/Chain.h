@@ -3,6 +3,8 @@
 #define SPIRIT_CORE_CHAIN_H
 #include "DLL_Define_Export.h"
 
+#include "Spirit_Defines.h"
+
 struct State;
 
 /*
@@ -138,6 +140,30 @@ Fills an array with the interpolated energy values along the chain.
 */
 PREFIX void Chain_Get_Energy_Interpolated( State * state, float * E_interpolated, int idx_chain = -1 ) SUFFIX;
 
+/*
+Copies the spin directions of all images in the chain into `spins`, which needs to have
+length `3*NOS*NOI`. The images follow each other, i.e. the array has the shape `[NOI][NOS][3]`.
+
+In contrast to `System_Get_Spin_Directions`, this is a copy. The chain is locked while it is made,
+so that the images are consistent with each other even if a calculation is running.
+*/
+PREFIX void Chain_Get_Spin_Directions( State * state, scalar * spins, int idx_chain = -1 ) SUFFIX;
+
+/*
+Sets the spin directions of all images in the chain from `spins`, which has the same layout as in
+`Chain_Get_Spin_Directions`. The directions are normalized.
+*/
+PREFIX void Chain_Set_Spin_Directions( State * state, const scalar * spins, int idx_chain = -1 ) SUFFIX;
+
+/*
+Copies the effective fields of all images in the chain into `fields`, which has the same layout as
+in `Chain_Get_Spin_Directions`.
+
+Like `System_Get_Effective_Field`, this returns the effective fields which were calculated last by
+a method running on the images, e.g. GNEB.
+*/
+PREFIX void Chain_Get_Effective_Fields( State * state, scalar * fields, int idx_chain = -1 ) SUFFIX;
+
 /* TODO: energy array getter
 std::vector<std::vector<float>> Chain_Get_Energy_Array_Interpolated(State * state, int idx_chain=-1) SUFFIX;
 */
@@ -89,7 +89,7 @@ Getters
 /*
 **Returns:** the number of spins.
 */
-PREFIX int Geometry_Get_NOS( State * state ) SUFFIX;
+PREFIX spirit_index Geometry_Get_NOS( State * state ) SUFFIX;
 
 /*
 **Returns:** pointer to positions of spins (array of length 3*NOS).
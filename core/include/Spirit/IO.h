@@ -21,6 +21,8 @@ Definition of file formats for vectorfields
 --------------------------------------------------------------------
 
 Spirit uses the OOMMF vector field file format with some minor variations.
+For long time series of spin configurations, a chunked and compressed trajectory
+format is available, which can be read with `spirit.trajectory` in Python.
 */
 
 // OVF binary format, using the precision of Spirit
@@ -38,6 +40,12 @@ Spirit uses the OOMMF vector field file format with some minor variations.
 // OVF text format with comma-separated columns
 #define IO_Fileformat_OVF_csv 4
 
+// Spirit trajectory format: chunked and losslessly compressed (byte-shuffle + LZ)
+#define IO_Fileformat_Trajectory 5
+
+// Spirit trajectory format: directions quantised to 2x16 bit spherical coordinates, then compressed
+#define IO_Fileformat_Trajectory_quantised 6
+
 /*
 Other
 --------------------------------------------------------------------
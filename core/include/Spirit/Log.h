@@ -58,13 +58,14 @@ PREFIX void Log_Send(
     State * state, Spirit_Log_Level level, Spirit_Log_Sender sender, const char * message, int idx_image = -1,
     int idx_chain = -1 ) SUFFIX;
 
-// Get the entries from the Log and write new number of entries into given int
+// Get the most recent entries from the Log and, if given, write the total number of entries into `n_entries`.
+// Only the last entries are kept, so the first returned entry has the index `n_entries - entries.size()`.
 // TODO: can this be written in a C-style way?
 namespace Utility
 {
 struct LogEntry;
 }
-std::vector<Utility::LogEntry> Log_Get_Entries( State * state ) SUFFIX;
+std::vector<Utility::LogEntry> Log_Get_Entries( State * state, int * n_entries = nullptr ) SUFFIX;
 
 // Append the Log to it's file
 PREFIX void Log_Append( State * state ) SUFFIX;
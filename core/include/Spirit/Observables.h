@@ -0,0 +1,102 @@
+#pragma once
+#ifndef SPIRIT_CORE_OBSERVABLES_H
+#define SPIRIT_CORE_OBSERVABLES_H
+#include "DLL_Define_Export.h"
+
+struct State;
+
+/*
+Observables
+====================================================================
+
+```C
+#include "Spirit/Observables.h"
+```
+
+Observables are recorded inside the iteration loop of a running method, every `step` iterations,
+without the overhead of calling the API between the iterations. Each image has its own set of observables
+and its own time series of samples.
+
+Each sample is a row of values. The first two columns are the iteration and the simulated time
+(in picoseconds, only for LLG simulations), followed by the columns of the observables in the order
+in which they were added. The labels of the columns can be retrieved with `Observables_Get_Labels`.
+
+Once the maximum number of samples is reached, the oldest samples are overwritten.
+*/
+
+/*
+Observables
+--------------------------------------------------------------------
+*/
+
+// Magnetization, i.e. the mean of mu_s * spin (columns "m_x", "m_y", "m_z")
+#define Observable_Magnetization 0
+
+// Magnetization of each basis atom of the unit cell (columns "m_x_0", "m_y_0", "m_z_0", ...)
+#define Observable_Sublattice_Magnetization 1
+
+// Topological charge, only calculated for 2D systems (column "Q")
+#define Observable_Topological_Charge 2
+
+// Total energy and energy of each interaction (columns "E", "E_Zeeman", ...)
+#define Observable_Energy 3
+
+// Spin-spin correlation, i.e. the static structure factor. Use `Observables_Add_Correlation` to add it.
+#define Observable_Correlation 4
+
+// Maximum torque (column "max_torque")
+#define Observable_Max_Torque 5
+
+/*
+Setup
+--------------------------------------------------------------------
+*/
+
+// Adds an observable (see the definitions above). Observables which were already added are ignored.
+PREFIX void Observables_Add( State * state, int observable, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+// Adds the spin-spin correlation at the wave vector q (in units of 1/Angstrom), i.e. the column "S(qx,qy,qz)"
+PREFIX void
+Observables_Add_Correlation( State * state, const float q[3], int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+// Removes all observables and samples
+PREFIX void Observables_Clear( State * state, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+// Removes all samples, but keeps the observables
+PREFIX void Observables_Reset_Samples( State * state, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+// Sets the number of iterations between two samples
+PREFIX void Observables_Set_Step( State * state, int n_iterations, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+// Returns the number of iterations between two samples
+PREFIX int Observables_Get_Step( State * state, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+// Sets the maximum number of stored samples. The most recent samples are kept.
+PREFIX void
+Observables_Set_Capacity( State * state, int n_samples_max, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+/*
+Samples
+--------------------------------------------------------------------
+*/
+
+// Returns the number of stored samples
+PREFIX int Observables_Get_N_Samples( State * state, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+// Returns the number of columns of the stored samples
+PREFIX int Observables_Get_N_Columns( State * state, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+// Retrieves the labels of the columns, represented as a single string and separated by "|". E.g
+// "iteration|time|m_x|m_y|m_z". If 'labels' is a nullptr, the required length of the char array is returned.
+PREFIX int Observables_Get_Labels( State * state, char * labels, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+/*
+Retrieves the stored samples in chronological order.
+
+The array is contiguous and of shape (N_Samples, N_Columns).
+If 'samples' is a nullptr, the required length of the array is returned.
+*/
+PREFIX int Observables_Get_Samples( State * state, float * samples, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+#include "DLL_Undefine_Export.h"
+#endif
@@ -86,6 +86,16 @@ Set the number of iterations and how often to log and write output.
 PREFIX void
 Parameters_GNEB_Set_N_Iterations( State * state, int n_iterations, int n_iterations_log, int idx_chain = -1 ) SUFFIX;
 
+/*
+Set after how many iterations the convergence is checked.
+
+The torques, the interpolated energies and the observables are only updated after this number
+of iterations, which saves the corresponding passes over the spins. The simulation may
+therefore run up to `n_iterations_amortize - 1` iterations past convergence.
+*/
+PREFIX void
+Parameters_GNEB_Set_N_Iterations_Amortize( State * state, int n_iterations_amortize, int idx_chain = -1 ) SUFFIX;
+
 /*
 Set Parameters
 --------------------------------------------------------------------
@@ -163,6 +173,9 @@ PREFIX void Parameters_GNEB_Get_Output_Chain( State * state, bool * step, int *
 PREFIX void
 Parameters_GNEB_Get_N_Iterations( State * state, int * iterations, int * iterations_log, int idx_chain = -1 ) SUFFIX;
 
+// Returns after how many iterations the convergence is checked.
+PREFIX int Parameters_GNEB_Get_N_Iterations_Amortize( State * state, int idx_chain = -1 ) SUFFIX;
+
 /*
 Get Parameters
 --------------------------------------------------------------------
@@ -70,6 +70,16 @@ Set the number of iterations and how often to log and write output.
 PREFIX void Parameters_LLG_Set_N_Iterations(
     State * state, int n_iterations, int n_iterations_log, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
 
+/*
+Set after how many iterations the convergence is checked.
+
+The torques, the effective field and the observables are only updated after this number
+of iterations, which saves the corresponding passes over the spins. The simulation may
+therefore run up to `n_iterations_amortize - 1` iterations past convergence.
+*/
+PREFIX void Parameters_LLG_Set_N_Iterations_Amortize(
+    State * state, int n_iterations_amortize, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
 /*
 Set Parameters
 --------------------------------------------------------------------
@@ -155,6 +165,9 @@ PREFIX void Parameters_LLG_Get_Output_Configuration(
 PREFIX void Parameters_LLG_Get_N_Iterations(
     State * state, int * iterations, int * iterations_log, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
 
+// Returns after how many iterations the convergence is checked.
+PREFIX int Parameters_LLG_Get_N_Iterations_Amortize( State * state, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
 /*
 Get Parameters
 --------------------------------------------------------------------
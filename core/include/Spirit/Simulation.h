@@ -26,7 +26,7 @@ regular simulation, except that the iterations have to be triggered manually.
 Definition of solvers
 --------------------------------------------------------------------
 
-Note that the VP and LBFGS Solvers are only meant for direct minimization and not for dynamics.
+Note that the VP, LBFGS, NCG and Newton Solvers are only meant for direct minimization and not for dynamics.
 */
 
 // `VP`: Verlet-like velocity projection
@@ -53,6 +53,12 @@ Note that the VP and LBFGS Solvers are only meant for direct minimization and no
 // `Solver_VP_OSO`: Verlet-like velocity projection, exponential transform
 #define Solver_VP_OSO 7
 
+// `NCG`: Preconditioned nonlinear conjugate gradients, exponential transform
+#define Solver_NCG 8
+
+// `Newton`: Trust-region Newton-Krylov, exponential transform
+#define Solver_Newton 9
+
 // A struct that can be passed as an additional argument to the `Simulation_XXX_Start` methods to gather some basic
 // information about the simulation run
 struct Simulation_Run_Info
@@ -124,6 +130,43 @@ PREFIX void Simulation_Stop( State * state, int idx_image = -1, int idx_chain =
 // Stop all simulations
 PREFIX void Simulation_Stop_All( State * state ) SUFFIX;
 
+/*
+Request all running simulations of all states to stop after their current iteration.
+
+As this only sets an atomic flag, it may be called from a signal handler. The simulations
+finish as if they had found a `STOP` file.
+*/
+PREFIX void Simulation_Request_Stop() SUFFIX;
+
+/*
+Checkpoints
+--------------------------------------------------------------------
+
+A checkpoint contains the complete state of an LLG, MC, GNEB or MMF calculation: the spins, the
+memory of the solver (e.g. LBFGS updates or VP velocities), the state of the random number
+generator and the iteration counters. A calculation resumed from it continues bit-identically,
+as if it had not been interrupted. Checkpoints are meant to be resumed by the same build of Spirit.
+
+Checkpoints are written periodically if e.g. `llg_checkpoint_interval` is set in the input file,
+as well as when such a calculation stops (e.g. because its walltime ran out). They are written
+to `llg_checkpoint_file` or, by default, to the output folder.
+*/
+
+// Write a checkpoint of the simulation running on an image or chain
+PREFIX void
+Simulation_Write_Checkpoint( State * state, const char * file, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+/*
+Resume the calculation saved in a checkpoint, on an image (LLG, MC, MMF) or on a chain (GNEB)
+which has the same numbers of images and spins.
+
+The remaining arguments are the same as for `Simulation_XXX_Start`. The number of iterations
+includes those which were performed before the checkpoint was written.
+*/
+PREFIX void Simulation_Resume(
+    State * state, const char * file, int n_iterations = -1, int n_iterations_log = -1, bool singleshot = false,
+    Simulation_Run_Info * info = nullptr, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
 /*
 Get information
 --------------------------------------------------------------------
@@ -203,6 +246,34 @@ If a GNEB simulation is running this returns the Method name on the current chai
 */
 PREFIX const char * Simulation_Get_Method_Name( State * state, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
 
+/*
+Profiling
+--------------------------------------------------------------------
+
+If Spirit was built with the CMake option `SPIRIT_ENABLE_PROFILING`, the wall time spent
+in the Hamiltonian terms (exchange, DMI, DDI including its FFTs, ...), the solver iterations,
+thermal noise, convergence checks and I/O is measured. The times are inclusive, e.g. the
+time of the gradient contains the time of the individual terms, and they are summed over
+all threads and simulations until they are reset.
+*/
+
+// Returns the number of profiled sections
+PREFIX int Simulation_Get_N_Timings( State * state ) SUFFIX;
+
+// Returns the name of the profiled section with the given index
+PREFIX const char * Simulation_Get_Timing_Name( State * state, int idx_section ) SUFFIX;
+
+/*
+Writes the accumulated wall time [s] and number of calls of each profiled section into
+`seconds` and `calls`, which need to have length `Simulation_Get_N_Timings`.
+
+Returns false, and sets everything to zero, if Spirit was built without profiling.
+*/
+PREFIX bool Simulation_Get_Timings( State * state, float * seconds, int * calls ) SUFFIX;
+
+// Sets the accumulated timings of all profiled sections to zero
+PREFIX void Simulation_Reset_Timings( State * state ) SUFFIX;
+
 /*
 Whether a simulation is running
 --------------------------------------------------------------------
@@ -25,7 +25,7 @@ out of the chain a function should be applied to.
 PREFIX int System_Get_Index( State * state ) SUFFIX;
 
 // Returns the number of spins (NOS) of a spin system.
-PREFIX int System_Get_NOS( State * state, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+PREFIX spirit_index System_Get_NOS( State * state, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
 
 /*
 Returns a pointer to the spin orientations data.
@@ -34,6 +34,30 @@ The array is contiguous and of shape (NOS, 3).
 */
 PREFIX scalar * System_Get_Spin_Directions( State * state, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
 
+/*
+Returns the number of spins written by `System_Get_Spin_Snapshot` for the given `n_cell_step`, i.e.
+the number of basis atoms times the number of cells, which is divided by `n_cell_step` along each
+translation vector (but at least one).
+*/
+PREFIX spirit_index
+System_Get_Snapshot_NOS( State * state, int n_cell_step = 1, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
+/*
+Writes the spin directions of every `n_cell_step`-th cell along each translation vector into
+`directions` in single precision. The array has to be contiguous and of shape
+(`System_Get_Snapshot_NOS`, 3). Vacancies are written as zero vectors.
+
+While a simulation is running on the system, the directions are taken from the latest snapshot
+published by the simulation. Such a snapshot is never partly updated, is at most one iteration old
+and is read without locking the system, so frequent calls (e.g. for visualisation) do not slow down
+the simulation.
+
+Returns the number of the snapshot, which increases with each snapshot published by a simulation,
+or 0 if the directions were copied from the system itself, e.g. because no simulation is running.
+*/
+PREFIX long System_Get_Spin_Snapshot(
+    State * state, float * directions, int n_cell_step = 1, int idx_image = -1, int idx_chain = -1 ) SUFFIX;
+
 /*
 Returns a pointer to the effective field data.
 
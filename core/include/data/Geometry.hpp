@@ -6,6 +6,7 @@
 #include <Spirit/Geometry.h>
 #include <engine/Vectormath_Defines.hpp>
 
+#include <array>
 #include <vector>
 
 namespace Data
@@ -24,6 +25,11 @@ struct vector2_t
 using tetrahedron_t = std::array<int, 4>;
 using triangle_t    = std::array<int, 3>;
 
+// Simplices given by the sites of a small block of cells. Replicating the simplices of such a stencil across
+// the cells of a lattice gives a triangulation of the whole lattice.
+using tetrahedron_stencil_t = std::array<Site, 4>;
+using triangle_stencil_t    = std::array<Site, 3>;
+
 enum class BravaisLatticeType
 {
     Irregular   = Bravais_Lattice_Irregular,   // Arbitrary bravais vectors
@@ -124,11 +130,11 @@ public:
     // The kind of geometry
     BravaisLatticeType classifier;
     // Number of sites (total)
-    int nos;
+    spirit_index nos;
     // Number of non-vacancy sites (if defects are activated)
-    int nos_nonvacant;
+    spirit_index nos_nonvacant;
     // Number of basis cells total
-    int n_cells_total;
+    spirit_index n_cells_total;
     // Positions of all the atoms
     vectorfield positions;
     // Spin magnetic moments of the atoms
@@ -145,6 +151,10 @@ public:
     Vector3 center, bounds_min, bounds_max;
     // Unit Cell Bounds
     Vector3 cell_bounds_min, cell_bounds_max;
+    // Stencil of the topological charge density of a 2D lattice: triangles of the basis atoms and the
+    // neighbouring lattice sites in directions a, b and a+b, and the orientations (+1 or -1) of the triangles
+    std::vector<triangle_stencil_t> charge_stencil;
+    std::vector<scalar> charge_stencil_signs;
 
 private:
     // Generate the full set of spin positions
@@ -159,11 +169,27 @@ private:
     void calculateUnitCellBounds();
     // Calculate and update the type lattice
     void calculateGeometryType();
+    // Calculate and update the stencil of the topological charge density
+    void calculateChargeStencil();
+
+    // Retrieve the stencils of the triangulation and tetrahedra of the lattice, in which every n_cell_step'th
+    // cell is used and only the directions marked as extended are translated. They are empty if the lattice
+    // cannot be triangulated cell by cell, e.g. because its triangulation is not local.
+    const std::vector<triangle_stencil_t> & triangleStencil( int n_cell_step, std::array<bool, 3> extended );
+    const std::vector<tetrahedron_stencil_t> & tetrahedronStencil( int n_cell_step, std::array<bool, 3> extended );
 
     //
     std::vector<triangle_t> _triangulation;
     std::vector<tetrahedron_t> _tetrahedra;
 
+    // The stencils and the arguments they were calculated for
+    std::vector<triangle_stencil_t> _triangle_stencil;
+    std::vector<tetrahedron_stencil_t> _tetrahedron_stencil;
+    int triangle_stencil_n_cell_step    = -1;
+    int tetrahedron_stencil_n_cell_step = -1;
+    std::array<bool, 3> triangle_stencil_extended;
+    std::array<bool, 3> tetrahedron_stencil_extended;
+
     // Temporaries to tell wether the triangulation or tetrahedra
     // need to be updated when the corresponding function is called
     int last_update_n_cell_step;
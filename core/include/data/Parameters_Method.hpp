@@ -28,6 +28,12 @@ struct Parameters_Method
     // Force convergence criterium
     double force_convergence = 1e-10;
 
+    // Number of iterations after which a checkpoint is written, from which the calculation can be resumed
+    // (0 means no checkpoints are written)
+    long int checkpoint_interval = 0;
+    // Checkpoint file (if empty, it is placed in the output folder)
+    std::string checkpoint_file = "";
+
     // ----------------- Output --------------
     // Data output folder
     std::string output_folder = "output";
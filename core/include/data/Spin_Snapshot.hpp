@@ -0,0 +1,64 @@
+#pragma once
+#ifndef SPIRIT_CORE_DATA_SPIN_SNAPSHOT_HPP
+#define SPIRIT_CORE_DATA_SPIN_SNAPSHOT_HPP
+
+#include "Spirit_Defines.h"
+#include <data/Geometry.hpp>
+#include <engine/Vectormath_Defines.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace Data
+{
+
+/*
+Consistent copies of the spin directions of a system in single precision, which can be read while a
+simulation is running on the system, e.g. for visualisation.
+
+The thread iterating on the system publishes a snapshot whenever one was requested since the last publication.
+It writes it into the one of two buffers which was not published last. Readers copy the last published buffer
+without taking a lock and check afterwards, through the counters of started and finished publications, that
+the writer did not start to overwrite it in the meantime (a sequence lock). The writer therefore never waits for
+the readers, and the readers never see a partly updated state.
+*/
+class Spin_Snapshot
+{
+public:
+    // Publishes `spins` if a snapshot was requested since the last publication, or if `force` is set. Only one
+    // thread may publish at a time, e.g. the one holding the lock of the system
+    void Publish( const vectorfield & spins, bool force = false );
+
+    /*
+    Copies the last published snapshot into `directions` (see `Export`) and requests a new one.
+
+    Returns the number of the snapshot, which increases with every publication, or 0 if no consistent snapshot
+    of the geometry's number of spins could be read. In that case `directions` may have been partly written.
+    */
+    std::uint64_t Read( const Geometry & geometry, int n_cell_step, float * directions );
+
+    // Number of spins written by `Export` for every `n_cell_step`-th cell along each translation vector
+    static spirit_index Subsampled_NOS( const Geometry & geometry, int n_cell_step );
+
+    // Copies every `n_cell_step`-th cell of `spins` into `directions` [3 * Subsampled_NOS] in single precision,
+    // with zero vectors for the vacancies
+    static void Export( const vectorfield & spins, const Geometry & geometry, int n_cell_step, float * directions );
+
+private:
+    struct Buffers
+    {
+        field<float> directions[2];
+        // Publication n writes into directions[n % 2]
+        std::atomic<std::uint64_t> n_started{ 0 };
+        std::atomic<std::uint64_t> n_finished{ 0 };
+    };
+
+    // Replaced, not resized, when the number of spins changes, as readers may still use the previous buffers
+    std::shared_ptr<Buffers> buffers = std::make_shared<Buffers>();
+    std::atomic<bool> requested{ true };
+};
+
+} // namespace Data
+
+#endif
@@ -9,11 +9,14 @@
 #include <data/Parameters_Method_LLG.hpp>
 #include <data/Parameters_Method_MC.hpp>
 #include <data/Parameters_Method_MMF.hpp>
+#include <data/Spin_Snapshot.hpp>
 #include <engine/Hamiltonian.hpp>
+#include <engine/Observables.hpp>
 #include <engine/Vectormath_Defines.hpp>
 #include <utility/Ordered_Lock.hpp>
 
 #include <memory>
+#include <mutex>
 #include <random>
 
 namespace Data
@@ -32,27 +35,35 @@ public:
         std::unique_ptr<Parameters_Method_LLG> llg_params, std::unique_ptr<Parameters_Method_MC> mc_params,
         std::unique_ptr<Parameters_Method_EMA> ema_params, std::unique_ptr<Parameters_Method_MMF> mmf_params,
         bool iteration_allowed );
-    // Copy constructor
+    // Copy constructor. The copy has its own spins, but shares the geometry and Hamiltonian with `other` until one of
+    // them calls `Unshare_Hamiltonian`
     Spin_System( Spin_System const & other );
-    // Assignment operator
+    // Assignment operator, sharing the geometry and Hamiltonian like the copy constructor
     Spin_System & operator=( Spin_System const & other );
 
     // Update
     void UpdateEnergy();
     void UpdateEffectiveField();
 
+    // Gives this system its own copy of the geometry and Hamiltonian, if they are shared with other systems. This has
+    // to be called before they are modified, or used by a Method or any other lengthy calculation.
+    void Unshare_Hamiltonian();
+    bool Hamiltonian_Is_Shared() const;
+
     // For multithreading
     void Lock() noexcept;
     void Unlock() noexcept;
 
     // Number of spins
-    int nos;
+    spirit_index nos;
     // Eigenmodes of the system: modes[nem][dim][nos]
     std::vector<std::shared_ptr<vectorfield>> modes;
     // Eigenvalues of the system
     std::vector<scalar> eigenvalues;
     // Orientations of the spins: spins[dim][nos]
     std::shared_ptr<vectorfield> spins;
+    // Snapshots of the spins, published by a Method iterating on this system
+    std::shared_ptr<Spin_Snapshot> snapshot;
     // Spin Hamiltonian
     std::shared_ptr<Engine::Hamiltonian> hamiltonian;
     // Geometric information
@@ -65,6 +76,8 @@ public:
     std::shared_ptr<Parameters_Method_EMA> ema_parameters;
     // Parameters for MMF
     std::shared_ptr<Parameters_Method_MMF> mmf_parameters;
+    // Observables recorded while iterating and their time series
+    std::shared_ptr<Engine::Observables> observables;
     // Is it allowed to iterate on this system or do a singleshot?
     bool iteration_allowed;
     bool singleshot_allowed;
@@ -80,6 +93,8 @@ public:
 private:
     // FIFO mutex for thread-safety
     Utility::OrderedLock ordered_lock;
+    // The Hamiltonian keeps buffers for its calculations, so the systems sharing it must not use it at the same time
+    std::shared_ptr<std::mutex> hamiltonian_mutex;
 };
 
 } // namespace Data
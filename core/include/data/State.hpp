@@ -25,7 +25,7 @@ struct State
     std::shared_ptr<vectorfield> clipboard_spins;
 
     // Number of Spins
-    int nos{ 0 };
+    spirit_index nos{ 0 };
     // Number of Images
     int noi{ 0 };
     // Index of the urrently "active" image
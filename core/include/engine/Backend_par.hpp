@@ -12,6 +12,12 @@
 #else
     #define SPIRIT_LAMBDA
 #endif
+
+#if defined( SPIRIT_USE_THREADS ) && !defined( SPIRIT_USE_CUDA )
+    #include <utility/Thread_Pool.hpp>
+    #include <numeric>
+    #include <vector>
+#endif
 // clang-format on
 
 namespace Engine
@@ -24,23 +30,23 @@ namespace par
 #ifdef SPIRIT_USE_CUDA
 
 template<typename F>
-__global__ void cu_apply( int N, F f )
+__global__ void cu_apply( spirit_index N, F f )
 {
-    int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    spirit_index idx = spirit_index( blockIdx.x ) * blockDim.x + threadIdx.x;
     if( idx < N )
         f( idx );
 }
 
 // vf1[i] = f( vf2[i] )
 template<typename F>
-void apply( int N, F f )
+void apply( spirit_index N, F f )
 {
     cu_apply<<<( N + 1023 ) / 1024, 1024>>>( N, f );
     CU_CHECK_AND_SYNC();
 }
 
 template<typename F>
-scalar reduce( int N, const F f )
+scalar reduce( spirit_index N, const F f )
 {
     static scalarfield sf( N, 0 );
     // Vectormath::fill(sf, 0);
@@ -49,7 +55,7 @@ scalar reduce( int N, const F f )
         sf.resize( N );
 
     auto s = sf.data();
-    apply( N, [f, s] SPIRIT_LAMBDA( int idx ) { s[idx] = f( idx ); } );
+    apply( N, [f, s] SPIRIT_LAMBDA( spirit_index idx ) { s[idx] = f( idx ); } );
 
     static scalarfield ret( 1, 0 );
 
@@ -72,7 +78,7 @@ scalar reduce( const field<A> & vf1, const F f )
     // We also use this workaround for a single field as argument, because cub does not support non-commutative
     // reduction operations
 
-    int n = vf1.size();
+    spirit_index n = vf1.size();
     static scalarfield sf( n, 0 );
     // Vectormath::fill(sf, 0);
 
@@ -81,7 +87,7 @@ scalar reduce( const field<A> & vf1, const F f )
 
     auto s  = sf.data();
     auto v1 = vf1.data();
-    apply( n, [f, s, v1] SPIRIT_LAMBDA( int idx ) { s[idx] = f( v1[idx] ); } );
+    apply( n, [f, s, v1] SPIRIT_LAMBDA( spirit_index idx ) { s[idx] = f( v1[idx] ); } );
 
     static scalarfield ret( 1, 0 );
     // Vectormath::fill(ret, 0);
@@ -102,7 +108,7 @@ template<typename A, typename B, typename F>
 scalar reduce( const field<A> & vf1, const field<B> & vf2, const F f )
 {
     // TODO: remove the reliance on a temporary scalar field (maybe thrust::dot with generalized operations)
-    int n = vf1.size();
+    spirit_index n = vf1.size();
     static scalarfield sf( n, 0 );
     // Vectormath::fill(sf, 0);
 
@@ -112,7 +118,7 @@ scalar reduce( const field<A> & vf1, const field<B> & vf2, const F f )
     auto s  = sf.data();
     auto v1 = vf1.data();
     auto v2 = vf2.data();
-    apply( n, [f, s, v1, v2] SPIRIT_LAMBDA( int idx ) { s[idx] = f( v1[idx], v2[idx] ); } );
+    apply( n, [f, s, v1, v2] SPIRIT_LAMBDA( spirit_index idx ) { s[idx] = f( v1[idx], v2[idx] ); } );
 
     static scalarfield ret( 1, 0 );
     // Vectormath::fill(ret, 0);
@@ -130,9 +136,9 @@ scalar reduce( const field<A> & vf1, const field<B> & vf2, const F f )
 
 // vf1[i] = f( vf2[i] )
 template<typename A, typename B, typename F>
-__global__ void cu_set_lambda( A * vf1, const B * vf2, F f, int N )
+__global__ void cu_set_lambda( A * vf1, const B * vf2, F f, spirit_index N )
 {
-    int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    spirit_index idx = spirit_index( blockIdx.x ) * blockDim.x + threadIdx.x;
     if( idx < N )
     {
         vf1[idx] = f( vf2[idx] );
@@ -143,19 +149,74 @@ __global__ void cu_set_lambda( A * vf1, const B * vf2, F f, int N )
 template<typename A, typename B, typename F>
 void set( field<A> & vf1, const field<B> & vf2, F f )
 {
-    int N = vf1.size();
+    spirit_index N = vf1.size();
     cu_set_lambda<<<( N + 1023 ) / 1024, 1024>>>( vf1.data(), vf2.data(), f, N );
     CU_CHECK_AND_SYNC();
 }
 
+#elif defined( SPIRIT_USE_THREADS )
+
+// The loops are split into chunks, which are distributed over the threads of the pool.
+// Reductions sum the partial results of the chunks in order, so they do not depend on the number of threads.
+
+template<typename F>
+scalar reduce( spirit_index N, const F f )
+{
+    auto & pool = Utility::Thread_Pool::Get();
+    std::vector<scalar> partial_sums( pool.N_Chunks( N ), 0 );
+    pool.Parallel_For(
+        N,
+        [&]( int i_chunk, spirit_index begin, spirit_index end )
+        {
+            scalar res = 0;
+            for( spirit_index idx = begin; idx < end; ++idx )
+                res += f( idx );
+            partial_sums[i_chunk] = res;
+        } );
+    return std::accumulate( partial_sums.begin(), partial_sums.end(), scalar( 0 ) );
+}
+
+template<typename A, typename F>
+scalar reduce( const field<A> & vf1, const F f )
+{
+    return reduce( vf1.size(), [&]( spirit_index idx ) { return f( vf1[idx] ); } );
+}
+
+// result = sum_i  f( vf1[i], vf2[i] )
+template<typename A, typename B, typename F>
+scalar reduce( const field<A> & vf1, const field<B> & vf2, const F & f )
+{
+    return reduce( vf1.size(), [&]( spirit_index idx ) { return f( vf1[idx], vf2[idx] ); } );
+}
+
+// f( vf1[idx], idx ) for all i
+template<typename F>
+void apply( spirit_index N, const F & f )
+{
+    Utility::Thread_Pool::Get().Parallel_For(
+        N,
+        [&]( int, spirit_index begin, spirit_index end )
+        {
+            for( spirit_index idx = begin; idx < end; ++idx )
+                f( idx );
+        } );
+}
+
+// vf1[i] = f( vf2[i] )
+template<typename A, typename B, typename F>
+void set( field<A> & vf1, const field<B> & vf2, const F & f )
+{
+    apply( vf1.size(), [&]( spirit_index idx ) { vf1[idx] = f( vf2[idx] ); } );
+}
+
 #else
 
 template<typename F>
-scalar reduce( int N, const F f )
+scalar reduce( spirit_index N, const F f )
 {
     scalar res = 0;
 #pragma omp parallel for reduction( + : res )
-    for( unsigned int idx = 0; idx < N; ++idx )
+    for( spirit_index idx = 0; idx < N; ++idx )
     {
         res += f( idx );
     }
@@ -167,7 +228,7 @@ scalar reduce( const field<A> & vf1, const F f )
 {
     scalar res = 0;
 #pragma omp parallel for reduction( + : res )
-    for( unsigned int idx = 0; idx < vf1.size(); ++idx )
+    for( spirit_index idx = 0; idx < spirit_index( vf1.size() ); ++idx )
     {
         res += f( vf1[idx] );
     }
@@ -180,7 +241,7 @@ scalar reduce( const field<A> & vf1, const field<B> & vf2, const F & f )
 {
     scalar res = 0;
 #pragma omp parallel for reduction( + : res )
-    for( unsigned int idx = 0; idx < vf1.size(); ++idx )
+    for( spirit_index idx = 0; idx < spirit_index( vf1.size() ); ++idx )
     {
         res += f( vf1[idx], vf2[idx] );
     }
@@ -192,7 +253,7 @@ template<typename A, typename B, typename F>
 void set( field<A> & vf1, const field<B> & vf2, const F & f )
 {
 #pragma omp parallel for
-    for( unsigned int idx = 0; idx < vf1.size(); ++idx )
+    for( spirit_index idx = 0; idx < spirit_index( vf1.size() ); ++idx )
     {
         vf1[idx] = f( vf2[idx] );
     }
@@ -200,10 +261,10 @@ void set( field<A> & vf1, const field<B> & vf2, const F & f )
 
 // f( vf1[idx], idx ) for all i
 template<typename F>
-void apply( int N, const F & f )
+void apply( spirit_index N, const F & f )
 {
 #pragma omp parallel for
-    for( unsigned int idx = 0; idx < N; ++idx )
+    for( spirit_index idx = 0; idx < N; ++idx )
     {
         f( idx );
     }
@@ -149,7 +149,7 @@ inline void FFT_Init()
 #endif
 }
 
-inline void get_strides( field<int *> & strides, const field<int> & maxVal )
+inline void get_strides( field<spirit_index *> & strides, const field<spirit_index> & maxVal )
 {
     strides.resize( maxVal.size() );
     *( strides[0] ) = 1;
@@ -161,11 +161,11 @@ inline void get_strides( field<int *> & strides, const field<int> & maxVal )
 
 struct StrideContainer
 {
-    int comp;
-    int basis;
-    int a;
-    int b;
-    int c;
+    spirit_index comp;
+    spirit_index basis;
+    spirit_index a;
+    spirit_index b;
+    spirit_index c;
 };
 
 struct FFT_Plan
@@ -187,12 +187,12 @@ struct FFT_Plan
     // Constructor delegation
     FFT_Plan() : FFT_Plan( { 2, 2, 2 }, true, 1, 8 ) {}
 
-    FFT_Plan( std::vector<int> dims, bool inverse, int n_transforms, int len )
+    FFT_Plan( std::vector<int> dims, bool inverse, int n_transforms, spirit_index len )
             : dims( dims ),
               inverse( inverse ),
               n_transforms( n_transforms ),
-              real_ptr( field<FFT::FFT_real_type>( n_transforms * len ) ),
-              cpx_ptr( field<FFT::FFT_cpx_type>( n_transforms * len ) )
+              real_ptr( field<FFT::FFT_real_type>( std::size_t( n_transforms ) * len ) ),
+              cpx_ptr( field<FFT::FFT_cpx_type>( std::size_t( n_transforms ) * len ) )
 
     {
         this->Create_Configuration();
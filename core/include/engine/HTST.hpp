@@ -6,6 +6,7 @@
 #include "Spirit_Defines.h"
 #include <data/Spin_System.hpp>
 #include <data/Spin_System_Chain.hpp>
+#include <engine/Manifoldmath.hpp>
 #include <engine/Vectormath_Defines.hpp>
 
 namespace Engine
@@ -18,8 +19,8 @@ void Calculate( Data::HTST_Info & htst_info, int n_eigenmodes_keep = 0 );
 
 // Calculate the 'a' component of the prefactor
 void Calculate_Perpendicular_Velocity(
-    const vectorfield & spins, const scalarfield & mu_s, const MatrixX & hessian, const MatrixX & basis,
-    const MatrixX & eigenbasis, VectorX & a );
+    const vectorfield & spins, const scalarfield & mu_s, const MatrixX & hessian,
+    const field<Manifoldmath::Matrix3x2> & basis, const MatrixX & eigenbasis, VectorX & a );
 
 // Calculate the Velocity matrix
 void Calculate_Dynamical_Matrix(
@@ -2,7 +2,9 @@
 #ifndef SPIRIT_CORE_ENGINE_HAMILTONIAN_HPP
 #define SPIRIT_CORE_ENGINE_HAMILTONIAN_HPP
 
+#include <cstdint>
 #include <random>
+#include <string>
 #include <vector>
 
 #include "Spirit_Defines.h"
@@ -70,6 +72,13 @@ public:
      */
     virtual void Gradient_FD( const vectorfield & spins, vectorfield & gradient ) final;
 
+    /*
+     * Estimate how stiffly each spin is held by its interactions, i.e. the sum of their magnitudes acting on it.
+     * This is used to precondition minimisation solvers. `stiffness` has to have the size of the system.
+     * The implementation provided here is a fallback for derived classes and treats all spins as equally stiff.
+     */
+    virtual void Stiffness( scalarfield & stiffness );
+
     // Calculate the Energy contributions for the spins of a configuration
     virtual void Energy_Contributions_per_Spin(
         const vectorfield & spins, std::vector<std::pair<std::string, scalarfield>> & contributions );
@@ -81,10 +90,35 @@ public:
     virtual scalar Energy( const vectorfield & spins );
 
     // Calculate the total energy for a single spin
-    virtual scalar Energy_Single_Spin( int ispin, const vectorfield & spins );
+    virtual scalar Energy_Single_Spin( spirit_index ispin, const vectorfield & spins );
 
     virtual std::size_t Number_of_Interactions();
 
+    // Energy contributions, recorded as a by-product of `Gradient_and_Energy`
+    struct Energy_Record
+    {
+        // The version given to `Record_Energy_Contributions` when the record was made
+        std::uint64_t version = 0;
+        // The energy of each interaction, in the same order as `Energy_Contributions`
+        std::vector<std::pair<std::string, scalar>> energies;
+        // The inclination of each energy along the tangent, if one was given (the gradient of each interaction
+        // projected onto the tangent, with the sign convention of GNEB)
+        std::vector<scalar> dE_dRx;
+    };
+
+    /*
+     * Makes the following calls of `Gradient_and_Energy` record the energy of each interaction, stamped with
+     * `version`, until `Stop_Recording_Energy_Contributions` is called. The caller decides what the version
+     * stands for, e.g. the iteration of a method.
+     * If a tangent is given, the inclinations of the energies along it are recorded as well. It has to stay
+     * valid while it is being used.
+     */
+    void Record_Energy_Contributions( std::uint64_t version, const vectorfield * tangent = nullptr );
+    void Stop_Recording_Energy_Contributions();
+
+    // The record of the last call of `Gradient_and_Energy`, or nullptr if there is none since recording started
+    const Energy_Record * Recorded_Energy_Contributions() const;
+
     // Hamiltonian name as string
     virtual const std::string & Name() const = 0;
 
@@ -95,6 +129,28 @@ protected:
     // Energy contributions per spin
     std::vector<std::pair<std::string, scalarfield>> energy_contributions_per_spin;
 
+    // State of the recording of energy contributions. A copy of a Hamiltonian does not record, as it will be used
+    // for a different configuration.
+    struct Recording
+    {
+        Recording() = default;
+        Recording( const Recording & ) {}
+        Recording & operator=( const Recording & )
+        {
+            active  = false;
+            valid   = false;
+            tangent = nullptr;
+            return *this;
+        }
+
+        bool active                 = false;
+        bool valid                  = false;
+        std::uint64_t version       = 0;
+        const vectorfield * tangent = nullptr;
+        Energy_Record record;
+    };
+    Recording recording;
+
     std::mt19937 prng;
     std::uniform_int_distribution<int> distribution_int;
     scalar delta;
@@ -33,7 +33,7 @@ public:
         const vectorfield & spins, std::vector<std::pair<std::string, scalarfield>> & contributions ) override;
 
     // Calculate the total energy for a single spin
-    scalar Energy_Single_Spin( int ispin, const vectorfield & spins ) override;
+    scalar Energy_Single_Spin( spirit_index ispin, const vectorfield & spins ) override;
 
     // Hamiltonian name as string
     const std::string & Name() const override;
@@ -10,6 +10,7 @@
 #include <Spirit/Hamiltonian.h>
 #include <data/Geometry.hpp>
 #include <engine/Hamiltonian.hpp>
+#include <engine/Neighbours.hpp>
 #include <engine/Vectormath_Defines.hpp>
 
 namespace Engine
@@ -60,9 +61,12 @@ public:
     void Energy_Contributions_per_Spin(
         const vectorfield & spins, std::vector<std::pair<std::string, scalarfield>> & contributions ) override;
 
+    // Sum of the magnitudes of the field, anisotropy, exchange and DMI interactions acting on each spin
+    void Stiffness( scalarfield & stiffness ) override;
+
     // Calculate the total energy for a single spin to be used in Monte Carlo.
     //      Note: therefore the energy of pairs is weighted x2 and of quadruplets x4.
-    scalar Energy_Single_Spin( int ispin, const vectorfield & spins ) override;
+    scalar Energy_Single_Spin( spirit_index ispin, const vectorfield & spins ) override;
 
     // Hamiltonian name as string
     const std::string & Name() const override;
@@ -187,6 +191,33 @@ private:
     void E_DDI_Cutoff( const vectorfield & spins, scalarfield & Energy );
     void E_DDI_FFT( const vectorfield & spins, scalarfield & Energy );
 
+    // Neighbour shells of the current lattice, reused when only the magnitudes of the interactions change
+    Neighbours::Neighbour_Shell_Cache neighbour_shell_cache;
+
+    /*
+        Pair interactions of the occupied sites, stored per site. If the lattice contains vacancies, the exchange
+        and DMI loops run over these tables instead of over all pairs of all cells, so that their cost scales with
+        the number of magnetic atoms rather than the number of lattice sites.
+    */
+    struct Site_Pairs
+    {
+        // Indices of the occupied sites in the full lattice
+        intfield sites;
+        // The partners of sites[i] are partners[offsets[i]] up to partners[offsets[i+1]-1]
+        intfield offsets;
+        intfield partners;
+        // Index of each interaction in the pair list, to look up its magnitude (and normal)
+        intfield pair_indices;
+    };
+    Site_Pairs Get_Site_Pairs( const pairfield & pairs ) const;
+    // Rebuilds the per-site tables if the vacancies changed and returns whether they should be used
+    bool Update_Site_Pairs( bool force = false );
+    Site_Pairs exchange_site_pairs;
+    Site_Pairs dmi_site_pairs;
+    // Atom types for which the per-site tables were built
+    intfield site_pairs_atom_types;
+    bool use_site_pairs = false;
+
     // Preparations for DDI-Convolution Algorithm
     void Prepare_DDI();
     void Clean_DDI();
@@ -208,7 +239,7 @@ private:
     // Lengths of padded system
     field<int> n_cells_padded;
     // Total number of padded spins per sublattice
-    int sublattice_size;
+    spirit_index sublattice_size;
 
     FFT::StrideContainer spin_stride;
     FFT::StrideContainer dipole_stride;
@@ -41,12 +41,41 @@ void invert_orthogonal( vectorfield & vf1, const vectorfield & vf2 );
 // Project vf1's vectors into the tangent plane of vf2
 //      Note: vf2 must have normalized vectors
 void project_tangential( vectorfield & vf1, const vectorfield & vf2 );
+// Project vf1's vectors into the tangent plane of vf2 and return the largest norm of the projected vectors.
+//      Note: vf2 must have normalized vectors
+scalar project_tangential_max_norm( vectorfield & vf1, const vectorfield & vf2 );
+// As above, additionally writing the tangential part of vf3 into vf3_tangential in the same pass
+scalar project_tangential_max_norm(
+    vectorfield & vf1, const vectorfield & vf2, const vectorfield & vf3, vectorfield & vf3_tangential );
 
 // The tangential projector is a matrix which projects any vector into the tangent
 //      space of a vectorfield, considered to live on the direct product of N unit
 //      spheres. It is a 3N x 3N matrix.
 MatrixX tangential_projector( const vectorfield & image );
 
+// The tangential projector and the tangent bases below act on each spin separately,
+//      i.e. they are block-diagonal. These overloads only store the N diagonal blocks
+//      (3x3 for the projector, 3x2 for a basis), which is all that is needed to apply
+//      them to vectors and matrices in O(N) and O(N^2) or O(nnz) instead of O(N^3).
+using Matrix3x2 = Eigen::Matrix<scalar, 3, 2, Eigen::DontAlign>;
+void tangential_projector( const vectorfield & image, field<Matrix3> & projector );
+void tangent_basis_spherical( const vectorfield & vf, field<Matrix3x2> & basis );
+
+// Calculate P * matrix * P for a block-diagonal projector P and a 3N x 3N matrix
+void project_blockwise( const field<Matrix3> & projector, const MatrixX & matrix, MatrixX & matrix_out );
+void project_blockwise( const field<Matrix3> & projector, const SpMatrixX & matrix, SpMatrixX & matrix_out );
+
+// Transform a 3N x 3N matrix into the 2N x 2N matrix basis^T * matrix * basis of a block-diagonal tangent basis
+void change_basis( const field<Matrix3x2> & basis, const MatrixX & matrix_3N, MatrixX & matrix_2N );
+void change_basis( const field<Matrix3x2> & basis, const SpMatrixX & matrix_3N, SpMatrixX & matrix_2N );
+
+// Transform a 3N-vector into the 2N-vector basis^T * vector of a block-diagonal tangent basis, or back
+void to_tangent_basis( const field<Matrix3x2> & basis, const VectorX & vector_3N, VectorX & vector_2N );
+void from_tangent_basis( const field<Matrix3x2> & basis, const VectorX & vector_2N, VectorX & vector_3N );
+
+// The dense 3N x 2N matrix of a block-diagonal tangent basis, where it is needed explicitly
+void dense_basis( const field<Matrix3x2> & basis, MatrixX & basis_dense );
+
 // Calculate a matrix of orthonormal basis vectors that span the tangent space to
 //      a vectorfield, considered to live on the direct product of N unit spheres.
 //      The basis vectors will be the spherical unit vectors, except at the poles.
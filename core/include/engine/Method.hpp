@@ -6,12 +6,19 @@
 #include <data/Parameters_Method.hpp>
 #include <data/Spin_System_Chain.hpp>
 #include <utility/Logging.hpp>
+#include <utility/Profiling.hpp>
 #include <utility/Timing.hpp>
 
 #include <deque>
 #include <fstream>
 #include <map>
 
+namespace IO
+{
+class Checkpoint_Writer;
+class Checkpoint_Reader;
+} // namespace IO
+
 namespace Engine
 {
 
@@ -74,6 +81,8 @@ public:
     // Solver name as string
     virtual std::string SolverName();
     virtual std::string SolverFullName();
+    // Solver index (see `Engine::Solver`), -1 for methods without a solver
+    virtual int SolverType();
 
     // ------------------------------------------------------
 
@@ -104,12 +113,41 @@ public:
      */
     virtual void Hook_Post_Iteration();
 
+    /*
+     * Record the observables of the systems, if a sample is due.
+     *   Override to provide e.g. the simulated time of the samples
+     */
+    virtual void Sample_Observables();
+
+    // Publish snapshots of the spins of the systems, if they were requested or `force` is set (the systems have to be
+    // locked)
+    void Publish_Snapshots( bool force = false );
+
     /*
      * Save current data
      *   Override to specialize what a Method should save
      */
     virtual void Save_Current( std::string starttime, int iteration, bool initial = false, bool final = false );
 
+    /*
+     * Write or read the state of the calculation to or from a checkpoint, from which it can be resumed bit-identically
+     *   Override to add the state of a specialized Method, after calling the function of its base class.
+     *   Values have to be read in the same order in which they were written.
+     */
+    virtual void Checkpoint_Write( IO::Checkpoint_Writer & checkpoint );
+    virtual void Checkpoint_Read( IO::Checkpoint_Reader & checkpoint );
+
+    // Write the current state to a checkpoint file (the systems have to be locked)
+    void Write_Checkpoint( const std::string & filename );
+    // Write a checkpoint to the checkpoint file, logging instead of throwing errors (the systems have to be locked)
+    void Save_Checkpoint();
+    // Write a checkpoint, if checkpoints are enabled and none has been written at the current iteration
+    void Save_Final_Checkpoint();
+    // Check if a checkpoint is due, if the iteration count has just been advanced by the given number of iterations
+    bool Checkpoint_Due( int n_iterations_step ) const;
+    // Name of the checkpoint file
+    std::string Checkpoint_Filename();
+
     /*
      * Lock systems in order to prevent otherwise access
      *   This function should be overridden by specialized methods to ensure systems are
@@ -132,23 +170,32 @@ public:
     virtual bool ContinueIterating();
 
     //////////// Final implementations
-    // Check if walltime ran out
-    virtual bool Walltime_Expired( std::chrono::duration<scalar> dt_seconds ) final;
+    // Check if walltime ran out, measured on a monotonic clock since `Start_Stop_Checks`
+    virtual bool Walltime_Expired() final;
     // Check if a stop file is present -> Stop the iterations
     virtual bool StopFile_Present() final;
+    // Check if a stop was requested since `Start_Stop_Checks` -> Stop the iterations
+    virtual bool Stop_Requested() final;
+    // Set the starting points of the walltime and the stop requests
+    virtual void Start_Stop_Checks() final;
 
     std::chrono::time_point<std::chrono::system_clock> t_start, t_last;
+    std::chrono::steady_clock::time_point t_start_monotonic;
 
     // Number of iterations that have been executed
     long iteration;
     // Number of steps (set of iterations between logs) that have been executed
     long step;
+    // Iteration at which the last checkpoint was written
+    long iteration_checkpoint = -1;
 
     // Timings and Iterations per Second
     scalar ips;
     std::deque<std::chrono::time_point<std::chrono::system_clock>> t_iterations;
     // The time at which this Solver's Iterate() was last called
     std::string starttime;
+    // Profiler timings at the start of Iterate(), to report the timings of this run
+    Utility::Profiling::Timings timings_start;
 
     //////////// Parameters //////////////////////////////////////////////////////
     // Number of iterations
@@ -171,10 +218,13 @@ protected:
     // Number of images
     int noi;
     // Number of spins in an image
-    int nos;
+    spirit_index nos;
 
     int n_iterations_amortize;
 
+    // Number of stop requests at the start of the iterations
+    int n_stop_requests_start = 0;
+
     // Method name as enum
     Utility::Log_Sender SenderName;
     // Maximum torque of all images
@@ -31,6 +31,10 @@ public:
     // Method name as string
     std::string Name() override;
 
+    // Add the energies and reaction coordinates of the images to a checkpoint
+    void Checkpoint_Write( IO::Checkpoint_Writer & checkpoint ) override;
+    void Checkpoint_Read( IO::Checkpoint_Reader & checkpoint ) override;
+
     void Calculate_Force(
         const std::vector<std::shared_ptr<vectorfield>> & configurations,
         std::vector<vectorfield> & forces ) override; // Moved to public, because of cuda device lambda restrictions
@@ -84,6 +88,9 @@ private:
 
     vectorfield tangent_endpoints_left;
     vectorfield tangent_endpoints_right;
+
+    // Gradient of the calculation of the interpolated energy contributions
+    vectorfield gradient_interpolation;
 };
 
 } // namespace Engine
@@ -27,6 +27,10 @@ public:
     // Method name as string
     std::string Name() override;
 
+    // Add the state of the thermal random number generator and the simulated time to a checkpoint
+    void Checkpoint_Write( IO::Checkpoint_Writer & checkpoint ) override;
+    void Checkpoint_Read( IO::Checkpoint_Reader & checkpoint ) override;
+
     // Prepare random numbers for thermal fields, if needed
     void Prepare_Thermal_Field() override;
     // Calculate Forces onto Systems
@@ -42,10 +46,14 @@ private:
 
     // Save the current Step's Data: spins and energy
     void Save_Current( std::string starttime, int iteration, bool initial = false, bool final = false ) override;
+    // An Iteration of the Solver, which advances the simulated time
+    void Iteration() override;
     // A hook into the Method before an Iteration of the Solver
     void Hook_Pre_Iteration() override;
     // A hook into the Method after an Iteration of the Solver
     void Hook_Post_Iteration() override;
+    // Record the observables together with the simulated time
+    void Sample_Observables() override;
 
     // Sets iteration_allowed to false for the corresponding method
     void Finalize() override;
@@ -56,11 +64,8 @@ private:
     std::vector<bool> force_converged;
     // Temperature distribution
     scalarfield temperature_distribution;
-    // Field for stt gradient method
-    vectorfield s_c_grad;
-
-    // Jacobians of spin configurations
-    field<Matrix3> jacobians;
+    // Finite-difference stencil for the stt gradient method
+    Vectormath::Finite_Difference_Stencil stt_stencil;
 
     // Current energy
     scalar current_energy = 0;
@@ -25,6 +25,10 @@ public:
     // Method name as string
     std::string Name() override;
 
+    // Add the random number generator and the cone angle to a checkpoint
+    void Checkpoint_Write( IO::Checkpoint_Writer & checkpoint ) override;
+    void Checkpoint_Read( IO::Checkpoint_Reader & checkpoint ) override;
+
 private:
     // Solver_Iteration represents one iteration of a certain Solver
     void Iteration() override;
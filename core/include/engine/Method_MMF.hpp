@@ -22,6 +22,10 @@ public:
     // Method name as string
     std::string Name() override;
 
+    // Add the mode which is followed to a checkpoint
+    void Checkpoint_Write( IO::Checkpoint_Writer & checkpoint ) override;
+    void Checkpoint_Read( IO::Checkpoint_Reader & checkpoint ) override;
+
 private:
     // Calculate Forces onto Systems
     void Calculate_Force(
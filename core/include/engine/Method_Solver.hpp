@@ -10,6 +10,7 @@
 #include <engine/Method.hpp>
 #include <engine/Solver_Kernels.hpp>
 #include <engine/Vectormath.hpp>
+#include <io/Checkpoint.hpp>
 #include <utility/Constants.hpp>
 #include <utility/Logging.hpp>
 #include <utility/Timing.hpp>
@@ -17,6 +18,7 @@
 #include <deque>
 #include <fstream>
 #include <iomanip>
+#include <limits>
 #include <map>
 #include <sstream>
 
@@ -38,7 +40,9 @@ enum class Solver
     LBFGS_OSO   = Solver_LBFGS_OSO,
     LBFGS_Atlas = Solver_LBFGS_Atlas,
     VP          = Solver_VP,
-    VP_OSO      = Solver_VP_OSO
+    VP_OSO      = Solver_VP_OSO,
+    NCG         = Solver_NCG,
+    Newton      = Solver_Newton
 };
 
 /*
@@ -67,10 +71,15 @@ public:
     // Solver name as string
     virtual std::string SolverName() override;
     virtual std::string SolverFullName() override;
+    virtual int SolverType() override;
 
     // Iteration represents one iteration of a certain Solver
     virtual void Iteration() override;
 
+    // Add the state of the solver (e.g. the LBFGS memory or the VP velocities) to a checkpoint
+    virtual void Checkpoint_Write( IO::Checkpoint_Writer & checkpoint ) override;
+    virtual void Checkpoint_Read( IO::Checkpoint_Reader & checkpoint ) override;
+
 protected:
     // Prepare random numbers for thermal fields, if needed
     virtual void Prepare_Thermal_Field() {}
@@ -112,6 +121,16 @@ protected:
     // Calculate maximum torque for a spin configuration
     virtual scalar MaxTorque_on_Image( const vectorfield & image, vectorfield & force ) final;
 
+    // Set up the diagonal preconditioner of NCG and Newton from the stiffness of the spins
+    void Prepare_Preconditioner();
+
+    // Calculate the product of the Hessian in OSO coordinates with a direction, by finite differences of the forces
+    void Hessian_Vector_Product( const std::vector<vectorfield> & direction, std::vector<vectorfield> & product );
+
+    // Apply a function to each member which carries the state of the solver from one iteration to the next
+    template<typename Function>
+    void Solver_State( Function && apply );
+
     // ...
     // virtual bool Iterations_Allowed() override;
 
@@ -169,6 +188,25 @@ protected:
     // buffer variables for checking convergence for solver and Newton-Raphson
     // std::vector<scalarfield> r_dot_d, dda2;
 
+    //////////// NCG and Newton ////////////////////////////////////////////////////
+    // Inverse of the normalised stiffness of each spin [noi][nos]
+    std::vector<scalarfield> preconditioner;
+    // Preconditioned gradients, current and previous [noi][nos]
+    std::vector<vectorfield> grad_preconditioned;
+    std::vector<vectorfield> grad_preconditioned_pr;
+    // Inner conjugate gradient solve of Newton: step, its Hessian product, residual and direction [noi][nos]
+    std::vector<vectorfield> newton_step;
+    std::vector<vectorfield> newton_hessian_step;
+    std::vector<vectorfield> newton_residual;
+    std::vector<vectorfield> newton_direction;
+    std::vector<vectorfield> newton_hessian_direction;
+    // Maximum RMS rotation of a Newton step
+    scalar trust_radius = 0;
+    // Norm of the gradient in the first Newton iteration
+    scalar gradient_norm_initial = 0;
+    // Configurations before the last Newton step, in case it is rejected
+    std::vector<vectorfield> configurations_backup;
+
     //////////// VP ///////////////////////////////////////////////////////////////
     // "Mass of our particle" which we accelerate
     scalar m = 1.0;
@@ -224,9 +262,151 @@ scalar Method_Solver<solver>::Force_on_Image_MaxAbsComponent( const vectorfield
 template<Solver solver>
 scalar Method_Solver<solver>::MaxTorque_on_Image( const vectorfield & image, vectorfield & force )
 {
-    // Take out component in direction of v2
-    Manifoldmath::project_tangential( force, image );
-    return Vectormath::max_norm( force );
+    // Take out component in direction of v2, in the same pass as the norms
+    return Manifoldmath::project_tangential_max_norm( force, image );
+}
+
+template<Solver solver>
+void Method_Solver<solver>::Prepare_Preconditioner()
+{
+    this->preconditioner = std::vector<scalarfield>( this->noi, scalarfield( this->nos, 1 ) );
+    for( int img = 0; img < this->noi; ++img )
+    {
+        auto & p = this->preconditioner[img];
+        this->systems[img]->hamiltonian->Stiffness( p );
+
+        // Normalised to a mean of one, so that step lengths keep their meaning. Spins which are hardly held by
+        // anything are limited to a hundred times the mean step.
+        scalar mean = Vectormath::sum( p ) / this->nos;
+        if( mean <= 0 )
+        {
+            Vectormath::fill( p, 1 );
+            continue;
+        }
+        Backend::par::apply(
+            this->nos, [p = p.data(), mean] SPIRIT_LAMBDA( spirit_index idx )
+            { p[idx] = ( p[idx] > 0.01 * mean ) ? mean / p[idx] : 100; } );
+    }
+}
+
+template<Solver solver>
+void Method_Solver<solver>::Hessian_Vector_Product(
+    const std::vector<vectorfield> & direction, std::vector<vectorfield> & product )
+{
+    scalar norm2 = 0;
+    for( int img = 0; img < this->noi; ++img )
+        norm2 += Vectormath::dot( direction[img], direction[img] );
+    if( norm2 <= 0 )
+    {
+        for( int img = 0; img < this->noi; ++img )
+            Vectormath::fill( product[img], Vector3::Zero() );
+        return;
+    }
+
+    // Rotate the spins along the direction by a small RMS angle
+    const scalar h = std::sqrt( std::numeric_limits<scalar>::epsilon() )
+                     / std::sqrt( norm2 / ( this->noi * this->nos ) );
+    for( int img = 0; img < this->noi; ++img )
+    {
+        *this->configurations_temp[img] = *this->configurations[img];
+        Vectormath::set_c_a( h, direction[img], product[img] );
+    }
+    Solver_Kernels::oso_rotate( this->configurations_temp, product );
+
+    // The difference of the gradients, restricted to rotations which actually move the spins
+    this->Calculate_Force( this->configurations_temp, this->forces_predictor );
+    for( int img = 0; img < this->noi; ++img )
+    {
+        Solver_Kernels::oso_calc_gradients(
+            product[img], *this->configurations_temp[img], this->forces_predictor[img] );
+        Vectormath::add_c_a( -1, this->grad[img], product[img] );
+        Vectormath::scale( product[img], 1 / h );
+        Solver_Kernels::oso_project_tangential( product[img], *this->configurations[img] );
+    }
+}
+
+template<Solver solver>
+int Method_Solver<solver>::SolverType()
+{
+    return int( solver );
+}
+
+template<Solver solver>
+template<typename Function>
+void Method_Solver<solver>::Solver_State( Function && apply )
+{
+    // Everything else, e.g. the predictors of Heun and RK4, is recalculated from the spins in each iteration
+    apply( this->forces );
+    apply( this->forces_virtual );
+    apply( this->xi );
+
+    if( solver == Solver::VP || solver == Solver::VP_OSO )
+    {
+        apply( this->velocities );
+        apply( this->velocities_previous );
+        apply( this->forces_previous );
+        apply( this->projection );
+        apply( this->force_norm2 );
+    }
+    if( solver == Solver::VP_OSO || solver == Solver::LBFGS_OSO || solver == Solver::NCG || solver == Solver::Newton )
+    {
+        apply( this->grad );
+        apply( this->grad_pr );
+        apply( this->searchdir );
+    }
+    if( solver == Solver::LBFGS_OSO || solver == Solver::LBFGS_Atlas || solver == Solver::NCG
+        || solver == Solver::Newton )
+    {
+        apply( this->local_iter );
+        apply( this->maxmove );
+    }
+    if( solver == Solver::LBFGS_OSO || solver == Solver::LBFGS_Atlas )
+    {
+        apply( this->rho );
+        apply( this->alpha );
+    }
+    if( solver == Solver::LBFGS_OSO )
+    {
+        apply( this->delta_a );
+        apply( this->delta_grad );
+        apply( this->q_vec );
+    }
+    if( solver == Solver::LBFGS_Atlas )
+    {
+        apply( this->atlas_updates );
+        apply( this->grad_atlas_updates );
+        apply( this->atlas_coords3 );
+        apply( this->atlas_directions );
+        apply( this->atlas_residuals );
+        apply( this->atlas_residuals_last );
+        apply( this->atlas_q_vec );
+    }
+    if( solver == Solver::NCG || solver == Solver::Newton )
+    {
+        // The preconditioner was calculated from the spins at the start
+        apply( this->preconditioner );
+        apply( this->grad_preconditioned );
+        apply( this->grad_preconditioned_pr );
+    }
+    if( solver == Solver::Newton )
+    {
+        apply( this->trust_radius );
+        apply( this->gradient_norm_initial );
+    }
+}
+
+template<Solver solver>
+void Method_Solver<solver>::Checkpoint_Write( IO::Checkpoint_Writer & checkpoint )
+{
+    Method::Checkpoint_Write( checkpoint );
+    this->Solver_State( [&checkpoint]( const auto & value ) { checkpoint.write( value ); } );
+}
+
+template<Solver solver>
+void Method_Solver<solver>::Checkpoint_Read( IO::Checkpoint_Reader & checkpoint )
+{
+    Method::Checkpoint_Read( checkpoint );
+    this->Solver_State( [&checkpoint]( auto & value ) { checkpoint.read( value ); } );
 }
 
 template<Solver solver>
@@ -286,7 +466,8 @@ void Method_Solver<solver>::Message_Step()
         = this->Name() == "LLG"
           && !(
               this->systems[0]->llg_parameters->direct_minimization || solver == Solver::VP || solver == Solver::VP_OSO
-              || solver == Solver::LBFGS_OSO || solver == Solver::LBFGS_Atlas );
+              || solver == Solver::LBFGS_OSO || solver == Solver::LBFGS_Atlas || solver == Solver::NCG
+              || solver == Solver::Newton );
 
     // Update time of current step
     auto t_current = std::chrono::system_clock::now();
@@ -332,7 +513,8 @@ void Method_Solver<solver>::Message_End()
         = this->Name() == "LLG"
           && !(
               this->systems[0]->llg_parameters->direct_minimization || solver == Solver::VP || solver == Solver::VP_OSO
-              || solver == Solver::LBFGS_OSO || solver == Solver::LBFGS_Atlas );
+              || solver == Solver::LBFGS_OSO || solver == Solver::LBFGS_Atlas || solver == Solver::NCG
+              || solver == Solver::Newton );
 
     //---- End timings
     auto t_end = std::chrono::system_clock::now();
@@ -341,9 +523,11 @@ void Method_Solver<solver>::Message_End()
     std::string reason = "";
     if( this->StopFile_Present() )
         reason = "A STOP file has been found";
+    else if( this->Stop_Requested() )
+        reason = "A stop was requested";
     else if( this->Converged() )
         reason = "The force converged";
-    else if( this->Walltime_Expired( t_end - this->t_start ) )
+    else if( this->Walltime_Expired() )
         reason = "The maximum walltime has been reached";
 
     //---- Log messages
@@ -370,6 +554,11 @@ void Method_Solver<solver>::Message_End()
         "    Maximum torque:              {:." + fmt::format( "{}", this->print_precision ) + "f}",
         this->max_torque ) );
     block.push_back( fmt::format( "    Solver: {}", this->SolverFullName() ) );
+    if( Profiling::enabled() )
+    {
+        auto timings = Profiling::Timings_Block( this->timings_start, Profiling::Get_Timings() );
+        block.insert( block.end(), timings.begin(), timings.end() );
+    }
     block.push_back( "-----------------------------------------------------" );
     Log.SendBlock( Log_Level::All, this->SenderName, block, this->idx_image, this->idx_chain );
 }
@@ -391,6 +580,8 @@ inline std::string Method_Solver<Solver::None>::SolverFullName()
 #include <engine/Solver_Heun.hpp>
 #include <engine/Solver_LBFGS_Atlas.hpp>
 #include <engine/Solver_LBFGS_OSO.hpp>
+#include <engine/Solver_NCG.hpp>
+#include <engine/Solver_Newton.hpp>
 #include <engine/Solver_RK4.hpp>
 #include <engine/Solver_SIB.hpp>
 #include <engine/Solver_VP.hpp>
@@ -16,6 +16,43 @@ namespace Engine
 namespace Neighbours
 {
 
+/*
+ * The neighbours of the basis atoms of a lattice, grouped into shells of equal distance.
+ *
+ * Distances which differ by less than a small tolerance belong to the same shell. For each basis atom, the pairs
+ * are ordered by shell and, within a shell, by descending translations. The redundant pairs are included.
+ */
+struct Neighbour_Shells
+{
+    std::vector<scalar> radii;
+    pairfield pairs;
+    intfield shells;
+};
+
+// Calculates the neighbours in the first n_shells shells in a single pass over a cell list of the lattice sites
+// within the outermost shell. Shells which do not exist within the lattice have a radius of zero and no pairs.
+Neighbour_Shells Get_Neighbour_Shells( const Data::Geometry & geometry, std::size_t n_shells );
+
+/*
+ * Keeps the neighbour shells of the most recent lattice, so that updating the magnitudes of the interactions
+ * does not rebuild the neighbours. They are only recalculated if the lattice changes or more shells are needed.
+ */
+class Neighbour_Shell_Cache
+{
+public:
+    // Returns the neighbours in at least n_shells shells
+    const Neighbour_Shells & Get( const Data::Geometry & geometry, std::size_t n_shells );
+
+private:
+    bool Matches( const Data::Geometry & geometry ) const;
+
+    std::vector<Vector3> bravais_vectors;
+    scalar lattice_constant = 0;
+    intfield n_cells;
+    std::vector<Vector3> cell_atoms;
+    Neighbour_Shells neighbour_shells;
+};
+
 std::vector<scalar> Get_Shell_Radii( const Data::Geometry & geometry, std::size_t n_shells );
 
 pairfield Get_Pairs_in_Radius( const Data::Geometry & geometry, scalar radius );
@@ -24,6 +61,11 @@ void Get_Neighbours_in_Shells(
     const Data::Geometry & geometry, std::size_t n_shells, pairfield & neighbours, intfield & shells,
     bool use_redundant_neighbours );
 
+// Selects the neighbours in the first n_shells of the given shells
+void Get_Neighbours_in_Shells(
+    const Neighbour_Shells & neighbour_shells, std::size_t n_shells, pairfield & neighbours, intfield & shells,
+    bool use_redundant_neighbours );
+
 Vector3 DMI_Normal_from_Pair( const Data::Geometry & geometry, const Pair & pair, std::int8_t chirality = 1 );
 
 void DDI_from_Pair( const Data::Geometry & geometry, const Pair & pair, scalar & magnitude, Vector3 & normal );
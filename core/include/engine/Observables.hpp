@@ -0,0 +1,99 @@
+#pragma once
+#ifndef SPIRIT_CORE_ENGINE_OBSERVABLES_HPP
+#define SPIRIT_CORE_ENGINE_OBSERVABLES_HPP
+
+#include "Spirit_Defines.h"
+#include <engine/Vectormath_Defines.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Data
+{
+class Spin_System;
+}
+
+namespace Engine
+{
+
+// Quantities which can be recorded by `Observables`, with the same values as in Spirit/Observables.h
+enum class Observable
+{
+    // Magnetization, i.e. the mean of mu_s * spin (3 columns)
+    Magnetization = 0,
+    // Magnetization of each basis atom of the unit cell (3 columns per basis atom)
+    Sublattice_Magnetization = 1,
+    // Topological charge of a 2D system (1 column)
+    Topological_Charge = 2,
+    // Total energy and the energy of each interaction (1 column plus 1 per interaction)
+    Energy = 3,
+    // Spin-spin correlation, i.e. the static structure factor at given wave vectors (1 column per wave vector)
+    Correlation = 4,
+    // Maximum torque (1 column)
+    Max_Torque = 5
+};
+
+/*
+ * A registry of observables of a spin system, which are evaluated inside the iteration loop of a method
+ * every `n_iterations_step` iterations and stored in a bounded time series.
+ *
+ * The observables which depend on the spin directions are evaluated in a single pass over the spins.
+ * The energies and the torque are taken from the method, which has already calculated them.
+ *
+ * Each sample is a row with the columns "iteration", "time" and the columns of the observables. Once the
+ * buffer holds `n_samples_max` samples, the oldest samples are overwritten.
+ */
+class Observables
+{
+public:
+    // Adds an observable. Observables which were already added are ignored.
+    void Add( Observable observable );
+    // Adds the correlation at a wave vector (in units of 1/Angstrom)
+    void Add_Correlation( const Vector3 & q );
+    // Removes all observables and samples
+    void Clear();
+    // Removes all samples, but keeps the observables
+    void Reset_Samples();
+
+    // Whether any observables were added
+    bool Empty() const;
+
+    void Set_Step( int n_iterations_step );
+    int Step() const;
+    void Set_Capacity( int n_samples_max );
+    int Capacity() const;
+
+    // Whether a sample is due after the iterations [iteration, iteration + n_iterations_amortize) were done
+    bool Due( long iteration, int n_iterations_amortize ) const;
+
+    // Evaluates the observables for the current state of a system and stores them as a new sample.
+    // The layout of the columns is updated if it has changed, e.g. because an interaction was added. In that
+    // case the previous samples are removed.
+    void Sample( const Data::Spin_System & system, long iteration, scalar time, scalar max_torque );
+
+    // Labels of the columns of the stored samples
+    const std::vector<std::string> & Labels() const;
+    // Number of stored samples
+    int N_Samples() const;
+    // The stored samples in chronological order, as rows of `Labels().size()` values
+    std::vector<scalar> Samples() const;
+
+private:
+    std::vector<Observable> observables;
+    std::vector<Vector3> q_vectors;
+
+    int n_iterations_step = 1;
+    int n_samples_max     = 10000;
+
+    // Ring buffer of the samples
+    std::vector<std::string> labels;
+    std::vector<scalar> buffer;
+    int i_first   = 0;
+    int n_samples = 0;
+
+    bool Has( Observable observable ) const;
+};
+
+} // namespace Engine
+
+#endif
@@ -25,6 +25,8 @@ void sib_transform( const vectorfield & spins, const vectorfield & force, vector
 void oso_rotate( std::vector<std::shared_ptr<vectorfield>> & configurations, std::vector<vectorfield> & searchdir );
 void oso_calc_gradients( vectorfield & residuals, const vectorfield & spins, const vectorfield & forces );
 scalar maximum_rotation( const vectorfield & searchdir, scalar maxmove );
+// Remove the component which would rotate each spin about itself
+void oso_project_tangential( vectorfield & searchdir, const vectorfield & spins );
 
 // Atlas coordinates
 void atlas_calc_gradients(
@@ -53,10 +55,10 @@ void lbfgs_get_searchdir(
 
     scalar epsilon = sizeof( scalar ) == sizeof( float ) ? 1e-30 : 1e-300;
 
-    int noi     = grad.size();
-    int nos     = grad[0].size();
-    int m_index = local_iter % num_mem; // memory index
-    int c_ind   = 0;
+    int noi          = grad.size();
+    spirit_index nos = grad[0].size();
+    int m_index      = local_iter % num_mem; // memory index
+    int c_ind        = 0;
 
     if( local_iter == 0 ) // gradient descent
     {
@@ -75,7 +77,7 @@ void lbfgs_get_searchdir(
                 auto dgi = dg[i].data();
                 Backend::par::apply(
                     nos,
-                    [dai, dgi] SPIRIT_LAMBDA( int idx )
+                    [dai, dgi] SPIRIT_LAMBDA( spirit_index idx )
                     {
                         dai[idx] = Vec::Zero();
                         dgi[idx] = Vec::Zero();
@@ -94,7 +96,7 @@ void lbfgs_get_searchdir(
             auto sd   = searchdir[img].data();
             Backend::par::apply(
                 nos,
-                [da, dg, g, g_pr, sd] SPIRIT_LAMBDA( int idx )
+                [da, dg, g, g_pr, sd] SPIRIT_LAMBDA( spirit_index idx )
                 {
                     da[idx] = sd[idx];
                     dg[idx] = g[idx] - g_pr[idx];
@@ -130,7 +132,8 @@ void lbfgs_get_searchdir(
                 auto q = q_vec[img].data();
                 auto a = alpha.data();
                 auto d = delta_grad[img][c_ind].data();
-                Backend::par::apply( nos, [c_ind, q, a, d] SPIRIT_LAMBDA( int idx ) { q[idx] += -a[c_ind] * d[idx]; } );
+                Backend::par::apply(
+                    nos, [c_ind, q, a, d] SPIRIT_LAMBDA( spirit_index idx ) { q[idx] += -a[c_ind] * d[idx]; } );
             }
         }
 
@@ -169,7 +172,9 @@ void lbfgs_get_searchdir(
                 auto alph = alpha[c_ind];
                 auto da   = delta_a[img][c_ind].data();
                 Backend::par::apply(
-                    nos, [sd, alph, da, rhopdg] SPIRIT_LAMBDA( int idx ) { sd[idx] += ( alph - rhopdg ) * da[idx]; } );
+                    nos,
+                    [sd, alph, da, rhopdg] SPIRIT_LAMBDA( spirit_index idx )
+                    { sd[idx] += ( alph - rhopdg ) * da[idx]; } );
             }
         }
 
@@ -180,7 +185,7 @@ void lbfgs_get_searchdir(
             auto sd   = searchdir[img].data();
             Backend::par::apply(
                 nos,
-                [g, g_pr, sd] SPIRIT_LAMBDA( int idx )
+                [g, g_pr, sd] SPIRIT_LAMBDA( spirit_index idx )
                 {
                     g_pr[idx] = g[idx];
                     sd[idx]   = -sd[idx];
@@ -33,7 +33,7 @@ inline void Method_Solver<Solver::LBFGS_Atlas>::Initialize()
     for( int img = 0; img < this->noi; img++ )
     {
         // Choose atlas3 coordinates
-        for( int i = 0; i < this->nos; i++ )
+        for( spirit_index i = 0; i < this->nos; i++ )
         {
             this->atlas_coords3[img][i] = ( *this->configurations[img] )[i][2] > 0 ? 1.0 : -1.0;
             // Solver_Kernels::ncg_spins_to_atlas( *this->configurations[i], this->atlas_coords[i], this->atlas_coords3[i] );
@@ -49,8 +49,8 @@ inline void Method_Solver<Solver::LBFGS_Atlas>::Initialize()
 template<>
 inline void Method_Solver<Solver::LBFGS_Atlas>::Iteration()
 {
-    int noi = configurations.size();
-    int nos = ( *configurations[0] ).size();
+    int noi          = configurations.size();
+    spirit_index nos = ( *configurations[0] ).size();
 
     // Current force
     this->Calculate_Force( this->configurations, this->forces );
@@ -64,7 +64,8 @@ inline void Method_Solver<Solver::LBFGS_Atlas>::Iteration()
         auto f  = this->forces[img].data();
         auto s  = image.data();
 
-        Backend::par::apply( this->nos, [f, fv, s] SPIRIT_LAMBDA( int idx ) { fv[idx] = s[idx].cross( f[idx] ); } );
+        Backend::par::apply(
+            this->nos, [f, fv, s] SPIRIT_LAMBDA( spirit_index idx ) { fv[idx] = s[idx].cross( f[idx] ); } );
 
         Solver_Kernels::atlas_calc_gradients( grad_ref, image, this->forces[img], this->atlas_coords3[img] );
     }
@@ -90,7 +91,7 @@ inline void Method_Solver<Solver::LBFGS_Atlas>::Iteration()
     for( int img = 0; img < noi; img++ )
     {
         auto d = atlas_directions[img].data();
-        Backend::par::apply( nos, [scaling, d] SPIRIT_LAMBDA( int idx ) { d[idx] *= scaling; } );
+        Backend::par::apply( nos, [scaling, d] SPIRIT_LAMBDA( spirit_index idx ) { d[idx] *= scaling; } );
     }
 
     // Rotate spins
@@ -50,7 +50,8 @@ inline void Method_Solver<Solver::LBFGS_OSO>::Iteration()
         auto f  = this->forces[img].data();
         auto s  = image.data();
 
-        Backend::par::apply( this->nos, [f, fv, s] SPIRIT_LAMBDA( int idx ) { fv[idx] = s[idx].cross( f[idx] ); } );
+        Backend::par::apply(
+            this->nos, [f, fv, s] SPIRIT_LAMBDA( spirit_index idx ) { fv[idx] = s[idx].cross( f[idx] ); } );
 
         Solver_Kernels::oso_calc_gradients( grad_ref, image, this->forces[img] );
     }
@@ -0,0 +1,127 @@
+#pragma once
+#ifndef SPIRIT_CORE_ENGINE_SOLVER_NCG_HPP
+#define SPIRIT_CORE_ENGINE_SOLVER_NCG_HPP
+
+#include <utility/Constants.hpp>
+
+#include <algorithm>
+
+using namespace Utility;
+
+template<>
+inline void Method_Solver<Solver::NCG>::Initialize()
+{
+    this->forces                 = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->forces_virtual         = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->forces_predictor       = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->grad                   = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->grad_pr                = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->grad_preconditioned    = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->grad_preconditioned_pr = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->searchdir              = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->q_vec                  = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+
+    this->configurations_temp = std::vector<std::shared_ptr<vectorfield>>( this->noi );
+    for( int i = 0; i < this->noi; i++ )
+        configurations_temp[i] = std::shared_ptr<vectorfield>( new vectorfield( this->nos ) );
+
+    this->local_iter = 0;
+    this->maxmove    = Constants::Pi / 20.0;
+    this->Prepare_Preconditioner();
+};
+
+/*
+    Nonlinear conjugate gradients (Polak-Ribiere with automatic restarts) in the OSO coordinates, preconditioned by
+    the stiffness of the spins, i.e. mostly by their exchange interactions.
+    Instead of a line search with energy evaluations, the step length is taken from the curvature along the search
+    direction, which is calculated by finite differences of the forces (a secant step). A step is limited to a
+    maximum RMS rotation of the spins.
+    See Jorge Nocedal and Stephen J. Wright 'Numerical Optimization' Second Edition, 2006 (p. 121).
+*/
+template<>
+inline void Method_Solver<Solver::NCG>::Iteration()
+{
+    // Forces and gradients in OSO coordinates
+    this->Calculate_Force( this->configurations, this->forces );
+    for( int img = 0; img < this->noi; img++ )
+    {
+        auto & image = *this->configurations[img];
+        Vectormath::set_c_cross( 1, image, this->forces[img], this->forces_virtual[img] );
+        Solver_Kernels::oso_calc_gradients( this->grad[img], image, this->forces[img] );
+        Vectormath::set_c_a( this->preconditioner[img], this->grad[img], this->grad_preconditioned[img] );
+    }
+
+    // Polak-Ribiere coefficient, which restarts with steepest descent when it becomes negative
+    scalar beta = 0;
+    if( this->local_iter > 0 )
+    {
+        scalar numerator   = 0;
+        scalar denominator = 0;
+        for( int img = 0; img < this->noi; img++ )
+        {
+            numerator += Vectormath::dot( this->grad_preconditioned[img], this->grad[img] )
+                         - Vectormath::dot( this->grad_preconditioned[img], this->grad_pr[img] );
+            denominator += Vectormath::dot( this->grad_preconditioned_pr[img], this->grad_pr[img] );
+        }
+        if( denominator > 0 )
+            beta = std::max( numerator / denominator, scalar( 0 ) );
+    }
+
+    // New search direction, which has to point downhill
+    scalar slope = 0;
+    for( int img = 0; img < this->noi; img++ )
+    {
+        Vectormath::scale( this->searchdir[img], beta );
+        Vectormath::add_c_a( -1, this->grad_preconditioned[img], this->searchdir[img] );
+        slope += Vectormath::dot( this->searchdir[img], this->grad[img] );
+    }
+    if( slope >= 0 )
+    {
+        slope = 0;
+        for( int img = 0; img < this->noi; img++ )
+        {
+            Vectormath::set_c_a( -1, this->grad_preconditioned[img], this->searchdir[img] );
+            slope += Vectormath::dot( this->searchdir[img], this->grad[img] );
+        }
+    }
+
+    // Step length from the curvature along the search direction
+    this->Hessian_Vector_Product( this->searchdir, this->q_vec );
+    scalar curvature = 0;
+    scalar norm2     = 0;
+    for( int img = 0; img < this->noi; img++ )
+    {
+        curvature += Vectormath::dot( this->searchdir[img], this->q_vec[img] );
+        norm2 += Vectormath::dot( this->searchdir[img], this->searchdir[img] );
+    }
+
+    if( norm2 > 0 )
+    {
+        scalar step_max = this->maxmove / std::sqrt( norm2 / ( this->noi * this->nos ) );
+        scalar step     = step_max;
+        if( curvature > 0 )
+            step = std::min( -slope / curvature, step_max );
+
+        for( int img = 0; img < this->noi; img++ )
+            Vectormath::set_c_a( step, this->searchdir[img], this->q_vec[img] );
+        Solver_Kernels::oso_rotate( this->configurations, this->q_vec );
+    }
+
+    std::swap( this->grad, this->grad_pr );
+    std::swap( this->grad_preconditioned, this->grad_preconditioned_pr );
+    ++this->local_iter;
+}
+
+template<>
+inline std::string Method_Solver<Solver::NCG>::SolverName()
+{
+    return "NCG";
+}
+
+template<>
+inline std::string Method_Solver<Solver::NCG>::SolverFullName()
+{
+    return "Preconditioned nonlinear conjugate gradients using exponential transforms";
+}
+
+#endif
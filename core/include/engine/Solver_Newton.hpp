@@ -0,0 +1,205 @@
+#pragma once
+#ifndef SPIRIT_CORE_ENGINE_SOLVER_NEWTON_HPP
+#define SPIRIT_CORE_ENGINE_SOLVER_NEWTON_HPP
+
+#include <utility/Constants.hpp>
+
+#include <algorithm>
+
+using namespace Utility;
+
+template<>
+inline void Method_Solver<Solver::Newton>::Initialize()
+{
+    this->forces                   = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->forces_virtual           = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->forces_predictor         = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->grad                     = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->grad_pr                  = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->grad_preconditioned      = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->newton_step              = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->newton_hessian_step      = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->newton_residual          = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->newton_direction         = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->newton_hessian_direction = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+    this->configurations_backup    = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) );
+
+    this->configurations_temp = std::vector<std::shared_ptr<vectorfield>>( this->noi );
+    for( int i = 0; i < this->noi; i++ )
+        configurations_temp[i] = std::shared_ptr<vectorfield>( new vectorfield( this->nos ) );
+
+    this->local_iter   = 0;
+    this->maxmove      = Constants::Pi / 2.0;
+    this->trust_radius = Constants::Pi / 20.0;
+    this->Prepare_Preconditioner();
+};
+
+/*
+    Trust-region Newton-Krylov method in the OSO coordinates.
+    Each iteration solves the Newton equations inexactly with preconditioned conjugate gradients, which are truncated
+    at the trust radius or when they encounter negative curvature (Steihaug-Toint). The products of the Hessian with
+    the search directions are calculated by finite differences of the forces, so that the Hessian itself is never
+    built. The preconditioner is the stiffness of the spins, i.e. mostly their exchange interactions.
+    Since only forces are available, the energy change of a step is estimated by integrating the forces along it
+    (trapezoidal rule, which is exact for a quadratic energy). Steps which do not reduce the energy as predicted are
+    rejected and the trust radius shrinks.
+    See Jorge Nocedal and Stephen J. Wright 'Numerical Optimization' Second Edition, 2006 (p. 171).
+*/
+template<>
+inline void Method_Solver<Solver::Newton>::Iteration()
+{
+    // Maximum number of Hessian-vector products per iteration
+    const int n_inner_max = 50;
+
+    auto dot = [this]( const std::vector<vectorfield> & a, const std::vector<vectorfield> & b )
+    {
+        scalar result = 0;
+        for( int img = 0; img < this->noi; img++ )
+            result += Vectormath::dot( a[img], b[img] );
+        return result;
+    };
+
+    auto update_gradients = [this]()
+    {
+        for( int img = 0; img < this->noi; img++ )
+        {
+            auto & image = *this->configurations[img];
+            Vectormath::set_c_cross( 1, image, this->forces[img], this->forces_virtual[img] );
+            Solver_Kernels::oso_calc_gradients( this->grad[img], image, this->forces[img] );
+        }
+    };
+
+    // The forces of the current configurations are known from the end of the previous iteration
+    if( this->local_iter == 0 )
+    {
+        this->Calculate_Force( this->configurations, this->forces );
+        update_gradients();
+        this->gradient_norm_initial = std::sqrt( dot( this->grad, this->grad ) );
+    }
+    ++this->local_iter;
+
+    const scalar gradient_norm = std::sqrt( dot( this->grad, this->grad ) );
+    if( gradient_norm <= 0 )
+        return;
+
+    // ---- Preconditioned conjugate gradients for the Newton step, within the trust region in the norm of the
+    //      preconditioner. The norms of the step and direction follow from recurrences.
+    const scalar radius2 = this->trust_radius * this->trust_radius * this->noi * this->nos;
+    // The inner solve becomes more accurate as the gradient decreases, for superlinear convergence
+    const scalar tolerance
+        = gradient_norm * std::min( scalar( 0.5 ), std::sqrt( gradient_norm / this->gradient_norm_initial ) );
+
+    for( int img = 0; img < this->noi; img++ )
+    {
+        Vectormath::fill( this->newton_step[img], Vector3::Zero() );
+        Vectormath::fill( this->newton_hessian_step[img], Vector3::Zero() );
+        Vectormath::set_c_a( 1, this->grad[img], this->newton_residual[img] );
+        Vectormath::set_c_a( this->preconditioner[img], this->grad[img], this->grad_preconditioned[img] );
+        Vectormath::set_c_a( -1, this->grad_preconditioned[img], this->newton_direction[img] );
+    }
+    scalar rz        = dot( this->newton_residual, this->grad_preconditioned );
+    scalar pMp       = 0;
+    scalar pMd       = 0;
+    scalar dMd       = rz;
+    bool on_boundary = false;
+
+    // Advance the step along the direction by tau
+    auto advance = [this]( scalar tau )
+    {
+        for( int img = 0; img < this->noi; img++ )
+        {
+            Vectormath::add_c_a( tau, this->newton_direction[img], this->newton_step[img] );
+            Vectormath::add_c_a( tau, this->newton_hessian_direction[img], this->newton_hessian_step[img] );
+        }
+    };
+    // Length along the direction at which the step reaches the trust radius
+    auto to_boundary = [&]()
+    { return ( -pMd + std::sqrt( std::max( pMd * pMd + dMd * ( radius2 - pMp ), scalar( 0 ) ) ) ) / dMd; };
+
+    for( int i_inner = 0; i_inner < n_inner_max; ++i_inner )
+    {
+        this->Hessian_Vector_Product( this->newton_direction, this->newton_hessian_direction );
+        scalar dHd = dot( this->newton_direction, this->newton_hessian_direction );
+
+        // Negative curvature: follow it to the trust radius
+        if( dHd <= 0 )
+        {
+            advance( to_boundary() );
+            on_boundary = true;
+            break;
+        }
+
+        scalar alpha   = rz / dHd;
+        scalar pMp_new = pMp + 2 * alpha * pMd + alpha * alpha * dMd;
+        if( pMp_new >= radius2 )
+        {
+            advance( to_boundary() );
+            on_boundary = true;
+            break;
+        }
+
+        advance( alpha );
+        pMp = pMp_new;
+        for( int img = 0; img < this->noi; img++ )
+            Vectormath::add_c_a( alpha, this->newton_hessian_direction[img], this->newton_residual[img] );
+        if( std::sqrt( dot( this->newton_residual, this->newton_residual ) ) <= tolerance )
+            break;
+
+        for( int img = 0; img < this->noi; img++ )
+            Vectormath::set_c_a(
+                this->preconditioner[img], this->newton_residual[img], this->grad_preconditioned[img] );
+        scalar rz_new = dot( this->newton_residual, this->grad_preconditioned );
+        scalar beta   = rz_new / rz;
+        rz            = rz_new;
+        pMd           = beta * ( pMd + alpha * dMd );
+        dMd           = rz + beta * beta * dMd;
+        for( int img = 0; img < this->noi; img++ )
+        {
+            Vectormath::scale( this->newton_direction[img], beta );
+            Vectormath::add_c_a( -1, this->grad_preconditioned[img], this->newton_direction[img] );
+        }
+    }
+
+    // ---- Take the step and compare the energy change with the quadratic model
+    const scalar predicted
+        = dot( this->grad, this->newton_step ) + 0.5 * dot( this->newton_step, this->newton_hessian_step );
+
+    for( int img = 0; img < this->noi; img++ )
+        this->configurations_backup[img] = *this->configurations[img];
+    std::swap( this->grad, this->grad_pr );
+
+    Solver_Kernels::oso_rotate( this->configurations, this->newton_step );
+    this->Calculate_Force( this->configurations, this->forces );
+    update_gradients();
+
+    const scalar actual = 0.5 * ( dot( this->grad_pr, this->newton_step ) + dot( this->grad, this->newton_step ) );
+    const scalar rho    = predicted < 0 ? actual / predicted : 1;
+
+    if( rho < 0.25 )
+        this->trust_radius *= 0.25;
+    else if( rho > 0.75 && on_boundary )
+        this->trust_radius = std::min( 2 * this->trust_radius, this->maxmove );
+
+    // Rejected steps are undone
+    if( rho < 0.01 )
+    {
+        for( int img = 0; img < this->noi; img++ )
+            *this->configurations[img] = this->configurations_backup[img];
+        this->Calculate_Force( this->configurations, this->forces );
+        update_gradients();
+    }
+}
+
+template<>
+inline std::string Method_Solver<Solver::Newton>::SolverName()
+{
+    return "Newton";
+}
+
+template<>
+inline std::string Method_Solver<Solver::Newton>::SolverFullName()
+{
+    return "Trust-region Newton-Krylov using exponential transforms";
+}
+
+#endif
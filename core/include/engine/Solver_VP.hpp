@@ -41,7 +41,7 @@ inline void Method_Solver<Solver::VP>::Iteration()
 
         Backend::par::apply(
             forces[i].size(),
-            [f, f_pr, v, v_pr] SPIRIT_LAMBDA( int idx )
+            [f, f_pr, v, v_pr] SPIRIT_LAMBDA( spirit_index idx )
             {
                 f_pr[idx] = f[idx];
                 v_pr[idx] = v[idx];
@@ -66,7 +66,8 @@ inline void Method_Solver<Solver::VP>::Iteration()
         // Calculate the new velocity
         Backend::par::apply(
             force.size(),
-            [f, f_pr, v, m_temp] SPIRIT_LAMBDA( int idx ) { v[idx] += 0.5 / m_temp * ( f_pr[idx] + f[idx] ); } );
+            [f, f_pr, v, m_temp] SPIRIT_LAMBDA( spirit_index idx )
+            { v[idx] += 0.5 / m_temp * ( f_pr[idx] + f[idx] ); } );
 
         // Get the projection of the velocity on the force
         projection[i]  = Vectormath::dot( velocity, force );
@@ -100,12 +101,13 @@ inline void Method_Solver<Solver::VP>::Iteration()
         }
         else
         {
-            Backend::par::apply( force.size(), [f, v, ratio] SPIRIT_LAMBDA( int idx ) { v[idx] = f[idx] * ratio; } );
+            Backend::par::apply(
+                force.size(), [f, v, ratio] SPIRIT_LAMBDA( spirit_index idx ) { v[idx] = f[idx] * ratio; } );
         }
 
         Backend::par::apply(
             force.size(),
-            [conf, conf_temp, dt, m_temp, v, f] SPIRIT_LAMBDA( int idx )
+            [conf, conf_temp, dt, m_temp, v, f] SPIRIT_LAMBDA( spirit_index idx )
             {
                 conf_temp[idx] = conf[idx] + dt * v[idx] + 0.5 / m_temp * dt * f[idx];
                 conf[idx]      = conf_temp[idx].normalized();
@@ -46,7 +46,7 @@ inline void Method_Solver<Solver::VP_OSO>::Iteration()
 
         Backend::par::apply(
             nos,
-            [g, g_pr, v, v_pr] SPIRIT_LAMBDA( int idx )
+            [g, g_pr, v, v_pr] SPIRIT_LAMBDA( spirit_index idx )
             {
                 g_pr[idx] = g[idx];
                 v_pr[idx] = v[idx];
@@ -75,7 +75,9 @@ inline void Method_Solver<Solver::VP_OSO>::Iteration()
 
         // Calculate the new velocity
         Backend::par::apply(
-            nos, [g, g_pr, v, m_temp] SPIRIT_LAMBDA( int idx ) { v[idx] += 0.5 / m_temp * ( g_pr[idx] + g[idx] ); } );
+            nos,
+            [g, g_pr, v, m_temp] SPIRIT_LAMBDA( spirit_index idx )
+            { v[idx] += 0.5 / m_temp * ( g_pr[idx] + g[idx] ); } );
 
         // Get the projection of the velocity on the force
         projection[img]  = Vectormath::dot( velocity, this->grad[img] );
@@ -103,12 +105,13 @@ inline void Method_Solver<Solver::VP_OSO>::Iteration()
         }
         else
         {
-            Backend::par::apply( nos, [g, v, ratio] SPIRIT_LAMBDA( int idx ) { v[idx] = g[idx] * ratio; } );
+            Backend::par::apply( nos, [g, v, ratio] SPIRIT_LAMBDA( spirit_index idx ) { v[idx] = g[idx] * ratio; } );
         }
 
         Backend::par::apply(
             nos,
-            [sd, dt, m_temp, v, g] SPIRIT_LAMBDA( int idx ) { sd[idx] = dt * v[idx] + 0.5 / m_temp * dt * g[idx]; } );
+            [sd, dt, m_temp, v, g] SPIRIT_LAMBDA( spirit_index idx )
+            { sd[idx] = dt * v[idx] + 0.5 / m_temp * dt * g[idx]; } );
     }
     Solver_Kernels::oso_rotate( this->configurations, this->searchdir );
 }
@@ -33,7 +33,7 @@ public:
     {
     }
 
-    const vector_t operator[]( int idx )
+    const vector_t operator[]( spirit_index idx )
     {
         return rotation_matrix * ( field[idx] - shift_pre ) + shift_post;
     }
@@ -58,13 +58,12 @@ Vector3 decompose( const Vector3 & v, const std::vector<Vector3> & basis );
 //////// Translating across the lattice
 
 // Note: translations must lie within bounds of n_cells
-inline int
+inline spirit_index
 idx_from_translations( const intfield & n_cells, const int n_cell_atoms, const std::array<int, 3> & translations )
 {
-    auto & Na = n_cells[0];
-    auto & Nb = n_cells[1];
-    auto & Nc = n_cells[2];
-    auto & N  = n_cell_atoms;
+    const spirit_index Na = n_cells[0];
+    const spirit_index Nb = n_cells[1];
+    const spirit_index N  = n_cell_atoms;
 
     auto & da = translations[0];
     auto & db = translations[1];
@@ -77,10 +76,10 @@ idx_from_translations( const intfield & n_cells, const int n_cell_atoms, const s
 
 // Get the linear index in a n-D array where tupel contains the components in n-dimensions from fatest to slowest
 // varying and maxVal is the extent in every dimension
-inline int idx_from_tupel( const field<int> & tupel, const field<int> & maxVal )
+inline spirit_index idx_from_tupel( const field<int> & tupel, const field<int> & maxVal )
 {
-    int idx  = 0;
-    int mult = 1;
+    spirit_index idx  = 0;
+    spirit_index mult = 1;
     for( int i = 0; i < tupel.size(); i++ )
     {
         idx += mult * tupel[i];
@@ -90,10 +89,10 @@ inline int idx_from_tupel( const field<int> & tupel, const field<int> & maxVal )
 }
 
 // reverse of idx_from_tupel
-inline void tupel_from_idx( int & idx, field<int> & tupel, field<int> & maxVal )
+inline void tupel_from_idx( spirit_index idx, field<int> & tupel, field<int> & maxVal )
 {
-    int idx_diff = idx;
-    int div      = 1;
+    spirit_index idx_diff = idx;
+    spirit_index div      = 1;
     for( int i = 0; i < tupel.size() - 1; i++ )
         div *= maxVal[i];
     for( int i = tupel.size() - 1; i > 0; i-- )
@@ -105,18 +104,18 @@ inline void tupel_from_idx( int & idx, field<int> & tupel, field<int> & maxVal )
     tupel[0] = idx_diff / div;
 }
 
-inline int idx_from_translations(
+inline spirit_index idx_from_translations(
     const intfield & n_cells, const int n_cell_atoms, const std::array<int, 3> & translations_i,
     const std::array<int, 3> & translations )
 {
-    auto & Na = n_cells[0];
-    auto & Nb = n_cells[1];
-    auto & Nc = n_cells[2];
-    auto & N  = n_cell_atoms;
+    const spirit_index Na = n_cells[0];
+    const spirit_index Nb = n_cells[1];
+    const spirit_index Nc = n_cells[2];
+    const spirit_index N  = n_cell_atoms;
 
-    int da = translations_i[0] + translations[0];
-    int db = translations_i[1] + translations[1];
-    int dc = translations_i[2] + translations[2];
+    spirit_index da = translations_i[0] + translations[0];
+    spirit_index db = translations_i[1] + translations[1];
+    spirit_index dc = translations_i[2] + translations[2];
 
     if( translations[0] < 0 )
         da += N * Na;
@@ -181,10 +180,10 @@ void apply( int N, const F & f )
 
 // Get the linear index in a n-D array where tupel contains the components in n-dimensions from fatest to slowest
 // varying and maxVal is the extent in every dimension
-inline __device__ int cu_idx_from_tupel( field<int> & tupel, field<int> & maxVal )
+inline __device__ spirit_index cu_idx_from_tupel( field<int> & tupel, field<int> & maxVal )
 {
-    int idx  = 0;
-    int mult = 1;
+    spirit_index idx  = 0;
+    spirit_index mult = 1;
     for( int i = 0; i < tupel.size(); i++ )
     {
         idx += mult * tupel[i];
@@ -194,10 +193,10 @@ inline __device__ int cu_idx_from_tupel( field<int> & tupel, field<int> & maxVal
 }
 
 // reverse of idx_from_tupel
-inline __device__ void cu_tupel_from_idx( int & idx, int * tupel, int * maxVal, int n )
+inline __device__ void cu_tupel_from_idx( spirit_index idx, int * tupel, int * maxVal, int n )
 {
-    int idx_diff = idx;
-    int div      = 1;
+    spirit_index idx_diff = idx;
+    spirit_index div      = 1;
     for( int i = 0; i < n - 1; i++ )
         div *= maxVal[i];
     for( int i = n - 1; i > 0; i-- )
@@ -209,10 +208,10 @@ inline __device__ void cu_tupel_from_idx( int & idx, int * tupel, int * maxVal,
     tupel[0] = idx_diff / div;
 }
 
-inline void tupel_from_idx( int & idx, field<int> & tupel, const field<int> & maxVal )
+inline void tupel_from_idx( spirit_index idx, field<int> & tupel, const field<int> & maxVal )
 {
-    int idx_diff = idx;
-    int div      = 1;
+    spirit_index idx_diff = idx;
+    spirit_index div      = 1;
     for( int i = 0; i < maxVal.size() - 1; i++ )
         div *= maxVal[i];
     for( int i = maxVal.size() - 1; i > 0; i-- )
@@ -224,18 +223,18 @@ inline void tupel_from_idx( int & idx, field<int> & tupel, const field<int> & ma
     tupel[0] = idx_diff / div;
 }
 
-inline int idx_from_translations(
+inline spirit_index idx_from_translations(
     const intfield & n_cells, const int n_cell_atoms, const std::array<int, 3> & translations_i,
     const int translations[3] )
 {
-    int Na = n_cells[0];
-    int Nb = n_cells[1];
-    int Nc = n_cells[2];
-    int N  = n_cell_atoms;
+    const spirit_index Na = n_cells[0];
+    const spirit_index Nb = n_cells[1];
+    const spirit_index Nc = n_cells[2];
+    const spirit_index N  = n_cell_atoms;
 
-    int da = translations_i[0] + translations[0];
-    int db = translations_i[1] + translations[1];
-    int dc = translations_i[2] + translations[2];
+    spirit_index da = translations_i[0] + translations[0];
+    spirit_index db = translations_i[1] + translations[1];
+    spirit_index dc = translations_i[2] + translations[2];
 
     if( translations[0] < 0 )
         da += N * Na;
@@ -244,7 +243,7 @@ inline int idx_from_translations(
     if( translations[2] < 0 )
         dc += N * Na * Nb * Nc;
 
-    int idx = ( da % Na ) * N + ( db % Nb ) * N * Na + ( dc % Nc ) * N * Na * Nb;
+    spirit_index idx = ( da % Na ) * N + ( db % Nb ) * N * Na + ( dc % Nc ) * N * Na * Nb;
 
     return idx;
 }
@@ -294,9 +293,9 @@ __inline__ __device__ bool cu_check_atom_type( int atom_type, int reference_type
 
 // Calculates, for a spin i, a pair spin's index j.
 // This function takes into account boundary conditions and atom types and returns `-1` if any condition is not met.
-__inline__ __device__ int cu_idx_from_pair(
-    int ispin, const int * boundary_conditions, const int * n_cells, int N, const int * atom_types, const Pair & pair,
-    bool invert = false )
+__inline__ __device__ spirit_index cu_idx_from_pair(
+    spirit_index ispin, const int * boundary_conditions, const int * n_cells, int N, const int * atom_types,
+    const Pair & pair, bool invert = false )
 {
     // Invalid index if atom type of spin i is not correct
     if( pair.i != ispin % N || !cu_check_atom_type( atom_types[ispin] ) )
@@ -313,9 +312,11 @@ __inline__ __device__ int cu_idx_from_pair(
         return -1;
 
     // Translations (cell) of spin i
-    int nic = ispin / ( N * Na * Nb );
-    int nib = ( ispin - nic * N * Na * Nb ) / ( N * Na );
-    int nia = ( ispin - nic * N * Na * Nb - nib * N * Na ) / N;
+    const spirit_index n_row   = spirit_index( N ) * Na;
+    const spirit_index n_plane = n_row * Nb;
+    int nic                    = ispin / n_plane;
+    int nib                    = ( ispin - nic * n_plane ) / n_row;
+    int nia                    = ( ispin - nic * n_plane - nib * n_row ) / N;
 
     // Translations (cell) of spin j (possibly outside of non-periodical domain)
     int pm = 1;
@@ -377,7 +378,7 @@ __inline__ __device__ int cu_idx_from_pair(
     }
 
     // Calculate the index of spin j according to it's translations
-    int jspin = pair.j + (nja)*N + (njb)*N * Na + (njc)*N * Na * Nb;
+    spirit_index jspin = pair.j + nja * N + njb * n_row + njc * n_plane;
 
     if( !cu_check_atom_type( atom_types[jspin] ) )
         return -1;
@@ -388,13 +389,13 @@ __inline__ __device__ int cu_idx_from_pair(
 
 #endif
 
-inline std::array<int, 3> translations_from_idx( const intfield & n_cells, const int n_cell_atoms, int idx )
+inline std::array<int, 3>
+translations_from_idx( const intfield & n_cells, const int n_cell_atoms, spirit_index idx )
 {
     std::array<int, 3> ret;
-    int Na = n_cells[0];
-    int Nb = n_cells[1];
-    int Nc = n_cells[2];
-    int N  = n_cell_atoms;
+    const spirit_index Na = n_cells[0];
+    const spirit_index Nb = n_cells[1];
+    const spirit_index N  = n_cell_atoms;
 
     ret[2] = idx / ( N * Na * Nb );
     ret[1] = ( idx - ret[2] * N * Na * Nb ) / ( N * Na );
@@ -434,9 +435,9 @@ inline bool check_atom_type( int atom_type, int reference_type )
 
 // Calculates, for a spin i, a pair spin's index j.
 // This function takes into account boundary conditions and atom types and returns `-1` if any condition is not met.
-inline int idx_from_pair(
-    int ispin, const intfield & boundary_conditions, const intfield & n_cells, int N, const intfield & atom_types,
-    const Pair & pair, bool invert = false )
+inline spirit_index idx_from_pair(
+    spirit_index ispin, const intfield & boundary_conditions, const intfield & n_cells, int N,
+    const intfield & atom_types, const Pair & pair, bool invert = false )
 {
     // Invalid index if atom type of spin i is not correct
     if( pair.i != ispin % N || !check_atom_type( atom_types[ispin] ) )
@@ -453,9 +454,11 @@ inline int idx_from_pair(
         return -1;
 
     // Translations (cell) of spin i
-    int nic = ispin / ( N * Na * Nb );
-    int nib = ( ispin - nic * N * Na * Nb ) / ( N * Na );
-    int nia = ( ispin - nic * N * Na * Nb - nib * N * Na ) / N;
+    const spirit_index n_row   = spirit_index( N ) * Na;
+    const spirit_index n_plane = n_row * Nb;
+    int nic                    = ispin / n_plane;
+    int nib                    = ( ispin - nic * n_plane ) / n_row;
+    int nia                    = ( ispin - nic * n_plane - nib * n_row ) / N;
 
     int pm = 1;
     if( invert )
@@ -517,7 +520,7 @@ inline int idx_from_pair(
     }
 
     // Calculate the index of spin j according to it's translations
-    int jspin = pair.j + (nja)*N + (njb)*N * Na + (njc)*N * Na * Nb;
+    spirit_index jspin = pair.j + nja * N + njb * n_row + njc * n_plane;
 
     // Invalid index if atom type of spin j is not correct
     if( !check_atom_type( atom_types[jspin] ) )
@@ -536,7 +539,7 @@ std::array<scalar, 3> Magnetization( const vectorfield & vf, const scalarfield &
 // Calculate the topological charge density inside a vectorfield
 void TopologicalChargeDensity(
     const vectorfield & vf, const Data::Geometry & geometry, const intfield & boundary_conditions,
-    scalarfield & charge_density, std::vector<int> & triangle_indices );
+    scalarfield & charge_density, intfield & triangle_indices );
 
 // Calculate the topological charge inside a vectorfield
 scalar TopologicalCharge( const vectorfield & vf, const Data::Geometry & geom, const intfield & boundary_conditions );
@@ -552,12 +555,35 @@ void get_gradient_distribution(
     const Data::Geometry & geometry, Vector3 gradient_direction, scalar gradient_start, scalar gradient_inclination,
     scalarfield & distribution, scalar range_min, scalar range_max );
 
-// Calculate the spatial gradient of a vectorfield in a certain direction.
+// Finite-difference stencil for spatial derivatives of a vectorfield on the lattice of a geometry, with any Bravais
+//      lattice and basis. For each spin and each of the three Bravais translations, it holds the neighbours in
+//      forward and backward direction and the prefactor of their difference: 1/2 for central differences and 1 for
+//      the one-sided differences at open boundaries (0 if there are no neighbours along a translation).
+//      The derivative along a direction d is the sum over the translations k of
+//          w_k * factor_k * (vf[forward_k] - vf[backward_k]),   where   w = inverse_bravais * d.
+struct Finite_Difference_Stencil
+{
+    // Indices of the forward and backward neighbours, i.e. 6 per spin
+    indexfield neighbours;
+    // Prefactors of the differences, i.e. 3 per spin
+    scalarfield factors;
+    // Inverse of the matrix of the Bravais vectors (in units of length)
+    Matrix3 inverse_bravais;
+};
+
+// Build the finite-difference stencil of a geometry. It only has to be rebuilt if the geometry changes.
+void finite_difference_stencil(
+    const Data::Geometry & geometry, const intfield & boundary_conditions, Finite_Difference_Stencil & stencil );
+
+// Calculate the spatial gradient of a vectorfield in a certain direction, i.e. (direction . nabla) vf.
 //      This requires to know the underlying geometry, as well as the boundary conditions.
-// NOTE: This implementation is only applicable to rectangular geometries.
 void directional_gradient(
     const vectorfield & vf, const Data::Geometry & geometry, const intfield & boundary_conditions,
     const Vector3 & direction, vectorfield & gradient );
+// As above, using a stencil built beforehand
+void directional_gradient(
+    const vectorfield & vf, const Finite_Difference_Stencil & stencil, const Vector3 & direction,
+    vectorfield & gradient );
 
 // Calculate the jacobians of a vectorfield
 void jacobian(
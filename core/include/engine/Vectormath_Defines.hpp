@@ -97,6 +97,7 @@ struct Neighbour : Pair
 
 // Important fields
 using intfield    = field<int>;
+using indexfield  = field<spirit_index>;
 using scalarfield = field<scalar>;
 using vectorfield = field<Vector3>;
 
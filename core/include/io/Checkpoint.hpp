@@ -0,0 +1,177 @@
+#pragma once
+#ifndef SPIRIT_CORE_IO_CHECKPOINT_HPP
+#define SPIRIT_CORE_IO_CHECKPOINT_HPP
+
+#include "Spirit_Defines.h"
+#include <engine/Vectormath_Defines.hpp>
+
+#include <Eigen/Core>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace IO
+{
+
+/*
+ * Binary checkpoint of the state of a calculation method, from which it can be resumed bit-identically.
+ *
+ * Layout:
+ *   Header:  "SPIRITCP", version (u32), byte order mark (u32), scalar size (u32),
+ *            method name, solver (i32), noi (i32), nos (i32)
+ *   Body:    the values written by the method, in the order in which it writes them
+ *
+ * Strings and arrays are prefixed with their length (u64). Values are stored with the byte order and scalar type of
+ * the machine, as the checkpoint is meant to be resumed by the same build, which the header is checked against.
+ */
+struct Checkpoint_Header
+{
+    // Name of the method, e.g. "LLG"
+    std::string method;
+    // Index of the solver (see `Engine::Solver`), -1 for methods without solver
+    int solver = -1;
+    // Number of images and spins per image
+    int noi          = 0;
+    spirit_index nos = 0;
+};
+
+namespace Checkpoint_Detail
+{
+
+// Values which are stored as their bytes: numbers, enums and fixed-size Eigen vectors and matrices of numbers
+template<typename T>
+struct is_raw : std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value>
+{
+};
+
+template<typename S, int R, int C, int O, int MR, int MC>
+struct is_raw<Eigen::Matrix<S, R, C, O, MR, MC>>
+        : std::integral_constant<
+              bool, std::is_arithmetic<S>::value && R != Eigen::Dynamic && C != Eigen::Dynamic
+                        && sizeof( Eigen::Matrix<S, R, C, O, MR, MC> ) == R * C * sizeof( S )>
+{
+};
+
+} // namespace Checkpoint_Detail
+
+// Collects the values of a checkpoint in memory, so that the file can be replaced at once
+class Checkpoint_Writer
+{
+public:
+    explicit Checkpoint_Writer( const Checkpoint_Header & header );
+
+    template<typename T>
+    void write( const T & value )
+    {
+        static_assert( Checkpoint_Detail::is_raw<T>::value, "This type cannot be written to a checkpoint" );
+        write_bytes( &value, sizeof( T ) );
+    }
+
+    template<typename T, typename A>
+    void write( const std::vector<T, A> & values )
+    {
+        write_size( values.size() );
+        write_elements( values, Checkpoint_Detail::is_raw<T>{} );
+    }
+
+    template<int O, int MR, int MC>
+    void write( const Eigen::Matrix<scalar, Eigen::Dynamic, 1, O, MR, MC> & values )
+    {
+        write_size( values.size() );
+        write_bytes( values.data(), values.size() * sizeof( scalar ) );
+    }
+
+    void write( const std::string & value );
+    // The state of the random number generator, so that it continues with the same sequence
+    void write( const std::mt19937 & prng );
+
+    // Writes the checkpoint to a temporary file next to the given one, which then atomically replaces it
+    void commit( const std::string & filename ) const;
+
+private:
+    void write_bytes( const void * data, std::size_t size );
+    void write_size( std::size_t size );
+
+    template<typename T, typename A>
+    void write_elements( const std::vector<T, A> & values, std::true_type )
+    {
+        write_bytes( values.data(), values.size() * sizeof( T ) );
+    }
+
+    template<typename T, typename A>
+    void write_elements( const std::vector<T, A> & values, std::false_type )
+    {
+        for( const auto & value : values )
+            write( value );
+    }
+
+    std::string buffer;
+};
+
+// Reads a checkpoint file at once. Throws if it is not a checkpoint of this build or if it ends too early
+class Checkpoint_Reader
+{
+public:
+    explicit Checkpoint_Reader( const std::string & filename );
+
+    const std::string filename;
+
+    const Checkpoint_Header & header() const;
+
+    template<typename T>
+    void read( T & value )
+    {
+        static_assert( Checkpoint_Detail::is_raw<T>::value, "This type cannot be read from a checkpoint" );
+        read_bytes( &value, sizeof( T ) );
+    }
+
+    // Arrays are resized to the stored length
+    template<typename T, typename A>
+    void read( std::vector<T, A> & values )
+    {
+        values.resize( read_size() );
+        read_elements( values, Checkpoint_Detail::is_raw<T>{} );
+    }
+
+    template<int O, int MR, int MC>
+    void read( Eigen::Matrix<scalar, Eigen::Dynamic, 1, O, MR, MC> & values )
+    {
+        values.resize( read_size() );
+        read_bytes( values.data(), values.size() * sizeof( scalar ) );
+    }
+
+    void read( std::string & value );
+    void read( std::mt19937 & prng );
+
+    // Throws if not all values of the checkpoint have been read
+    void finish() const;
+
+private:
+    void read_bytes( void * data, std::size_t size );
+    std::size_t read_size();
+
+    template<typename T, typename A>
+    void read_elements( std::vector<T, A> & values, std::true_type )
+    {
+        read_bytes( values.data(), values.size() * sizeof( T ) );
+    }
+
+    template<typename T, typename A>
+    void read_elements( std::vector<T, A> & values, std::false_type )
+    {
+        for( auto & value : values )
+            read( value );
+    }
+
+    Checkpoint_Header header_;
+    std::string buffer;
+    std::size_t position = 0;
+};
+
+} // namespace IO
+
+#endif
@@ -10,16 +10,32 @@
 namespace IO
 {
 
-// The supported OOMF Vector Field (OVF) file formats
+// The supported vector field file formats: OOMF Vector Field (OVF) and Spirit trajectory files
 enum class VF_FileFormat
 {
-    OVF_BIN  = IO_Fileformat_OVF_bin,
-    OVF_BIN4 = IO_Fileformat_OVF_bin4,
-    OVF_BIN8 = IO_Fileformat_OVF_bin8,
-    OVF_TEXT = IO_Fileformat_OVF_text,
-    OVF_CSV  = IO_Fileformat_OVF_csv
+    OVF_BIN                     = IO_Fileformat_OVF_bin,
+    OVF_BIN4                    = IO_Fileformat_OVF_bin4,
+    OVF_BIN8                    = IO_Fileformat_OVF_bin8,
+    OVF_TEXT                    = IO_Fileformat_OVF_text,
+    OVF_CSV                     = IO_Fileformat_OVF_csv,
+    SPIRIT_TRAJECTORY           = IO_Fileformat_Trajectory,
+    SPIRIT_TRAJECTORY_QUANTISED = IO_Fileformat_Trajectory_quantised
 };
 
+// Whether the format is one of the Spirit trajectory formats (as opposed to OVF)
+inline bool is_trajectory( IO::VF_FileFormat format )
+{
+    return format == IO::VF_FileFormat::SPIRIT_TRAJECTORY || format == IO::VF_FileFormat::SPIRIT_TRAJECTORY_QUANTISED;
+}
+
+// The file extension used for output files written in the given format
+inline std::string extension( IO::VF_FileFormat format )
+{
+    if( is_trajectory( format ) )
+        return ".sptraj";
+    return ".ovf";
+}
+
 inline std::string str( IO::VF_FileFormat format )
 {
     if( format == IO::VF_FileFormat::OVF_BIN )
@@ -32,6 +48,10 @@ inline std::string str( IO::VF_FileFormat format )
         return "text OVF";
     else if( format == IO::VF_FileFormat::OVF_CSV )
         return "CSV OVF";
+    else if( format == IO::VF_FileFormat::SPIRIT_TRAJECTORY )
+        return "compressed trajectory";
+    else if( format == IO::VF_FileFormat::SPIRIT_TRAJECTORY_QUANTISED )
+        return "quantised compressed trajectory";
     else
         return "unknown";
 }
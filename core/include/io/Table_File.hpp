@@ -0,0 +1,181 @@
+#pragma once
+#ifndef SPIRIT_CORE_IO_TABLEFILE_HPP
+#define SPIRIT_CORE_IO_TABLEFILE_HPP
+
+#include <engine/Vectormath_Defines.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace IO
+{
+
+/*
+ * Fast reader for large text files of numeric columns (pairs, anisotropies, defects, spins, ...).
+ *
+ * The whole file is read at once and split into lines in parallel chunks. Comments (everything after the
+ * comment tag) and empty lines are dropped, so that the remaining lines can be accessed by index.
+ * Words are separated by whitespace, commas or '|' and numbers are parsed without streams, so that
+ * the lines can be parsed in parallel.
+ */
+class Table_File
+{
+public:
+    // Reads the file. Throws if it cannot be opened
+    Table_File( const std::string & filename, const std::string & comment_tag = "#" );
+
+    Table_File( const Table_File & )             = delete;
+    Table_File & operator=( const Table_File & ) = delete;
+
+    const std::string filename;
+
+    // Number of lines which contain data
+    std::size_t n_lines() const;
+    // Index of the first line which starts with the keyword (ignoring case), or -1 if there is none
+    std::ptrdiff_t find( const std::string & keyword ) const;
+    // The words of a line
+    std::vector<std::string> words( std::size_t line ) const;
+    // Parses the first `n_values` words of a line as numbers.
+    // Missing or invalid values are set to zero. Returns the number of values found.
+    std::size_t read_numbers( std::size_t line, std::size_t n_values, double * values ) const;
+
+private:
+    struct Line
+    {
+        const char * begin;
+        const char * end;
+    };
+
+    std::string contents;
+    std::vector<Line> lines;
+};
+
+/*
+ * Binary cache of data which was parsed from a text file.
+ *
+ * The cache is stored next to the source file as "<source>.<kind>.cache" and is only valid if the
+ * size and modification time of the source file, as well as the given key (e.g. a hash of the geometry
+ * on which the parsed data depends), are unchanged.
+ * Fields are stored as raw bytes, so their elements need to be plain data (numbers, Vector3, Pair, Site, ...).
+ */
+class Table_Cache
+{
+public:
+    // Minimum number of parsed lines for which it is worth writing a cache
+    static constexpr std::size_t min_lines = 10000;
+
+    Table_Cache( const std::string & source_file, const std::string & kind, std::uint64_t key = 0 );
+
+    // Name of the cache file
+    const std::string filename;
+
+    // Reads the fields from the cache. Returns false, without modifying the fields, if there is no valid cache
+    template<typename... Fields>
+    bool load( Fields &... fields ) const
+    {
+        std::ifstream stream( filename, std::ios::binary );
+        if( !stream.good() || !read_header( stream ) )
+            return false;
+
+        // Read into temporaries, so that a truncated cache leaves the output untouched
+        auto values = std::make_tuple( std::remove_reference_t<Fields>()... );
+        if( !read_all( stream, values, std::index_sequence_for<Fields...>{} ) )
+            return false;
+        assign_all( values, std::index_sequence_for<Fields...>{}, fields... );
+        return true;
+    }
+
+    // Writes the fields to the cache. Failure (e.g. in a read-only directory) is not an error
+    template<typename... Fields>
+    void store( const Fields &... fields ) const
+    {
+        const std::string tmp_filename = filename + ".tmp";
+        {
+            std::ofstream stream( tmp_filename, std::ios::binary | std::ios::trunc );
+            if( !stream.good() )
+                return;
+            write_header( stream );
+            int dummy[] = { 0, ( write_field( stream, fields ), 0 )... };
+            (void)dummy;
+            if( !stream.good() )
+                return;
+        }
+        finish_store( tmp_filename );
+    }
+
+private:
+    std::string kind;
+    std::uint64_t key;
+    std::uint64_t source_size;
+    std::int64_t source_mtime;
+    bool source_found;
+
+    bool read_header( std::ifstream & stream ) const;
+    void write_header( std::ofstream & stream ) const;
+    void finish_store( const std::string & tmp_filename ) const;
+    static std::uint64_t remaining_bytes( std::ifstream & stream );
+
+    template<typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+    static void write_field( std::ofstream & stream, const T & value )
+    {
+        stream.write( reinterpret_cast<const char *>( &value ), sizeof( T ) );
+    }
+
+    template<typename Container, typename std::enable_if<!std::is_arithmetic<Container>::value, int>::type = 0>
+    static void write_field( std::ofstream & stream, const Container & container )
+    {
+        std::uint64_t size = container.size();
+        stream.write( reinterpret_cast<const char *>( &size ), sizeof( size ) );
+        stream.write(
+            reinterpret_cast<const char *>( container.data() ), size * sizeof( typename Container::value_type ) );
+    }
+
+    template<typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+    static bool read_field( std::ifstream & stream, T & value )
+    {
+        return bool( stream.read( reinterpret_cast<char *>( &value ), sizeof( T ) ) );
+    }
+
+    template<typename Container, typename std::enable_if<!std::is_arithmetic<Container>::value, int>::type = 0>
+    static bool read_field( std::ifstream & stream, Container & container )
+    {
+        std::uint64_t size = 0;
+        if( !stream.read( reinterpret_cast<char *>( &size ), sizeof( size ) ) )
+            return false;
+        // Guard against a corrupt size
+        if( size * sizeof( typename Container::value_type ) > remaining_bytes( stream ) )
+            return false;
+        container.resize( size );
+        return bool( stream.read(
+            reinterpret_cast<char *>( container.data() ), size * sizeof( typename Container::value_type ) ) );
+    }
+
+    template<typename Tuple, std::size_t... I>
+    static bool read_all( std::ifstream & stream, Tuple & values, std::index_sequence<I...> )
+    {
+        bool success = true;
+        int dummy[]  = { 0, ( success = success && read_field( stream, std::get<I>( values ) ), 0 )... };
+        (void)dummy;
+        return success;
+    }
+
+    template<typename Tuple, std::size_t... I, typename... Fields>
+    static void assign_all( Tuple & values, std::index_sequence<I...>, Fields &... fields )
+    {
+        int dummy[] = { 0, ( fields = std::move( std::get<I>( values ) ), 0 )... };
+        (void)dummy;
+    }
+};
+
+// Hash of the geometry data on which parsed interactions can depend (lattice constant and Bravais vectors)
+std::uint64_t cache_key( scalar lattice_constant, const std::vector<Vector3> & bravais_vectors );
+
+} // namespace IO
+
+#endif
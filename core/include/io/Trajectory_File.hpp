@@ -0,0 +1,102 @@
+#pragma once
+#ifndef SPIRIT_CORE_IO_TRAJECTORYFILE_HPP
+#define SPIRIT_CORE_IO_TRAJECTORYFILE_HPP
+
+#include <engine/Vectormath_Defines.hpp>
+#include <io/Fileformat.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace IO
+{
+
+/*
+ * How the vectors of a trajectory frame are encoded before compression
+ *  - Lossless:  the scalar values are stored exactly
+ *  - Quantised: each vector is stored as its direction in spherical coordinates (theta, phi),
+ *               each quantised to 16 bit. The norm is not stored, so this is meant for spin directions.
+ */
+enum class Trajectory_Encoding
+{
+    Lossless  = 0,
+    Quantised = 1
+};
+
+/*
+ * Chunked, compressed file of a time series of vector fields (e.g. the spins of an LLG simulation).
+ *
+ * Layout (all integers little endian):
+ *   File header:  "SPIRITTR", version (u32), encoding (u32), value size in bytes (u32), valuedim (u32), nos (u64)
+ *   Frames:       "FRME", iteration (i64), n_blocks (u32), compressed size of each block (n_blocks x u32),
+ *                 followed by the compressed blocks
+ *
+ * Each block contains up to `n_vectors_per_block` vectors. Its values are byte-shuffled (byte k of all values,
+ * then byte k+1, ...) and compressed with an LZ77 scheme in an LZ4-style block format. The first byte of a block
+ * tells whether it is compressed (1) or stored (0). Blocks are compressed and decompressed independently
+ * (and in parallel), so that memory use is bounded and any frame can be accessed directly.
+ *
+ * When a file is opened, an index of the frames is built by skipping from frame header to frame header.
+ */
+class Trajectory_File
+{
+public:
+    // Number of vectors per compressed block
+    static constexpr int n_vectors_per_block = 1 << 16;
+
+    // Opens the file, if it exists, and builds the index of its frames
+    Trajectory_File( const std::string & filename, bool should_exist = false );
+
+    // Checks if the file exists and starts with the trajectory file signature
+    static bool is_trajectory_file( const std::string & filename );
+
+    // Whether the file exists and is a trajectory file
+    bool found() const;
+    // Number of frames in the file
+    int n_frames() const;
+    // Number of vectors per frame
+    int nos() const;
+    // Iteration at which the given frame was written
+    std::int64_t frame_iteration( int index ) const;
+    // Encoding of the frames in the file
+    Trajectory_Encoding encoding() const;
+
+    // Overwrites the file with a single frame
+    void write_frame( const vectorfield & vf, std::int64_t iteration, Trajectory_Encoding encoding );
+    // Appends a frame to the file, creating the file if it does not exist
+    void append_frame( const vectorfield & vf, std::int64_t iteration, Trajectory_Encoding encoding );
+    // Reads a frame into the given vectorfield. If the sizes differ, only the common part is read
+    void read_frame( int index, vectorfield & vf ) const;
+
+private:
+    struct Frame_Entry
+    {
+        std::int64_t iteration;
+        // Offset of the first compressed block in the file
+        std::uint64_t offset;
+        std::vector<std::uint32_t> block_sizes;
+    };
+
+    void read_index();
+    void write( const vectorfield & vf, std::int64_t iteration, Trajectory_Encoding encoding, bool append );
+
+    std::string filename;
+    bool file_found = false;
+    std::uint32_t file_encoding;
+    std::uint32_t value_size;
+    std::uint64_t file_nos;
+    std::vector<Frame_Entry> frames;
+};
+
+// Returns the trajectory encoding corresponding to a trajectory file format
+inline Trajectory_Encoding trajectory_encoding( VF_FileFormat format )
+{
+    if( format == VF_FileFormat::SPIRIT_TRAJECTORY_QUANTISED )
+        return Trajectory_Encoding::Quantised;
+    return Trajectory_Encoding::Lossless;
+}
+
+} // namespace IO
+
+#endif
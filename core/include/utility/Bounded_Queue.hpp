@@ -0,0 +1,111 @@
+#pragma once
+#ifndef SPIRIT_CORE_UTILITY_BOUNDED_QUEUE_HPP
+#define SPIRIT_CORE_UTILITY_BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace Utility
+{
+
+/*
+ * A fixed-size, lock-free queue for many producers and a single consumer.
+ *
+ * Each cell carries a sequence number, which tells producers whether the cell is free and the consumer whether
+ * it has been filled (D. Vyukov's bounded queue). Producers claim a cell with a single compare-and-swap,
+ * so `try_push` never blocks. If the queue is full, it fails instead of allocating more memory.
+ * Only one thread at a time may call `try_pop`.
+ */
+template<typename T>
+class Bounded_Queue
+{
+public:
+    // The capacity is rounded up to a power of two
+    explicit Bounded_Queue( std::size_t min_capacity )
+    {
+        std::size_t capacity = 2;
+        while( capacity < min_capacity )
+            capacity *= 2;
+        mask  = capacity - 1;
+        cells = std::unique_ptr<Cell[]>( new Cell[capacity] );
+        for( std::size_t i = 0; i < capacity; ++i )
+            cells[i].sequence.store( i, std::memory_order_relaxed );
+    }
+
+    Bounded_Queue( const Bounded_Queue & )             = delete;
+    Bounded_Queue & operator=( const Bounded_Queue & ) = delete;
+
+    std::size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+    // Moves the value into the queue. Returns false, leaving the value untouched, if the queue is full
+    bool try_push( T & value )
+    {
+        Cell * cell;
+        std::size_t position = push_position.load( std::memory_order_relaxed );
+        while( true )
+        {
+            cell                 = &cells[position & mask];
+            std::size_t sequence = cell->sequence.load( std::memory_order_acquire );
+            auto difference      = static_cast<std::ptrdiff_t>( sequence ) - static_cast<std::ptrdiff_t>( position );
+            if( difference == 0 )
+            {
+                if( push_position.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+                    break;
+            }
+            else if( difference < 0 )
+                return false;
+            else
+                position = push_position.load( std::memory_order_relaxed );
+        }
+        cell->value = std::move( value );
+        cell->sequence.store( position + 1, std::memory_order_release );
+        return true;
+    }
+
+    // Moves the oldest value out of the queue. Returns false if there is none
+    bool try_pop( T & value )
+    {
+        std::size_t position = pop_position.load( std::memory_order_relaxed );
+        Cell & cell          = cells[position & mask];
+        if( cell.sequence.load( std::memory_order_acquire ) != position + 1 )
+            return false;
+        value = std::move( cell.value );
+        cell.sequence.store( position + mask + 1, std::memory_order_release );
+        pop_position.store( position + 1, std::memory_order_release );
+        return true;
+    }
+
+    // Number of values which have been popped so far
+    std::size_t n_popped() const
+    {
+        return pop_position.load( std::memory_order_acquire );
+    }
+
+    // Number of values which have been (or are being) pushed so far
+    std::size_t n_pushed() const
+    {
+        return push_position.load( std::memory_order_acquire );
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask;
+    // Producers and consumer work on different cache lines
+    alignas( 64 ) std::atomic<std::size_t> push_position{ 0 };
+    alignas( 64 ) std::atomic<std::size_t> pop_position{ 0 };
+};
+
+} // namespace Utility
+
+#endif
@@ -4,12 +4,19 @@
 
 #include <Spirit/Log.h>
 
+#include <utility/Bounded_Queue.hpp>
 #include <utility/Timing.hpp>
 
+#include <fmt/format.h>
+
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 // Define Log as the singleton instance, so that messages can be sent with Log(..., message, ...)
@@ -64,7 +71,14 @@ std::string LogEntryToString( LogEntry entry, bool braces_separators = true );
 std::string LogBlockToString( std::vector<LogEntry> entries, bool braces_separators = true );
 
 /*
- * The Logging Handler keeps all Log Entries and provides methods to dump or append the entire Log to a file.
+ * The Logging Handler receives Log Entries, prints them to the console, writes them to the Log file and keeps
+ * the most recent ones in memory. It provides methods to dump or append the Log to a file.
+ *
+ * Messages with a level which is neither printed to the console nor written to the file are discarded right away.
+ * Accepted entries are pushed into a bounded lock-free queue, from which they are formatted and written by a
+ * background thread (if SPIRIT_USE_THREADS is defined) or by the sending thread. Only the last `n_entries_max`
+ * entries are kept in memory, so that the memory use of the Log does not grow over long runs.
+ *
  * Note: the Handler is a singleton.
  */
 class LoggingHandler
@@ -82,8 +96,25 @@ public:
         Log_Level level, Log_Sender sender, const std::vector<std::string> & messages, int idx_image = -1,
         int idx_chain = -1 );
 
-    // Get the log's entries
-    std::vector<LogEntry> GetEntries();
+    // Send a Log message, which is only formatted if its level is accepted, e.g.
+    //      Log.SendFormatted( Log_Level::Debug, Log_Sender::IO, -1, -1, "Read {} pairs", n_pairs );
+    template<typename... Args>
+    void SendFormatted(
+        Log_Level level, Log_Sender sender, int idx_image, int idx_chain, fmt::CStringRef format,
+        const Args &... args )
+    {
+        if( Accepts( level ) )
+            Send( level, sender, fmt::format( format, args... ), idx_image, idx_chain );
+    }
+
+    // Whether messages of the given level are kept, i.e. are printed to the console or written to the file
+    bool Accepts( Log_Level level ) const;
+
+    // Get the entries which are kept in memory and, if requested, the total number of entries so far
+    std::vector<LogEntry> GetEntries( int * n_entries_total = nullptr );
+
+    // Waits until all entries which have been sent so far are processed
+    void Flush();
 
     // Dumps the log to File fileName
     void Append_to_File();
@@ -112,12 +143,14 @@ public:
     bool save_neighbours_final{ false };
     // Name of the Log file
     std::string file_name{ "" };
+    // Maximum number of Log entries which are kept in memory
+    std::size_t n_entries_max{ 10000 };
     // Number of Log entries
-    int n_entries{ 0 };
+    std::atomic<int> n_entries{ 0 };
     // Number of errors in the Log
-    int n_errors{ 0 };
+    std::atomic<int> n_errors{ 0 };
     // Number of warnings in the Log
-    int n_warnings{ 0 };
+    std::atomic<int> n_warnings{ 0 };
     // Length of the tags before each message in spaces
     const std::string tags_space = std::string( 49, ' ' );
 
@@ -133,16 +166,33 @@ public:
 private:
     // Constructor
     LoggingHandler();
-
-    // Get the Log's entries, filtered for level, sender and indices
-    std::vector<LogEntry> Filter(
-        Log_Level level = Log_Level::All, Log_Sender sender = Log_Sender::All, int idx_image = -1, int idx_chain = -1 );
-
-    int no_dumped{ 0 };
-    std::vector<LogEntry> log_entries{};
-
-    // Mutex for thread-safety
-    std::mutex mutex;
+    // Destructor, processes the remaining entries and stops the sink thread
+    ~LoggingHandler();
+
+    // Pushes an accepted entry into the queue
+    void Enqueue( LogEntry & entry );
+    // Pops the queued entries and writes them to the console, the file buffer and the history
+    void Process_Queue();
+    // Loop of the sink thread
+    void Sink_Loop();
+
+    // Queue of entries which have not yet been processed
+    Bounded_Queue<LogEntry> queue{ 1024 };
+
+    // The most recent entries and the total number of processed entries
+    std::deque<LogEntry> history{};
+    int n_entries_processed{ 0 };
+    // Formatted entries which are yet to be appended to the Log file
+    std::string file_buffer{};
+
+    // Mutex of the processing of the queue, protecting the history and file buffer
+    std::mutex sink_mutex;
+
+    // Background thread processing the queue (only used if SPIRIT_USE_THREADS is defined)
+    std::thread sink_thread;
+    std::mutex wake_mutex;
+    std::condition_variable wake_condition;
+    bool stop_sink{ false };
 
 public:
     LoggingHandler( LoggingHandler const & ) = delete;
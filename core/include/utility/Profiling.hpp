@@ -0,0 +1,107 @@
+#pragma once
+#ifndef SPIRIT_CORE_UTILITY_PROFILING_HPP
+#define SPIRIT_CORE_UTILITY_PROFILING_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Utility
+{
+namespace Profiling
+{
+
+/*
+ * Sections of the code which are timed by the profiler.
+ * The times are inclusive, e.g. `Gradient` contains the time spent in the Hamiltonian terms and
+ * `DDI` contains the time spent in the FFTs.
+ */
+enum class Section
+{
+    Iteration = 0,
+    Gradient,
+    Zeeman,
+    Anisotropy,
+    Cubic_Anisotropy,
+    Exchange,
+    DMI,
+    DDI,
+    DDI_FFT_Forward,
+    DDI_Multiply,
+    DDI_FFT_Inverse,
+    Quadruplets,
+    Thermal_Noise,
+    Convergence,
+    IO,
+    Count
+};
+
+constexpr int n_sections = static_cast<int>( Section::Count );
+
+// Name of a section, as used in the C API and the log
+const char * Section_Name( Section section );
+
+// Accumulated wall time and number of calls of each section
+struct Timings
+{
+    std::array<double, n_sections> seconds{};
+    std::array<std::int64_t, n_sections> calls{};
+};
+
+// Whether the profiler was compiled in (CMake option SPIRIT_ENABLE_PROFILING)
+constexpr bool enabled()
+{
+#ifdef SPIRIT_ENABLE_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Sum of the timings of all threads
+Timings Get_Timings();
+// Sets the timings of all threads to zero
+void Reset_Timings();
+// Formats the difference between two snapshots of the timings as a log block
+std::vector<std::string> Timings_Block( const Timings & start, const Timings & end );
+
+// Adds a measured duration to the timings of the calling thread
+void Add( Section section, std::chrono::steady_clock::duration duration );
+
+// Measures the time from its construction to its destruction
+class Scoped_Timer
+{
+public:
+    explicit Scoped_Timer( Section section ) : section( section ), start( std::chrono::steady_clock::now() ) {}
+
+    ~Scoped_Timer()
+    {
+        Add( section, std::chrono::steady_clock::now() - start );
+    }
+
+    Scoped_Timer( const Scoped_Timer & )             = delete;
+    Scoped_Timer & operator=( const Scoped_Timer & ) = delete;
+
+private:
+    Section section;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace Profiling
+} // namespace Utility
+
+// Times the rest of the enclosing scope as the given Utility::Profiling::Section.
+// Compiles to nothing unless SPIRIT_ENABLE_PROFILING is defined.
+#ifdef SPIRIT_ENABLE_PROFILING
+#define SPIRIT_PROFILING_CONCAT_INNER( a, b ) a##b
+#define SPIRIT_PROFILING_CONCAT( a, b ) SPIRIT_PROFILING_CONCAT_INNER( a, b )
+#define SPIRIT_PROFILE( section )                                                                                      \
+    Utility::Profiling::Scoped_Timer SPIRIT_PROFILING_CONCAT( spirit_profiling_timer_, __LINE__ )(                     \
+        Utility::Profiling::Section::section )
+#else
+#define SPIRIT_PROFILE( section )
+#endif
+
+#endif
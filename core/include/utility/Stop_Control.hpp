@@ -0,0 +1,50 @@
+#pragma once
+#ifndef SPIRIT_CORE_UTILITY_STOP_CONTROL_HPP
+#define SPIRIT_CORE_UTILITY_STOP_CONTROL_HPP
+
+namespace Utility
+{
+
+/*
+ * Checks of the conditions, other than convergence and walltime, under which running simulations stop. They are
+ * cheap enough to be made in every iteration.
+ *
+ * A file called `STOP` in the working directory is looked for at most every few seconds, as set by the environment
+ * variable SPIRIT_STOP_FILE_INTERVAL (default: 1 second). With SPIRIT_USE_THREADS a watcher thread makes these checks
+ * while simulations are running (see `Stop_Watch`), so that the iteration loops only read an atomic flag. Otherwise
+ * the loops make them once the interval has passed, which costs them a read of a monotonic clock.
+ *
+ * Stops can also be requested directly. `Request_Stop` only increments an atomic counter, so that it may be called
+ * from a signal handler.
+ */
+namespace Stop_Control
+{
+
+// Whether a file called `STOP` was found at the last check
+bool Stop_File_Present();
+
+// Requests all running simulations to stop after their current iteration
+void Request_Stop() noexcept;
+
+// The number of stops requested so far. A simulation stops when it changed since the simulation started
+int N_Stop_Requests() noexcept;
+
+} // namespace Stop_Control
+
+/*
+ * Registers the calling thread as running a simulation for the lifetime of this object. The watcher thread runs
+ * while at least one simulation is registered.
+ */
+class Stop_Watch
+{
+public:
+    Stop_Watch();
+    ~Stop_Watch();
+
+    Stop_Watch( const Stop_Watch & )             = delete;
+    Stop_Watch & operator=( const Stop_Watch & ) = delete;
+};
+
+} // namespace Utility
+
+#endif
@@ -0,0 +1,98 @@
+#pragma once
+#ifndef SPIRIT_CORE_UTILITY_THREAD_POOL_HPP
+#define SPIRIT_CORE_UTILITY_THREAD_POOL_HPP
+
+#include "Spirit_Defines.h"
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Utility
+{
+
+/*
+ * A work-stealing pool of threads, which execute the parallel loops of the engine.
+ *
+ * A loop is split into chunks. The calling thread processes chunks itself and posts one helper task per
+ * additional thread of its budget to the queues of the workers. Each worker takes tasks from the front of its
+ * own queue and, if that is empty, steals from the back of the other queues. The chunks are claimed through an
+ * atomic counter, so a helper which starts late simply finds no work left and the caller never waits for it.
+ *
+ * Without SPIRIT_USE_THREADS the pool has no workers and all loops run on the calling thread.
+ */
+class Thread_Pool
+{
+public:
+    // Called for the chunk with index `i_chunk`, which covers the range [begin, end)
+    using Chunk_Function = std::function<void( int i_chunk, spirit_index begin, spirit_index end )>;
+
+    // The pool shared by all simulations. Its number of threads is taken from the environment variable
+    // SPIRIT_NUM_THREADS or, if that is not set, from the number of hardware threads
+    static Thread_Pool & Get();
+
+    // Creates `n_threads - 1` workers, as the thread calling `Parallel_For` takes part in the loop
+    explicit Thread_Pool( int n_threads );
+    ~Thread_Pool();
+
+    Thread_Pool( const Thread_Pool & )             = delete;
+    Thread_Pool & operator=( const Thread_Pool & ) = delete;
+
+    // Number of threads of the pool, including the calling thread
+    int N_Threads() const;
+
+    // Number of threads the calling thread may currently use (see `Thread_Budget`)
+    int Budget() const;
+
+    // Number of chunks into which a loop of length n is split. It does not depend on the budget, so that
+    // reductions over the chunks give the same result regardless of how many threads take part
+    int N_Chunks( spirit_index n ) const;
+
+    // Calls f for all chunks of [0, n) and returns once they are done. The first exception thrown by f is
+    // rethrown on the calling thread. Loops started from within a chunk run on the thread of that chunk
+    void Parallel_For( spirit_index n, const Chunk_Function & f );
+
+private:
+    struct Loop;
+    struct Worker;
+
+    void Post( const std::shared_ptr<Loop> & loop, int n_helpers );
+    bool Take( int i_worker, std::shared_ptr<Loop> & loop );
+    void Work( int i_worker );
+
+    int n_threads;
+    std::vector<std::unique_ptr<Worker>> workers;
+    // Workers without tasks sleep until new tasks are posted
+    std::mutex sleep_mutex;
+    std::condition_variable wake_condition;
+    int n_pending   = 0;
+    bool stop       = false;
+    int next_worker = 0;
+};
+
+/*
+ * Registers the calling thread as running a simulation for the lifetime of this object.
+ *
+ * Unless `n_threads` is given, the threads of the pool are shared evenly among all registered threads, so that
+ * simulations running concurrently on several images share the cores instead of oversubscribing them.
+ * Threads which are not registered may use the whole pool.
+ */
+class Thread_Budget
+{
+public:
+    explicit Thread_Budget( int n_threads = 0 );
+    ~Thread_Budget();
+
+    Thread_Budget( const Thread_Budget & )             = delete;
+    Thread_Budget & operator=( const Thread_Budget & ) = delete;
+
+private:
+    int n_threads_previous;
+    bool registered_previous;
+};
+
+} // namespace Utility
+
+#endif
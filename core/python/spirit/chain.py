@@ -9,7 +9,9 @@ Get information, such as number of images or energies and reaction coordinates.
 from spirit import spiritlib
 from spirit import system
 from spirit import parameters
+from spirit.scalar import scalar
 import ctypes
+import numpy as np
 
 ### Load Library
 _spirit = spiritlib.load_spirit_library()
@@ -235,9 +237,9 @@ _Get_Rx.restype = None
 def get_reaction_coordinate(p_state, idx_chain=-1):
     """Returns an array of `shape(NOI)` containing the reaction coordinates of the images."""
     noi = get_noi(p_state, idx_chain)
-    Rx = (noi * ctypes.c_float)()
-    _Get_Rx(ctypes.c_void_p(p_state), Rx, ctypes.c_int(idx_chain))
-    return [x for x in Rx]
+    Rx = np.empty(noi, dtype=np.float32)
+    _Get_Rx(ctypes.c_void_p(p_state), _float_pointer(Rx), ctypes.c_int(idx_chain))
+    return Rx
 
 
 ### Get Rx interpolated
@@ -258,9 +260,11 @@ def get_reaction_coordinate_interpolated(p_state, idx_chain=-1):
     noi = get_noi(p_state, idx_chain)
     n_interp = parameters.gneb.get_n_energy_interpolations(p_state, idx_chain)
     len_Rx = noi + (noi - 1) * n_interp
-    Rx = (len_Rx * ctypes.c_float)()
-    _Get_Rx_Interpolated(ctypes.c_void_p(p_state), Rx, ctypes.c_int(idx_chain))
-    return [x for x in Rx]
+    Rx = np.empty(len_Rx, dtype=np.float32)
+    _Get_Rx_Interpolated(
+        ctypes.c_void_p(p_state), _float_pointer(Rx), ctypes.c_int(idx_chain)
+    )
+    return Rx
 
 
 ### Get Energy
@@ -272,9 +276,11 @@ _Get_Energy.restype = None
 def get_energy(p_state, idx_chain=-1):
     """Returns an array of `shape(NOI)` containing the energies of the images."""
     noi = get_noi(p_state, idx_chain)
-    Energy = (noi * ctypes.c_float)()
-    _Get_Energy(ctypes.c_void_p(p_state), Energy, ctypes.c_int(idx_chain))
-    return [E for E in Energy]
+    Energy = np.empty(noi, dtype=np.float32)
+    _Get_Energy(
+        ctypes.c_void_p(p_state), _float_pointer(Energy), ctypes.c_int(idx_chain)
+    )
+    return Energy
 
 
 ### Get Energy Interpolated
@@ -295,8 +301,92 @@ def get_energy_interpolated(p_state, idx_chain=-1):
     noi = get_noi(p_state, idx_chain)
     n_interp = parameters.gneb.get_n_energy_interpolations(p_state, idx_chain)
     len_Energy = noi + (noi - 1) * n_interp
-    Energy_interp = (len_Energy * ctypes.c_float)()
+    Energy_interp = np.empty(len_Energy, dtype=np.float32)
     _Get_Energy_Interpolated(
-        ctypes.c_void_p(p_state), Energy_interp, ctypes.c_int(idx_chain)
+        ctypes.c_void_p(p_state), _float_pointer(Energy_interp), ctypes.c_int(idx_chain)
+    )
+    return Energy_interp
+
+
+### Get Spin Directions of all images
+_Get_Spin_Directions = _spirit.Chain_Get_Spin_Directions
+_Get_Spin_Directions.argtypes = [ctypes.c_void_p, ctypes.POINTER(scalar), ctypes.c_int]
+_Get_Spin_Directions.restype = None
+
+
+def get_spin_directions(p_state, idx_chain=-1, out=None):
+    """Returns a `numpy.array` of `shape(NOI, NOS, 3)` with the spin directions of all images.
+
+    In contrast to `system.get_spin_directions`, this is a copy, which is made in a single call.
+    An array of the right shape and type can be passed as `out` to be reused.
+    """
+    out = _chain_array(p_state, idx_chain, out)
+    _Get_Spin_Directions(
+        ctypes.c_void_p(p_state), _scalar_pointer(out), ctypes.c_int(idx_chain)
     )
-    return [E for E in Energy_interp]
+    return out
+
+
+### Set Spin Directions of all images
+_Set_Spin_Directions = _spirit.Chain_Set_Spin_Directions
+_Set_Spin_Directions.argtypes = [ctypes.c_void_p, ctypes.POINTER(scalar), ctypes.c_int]
+_Set_Spin_Directions.restype = None
+
+
+def set_spin_directions(p_state, spins, idx_chain=-1):
+    """Sets the spin directions of all images from an array of `shape(NOI, NOS, 3)`.
+
+    The directions are normalized.
+    """
+    shape = (get_noi(p_state, idx_chain), system.get_nos(p_state, -1, idx_chain), 3)
+    spins = np.ascontiguousarray(spins, dtype=scalar)
+    if spins.shape != shape:
+        raise ValueError(
+            "chain.set_spin_directions: expected shape {}, got {}".format(
+                shape, spins.shape
+            )
+        )
+    _Set_Spin_Directions(
+        ctypes.c_void_p(p_state), _scalar_pointer(spins), ctypes.c_int(idx_chain)
+    )
+
+
+### Get Effective Fields of all images
+_Get_Effective_Fields = _spirit.Chain_Get_Effective_Fields
+_Get_Effective_Fields.argtypes = [ctypes.c_void_p, ctypes.POINTER(scalar), ctypes.c_int]
+_Get_Effective_Fields.restype = None
+
+
+def get_effective_fields(p_state, idx_chain=-1, out=None):
+    """Returns a `numpy.array` of `shape(NOI, NOS, 3)` with the effective fields of all images.
+
+    An array of the right shape and type can be passed as `out` to be reused.
+    """
+    out = _chain_array(p_state, idx_chain, out)
+    _Get_Effective_Fields(
+        ctypes.c_void_p(p_state), _scalar_pointer(out), ctypes.c_int(idx_chain)
+    )
+    return out
+
+
+def _float_pointer(array):
+    return array.ctypes.data_as(ctypes.POINTER(ctypes.c_float))
+
+
+def _scalar_pointer(array):
+    return array.ctypes.data_as(ctypes.POINTER(scalar))
+
+
+def _chain_array(p_state, idx_chain, out):
+    """An array of `shape(NOI, NOS, 3)` to be filled by the library."""
+    shape = (get_noi(p_state, idx_chain), system.get_nos(p_state, -1, idx_chain), 3)
+    dtype = np.dtype(scalar)
+    if out is None:
+        return np.empty(shape, dtype=dtype)
+    if out.shape != shape or out.dtype != dtype or not out.flags.c_contiguous:
+        raise ValueError(
+            "chain: expected a contiguous array of shape {} and type {}".format(
+                shape, dtype
+            )
+        )
+    return out
@@ -33,6 +33,12 @@ FILEFORMAT_OVF_TEXT = 3
 FILEFORMAT_OVF_CSV = 4
 """OVF text format with comma-separated columns"""
 
+FILEFORMAT_TRAJECTORY = 5
+"""Spirit trajectory format, chunked and losslessly compressed. Can be read with `spirit.trajectory`"""
+
+FILEFORMAT_TRAJECTORY_QUANTISED = 6
+"""Spirit trajectory format, with directions quantised to 2x16 bit spherical coordinates. Can be read with `spirit.trajectory`"""
+
 _N_Images_In_File = _spirit.IO_N_Images_In_File
 _N_Images_In_File.argtypes = [
     ctypes.c_void_p,
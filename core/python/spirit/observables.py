@@ -0,0 +1,230 @@
+"""
+Observables
+====================
+
+Record time series of observables inside the iteration loop of a running method.
+
+Each sample is a row of values. The first two columns are the iteration and the simulated time
+(in picoseconds, only for LLG simulations), followed by the columns of the observables in the order
+in which they were added.
+"""
+
+from spirit import spiritlib
+import ctypes
+
+import numpy as np
+
+### Load Library
+_spirit = spiritlib.load_spirit_library()
+
+### Observables
+MAGNETIZATION = 0
+"""Magnetization, i.e. the mean of mu_s * spin (columns `m_x`, `m_y`, `m_z`)"""
+
+SUBLATTICE_MAGNETIZATION = 1
+"""Magnetization of each basis atom of the unit cell (columns `m_x_0`, `m_y_0`, `m_z_0`, ...)"""
+
+TOPOLOGICAL_CHARGE = 2
+"""Topological charge, only calculated for 2D systems (column `Q`)"""
+
+ENERGY = 3
+"""Total energy and energy of each interaction (columns `E`, `E_Zeeman`, ...)"""
+
+MAX_TORQUE = 5
+"""Maximum torque (column `max_torque`)"""
+
+
+_Add = _spirit.Observables_Add
+_Add.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int, ctypes.c_int]
+_Add.restype = None
+
+
+def add(p_state, observable, idx_image=-1, idx_chain=-1):
+    """Adds an observable, i.e. one of the integers defined above.
+    Observables which were already added are ignored.
+    """
+    _Add(
+        ctypes.c_void_p(p_state),
+        ctypes.c_int(observable),
+        ctypes.c_int(idx_image),
+        ctypes.c_int(idx_chain),
+    )
+
+
+_Add_Correlation = _spirit.Observables_Add_Correlation
+_Add_Correlation.argtypes = [
+    ctypes.c_void_p,
+    ctypes.POINTER(ctypes.c_float),
+    ctypes.c_int,
+    ctypes.c_int,
+]
+_Add_Correlation.restype = None
+
+
+def add_correlation(p_state, q, idx_image=-1, idx_chain=-1):
+    """Adds the spin-spin correlation (static structure factor) at the wave vector `q`
+    (in units of 1/Angstrom), i.e. the column `S(qx,qy,qz)`.
+    """
+    vec3 = ctypes.c_float * 3
+    _Add_Correlation(
+        ctypes.c_void_p(p_state),
+        vec3(*q),
+        ctypes.c_int(idx_image),
+        ctypes.c_int(idx_chain),
+    )
+
+
+_Clear = _spirit.Observables_Clear
+_Clear.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+_Clear.restype = None
+
+
+def clear(p_state, idx_image=-1, idx_chain=-1):
+    """Removes all observables and samples."""
+    _Clear(ctypes.c_void_p(p_state), ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
+
+
+_Reset_Samples = _spirit.Observables_Reset_Samples
+_Reset_Samples.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+_Reset_Samples.restype = None
+
+
+def reset_samples(p_state, idx_image=-1, idx_chain=-1):
+    """Removes all samples, but keeps the observables."""
+    _Reset_Samples(
+        ctypes.c_void_p(p_state), ctypes.c_int(idx_image), ctypes.c_int(idx_chain)
+    )
+
+
+_Set_Step = _spirit.Observables_Set_Step
+_Set_Step.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int, ctypes.c_int]
+_Set_Step.restype = None
+
+
+def set_step(p_state, n_iterations, idx_image=-1, idx_chain=-1):
+    """Sets the number of iterations between two samples."""
+    _Set_Step(
+        ctypes.c_void_p(p_state),
+        ctypes.c_int(n_iterations),
+        ctypes.c_int(idx_image),
+        ctypes.c_int(idx_chain),
+    )
+
+
+_Get_Step = _spirit.Observables_Get_Step
+_Get_Step.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+_Get_Step.restype = ctypes.c_int
+
+
+def get_step(p_state, idx_image=-1, idx_chain=-1):
+    """Returns the number of iterations between two samples."""
+    return int(
+        _Get_Step(
+            ctypes.c_void_p(p_state), ctypes.c_int(idx_image), ctypes.c_int(idx_chain)
+        )
+    )
+
+
+_Set_Capacity = _spirit.Observables_Set_Capacity
+_Set_Capacity.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int, ctypes.c_int]
+_Set_Capacity.restype = None
+
+
+def set_capacity(p_state, n_samples_max, idx_image=-1, idx_chain=-1):
+    """Sets the maximum number of stored samples. Once it is reached, the oldest samples
+    are overwritten.
+    """
+    _Set_Capacity(
+        ctypes.c_void_p(p_state),
+        ctypes.c_int(n_samples_max),
+        ctypes.c_int(idx_image),
+        ctypes.c_int(idx_chain),
+    )
+
+
+_Get_N_Samples = _spirit.Observables_Get_N_Samples
+_Get_N_Samples.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+_Get_N_Samples.restype = ctypes.c_int
+
+
+def get_n_samples(p_state, idx_image=-1, idx_chain=-1):
+    """Returns the number of stored samples."""
+    return int(
+        _Get_N_Samples(
+            ctypes.c_void_p(p_state), ctypes.c_int(idx_image), ctypes.c_int(idx_chain)
+        )
+    )
+
+
+_Get_Labels = _spirit.Observables_Get_Labels
+_Get_Labels.argtypes = [
+    ctypes.c_void_p,
+    ctypes.POINTER(ctypes.c_char),
+    ctypes.c_int,
+    ctypes.c_int,
+]
+_Get_Labels.restype = ctypes.c_int
+
+
+def get_labels(p_state, idx_image=-1, idx_chain=-1):
+    """Returns the labels of the columns of the stored samples as a list of strings."""
+    NULL = ctypes.POINTER(ctypes.c_char)()
+    n_char_array = _Get_Labels(
+        ctypes.c_void_p(p_state), NULL, ctypes.c_int(idx_image), ctypes.c_int(idx_chain)
+    )
+    if n_char_array <= 0:
+        return []
+
+    labels = (n_char_array * ctypes.c_char)()
+    _Get_Labels(
+        ctypes.c_void_p(p_state),
+        labels,
+        ctypes.c_int(idx_image),
+        ctypes.c_int(idx_chain),
+    )
+    return str(labels[:].decode("utf-8")).split("|")
+
+
+_Get_N_Columns = _spirit.Observables_Get_N_Columns
+_Get_N_Columns.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+_Get_N_Columns.restype = ctypes.c_int
+
+
+def get_n_columns(p_state, idx_image=-1, idx_chain=-1):
+    """Returns the number of columns of the stored samples."""
+    return int(
+        _Get_N_Columns(
+            ctypes.c_void_p(p_state), ctypes.c_int(idx_image), ctypes.c_int(idx_chain)
+        )
+    )
+
+
+_Get_Samples = _spirit.Observables_Get_Samples
+_Get_Samples.argtypes = [
+    ctypes.c_void_p,
+    ctypes.POINTER(ctypes.c_float),
+    ctypes.c_int,
+    ctypes.c_int,
+]
+_Get_Samples.restype = ctypes.c_int
+
+
+def get_samples(p_state, idx_image=-1, idx_chain=-1):
+    """Returns the stored samples in chronological order as a `numpy.ndarray` of
+    `shape(n_samples, n_columns)`, together with the labels of the columns.
+    """
+    labels = get_labels(p_state, idx_image, idx_chain)
+    NULL = ctypes.POINTER(ctypes.c_float)()
+    n_values = _Get_Samples(
+        ctypes.c_void_p(p_state), NULL, ctypes.c_int(idx_image), ctypes.c_int(idx_chain)
+    )
+    n_columns = len(labels)
+    samples = np.zeros(max(n_values, 0), dtype=np.float32)
+    if n_values > 0:
+        _Get_Samples(
+            ctypes.c_void_p(p_state),
+            samples.ctypes.data_as(ctypes.POINTER(ctypes.c_float)),
+            ctypes.c_int(idx_image),
+            ctypes.c_int(idx_chain),
+        )
+    return labels, samples.reshape((-1, max(n_columns, 1)))
@@ -193,6 +193,28 @@ def set_iterations(p_state, n_iterations, n_iterations_log, idx_image=-1, idx_ch
     )
 
 
+_GNEB_Set_N_Iterations_Amortize = _spirit.Parameters_GNEB_Set_N_Iterations_Amortize
+_GNEB_Set_N_Iterations_Amortize.argtypes = [
+    ctypes.c_void_p,
+    ctypes.c_int,
+    ctypes.c_int,
+]
+_GNEB_Set_N_Iterations_Amortize.restype = None
+
+
+def set_iterations_amortize(p_state, n_iterations_amortize, idx_chain=-1):
+    """Set after how many iterations the convergence is checked.
+
+    The torques, the interpolated energies and the observables are only updated after this number
+    of iterations, which saves the corresponding passes over the spins. The simulation may
+    therefore run up to `n_iterations_amortize - 1` iterations past convergence.
+    """
+    _GNEB_Set_N_Iterations_Amortize(
+        ctypes.c_void_p(p_state),
+        ctypes.c_int(n_iterations_amortize),
+        ctypes.c_int(idx_chain),
+    )
+
 _GNEB_Set_Convergence = _spirit.Parameters_GNEB_Set_Convergence
 _GNEB_Set_Convergence.argtypes = [
     ctypes.c_void_p,
@@ -390,6 +412,15 @@ def get_iterations(p_state, idx_image=-1, idx_chain=-1):
     return int(n_iterations.value), int(n_iterations_log.value)
 
 
+_GNEB_Get_N_Iterations_Amortize = _spirit.Parameters_GNEB_Get_N_Iterations_Amortize
+_GNEB_Get_N_Iterations_Amortize.argtypes = [ctypes.c_void_p, ctypes.c_int]
+_GNEB_Get_N_Iterations_Amortize.restype = ctypes.c_int
+
+
+def get_iterations_amortize(p_state, idx_chain=-1):
+    """Returns after how many iterations the convergence is checked."""
+    return int(_GNEB_Get_N_Iterations_Amortize(ctypes.c_void_p(p_state), ctypes.c_int(idx_chain)))
+
 _GNEB_Get_Convergence = _spirit.Parameters_GNEB_Get_Convergence
 _GNEB_Get_Convergence.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
 _GNEB_Get_Convergence.restype = ctypes.c_float
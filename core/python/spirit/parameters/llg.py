@@ -186,6 +186,30 @@ def set_iterations(p_state, n_iterations, n_iterations_log, idx_image=-1, idx_ch
     )
 
 
+_LLG_Set_N_Iterations_Amortize = _spirit.Parameters_LLG_Set_N_Iterations_Amortize
+_LLG_Set_N_Iterations_Amortize.argtypes = [
+    ctypes.c_void_p,
+    ctypes.c_int,
+    ctypes.c_int,
+    ctypes.c_int,
+]
+_LLG_Set_N_Iterations_Amortize.restype = None
+
+
+def set_iterations_amortize(p_state, n_iterations_amortize, idx_image=-1, idx_chain=-1):
+    """Set after how many iterations the convergence is checked.
+
+    The torques, the effective field and the observables are only updated after this number
+    of iterations, which saves the corresponding passes over the spins. The simulation may
+    therefore run up to `n_iterations_amortize - 1` iterations past convergence.
+    """
+    _LLG_Set_N_Iterations_Amortize(
+        ctypes.c_void_p(p_state),
+        ctypes.c_int(n_iterations_amortize),
+        ctypes.c_int(idx_image),
+        ctypes.c_int(idx_chain),
+    )
+
 _LLG_Set_Direct_Minimization = _spirit.Parameters_LLG_Set_Direct_Minimization
 _LLG_Set_Direct_Minimization.argtypes = [
     ctypes.c_void_p,
@@ -411,6 +435,19 @@ def get_iterations(p_state, idx_image=-1, idx_chain=-1):
     return int(n_iterations.value), int(n_iterations_log.value)
 
 
+_LLG_Get_N_Iterations_Amortize = _spirit.Parameters_LLG_Get_N_Iterations_Amortize
+_LLG_Get_N_Iterations_Amortize.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+_LLG_Get_N_Iterations_Amortize.restype = ctypes.c_int
+
+
+def get_iterations_amortize(p_state, idx_image=-1, idx_chain=-1):
+    """Returns after how many iterations the convergence is checked."""
+    return int(
+        _LLG_Get_N_Iterations_Amortize(
+            ctypes.c_void_p(p_state), ctypes.c_int(idx_image), ctypes.c_int(idx_chain)
+        )
+    )
+
 _LLG_Get_Direct_Minimization = _spirit.Parameters_LLG_Get_Direct_Minimization
 _LLG_Get_Direct_Minimization.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
 _LLG_Get_Direct_Minimization.restype = ctypes.c_bool
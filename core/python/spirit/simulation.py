@@ -49,6 +49,12 @@ SOLVER_LBFGS_Atlas = 6
 SOLVER_VP_OSO = 7
 """Verlet-like velocity projection method, using exponential transforms."""
 
+SOLVER_NCG = 8
+"""Preconditioned nonlinear conjugate gradients, using exponential transforms."""
+
+SOLVER_NEWTON = 9
+"""Trust-region Newton-Krylov method, using exponential transforms."""
+
 
 METHOD_MC = 0
 """Monte Carlo.
@@ -203,6 +209,9 @@ def start(
     - `single_shot`: if set to `True`, iterations have to be triggered individually
     - `idx_image`: the image on which to run the calculation (default: active image). Not used for GNEB
 
+    The GIL is released while the calculation runs, so that other Python threads can e.g. read
+    the spins in the meantime.
+
     returns a `simulation_run_info` object.
     """
 
@@ -341,6 +350,84 @@ def stop_all(p_state):
     _Stop_All(ctypes.c_void_p(p_state))
 
 
+_Request_Stop = _spirit.Simulation_Request_Stop
+_Request_Stop.argtypes = []
+_Request_Stop.restype = None
+
+
+def request_stop():
+    """Request all running simulations of all states to stop after their current iteration.
+
+    As this only sets an atomic flag, it may be called e.g. from a signal handler.
+    """
+    _Request_Stop()
+
+
+_Write_Checkpoint = _spirit.Simulation_Write_Checkpoint
+_Write_Checkpoint.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_int]
+_Write_Checkpoint.restype = None
+
+
+def write_checkpoint(p_state, filename, idx_image=-1, idx_chain=-1):
+    """Write a checkpoint of the simulation running on an image or chain.
+
+    A simulation resumed from it continues bit-identically (see `resume`).
+    """
+    _Write_Checkpoint(
+        ctypes.c_void_p(p_state),
+        ctypes.c_char_p(filename.encode("utf-8")),
+        ctypes.c_int(idx_image),
+        ctypes.c_int(idx_chain),
+    )
+
+
+_Resume = _spirit.Simulation_Resume
+_Resume.argtypes = [
+    ctypes.c_void_p,
+    ctypes.c_char_p,
+    ctypes.c_int,
+    ctypes.c_int,
+    ctypes.c_bool,
+    ctypes.POINTER(simulation_run_info),
+    ctypes.c_int,
+    ctypes.c_int,
+]
+_Resume.restype = None
+
+
+def resume(
+    p_state,
+    filename,
+    n_iterations=-1,
+    n_iterations_log=-1,
+    single_shot=False,
+    idx_image=-1,
+    idx_chain=-1,
+):
+    """Resume the calculation saved in a checkpoint file.
+
+    The method and solver are taken from the checkpoint. The other arguments are the same as for `start`,
+    where `n_iterations` includes the iterations which were performed before the checkpoint was written.
+
+    returns a `simulation_run_info` object.
+    """
+    info = simulation_run_info()
+    spiritlib.wrap_function(
+        _Resume,
+        [
+            ctypes.c_void_p(p_state),
+            ctypes.c_char_p(filename.encode("utf-8")),
+            ctypes.c_int(n_iterations),
+            ctypes.c_int(n_iterations_log),
+            ctypes.c_bool(single_shot),
+            ctypes.pointer(info),
+            ctypes.c_int(idx_image),
+            ctypes.c_int(idx_chain),
+        ],
+    )
+    return info
+
+
 _Running_On_Image = _spirit.Simulation_Running_On_Image
 _Running_On_Image.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
 _Running_On_Image.restype = ctypes.c_bool
@@ -429,3 +516,48 @@ def get_wall_time(p_state, idx_image=-1, idx_chain=-1):
             ctypes.c_void_p(p_state), ctypes.c_int(idx_image), ctypes.c_int(idx_chain)
         )
     )
+
+
+_Get_N_Timings = _spirit.Simulation_Get_N_Timings
+_Get_N_Timings.argtypes = [ctypes.c_void_p]
+_Get_N_Timings.restype = ctypes.c_int
+
+_Get_Timing_Name = _spirit.Simulation_Get_Timing_Name
+_Get_Timing_Name.argtypes = [ctypes.c_void_p, ctypes.c_int]
+_Get_Timing_Name.restype = ctypes.c_char_p
+
+_Get_Timings = _spirit.Simulation_Get_Timings
+_Get_Timings.argtypes = [
+    ctypes.c_void_p,
+    ctypes.POINTER(ctypes.c_float),
+    ctypes.POINTER(ctypes.c_int),
+]
+_Get_Timings.restype = ctypes.c_bool
+
+
+def get_timings(p_state):
+    """Returns a dictionary of the profiled sections, mapping their names to the accumulated
+    wall time in seconds and the number of calls.
+
+    The dictionary is empty if Spirit was built without `SPIRIT_ENABLE_PROFILING`.
+    """
+    n_timings = int(_Get_N_Timings(ctypes.c_void_p(p_state)))
+    seconds = (ctypes.c_float * n_timings)()
+    calls = (ctypes.c_int * n_timings)()
+    if not _Get_Timings(ctypes.c_void_p(p_state), seconds, calls):
+        return {}
+    timings = {}
+    for i in range(n_timings):
+        name = _Get_Timing_Name(ctypes.c_void_p(p_state), ctypes.c_int(i)).decode("utf-8")
+        timings[name] = (float(seconds[i]), int(calls[i]))
+    return timings
+
+
+_Reset_Timings = _spirit.Simulation_Reset_Timings
+_Reset_Timings.argtypes = [ctypes.c_void_p]
+_Reset_Timings.restype = None
+
+
+def reset_timings(p_state):
+    """Sets the accumulated timings of all profiled sections to zero."""
+    _Reset_Timings(ctypes.c_void_p(p_state))
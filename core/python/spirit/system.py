@@ -9,9 +9,10 @@ import ctypes
 ### Load Library
 _spirit = spiritlib.load_spirit_library()
 
-from spirit.scalar import scalar
+from spirit.scalar import scalar, index
 from spirit import parameters
 from numpy import frombuffer, ndarray as np
+import numpy
 
 ### Get Chain index
 _Get_Index = _spirit.System_Get_Index
@@ -27,7 +28,7 @@ def get_index(p_state):
 ### Get Chain number of images
 _Get_NOS = _spirit.System_Get_NOS
 _Get_NOS.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
-_Get_NOS.restype = ctypes.c_int
+_Get_NOS.restype = index
 
 
 def get_nos(p_state, idx_image=-1, idx_chain=-1):
@@ -63,6 +64,61 @@ def get_spin_directions(p_state, idx_image=-1, idx_chain=-1):
     return array_view
 
 
+### Get a copy of the spin directions, which does not slow down a running simulation
+_Get_Snapshot_NOS = _spirit.System_Get_Snapshot_NOS
+_Get_Snapshot_NOS.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int, ctypes.c_int]
+_Get_Snapshot_NOS.restype = index
+
+_Get_Spin_Snapshot = _spirit.System_Get_Spin_Snapshot
+_Get_Spin_Snapshot.argtypes = [
+    ctypes.c_void_p,
+    ctypes.POINTER(ctypes.c_float),
+    ctypes.c_int,
+    ctypes.c_int,
+    ctypes.c_int,
+]
+_Get_Spin_Snapshot.restype = ctypes.c_long
+
+
+def get_spin_snapshot(p_state, n_cell_step=1, out=None, idx_image=-1, idx_chain=-1):
+    """Returns a `numpy.ndarray` of shape (N, 3) and dtype float32 with the spin directions of
+    every `n_cell_step`-th cell along each translation vector, and the number of the snapshot.
+
+    While a simulation is running, the directions are taken from the latest consistent snapshot
+    published by it, without locking the system. The number of the snapshot increases with every
+    published snapshot, so it can be used to skip unchanged states. It is 0 if the directions
+    were copied from the system, e.g. because no simulation is running.
+
+    An array `out` of the right shape and dtype can be passed to avoid allocations.
+    """
+    nos = int(
+        _Get_Snapshot_NOS(
+            ctypes.c_void_p(p_state),
+            ctypes.c_int(n_cell_step),
+            ctypes.c_int(idx_image),
+            ctypes.c_int(idx_chain),
+        )
+    )
+    if out is None:
+        out = numpy.empty((nos, 3), dtype=numpy.float32)
+    elif (
+        out.shape != (nos, 3)
+        or out.dtype != numpy.float32
+        or not out.flags["C_CONTIGUOUS"]
+    ):
+        raise ValueError(
+            "out has to be a contiguous float32 array of shape {}".format((nos, 3))
+        )
+    n_snapshot = _Get_Spin_Snapshot(
+        ctypes.c_void_p(p_state),
+        out.ctypes.data_as(ctypes.POINTER(ctypes.c_float)),
+        ctypes.c_int(n_cell_step),
+        ctypes.c_int(idx_image),
+        ctypes.c_int(idx_chain),
+    )
+    return out, int(n_snapshot)
+
+
 ### Get Pointer to Effective Field
 # NOTE: Changing the values of the array_view one can alter the value of the data of the state
 _Get_Effective_Field = _spirit.System_Get_Effective_Field
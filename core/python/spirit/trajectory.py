@@ -0,0 +1,225 @@
+"""
+Trajectory
+====================
+
+Reader for Spirit trajectory files, which are written when the output file format
+is `spirit.io.FILEFORMAT_TRAJECTORY` or `spirit.io.FILEFORMAT_TRAJECTORY_QUANTISED`.
+
+A trajectory file stores a series of frames (e.g. the spins of an LLG simulation at
+the output iterations, or the images of a GNEB chain) in compressed blocks.
+An index of the frames is built when the file is opened, so that any frame can be read directly.
+
+This module does not need the Spirit library and can be used for post-processing on
+any machine with `numpy`:
+
+```python
+from spirit import trajectory
+
+with trajectory.Trajectory("output/Image-00_Spins-archive.sptraj") as traj:
+    print(traj.n_frames, traj.nos)
+    spins = traj.read_frame(-1)  # numpy array of shape (nos, 3)
+```
+"""
+
+import struct
+
+import numpy as np
+
+ENCODING_LOSSLESS = 0
+"""The values are stored exactly"""
+
+ENCODING_QUANTISED = 1
+"""Each vector is stored as its direction in 16 bit spherical coordinates"""
+
+_FILE_SIGNATURE = b"SPIRITTR"
+_FRAME_SIGNATURE = b"FRME"
+_FILE_HEADER = struct.Struct("<8sIIIIQ")
+_FRAME_HEADER = struct.Struct("<4sqI")
+_BLOCK_STORED = 0
+_N_VECTORS_PER_BLOCK = 1 << 16
+
+
+def is_trajectory_file(filename):
+    """Returns `True` if the file starts with the Spirit trajectory file signature."""
+    try:
+        with open(filename, "rb") as f:
+            return f.read(len(_FILE_SIGNATURE)) == _FILE_SIGNATURE
+    except OSError:
+        return False
+
+
+def _lz_decompress(data, n_out):
+    """Decompresses a block in the LZ4-style format written by Spirit."""
+    out = bytearray()
+    ip = 0
+    n_in = len(data)
+
+    def read_length(ip, length):
+        byte = 255
+        while byte == 255:
+            byte = data[ip]
+            ip += 1
+            length += byte
+        return ip, length
+
+    while ip < n_in:
+        token = data[ip]
+        ip += 1
+
+        n_literals = token >> 4
+        if n_literals == 15:
+            ip, n_literals = read_length(ip, n_literals)
+        out += data[ip : ip + n_literals]
+        ip += n_literals
+
+        if ip >= n_in:
+            break
+
+        offset = data[ip] | (data[ip + 1] << 8)
+        ip += 2
+        length = token & 0x0F
+        if length == 15:
+            ip, length = read_length(ip, length)
+        length += 4
+
+        start = len(out) - offset
+        if offset >= length:
+            out += out[start : start + length]
+        else:
+            # Overlapping match: the last `offset` bytes are repeated
+            pattern = bytes(out[start:])
+            out += (pattern * (length // offset + 1))[:length]
+
+    if len(out) != n_out:
+        raise ValueError("Compressed trajectory block is corrupt")
+    return bytes(out)
+
+
+class Trajectory:
+    """A Spirit trajectory file, opened for reading.
+
+    Attributes:
+
+    - `n_frames`: number of (complete) frames in the file
+    - `nos`: number of vectors per frame
+    - `encoding`: `ENCODING_LOSSLESS` or `ENCODING_QUANTISED`
+    - `iterations`: list of the iterations at which the frames were written
+    """
+
+    def __init__(self, filename):
+        self.filename = filename
+        self._file = open(filename, "rb")
+        header = self._file.read(_FILE_HEADER.size)
+        if len(header) < _FILE_HEADER.size:
+            raise ValueError("File '{}' is not a Spirit trajectory file".format(filename))
+        (
+            signature,
+            version,
+            self.encoding,
+            self._value_size,
+            self._valuedim,
+            self.nos,
+        ) = _FILE_HEADER.unpack(header)
+        if signature != _FILE_SIGNATURE:
+            raise ValueError("File '{}' is not a Spirit trajectory file".format(filename))
+        if version != 1:
+            raise ValueError("Trajectory file '{}' has unsupported version {}".format(filename, version))
+
+        if self.encoding == ENCODING_QUANTISED:
+            self._dtype = np.dtype("<u2")
+            self._values_per_vector = 2
+        else:
+            self._dtype = np.dtype("<f{}".format(self._value_size))
+            self._values_per_vector = 3
+
+        self._frames = []
+        self.iterations = []
+        self._read_index()
+
+    def _read_index(self):
+        self._file.seek(0, 2)
+        file_size = self._file.tell()
+        offset = _FILE_HEADER.size
+        while offset + _FRAME_HEADER.size <= file_size:
+            self._file.seek(offset)
+            signature, iteration, n_blocks = _FRAME_HEADER.unpack(self._file.read(_FRAME_HEADER.size))
+            if signature != _FRAME_SIGNATURE:
+                break
+            sizes_bytes = self._file.read(4 * n_blocks)
+            if len(sizes_bytes) < 4 * n_blocks:
+                break
+            block_sizes = struct.unpack("<{}I".format(n_blocks), sizes_bytes)
+            data_offset = offset + _FRAME_HEADER.size + 4 * n_blocks
+            if data_offset + sum(block_sizes) > file_size:
+                # Incomplete last frame
+                break
+            self._frames.append((data_offset, block_sizes))
+            self.iterations.append(iteration)
+            offset = data_offset + sum(block_sizes)
+
+    @property
+    def n_frames(self):
+        return len(self._frames)
+
+    def __len__(self):
+        return self.n_frames
+
+    def __getitem__(self, index):
+        return self.read_frame(index)
+
+    def __iter__(self):
+        for i in range(self.n_frames):
+            yield self.read_frame(i)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def close(self):
+        """Closes the file."""
+        self._file.close()
+
+    def read_frame(self, index):
+        """Returns the vectors of the given frame as a numpy array of shape `(nos, 3)`.
+        Negative indices count from the end.
+        """
+        if index < 0:
+            index += self.n_frames
+        if index < 0 or index >= self.n_frames:
+            raise IndexError("Trajectory contains {} frames".format(self.n_frames))
+
+        data_offset, block_sizes = self._frames[index]
+        self._file.seek(data_offset)
+        data = self._file.read(sum(block_sizes))
+
+        result = np.empty((self.nos, 3), dtype=np.float64)
+        position = 0
+        for iblock, block_size in enumerate(block_sizes):
+            begin = iblock * _N_VECTORS_PER_BLOCK
+            n = min(_N_VECTORS_PER_BLOCK, self.nos - begin)
+            n_values = n * self._values_per_vector
+            n_bytes = n_values * self._value_size
+
+            block = data[position : position + block_size]
+            position += block_size
+            if block[0] == _BLOCK_STORED:
+                shuffled = block[1:]
+            else:
+                shuffled = _lz_decompress(block[1:], n_bytes)
+
+            # Undo the byte-shuffle: byte k of all values is stored contiguously
+            raw = np.frombuffer(shuffled, dtype=np.uint8).reshape(self._value_size, n_values).T.copy()
+            values = raw.view(self._dtype).reshape(n, self._values_per_vector)
+
+            if self.encoding == ENCODING_QUANTISED:
+                theta = values[:, 0] * (np.pi / 65535)
+                phi = values[:, 1] * (2 * np.pi / 65536) - np.pi
+                result[begin : begin + n, 0] = np.sin(theta) * np.cos(phi)
+                result[begin : begin + n, 1] = np.sin(theta) * np.sin(phi)
+                result[begin : begin + n, 2] = np.cos(theta)
+            else:
+                result[begin : begin + n] = values
+
+        return result
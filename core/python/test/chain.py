@@ -9,6 +9,7 @@ from spirit import state
 from spirit import chain
 from spirit import system
 
+import numpy as np
 import unittest
 
 ##########
@@ -184,6 +185,43 @@ class remove_TestChain(TestChain):
         self.assertEqual(system.get_index(self.p_state), 1)  # active is 1st
 
 
+class arrays_TestChain(TestChain):
+    def test_spin_directions(self):
+        chain.insert_image_after(self.p_state)
+        chain.insert_image_after(self.p_state)
+        noi = chain.get_noi(self.p_state)
+        nos = system.get_nos(self.p_state)
+
+        spins = chain.get_spin_directions(self.p_state)
+        self.assertEqual(spins.shape, (noi, nos, 3))
+
+        # Every image gets a different direction, which is normalized
+        for i in range(noi):
+            spins[i, :, :] = [0, i + 1, 1]
+        chain.set_spin_directions(self.p_state, spins)
+
+        out = np.zeros_like(spins)
+        result = chain.get_spin_directions(self.p_state, out=out)
+        self.assertIs(result, out)
+        for i in range(noi):
+            direction = np.array([0, i + 1, 1]) / np.sqrt((i + 1) ** 2 + 1)
+            self.assertTrue(np.allclose(out[i], direction))
+            # The same data is seen through the view of the image
+            view = system.get_spin_directions(self.p_state, idx_image=i)
+            self.assertTrue(np.array_equal(view, out[i]))
+
+    def test_wrong_shape(self):
+        with self.assertRaises(ValueError):
+            chain.set_spin_directions(self.p_state, np.zeros((2, 3)))
+
+    def test_energies(self):
+        chain.insert_image_after(self.p_state)
+        chain.update_data(self.p_state)
+        energies = chain.get_energy(self.p_state)
+        self.assertEqual(energies.shape, (2,))
+        self.assertAlmostEqual(energies[0], system.get_energy(self.p_state, 0), 2)
+
+
 # class getters_TestChain(TestChain):
 
 #     # TODO: a proper way to test Rx and E values
@@ -234,6 +272,7 @@ def suite():
     suite.addTest(unittest.makeSuite(jump_TestChain))
     suite.addTest(unittest.makeSuite(replace_TestChain))
     suite.addTest(unittest.makeSuite(remove_TestChain))
+    suite.addTest(unittest.makeSuite(arrays_TestChain))
     # suite.addTest( unittest.makeSuite( getters_TestChain ) )
     # suite.addTest( unittest.makeSuite( data_TestChain ) )
     return suite
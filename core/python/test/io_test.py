@@ -5,7 +5,7 @@ import sys
 spirit_py_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
 sys.path.insert(0, spirit_py_dir)
 
-from spirit import state, chain, system, io, configuration, simulation
+from spirit import state, chain, system, io, configuration, simulation, trajectory
 
 import unittest
 
@@ -14,6 +14,7 @@ import unittest
 cfgfile = spirit_py_dir + "/../test/input/fd_pairs.cfg"  # Input File
 io_image_test = spirit_py_dir + "/test/io_test_files/io_image_test"
 io_chain_test = spirit_py_dir + "/test/io_test_files/io_chain_test"
+io_trajectory_test = spirit_py_dir + "/test/io_test_files/io_trajectory_test.sptraj"
 
 p_state = state.setup(cfgfile)  # State setup
 
@@ -109,6 +110,38 @@ class Chain_IO(TestParameters):
         )
 
 
+class Trajectory_IO(TestParameters):
+    def test_read(self):
+        # plus_z compresses well, a random configuration hardly at all
+        configuration.plus_z(self.p_state)
+        io.image_write(self.p_state, io_trajectory_test, io.FILEFORMAT_TRAJECTORY)
+        spins_0 = system.get_spin_directions(self.p_state).copy()
+        configuration.random(self.p_state)
+        io.image_append(self.p_state, io_trajectory_test, io.FILEFORMAT_TRAJECTORY)
+        spins_1 = system.get_spin_directions(self.p_state).copy()
+
+        self.assertEqual(io.n_images_in_file(self.p_state, io_trajectory_test), 2)
+
+        with trajectory.Trajectory(io_trajectory_test) as traj:
+            self.assertEqual(traj.n_frames, 2)
+            self.assertEqual(traj.nos, system.get_nos(self.p_state))
+            self.assertEqual(traj.iterations, [0, 1])
+            self.assertTrue((traj.read_frame(0) == spins_0).all())
+            self.assertTrue((traj.read_frame(-1) == spins_1).all())
+
+    def test_read_quantised(self):
+        configuration.random(self.p_state)
+        io.image_write(
+            self.p_state, io_trajectory_test, io.FILEFORMAT_TRAJECTORY_QUANTISED
+        )
+        spins = system.get_spin_directions(self.p_state)
+
+        self.assertTrue(trajectory.is_trajectory_file(io_trajectory_test))
+        with trajectory.Trajectory(io_trajectory_test) as traj:
+            self.assertEqual(traj.encoding, trajectory.ENCODING_QUANTISED)
+            self.assertLess(abs(traj.read_frame(0) - spins).max(), 1e-4)
+
+
 #########
 
 
@@ -117,6 +150,7 @@ def suite():
     suite.addTest(unittest.makeSuite(Image_IO))
     suite.addTest(unittest.makeSuite(Eigenmodes_IO))
     suite.addTest(unittest.makeSuite(Chain_IO))
+    suite.addTest(unittest.makeSuite(Trajectory_IO))
     return suite
 
 
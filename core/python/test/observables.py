@@ -0,0 +1,111 @@
+import os
+import sys
+
+# spirit_py_dir = os.path.dirname(os.path.realpath(__file__))
+spirit_py_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, spirit_py_dir)
+
+from spirit import state, observables, simulation, configuration, quantities, hamiltonian
+
+import unittest
+
+##########
+
+cfgfile = spirit_py_dir + "/../test/input/api.cfg"  # Input File
+
+p_state = state.setup(cfgfile)  # State setup
+hamiltonian.set_field(p_state, 5, [1, 0, 0])  # So that the spins precess
+
+
+class TestParameters(unittest.TestCase):
+    def setUp(self):
+        """Setup a p_state and copy it to Clipboard"""
+        self.p_state = p_state
+        observables.clear(self.p_state)
+
+
+class Observables_Setup(TestParameters):
+    def test_step(self):
+        observables.set_step(self.p_state, 5)
+        self.assertEqual(observables.get_step(self.p_state), 5)
+        observables.set_step(self.p_state, 1)
+
+    def test_empty(self):
+        configuration.random(self.p_state)
+        simulation.start(
+            self.p_state,
+            simulation.METHOD_LLG,
+            simulation.SOLVER_SIB,
+            n_iterations=4,
+        )
+        self.assertEqual(observables.get_n_samples(self.p_state), 0)
+        labels, samples = observables.get_samples(self.p_state)
+        self.assertEqual(len(labels), 0)
+        self.assertEqual(samples.size, 0)
+
+
+class Observables_Sampling(TestParameters):
+    def test_time_series(self):
+        observables.add(self.p_state, observables.MAGNETIZATION)
+        observables.add(self.p_state, observables.ENERGY)
+        observables.add_correlation(self.p_state, [0, 0, 0])
+        observables.set_step(self.p_state, 2)
+
+        configuration.random(self.p_state)
+        simulation.start(
+            self.p_state,
+            simulation.METHOD_LLG,
+            simulation.SOLVER_SIB,
+            n_iterations=9,
+        )
+
+        labels, samples = observables.get_samples(self.p_state)
+        self.assertEqual(labels[:5], ["iteration", "time", "m_x", "m_y", "m_z"])
+        self.assertIn("E", labels)
+        self.assertEqual(labels[-1], "S(0,0,0)")
+        self.assertEqual(samples.shape, (5, len(labels)))
+        self.assertEqual(list(samples[:, 0]), [0, 2, 4, 6, 8])
+
+        # The last sample matches the final state
+        M = quantities.get_magnetization(self.p_state)
+        for i in range(3):
+            self.assertAlmostEqual(samples[-1, 2 + i], M[i], places=4)
+
+    def test_capacity(self):
+        observables.add(self.p_state, observables.MAX_TORQUE)
+        observables.set_capacity(self.p_state, 3)
+
+        configuration.random(self.p_state)
+        simulation.start(
+            self.p_state,
+            simulation.METHOD_LLG,
+            simulation.SOLVER_SIB,
+            n_iterations=10,
+        )
+
+        labels, samples = observables.get_samples(self.p_state)
+        self.assertEqual(labels, ["iteration", "time", "max_torque"])
+        self.assertEqual(observables.get_n_samples(self.p_state), 3)
+        self.assertEqual(list(samples[:, 0]), [7, 8, 9])
+        observables.set_capacity(self.p_state, 10000)
+
+
+#########
+
+
+def suite():
+    suite = unittest.TestSuite()
+    suite.addTest(unittest.makeSuite(Observables_Setup))
+    suite.addTest(unittest.makeSuite(Observables_Sampling))
+    return suite
+
+
+if __name__ == "__main__":
+    suite = suite()
+
+    runner = unittest.TextTestRunner()
+    success = runner.run(suite).wasSuccessful()
+
+    state.delete(p_state)  # Delete State
+
+    sys.exit(not success)
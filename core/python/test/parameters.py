@@ -34,6 +34,12 @@ class LLG_set_get(TestParameters):
         self.assertEqual(N_set, N_get)
         self.assertEqual(Nlog_set, Nlog_get)
 
+    def test_LLG_N_iterations_amortize(self):
+        parameters.llg.set_iterations_amortize(self.p_state, 10)  # try set
+        self.assertEqual(parameters.llg.get_iterations_amortize(self.p_state), 10)  # try get
+        parameters.llg.set_iterations_amortize(self.p_state, 0)  # at least one iteration
+        self.assertEqual(parameters.llg.get_iterations_amortize(self.p_state), 1)
+
     def test_LLG_direct_minimization(self):
         parameters.llg.set_direct_minimization(self.p_state, True)  # try set
         ret = parameters.llg.get_direct_minimization(self.p_state)  # try get
@@ -94,6 +100,11 @@ class GNEB_set_get(TestParameters):
         self.assertEqual(N_set, N_get)
         self.assertEqual(Nlog_set, Nlog_get)
 
+    def test_GNEB_N_Iterations_Amortize(self):
+        parameters.gneb.set_iterations_amortize(self.p_state, 10)  # try set
+        self.assertEqual(parameters.gneb.get_iterations_amortize(self.p_state), 10)  # try get
+        parameters.gneb.set_iterations_amortize(self.p_state, 1)
+
     def test_GNEB_Convergence(self):
         conv_set = 1.5e-3
         parameters.gneb.set_convergence(self.p_state, conv_set)  # try set
@@ -61,6 +61,23 @@ class Simulation_Running(TestParameters):
         self.assertFalse(simulation.running_anywhere_on_chain(self.p_state))
 
 
+class Simulation_Profiling(TestParameters):
+    def test_timings(self):
+        simulation.reset_timings(self.p_state)
+        configuration.plus_z(self.p_state)
+        simulation.start(self.p_state, LLG, SIB, n_iterations=10)
+        timings = simulation.get_timings(self.p_state)
+        # Without profiling compiled in, there are no timings
+        for name, (seconds, calls) in timings.items():
+            self.assertTrue(len(name) > 0)
+            self.assertTrue(seconds >= 0)
+        if timings:
+            self.assertEqual(timings["iteration"][1], 10)
+            simulation.reset_timings(self.p_state)
+            timings = simulation.get_timings(self.p_state)
+            self.assertEqual(timings["iteration"], (0.0, 0))
+
+
 #########
 
 
@@ -68,6 +85,7 @@ def suite():
     suite = unittest.TestSuite()
     suite.addTest(unittest.makeSuite(Simulation_StartStop))
     suite.addTest(unittest.makeSuite(Simulation_Running))
+    suite.addTest(unittest.makeSuite(Simulation_Profiling))
     return suite
 
 
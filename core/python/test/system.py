@@ -39,6 +39,22 @@ class SystemGetters(TestSystem):
             self.assertAlmostEqual(arr[i][1], 0.0)
             self.assertAlmostEqual(arr[i][2], 1.0)
 
+    def test_get_spin_snapshot(self):
+        configuration.random(self.p_state)
+        spins = system.get_spin_directions(self.p_state)
+        snapshot, n_snapshot = system.get_spin_snapshot(self.p_state)
+        # Without a running simulation, the spins are copied directly
+        self.assertEqual(n_snapshot, 0)
+        self.assertEqual(snapshot.shape, spins.shape)
+        for i in range(snapshot.shape[0]):
+            for j in range(3):
+                self.assertAlmostEqual(snapshot[i][j], spins[i][j], places=6)
+        # A preallocated array is reused
+        out, _ = system.get_spin_snapshot(self.p_state, out=snapshot)
+        self.assertIs(out, snapshot)
+        with self.assertRaises(ValueError):
+            system.get_spin_snapshot(self.p_state, out=snapshot[:1])
+
     def test_get_energy(self):
         # NOTE: that test is trivial
         E = system.get_energy(self.p_state)
@@ -10,6 +10,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 int Chain_Get_NOI( State * state, int idx_chain ) noexcept
 try
 {
@@ -35,9 +37,9 @@ try
     ++chain->idx_active_image;
     State_Update( state );
 
-    Log( Utility::Log_Level::Debug, Utility::Log_Sender::API,
-         fmt::format( "Switched to next image {} of {}", chain->idx_active_image + 1, chain->noi ),
-         chain->idx_active_image, idx_chain );
+    Log.SendFormatted(
+        Utility::Log_Level::Debug, Utility::Log_Sender::API, chain->idx_active_image, idx_chain,
+        "Switched to next image {} of {}", chain->idx_active_image + 1, chain->noi );
 
     return true;
 }
@@ -62,9 +64,9 @@ try
     {
         --chain->idx_active_image;
         State_Update( state );
-        Log( Utility::Log_Level::Debug, Utility::Log_Sender::API,
-             fmt::format( "Switched to previous image {} of {}", chain->idx_active_image + 1, chain->noi ),
-             chain->idx_active_image, idx_chain );
+        Log.SendFormatted(
+            Utility::Log_Level::Debug, Utility::Log_Sender::API, chain->idx_active_image, idx_chain,
+            "Switched to previous image {} of {}", chain->idx_active_image + 1, chain->noi );
         return true;
     }
     else
@@ -92,8 +94,9 @@ try
     chain->idx_active_image = idx_image;
     State_Update( state );
 
-    Log( Utility::Log_Level::Debug, Utility::Log_Sender::API,
-         fmt::format( "Jumped to image {} of {}", chain->idx_active_image + 1, chain->noi ), idx_image, idx_chain );
+    Log.SendFormatted(
+        Utility::Log_Level::Debug, Utility::Log_Sender::API, idx_image, idx_chain, "Jumped to image {} of {}",
+        chain->idx_active_image + 1, chain->noi );
 
     return true;
 }
@@ -659,6 +662,87 @@ catch( ... )
     spirit_handle_exception_api( -1, idx_chain );
 }
 
+void Chain_Get_Spin_Directions( State * state, scalar * spins, int idx_chain ) noexcept
+try
+{
+    int idx_image = -1;
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    chain->Lock();
+    for( const auto & system : chain->images )
+    {
+        const auto & directions = *system->spins;
+        std::copy( directions[0].data(), directions[0].data() + 3 * directions.size(), spins );
+        spins += 3 * directions.size();
+    }
+    chain->Unlock();
+}
+catch( ... )
+{
+    spirit_handle_exception_api( -1, idx_chain );
+}
+
+void Chain_Set_Spin_Directions( State * state, const scalar * spins, int idx_chain ) noexcept
+try
+{
+    int idx_image = -1;
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    chain->Lock();
+    for( auto & system : chain->images )
+    {
+        auto & directions = *system->spins;
+        for( auto & direction : directions )
+        {
+            direction = Vector3{ spins[0], spins[1], spins[2] };
+            // Vacancies may have zero length
+            if( direction.squaredNorm() > 0 )
+                direction.normalize();
+            spins += 3;
+        }
+    }
+    chain->Unlock();
+
+    Log( Utility::Log_Level::Info, Utility::Log_Sender::API,
+         fmt::format( "Set the spin directions of {} images", chain->noi ), -1, idx_chain );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( -1, idx_chain );
+}
+
+void Chain_Get_Effective_Fields( State * state, scalar * fields, int idx_chain ) noexcept
+try
+{
+    int idx_image = -1;
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    chain->Lock();
+    for( const auto & system : chain->images )
+    {
+        const auto & field = system->effective_field;
+        std::copy( field[0].data(), field[0].data() + 3 * field.size(), fields );
+        fields += 3 * field.size();
+    }
+    chain->Unlock();
+}
+catch( ... )
+{
+    spirit_handle_exception_api( -1, idx_chain );
+}
+
 std::vector<std::vector<float>> Chain_Get_Energy_Array_Interpolated( State * state, int idx_chain ) noexcept
 try
 {
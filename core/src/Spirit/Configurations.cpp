@@ -439,15 +439,15 @@ try
     {
         image->Lock();
 
-        auto & spins = *image->spins;
-        auto & mode  = *image->modes[idx_mode];
-        int nos      = spins.size();
+        auto & spins     = *image->spins;
+        auto & mode      = *image->modes[idx_mode];
+        spirit_index nos = spins.size();
 
         scalarfield angles( nos );
         vectorfield axes( nos );
 
         // Find the angles and axes of rotation
-        for( int idx = 0; idx < image->nos; idx++ )
+        for( spirit_index idx = 0; idx < image->nos; idx++ )
         {
             angles[idx] = mode[idx].norm();
             axes[idx]   = spins[idx].cross( mode[idx] ).normalized();
@@ -713,6 +713,7 @@ try
 
     // Apply configuration
     image->Lock();
+    image->Unshare_Hamiltonian();
     Utility::Configurations::Set_Pinned( *image, pinned, filter );
     image->Unlock();
 
@@ -746,6 +747,7 @@ try
 
     // Apply configuration
     image->Lock();
+    image->Unshare_Hamiltonian();
     Utility::Configurations::Set_Atom_Types( *image, atom_type, filter );
     image->Unlock();
 
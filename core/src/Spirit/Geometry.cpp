@@ -12,10 +12,12 @@
 
 void Helper_System_Set_Geometry( Data::Spin_System & system, const Data::Geometry & new_geometry )
 {
+    system.Unshare_Hamiltonian();
+
     auto old_geometry = *system.geometry;
 
-    int nos    = new_geometry.nos;
-    system.nos = nos;
+    spirit_index nos = new_geometry.nos;
+    system.nos       = nos;
 
     // Move the vector-fields to the new geometry
     *system.spins = Engine::Vectormath::change_dimensions(
@@ -57,7 +59,7 @@ void Helper_State_Set_Geometry(
     state.chain->Unlock();
 
     // Retrieve total number of spins
-    int nos = state.active_image->nos;
+    spirit_index nos = state.active_image->nos;
 
     // Update convenience integerin State
     state.nos = nos;
@@ -452,7 +454,7 @@ catch( ... )
     spirit_handle_exception_api( 0, 0 );
 }
 
-int Geometry_Get_NOS( State * state ) noexcept
+spirit_index Geometry_Get_NOS( State * state ) noexcept
 {
     check_state( state );
     return state->nos;
@@ -19,6 +19,9 @@ try
     info.minimum      = image_minimum;
     info.saddle_point = image_sp;
 
+    image_minimum->Unshare_Hamiltonian();
+    image_sp->Unshare_Hamiltonian();
+
 #ifndef SPIRIT_SKIP_HTST
     if( !sparse )
         Engine::HTST::Calculate( chain->htst_info, n_eigenmodes_keep );
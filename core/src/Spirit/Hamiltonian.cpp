@@ -32,6 +32,8 @@ try
     image->Lock();
     try
     {
+        image->Unshare_Hamiltonian();
+
         image->hamiltonian->boundary_conditions[0] = periodical[0];
         image->hamiltonian->boundary_conditions[1] = periodical[1];
         image->hamiltonian->boundary_conditions[2] = periodical[2];
@@ -66,6 +68,8 @@ try
 
     try
     {
+        image->Unshare_Hamiltonian();
+
         // Set
         if( image->hamiltonian->Name() == "Heisenberg" )
         {
@@ -118,10 +122,12 @@ try
 
     try
     {
+        image->Unshare_Hamiltonian();
+
         if( image->hamiltonian->Name() == "Heisenberg" )
         {
             auto * ham       = dynamic_cast<Engine::Hamiltonian_Heisenberg *>( image->hamiltonian.get() );
-            int nos          = image->nos;
+            spirit_index nos = image->nos;
             int n_cell_atoms = image->geometry->n_cell_atoms;
 
             // Indices and Magnitudes
@@ -179,10 +185,12 @@ try
 
     try
     {
+        image->Unshare_Hamiltonian();
+
         if( image->hamiltonian->Name() == "Heisenberg" )
         {
             auto * ham       = dynamic_cast<Engine::Hamiltonian_Heisenberg *>( image->hamiltonian.get() );
-            int nos          = image->nos;
+            spirit_index nos = image->nos;
             int n_cell_atoms = image->geometry->n_cell_atoms;
 
             // Indices and Magnitudes
@@ -233,6 +241,8 @@ try
 
     try
     {
+        image->Unshare_Hamiltonian();
+
         if( image->hamiltonian->Name() == "Heisenberg" )
         {
             // Update the Hamiltonian
@@ -284,6 +294,8 @@ try
 
     try
     {
+        image->Unshare_Hamiltonian();
+
         if( image->hamiltonian->Name() == "Heisenberg" )
         {
             // Update the Hamiltonian
@@ -330,6 +342,8 @@ try
 
     try
     {
+        image->Unshare_Hamiltonian();
+
         if( image->hamiltonian->Name() == "Heisenberg" )
         {
             auto * ham = dynamic_cast<Engine::Hamiltonian_Heisenberg *>( image->hamiltonian.get() );
@@ -718,7 +732,10 @@ void Hamiltonian_Write_Hessian(
     // Compute hessian
     auto nos = image->geometry->nos;
     SpMatrixX hessian( 3 * nos, 3 * nos );
+    image->Lock();
+    image->Unshare_Hamiltonian();
     image->hamiltonian->Sparse_Hessian( *image->spins, hessian );
+    image->Unlock();
 
     if( triplet_format )
         saveTriplets( std::string( filename ), hessian );
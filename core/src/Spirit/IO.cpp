@@ -9,6 +9,7 @@
 #include <io/Filter_File_Handle.hpp>
 #include <io/IO.hpp>
 #include <io/OVF_File.hpp>
+#include <io/Trajectory_File.hpp>
 #include <utility/Exception.hpp>
 #include <utility/Logging.hpp>
 #include <utility/Version.hpp>
@@ -165,6 +166,9 @@ catch( ... )
 int IO_N_Images_In_File( State * state, const char * filename, int idx_image, int idx_chain ) noexcept
 try
 {
+    if( IO::Trajectory_File::is_trajectory_file( filename ) )
+        return IO::Trajectory_File( filename, true ).n_frames();
+
     auto file = IO::OVF_File( filename );
 
     if( file.is_ovf )
@@ -172,7 +176,7 @@ try
     else
     {
         Log( Utility::Log_Level::Warning, Utility::Log_Sender::API,
-             fmt::format( "File \"{}\" is not OVF. Cannot measure number of images.", filename ), idx_image,
+             fmt::format( "File \"{}\" is neither OVF nor a trajectory file. Cannot measure number of images.", filename ), idx_image,
              idx_chain );
         return -1;
     }
@@ -203,6 +207,25 @@ try
         auto & spins    = *image->spins;
         auto & geometry = *image->geometry;
 
+        if( IO::Trajectory_File::is_trajectory_file( filename ) )
+        {
+            auto trajectory = IO::Trajectory_File( filename, true );
+            if( trajectory.nos() != image->nos )
+            {
+                Log( Utility::Log_Level::Warning, Utility::Log_Sender::API,
+                     fmt::format(
+                         "Trajectory file \"{}\" contains {} spins per frame while the system contains {}.",
+                         filename, trajectory.nos(), image->nos ),
+                     idx_image_inchain, idx_chain );
+            }
+            trajectory.read_frame( idx_image_infile, spins );
+            Log( Utility::Log_Level::Info, Utility::Log_Sender::API,
+                 fmt::format( "Read frame {} from trajectory file \"{}\"", idx_image_infile, filename ),
+                 idx_image_inchain, idx_chain );
+            image->Unlock();
+            return;
+        }
+
         // Open
         auto file = IO::OVF_File( filename, true );
 
@@ -237,7 +260,7 @@ try
                      "OVF file \"{}\": segment {}/{} contains only {} spins while the system contains {}.", filename,
                      idx_image_infile + 1, file.n_segments, segment.N, image->nos ),
                  idx_image_inchain, idx_chain );
-            segment.N = std::min( segment.N, image->nos );
+            segment.N = int( std::min<spirit_index>( segment.N, image->nos ) );
         }
         else if( segment.N > image->nos )
         {
@@ -247,7 +270,7 @@ try
                      "Reading only part of the segment data.",
                      filename, idx_image_infile + 1, file.n_segments, segment.N, image->nos ),
                  idx_image_inchain, idx_chain );
-            segment.N = std::min( segment.N, image->nos );
+            segment.N = int( std::min<spirit_index>( segment.N, image->nos ) );
         }
 
         if( segment.valuedim != 3 )
@@ -305,7 +328,9 @@ try
 
     try
     {
-        if( Get_Extension( filename ) != ".ovf" )
+        auto fileformat = (IO::VF_FileFormat)format;
+
+        if( !IO::is_trajectory( fileformat ) && Get_Extension( filename ) != ".ovf" )
             Log( Utility::Log_Level::Warning, Utility::Log_Sender::API,
                  fmt::format(
                      "The file \"{}\" is written in OVF format but has different extension. "
@@ -313,9 +338,19 @@ try
                      filename ),
                  idx_image, idx_chain );
 
-        auto fileformat = (IO::VF_FileFormat)format;
         switch( fileformat )
         {
+            case IO::VF_FileFormat::SPIRIT_TRAJECTORY:
+            case IO::VF_FileFormat::SPIRIT_TRAJECTORY_QUANTISED:
+            {
+                IO::Trajectory_File( filename ).write_frame( *image->spins, 0, IO::trajectory_encoding( fileformat ) );
+
+                Log( Utility::Log_Level::Info, Utility::Log_Sender::API,
+                     fmt::format( "Wrote spins to file \"{}\" in {} format", filename, str( fileformat ) ), idx_image,
+                     idx_chain );
+
+                break;
+            }
             case IO::VF_FileFormat::OVF_BIN:
             case IO::VF_FileFormat::OVF_BIN4:
             case IO::VF_FileFormat::OVF_BIN8:
@@ -378,6 +413,17 @@ try
         auto fileformat = static_cast<IO::VF_FileFormat>( format );
         switch( fileformat )
         {
+            case IO::VF_FileFormat::SPIRIT_TRAJECTORY:
+            case IO::VF_FileFormat::SPIRIT_TRAJECTORY_QUANTISED:
+            {
+                // Open
+                auto file = IO::Trajectory_File( filename );
+
+                // Frames appended through the API are labelled by their index in the file
+                file.append_frame( *image->spins, file.n_frames(), IO::trajectory_encoding( fileformat ) );
+
+                break;
+            }
             case IO::VF_FileFormat::OVF_BIN:
             case IO::VF_FileFormat::OVF_BIN4:
             case IO::VF_FileFormat::OVF_BIN8:
@@ -473,10 +519,12 @@ try
 
         // Open
         IO::OVF_File file( filename, true );
+        const bool is_trajectory = IO::Trajectory_File::is_trajectory_file( filename );
+        IO::Trajectory_File trajectory( filename );
 
-        if( file.is_ovf )
+        if( file.is_ovf || is_trajectory )
         {
-            int noi_infile = file.n_segments;
+            int noi_infile = is_trajectory ? trajectory.n_frames() : file.n_segments;
 
             if( start_image_infile < 0 )
                 start_image_infile = 0;
@@ -525,6 +573,13 @@ try
                 auto & spins    = *images[i]->spins;
                 auto & geometry = *images[i]->geometry;
 
+                if( is_trajectory )
+                {
+                    trajectory.read_frame( start_image_infile, spins );
+                    start_image_infile++;
+                    continue;
+                }
+
                 // Segment header
                 auto segment = IO::OVF_Segment();
 
@@ -542,7 +597,7 @@ try
                              "OVF file \"{}\": segment {}/{} contains only {} spins while the system contains {}.",
                              filename, start_image_infile + 1, file.n_segments, segment.N, image->nos ),
                          i, idx_chain );
-                    segment.N = std::min( segment.N, image->nos );
+                    segment.N = int( std::min<spirit_index>( segment.N, image->nos ) );
                 }
                 else if( segment.N > image->nos )
                 {
@@ -552,7 +607,7 @@ try
                              "Reading only part of the segment data.",
                              filename, start_image_infile + 1, file.n_segments, segment.N, image->nos ),
                          i, idx_chain );
-                    segment.N = std::min( segment.N, image->nos );
+                    segment.N = int( std::min<spirit_index>( segment.N, image->nos ) );
                 }
 
                 if( segment.valuedim != 3 )
@@ -567,7 +622,7 @@ try
                 // Read data
                 file.read_segment_data( start_image_infile, segment, spins[0].data() );
 
-                for( int ispin = 0; ispin < spins.size(); ++ispin )
+                for( spirit_index ispin = 0; ispin < spins.size(); ++ispin )
                 {
                     if( spins[ispin].norm() < 1e-5 )
                     {
@@ -667,6 +722,20 @@ try
 
         switch( fileformat )
         {
+            case IO::VF_FileFormat::SPIRIT_TRAJECTORY:
+            case IO::VF_FileFormat::SPIRIT_TRAJECTORY_QUANTISED:
+            {
+                auto & images = chain->images;
+                auto file     = IO::Trajectory_File( filename );
+                auto encoding = IO::trajectory_encoding( fileformat );
+
+                // Each image is stored as a frame, labelled by its index in the chain
+                file.write_frame( *images[0]->spins, 0, encoding );
+                for( int i = 1; i < chain->noi; i++ )
+                    file.append_frame( *images[i]->spins, i, encoding );
+
+                break;
+            }
             case IO::VF_FileFormat::OVF_BIN:
             case IO::VF_FileFormat::OVF_BIN4:
             case IO::VF_FileFormat::OVF_BIN8:
@@ -745,6 +814,18 @@ try
         auto fileformat = (IO::VF_FileFormat)format;
         switch( fileformat )
         {
+            case IO::VF_FileFormat::SPIRIT_TRAJECTORY:
+            case IO::VF_FileFormat::SPIRIT_TRAJECTORY_QUANTISED:
+            {
+                auto & images = chain->images;
+                auto file     = IO::Trajectory_File( filename );
+                auto encoding = IO::trajectory_encoding( fileformat );
+
+                for( int i = 0; i < chain->noi; i++ )
+                    file.append_frame( *images[i]->spins, i, encoding );
+
+                break;
+            }
             case IO::VF_FileFormat::OVF_BIN:
             case IO::VF_FileFormat::OVF_BIN4:
             case IO::VF_FileFormat::OVF_BIN8:
@@ -865,13 +946,14 @@ try
     auto & spins  = *image->spins;
 
     // Gather the data
+    system.Unshare_Hamiltonian();
     std::vector<std::pair<std::string, scalarfield>> contributions_spins( 0 );
     system.UpdateEnergy();
     system.hamiltonian->Energy_Contributions_per_Spin( spins, contributions_spins );
     int dataperspin = 1 + contributions_spins.size();
     int datasize    = dataperspin * system.nos;
     scalarfield data( datasize, 0 );
-    for( int ispin = 0; ispin < system.nos; ++ispin )
+    for( spirit_index ispin = 0; ispin < system.nos; ++ispin )
     {
         scalar E_spin = 0;
         int j         = 1;
@@ -1099,7 +1181,7 @@ try
                          "OVF file \"{}\": segment {}/{} contains only {} vectors while the system contains {}.",
                          filename, idx + 1, file.n_segments, segment.N, image->nos ),
                      idx_image_inchain, idx_chain );
-                segment.N = std::min( segment.N, image->nos );
+                segment.N = int( std::min<spirit_index>( segment.N, image->nos ) );
             }
             else if( segment.N > image->nos )
             {
@@ -1109,7 +1191,7 @@ try
                          "Reading only part of the segment data.",
                          filename, idx + 1, file.n_segments, segment.N, image->nos ),
                      idx_image_inchain, idx_chain );
-                segment.N = std::min( segment.N, image->nos );
+                segment.N = int( std::min<spirit_index>( segment.N, image->nos ) );
             }
 
             if( segment.valuedim != 3 )
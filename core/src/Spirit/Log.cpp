@@ -19,11 +19,11 @@ catch( ... )
     spirit_handle_exception_api( idx_image, idx_chain );
 }
 
-std::vector<Utility::LogEntry> Log_Get_Entries( State * state ) noexcept
+std::vector<Utility::LogEntry> Log_Get_Entries( State * state, int * n_entries ) noexcept
 try
 {
-    // Get all entries
-    return Log.GetEntries();
+    // Get the entries which are kept in memory
+    return Log.GetEntries( n_entries );
 }
 catch( ... )
 {
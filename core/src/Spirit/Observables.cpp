@@ -0,0 +1,250 @@
+#include <Spirit/Observables.h>
+
+#include <data/State.hpp>
+#include <engine/Observables.hpp>
+#include <utility/Exception.hpp>
+#include <utility/Logging.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+void Observables_Add( State * state, int observable, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    if( observable < Observable_Magnetization || observable > Observable_Max_Torque )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::Unknown_Exception, Utility::Log_Level::Error,
+            fmt::format( "Observables_Add: unknown observable {}", observable ) );
+    }
+    if( observable == Observable_Correlation )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::Unknown_Exception, Utility::Log_Level::Error,
+            "Observables_Add: the correlation has to be added with Observables_Add_Correlation" );
+    }
+
+    image->Lock();
+    image->observables->Add( Engine::Observable( observable ) );
+    image->Unlock();
+
+    Log( Utility::Log_Level::Info, Utility::Log_Sender::API, fmt::format( "Added observable {}", observable ),
+         idx_image, idx_chain );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+}
+
+void Observables_Add_Correlation( State * state, const float q[3], int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    image->Lock();
+    image->observables->Add_Correlation( Vector3{ q[0], q[1], q[2] } );
+    image->Unlock();
+
+    Log( Utility::Log_Level::Info, Utility::Log_Sender::API,
+         fmt::format( "Added the correlation at q = ({}, {}, {})", q[0], q[1], q[2] ), idx_image, idx_chain );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+}
+
+void Observables_Clear( State * state, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    image->Lock();
+    image->observables->Clear();
+    image->Unlock();
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+}
+
+void Observables_Reset_Samples( State * state, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    image->Lock();
+    image->observables->Reset_Samples();
+    image->Unlock();
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+}
+
+void Observables_Set_Step( State * state, int n_iterations, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    image->Lock();
+    image->observables->Set_Step( n_iterations );
+    image->Unlock();
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+}
+
+int Observables_Get_Step( State * state, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    return image->observables->Step();
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+    return 0;
+}
+
+void Observables_Set_Capacity( State * state, int n_samples_max, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    image->Lock();
+    image->observables->Set_Capacity( n_samples_max );
+    image->Unlock();
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+}
+
+int Observables_Get_N_Samples( State * state, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    return image->observables->N_Samples();
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+    return 0;
+}
+
+int Observables_Get_N_Columns( State * state, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    return image->observables->Labels().size();
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+    return 0;
+}
+
+int Observables_Get_Labels( State * state, char * labels, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    image->Lock();
+    const auto column_labels = image->observables->Labels();
+    image->Unlock();
+
+    // The labels are separated by "|"
+    std::string joined;
+    for( std::size_t i = 0; i < column_labels.size(); ++i )
+    {
+        if( i > 0 )
+            joined += '|';
+        joined += column_labels[i];
+    }
+
+    // If 'labels' is a nullptr, we return the required length of the labels array
+    if( labels == nullptr )
+        return joined.size();
+
+    std::copy( joined.begin(), joined.end(), labels );
+    return -1;
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+    return -1;
+}
+
+int Observables_Get_Samples( State * state, float * samples, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    image->Lock();
+    const auto values = image->observables->Samples();
+    image->Unlock();
+
+    // If 'samples' is a nullptr, we return the required length of the samples array
+    if( samples == nullptr )
+        return values.size();
+
+    for( std::size_t i = 0; i < values.size(); ++i )
+        samples[i] = static_cast<float>( values[i] );
+    return -1;
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+    return -1;
+}
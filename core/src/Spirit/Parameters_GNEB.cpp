@@ -144,6 +144,29 @@ catch( ... )
     spirit_handle_exception_api( -1, idx_chain );
 }
 
+void Parameters_GNEB_Set_N_Iterations_Amortize( State * state, int n_iterations_amortize, int idx_chain ) noexcept
+try
+{
+    int idx_image = -1;
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    chain->Lock();
+    chain->gneb_parameters->n_iterations_amortize = std::max( 1, n_iterations_amortize );
+    chain->Unlock();
+
+    Log( Utility::Log_Level::Parameter, Utility::Log_Sender::API,
+         fmt::format( "Set GNEB n_iterations_amortize = {}", chain->gneb_parameters->n_iterations_amortize ),
+         idx_image, idx_chain );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( -1, idx_chain );
+}
+
 // Set GNEB Calculation Parameters
 void Parameters_GNEB_Set_Convergence( State * state, float convergence, int idx_image, int idx_chain ) noexcept
 try
@@ -509,6 +532,24 @@ catch( ... )
     spirit_handle_exception_api( -1, idx_chain );
 }
 
+int Parameters_GNEB_Get_N_Iterations_Amortize( State * state, int idx_chain ) noexcept
+try
+{
+    int idx_image = -1;
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    return static_cast<int>( chain->gneb_parameters->n_iterations_amortize );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( -1, idx_chain );
+    return 0;
+}
+
 // Get GNEB Calculation Parameters
 float Parameters_GNEB_Get_Convergence( State * state, int idx_image, int idx_chain ) noexcept
 try
@@ -6,6 +6,8 @@
 #include <utility/Exception.hpp>
 #include <utility/Logging.hpp>
 
+#include <algorithm>
+
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
@@ -145,6 +147,29 @@ catch( ... )
     spirit_handle_exception_api( idx_image, idx_chain );
 }
 
+void Parameters_LLG_Set_N_Iterations_Amortize(
+    State * state, int n_iterations_amortize, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    image->Lock();
+    image->llg_parameters->n_iterations_amortize = std::max( 1, n_iterations_amortize );
+    image->Unlock();
+
+    Log( Utility::Log_Level::Parameter, Utility::Log_Sender::API,
+         fmt::format( "Set LLG n_iterations_amortize = {}", image->llg_parameters->n_iterations_amortize ),
+         idx_image, idx_chain );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+}
+
 // Set LLG Simulation Parameters
 void Parameters_LLG_Set_Direct_Minimization( State * state, bool direct, int idx_image, int idx_chain ) noexcept
 try
@@ -475,6 +500,23 @@ catch( ... )
     spirit_handle_exception_api( idx_image, idx_chain );
 }
 
+int Parameters_LLG_Get_N_Iterations_Amortize( State * state, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    return static_cast<int>( image->llg_parameters->n_iterations_amortize );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+    return 0;
+}
+
 // Get LLG Simulation Parameters
 bool Parameters_LLG_Get_Direct_Minimization( State * state, int idx_image, int idx_chain ) noexcept
 try
@@ -101,7 +101,7 @@ try
     scalar charge      = 0;
     int dimensionality = Geometry_Get_Dimensionality( state, idx_image, idx_chain );
     scalarfield charge_density( 0 );
-    std::vector<int> triangle_indices( 0 );
+    intfield triangle_indices( 0 );
 
     if( dimensionality == 2 )
     {
@@ -138,7 +138,7 @@ void check_modes(
     using namespace Engine;
     using namespace Utility;
 
-    int nos = image.size();
+    spirit_index nos = image.size();
 
     // ////////////////////////////////////////////////////////////////
     // // Check for complex numbers in the eigenvalues
@@ -235,10 +235,11 @@ void Quantity_Get_Grad_Force_MinimumMode(
     std::shared_ptr<Data::Spin_System> system;
     std::shared_ptr<Data::Spin_System_Chain> chain;
     from_indices( state, idx_image, idx_chain, system, chain );
+    system->Unshare_Hamiltonian();
 
     // Copy std::vector<Eigen::Vector3> into one single Eigen::VectorX
-    const int nos = system->nos;
-    auto & image  = *system->spins;
+    const spirit_index nos = system->nos;
+    auto & image           = *system->spins;
 
     vectorfield grad( nos, { 0, 0, 0 } );
     vectorfield minimum_mode( nos, { 0, 0, 0 } );
@@ -279,9 +280,9 @@ void Quantity_Get_Grad_Force_MinimumMode(
     system->hamiltonian->Hessian( image, hess );
 // Remove blocks of pinned spins
 #ifdef SPIRIT_ENABLE_PINNING
-    for( int i = 0; i < nos; ++i )
+    for( spirit_index i = 0; i < nos; ++i )
     {
-        for( int j = 0; j < nos; ++j )
+        for( spirit_index j = 0; j < nos; ++j )
         {
             if( ( !system->geometry->mask_unpinned[i] ) || ( !system->geometry->mask_unpinned[j] ) )
             {
@@ -310,14 +311,14 @@ void Quantity_Get_Grad_Force_MinimumMode(
         {
             // Retrieve the minimum mode
             mode_3N = basis_3Nx2N * eigenvectors.col( 0 );
-            for( int n = 0; n < nos; ++n )
+            for( spirit_index n = 0; n < nos; ++n )
                 minimum_mode[n] = { mode_3N[3 * n], mode_3N[3 * n + 1], mode_3N[3 * n + 2] };
         }
         else
         {
             // Retrieve the chosen mode
             mode_3N = basis_3Nx2N * eigenvectors.col( mode_positive );
-            for( int n = 0; n < nos; ++n )
+            for( spirit_index n = 0; n < nos; ++n )
                 minimum_mode[n] = { mode_3N[3 * n], mode_3N[3 * n + 1], mode_3N[3 * n + 2] };
         }
 
@@ -8,8 +8,11 @@
 #include <engine/Method_LLG.hpp>
 #include <engine/Method_MC.hpp>
 #include <engine/Method_MMF.hpp>
+#include <io/Checkpoint.hpp>
 #include <utility/Exception.hpp>
 #include <utility/Logging.hpp>
+#include <utility/Profiling.hpp>
+#include <utility/Stop_Control.hpp>
 
 #include <algorithm>
 
@@ -20,17 +23,45 @@ void free_run_info( Simulation_Run_Info info ) noexcept
     delete[] info.history_max_torque;
 };
 
-// Helper function to start a simulation once a Method has been created
-void run_method( std::shared_ptr<Engine::Method> method, bool singleshot, Simulation_Run_Info * info = nullptr )
+// Helper function to start a simulation once a Method has been created, optionally from the state of a checkpoint
+void run_method(
+    std::shared_ptr<Engine::Method> method, bool singleshot, Simulation_Run_Info * info = nullptr,
+    IO::Checkpoint_Reader * checkpoint = nullptr )
 {
+    if( checkpoint != nullptr )
+    {
+        method->Lock();
+        try
+        {
+            method->Checkpoint_Read( *checkpoint );
+            checkpoint->finish();
+        }
+        catch( ... )
+        {
+            // Free the systems for other simulations
+            method->Unlock();
+            method->Finalize();
+            throw;
+        }
+        method->Unlock();
+        Log( Utility::Log_Level::Info, Utility::Log_Sender::API,
+             fmt::format(
+                 "Resuming {} calculation from checkpoint \"{}\" at iteration {}", method->Name(),
+                 checkpoint->filename, method->iteration ) );
+    }
+
+    // Readers of the snapshots get the spins of this calculation from the start
+    method->Lock();
+    method->Publish_Snapshots( true );
+    method->Unlock();
+
     if( singleshot )
     {
         //---- Start timings
         method->starttime = Utility::Timing::CurrentDateTime();
         method->t_start   = std::chrono::system_clock::now();
-        auto t_current    = std::chrono::system_clock::now();
         method->t_last    = std::chrono::system_clock::now();
-        method->iteration = 0;
+        method->Start_Stop_Checks();
 
         //---- Log messages
         method->Message_Start();
@@ -74,10 +105,13 @@ void run_method( std::shared_ptr<Engine::Method> method, bool singleshot, Simula
     }
 }
 
-void Simulation_MC_Start(
-    State * state, int n_iterations, int n_iterations_log, bool singleshot, Simulation_Run_Info * info, int idx_image,
-    int idx_chain ) noexcept
-try
+namespace
+{
+
+// The following create a Method and run it. If a checkpoint is given, the Method resumes from it
+void start_mc(
+    State * state, int n_iterations, int n_iterations_log, bool singleshot, Simulation_Run_Info * info, int & idx_image,
+    int & idx_chain, IO::Checkpoint_Reader * checkpoint )
 {
     // Fetch correct indices and pointers for image and chain
     std::shared_ptr<Data::Spin_System> image;
@@ -110,6 +144,9 @@ try
         // We are not iterating, so we create the Method and call Iterate
         image->Lock();
 
+        // The Method uses the Hamiltonian from a different thread
+        image->Unshare_Hamiltonian();
+
         image->iteration_allowed  = true;
         image->singleshot_allowed = singleshot;
 
@@ -123,18 +160,13 @@ try
         image->Unlock();
 
         state->method_image[idx_image] = method;
-        run_method( method, singleshot, info );
+        run_method( method, singleshot, info, checkpoint );
     }
 }
-catch( ... )
-{
-    spirit_handle_exception_api( idx_image, idx_chain );
-}
 
-void Simulation_LLG_Start(
+void start_llg(
     State * state, int solver_type, int n_iterations, int n_iterations_log, bool singleshot, Simulation_Run_Info * info,
-    int idx_image, int idx_chain ) noexcept
-try
+    int & idx_image, int & idx_chain, IO::Checkpoint_Reader * checkpoint )
 {
     // Fetch correct indices and pointers for image and chain
     std::shared_ptr<Data::Spin_System> image;
@@ -167,6 +199,8 @@ try
         // We are not iterating, so we create the Method and call Iterate
         image->Lock();
 
+        image->Unshare_Hamiltonian();
+
         image->iteration_allowed  = true;
         image->singleshot_allowed = singleshot;
 
@@ -200,6 +234,12 @@ try
         else if( solver_type == int( Engine::Solver::VP_OSO ) )
             method = std::shared_ptr<Engine::Method>(
                 new Engine::Method_LLG<Engine::Solver::VP_OSO>( image, idx_image, idx_chain ) );
+        else if( solver_type == int( Engine::Solver::NCG ) )
+            method = std::shared_ptr<Engine::Method>(
+                new Engine::Method_LLG<Engine::Solver::NCG>( image, idx_image, idx_chain ) );
+        else if( solver_type == int( Engine::Solver::Newton ) )
+            method = std::shared_ptr<Engine::Method>(
+                new Engine::Method_LLG<Engine::Solver::Newton>( image, idx_image, idx_chain ) );
         else
             spirit_throw(
                 Utility::Exception_Classifier::Unknown_Exception, Utility::Log_Level::Warning,
@@ -208,18 +248,13 @@ try
         image->Unlock();
 
         state->method_image[idx_image] = method;
-        run_method( method, singleshot, info );
+        run_method( method, singleshot, info, checkpoint );
     }
 }
-catch( ... )
-{
-    spirit_handle_exception_api( idx_image, idx_chain );
-}
 
-void Simulation_GNEB_Start(
+void start_gneb(
     State * state, int solver_type, int n_iterations, int n_iterations_log, bool singleshot, Simulation_Run_Info * info,
-    int idx_chain ) noexcept
-try
+    int & idx_chain, IO::Checkpoint_Reader * checkpoint )
 {
     // Fetch correct indices and pointers for image and chain
     std::shared_ptr<Data::Spin_System> image;
@@ -267,6 +302,10 @@ try
         {
             chain->Lock();
 
+            // Each image needs its own Hamiltonian, as the Method records the energy contributions per image
+            for( auto & image : chain->images )
+                image->Unshare_Hamiltonian();
+
             chain->iteration_allowed  = true;
             chain->singleshot_allowed = singleshot;
 
@@ -297,6 +336,12 @@ try
             else if( solver_type == int( Engine::Solver::VP_OSO ) )
                 method = std::shared_ptr<Engine::Method>(
                     new Engine::Method_GNEB<Engine::Solver::VP_OSO>( chain, idx_chain ) );
+            else if( solver_type == int( Engine::Solver::NCG ) )
+                method = std::shared_ptr<Engine::Method>(
+                    new Engine::Method_GNEB<Engine::Solver::NCG>( chain, idx_chain ) );
+            else if( solver_type == int( Engine::Solver::Newton ) )
+                method = std::shared_ptr<Engine::Method>(
+                    new Engine::Method_GNEB<Engine::Solver::Newton>( chain, idx_chain ) );
             else
                 spirit_throw(
                     Utility::Exception_Classifier::Unknown_Exception, Utility::Log_Level::Warning,
@@ -305,19 +350,14 @@ try
             chain->Unlock();
 
             state->method_chain = method;
-            run_method( method, singleshot, info );
+            run_method( method, singleshot, info, checkpoint );
         }
     }
 }
-catch( ... )
-{
-    spirit_handle_exception_api( -1, idx_chain );
-}
 
-void Simulation_MMF_Start(
+void start_mmf(
     State * state, int solver_type, int n_iterations, int n_iterations_log, bool singleshot, Simulation_Run_Info * info,
-    int idx_image, int idx_chain ) noexcept
-try
+    int & idx_image, int & idx_chain, IO::Checkpoint_Reader * checkpoint )
 {
     // Fetch correct indices and pointers for image and chain
     std::shared_ptr<Data::Spin_System> image;
@@ -350,6 +390,8 @@ try
         // We are not iterating, so we create the Method and call Iterate
         image->Lock();
 
+        image->Unshare_Hamiltonian();
+
         image->iteration_allowed  = true;
         image->singleshot_allowed = singleshot;
 
@@ -380,9 +422,55 @@ try
         image->Unlock();
 
         state->method_image[idx_image] = method;
-        run_method( method, singleshot, info );
+        run_method( method, singleshot, info, checkpoint );
     }
 }
+
+} // namespace
+
+void Simulation_MC_Start(
+    State * state, int n_iterations, int n_iterations_log, bool singleshot, Simulation_Run_Info * info, int idx_image,
+    int idx_chain ) noexcept
+try
+{
+    start_mc( state, n_iterations, n_iterations_log, singleshot, info, idx_image, idx_chain, nullptr );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+}
+
+void Simulation_LLG_Start(
+    State * state, int solver_type, int n_iterations, int n_iterations_log, bool singleshot, Simulation_Run_Info * info,
+    int idx_image, int idx_chain ) noexcept
+try
+{
+    start_llg( state, solver_type, n_iterations, n_iterations_log, singleshot, info, idx_image, idx_chain, nullptr );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+}
+
+void Simulation_GNEB_Start(
+    State * state, int solver_type, int n_iterations, int n_iterations_log, bool singleshot, Simulation_Run_Info * info,
+    int idx_chain ) noexcept
+try
+{
+    start_gneb( state, solver_type, n_iterations, n_iterations_log, singleshot, info, idx_chain, nullptr );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( -1, idx_chain );
+}
+
+void Simulation_MMF_Start(
+    State * state, int solver_type, int n_iterations, int n_iterations_log, bool singleshot, Simulation_Run_Info * info,
+    int idx_image, int idx_chain ) noexcept
+try
+{
+    start_mmf( state, solver_type, n_iterations, n_iterations_log, singleshot, info, idx_image, idx_chain, nullptr );
+}
 catch( ... )
 {
     spirit_handle_exception_api( idx_image, idx_chain );
@@ -424,6 +512,8 @@ try
         // We are not iterating, so we create the Method and call Iterate
         image->Lock();
 
+        image->Unshare_Hamiltonian();
+
         image->iteration_allowed  = true;
         image->singleshot_allowed = singleshot;
 
@@ -479,8 +569,7 @@ try
     }
 
     // One Iteration
-    auto t_current = std::chrono::system_clock::now();
-    if( method->ContinueIterating() && !method->Walltime_Expired( t_current - method->t_start ) )
+    if( method->ContinueIterating() && !method->Walltime_Expired() )
     {
         // Lock Systems
         method->Lock();
@@ -492,6 +581,8 @@ try
             method->Iteration();
             // Post-iteration hook
             method->Hook_Post_Iteration();
+            method->Sample_Observables();
+            method->Publish_Snapshots();
 
             // Recalculate FPS
             method->t_iterations.pop_front();
@@ -508,6 +599,8 @@ try
                 method->Save_Current( method->starttime, method->iteration, false, false );
             }
             ++method->iteration;
+            if( method->Checkpoint_Due( 1 ) )
+                method->Save_Checkpoint();
         }
         // Unlock systems
         method->Unlock();
@@ -516,8 +609,7 @@ try
     // Check the conditions again after the iteration was performed,
     // as this condition may not be checked automatically (e.g. SingleShot
     // is not called anymore).
-    t_current = std::chrono::system_clock::now();
-    if( !method->ContinueIterating() || method->Walltime_Expired( t_current - method->t_start ) )
+    if( !method->ContinueIterating() || method->Walltime_Expired() )
     {
         //---- Log messages
         method->step = method->iteration / method->n_iterations_log;
@@ -525,6 +617,7 @@ try
 
         //---- Final save
         method->Save_Current( method->starttime, method->iteration, false, true );
+        method->Save_Final_Checkpoint();
         //---- Finalize (set iterations_allowed to false etc.)
         method->Finalize();
 
@@ -612,6 +705,83 @@ catch( ... )
     spirit_handle_exception_api( -1, -1 );
 }
 
+void Simulation_Request_Stop() noexcept
+{
+    Utility::Stop_Control::Request_Stop();
+}
+
+void Simulation_Write_Checkpoint( State * state, const char * file, int idx_image, int idx_chain ) noexcept
+try
+{
+    // Fetch correct indices and pointers for image and chain
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    std::shared_ptr<Engine::Method> method = nullptr;
+    if( image->iteration_allowed )
+        method = state->method_image[idx_image];
+    else if( chain->iteration_allowed )
+        method = state->method_chain;
+    else
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::Unknown_Exception, Utility::Log_Level::Warning,
+            fmt::format(
+                "Tried to write a checkpoint of image {} of chain {}, but no simulation is running.", idx_image,
+                idx_chain ) );
+    }
+
+    // Written between two iterations
+    method->Lock();
+    try
+    {
+        method->Write_Checkpoint( file );
+    }
+    catch( ... )
+    {
+        method->Unlock();
+        throw;
+    }
+    method->Unlock();
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+}
+
+void Simulation_Resume(
+    State * state, const char * file, int n_iterations, int n_iterations_log, bool singleshot,
+    Simulation_Run_Info * info, int idx_image, int idx_chain ) noexcept
+try
+{
+    IO::Checkpoint_Reader checkpoint( file );
+    const auto & header = checkpoint.header();
+
+    if( header.method == "LLG" )
+        start_llg(
+            state, header.solver, n_iterations, n_iterations_log, singleshot, info, idx_image, idx_chain,
+            &checkpoint );
+    else if( header.method == "MC" )
+        start_mc( state, n_iterations, n_iterations_log, singleshot, info, idx_image, idx_chain, &checkpoint );
+    else if( header.method == "GNEB" )
+        start_gneb( state, header.solver, n_iterations, n_iterations_log, singleshot, info, idx_chain, &checkpoint );
+    else if( header.method == "MMF" )
+        start_mmf(
+            state, header.solver, n_iterations, n_iterations_log, singleshot, info, idx_image, idx_chain,
+            &checkpoint );
+    else
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format( "Checkpoint \"{}\" of a {} calculation cannot be resumed", file, header.method ) );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+}
+
 float Simulation_Get_MaxTorqueComponent( State * state, int idx_image, int idx_chain ) noexcept
 try
 {
@@ -901,6 +1071,61 @@ catch( ... )
     return nullptr;
 }
 
+int Simulation_Get_N_Timings( State * state ) noexcept
+{
+    return Utility::Profiling::n_sections;
+}
+
+const char * Simulation_Get_Timing_Name( State * state, int idx_section ) noexcept
+try
+{
+    if( idx_section < 0 || idx_section >= Utility::Profiling::n_sections )
+    {
+        Log( Utility::Log_Level::Warning, Utility::Log_Sender::API,
+             fmt::format( "Invalid index {} of a profiled section", idx_section ) );
+        return "";
+    }
+    return Utility::Profiling::Section_Name( static_cast<Utility::Profiling::Section>( idx_section ) );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( -1, -1 );
+    return "";
+}
+
+bool Simulation_Get_Timings( State * state, float * seconds, int * calls ) noexcept
+try
+{
+    auto timings = Utility::Profiling::Get_Timings();
+    for( int i = 0; i < Utility::Profiling::n_sections; ++i )
+    {
+        seconds[i] = static_cast<float>( timings.seconds[i] );
+        calls[i]   = static_cast<int>( timings.calls[i] );
+    }
+
+    if( !Utility::Profiling::enabled() )
+    {
+        Log( Utility::Log_Level::Warning, Utility::Log_Sender::API,
+             "Timings are not available, as Spirit was built without SPIRIT_ENABLE_PROFILING" );
+    }
+    return Utility::Profiling::enabled();
+}
+catch( ... )
+{
+    spirit_handle_exception_api( -1, -1 );
+    return false;
+}
+
+void Simulation_Reset_Timings( State * state ) noexcept
+try
+{
+    Utility::Profiling::Reset_Timings();
+}
+catch( ... )
+{
+    spirit_handle_exception_api( -1, -1 );
+}
+
 bool Simulation_Running_On_Image( State * state, int idx_image, int idx_chain ) noexcept
 try
 {
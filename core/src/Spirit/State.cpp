@@ -6,6 +6,7 @@
 #include <utility/Configuration_Chain.hpp>
 #include <utility/Configurations.hpp>
 #include <utility/Logging.hpp>
+#include <utility/Thread_Pool.hpp>
 #include <utility/Version.hpp>
 
 #include <fmt/format.h>
@@ -97,7 +98,8 @@ try
 #endif
 // Log threading info
 #ifdef SPIRIT_USE_THREADS
-    block.emplace_back( "    Using std::thread" );
+    block.emplace_back(
+        fmt::format( "    Using std::thread (pool of {} threads)", Utility::Thread_Pool::Get().N_Threads() ) );
 #else
     block.emplace_back( "    Not using std::thread" );
 #endif
@@ -113,6 +115,12 @@ try
 #else
     block.emplace_back( "    Pinning is not enabled" );
 #endif
+// Log profiling info
+#ifdef SPIRIT_ENABLE_PROFILING
+    block.emplace_back( "    Profiling is enabled" );
+#else
+    block.emplace_back( "    Profiling is not enabled" );
+#endif
 // Log Precision info
 #ifdef SPIRIT_SCALAR_TYPE_DOUBLE
     block.emplace_back( "    Using double as scalar type" );
@@ -1,3 +1,4 @@
+#include <Spirit/Simulation.h>
 #include <Spirit/State.h>
 #include <Spirit/System.h>
 
@@ -6,6 +7,8 @@
 #include <utility/Exception.hpp>
 #include <utility/Logging.hpp>
 
+#include <algorithm>
+
 int System_Get_Index( State * state ) noexcept
 try
 {
@@ -17,7 +20,7 @@ catch( ... )
     return -1;
 }
 
-int System_Get_NOS( State * state, int idx_image, int idx_chain ) noexcept
+spirit_index System_Get_NOS( State * state, int idx_image, int idx_chain ) noexcept
 try
 {
     std::shared_ptr<Data::Spin_System> image;
@@ -51,6 +54,54 @@ catch( ... )
     return nullptr;
 }
 
+spirit_index System_Get_Snapshot_NOS( State * state, int n_cell_step, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    return Data::Spin_Snapshot::Subsampled_NOS( *image->geometry, std::max( 1, n_cell_step ) );
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+    return 0;
+}
+
+long System_Get_Spin_Snapshot(
+    State * state, float * directions, int n_cell_step, int idx_image, int idx_chain ) noexcept
+try
+{
+    std::shared_ptr<Data::Spin_System> image;
+    std::shared_ptr<Data::Spin_System_Chain> chain;
+
+    // Fetch correct indices and pointers
+    from_indices( state, idx_image, idx_chain, image, chain );
+
+    n_cell_step = std::max( 1, n_cell_step );
+
+    if( Simulation_Running_On_Image( state, idx_image, idx_chain ) || Simulation_Running_On_Chain( state, idx_chain ) )
+    {
+        const auto n_snapshot = image->snapshot->Read( *image->geometry, n_cell_step, directions );
+        if( n_snapshot > 0 )
+            return long( n_snapshot );
+    }
+
+    // Without a (consistent) snapshot, the spins are copied while the system is locked
+    image->Lock();
+    Data::Spin_Snapshot::Export( *image->spins, *image->geometry, n_cell_step, directions );
+    image->Unlock();
+    return 0;
+}
+catch( ... )
+{
+    spirit_handle_exception_api( idx_image, idx_chain );
+    return 0;
+}
+
 scalar * System_Get_Effective_Field( State * state, int idx_image, int idx_chain ) noexcept
 try
 {
@@ -289,6 +340,7 @@ try
     from_indices( state, idx_image, idx_chain, image, chain );
 
     image->Lock();
+    image->Unshare_Hamiltonian();
     Engine::Eigenmodes::Calculate_Eigenmodes( image, idx_image, idx_chain );
     image->Unlock();
 }
@@ -12,13 +12,48 @@
 
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <random>
 
 namespace Data
 {
 
+namespace
+{
+
+// Number of sites of a lattice. The spin arrays are passed around as arrays of 3*nos scalars, so it is checked that
+// this length can be represented by the index type.
+spirit_index count_sites( const intfield & n_cells, std::size_t n_cell_atoms )
+{
+    const std::int64_t max_nos = std::numeric_limits<spirit_index>::max() / 3;
+
+    std::int64_t nos          = n_cell_atoms;
+    long double nos_requested = n_cell_atoms;
+    for( int dim = 0; dim < 3; ++dim )
+    {
+        nos_requested *= n_cells[dim];
+        if( n_cells[dim] < 0 || ( n_cells[dim] > 0 && nos > max_nos / n_cells[dim] ) )
+            nos = -1;
+        else if( nos >= 0 )
+            nos *= n_cells[dim];
+    }
+
+    if( nos < 0 || nos > max_nos )
+        spirit_throw(
+            Utility::Exception_Classifier::Input_parse_failed, Utility::Log_Level::Severe,
+            fmt::format(
+                "A geometry of {}x{}x{} cells with {} atoms each would contain {:.4g} spins, but this build of Spirit "
+                "can index at most {} spins. Build Spirit with SPIRIT_USE_64BIT_INDICES=ON for larger systems.",
+                n_cells[0], n_cells[1], n_cells[2], n_cell_atoms, double( nos_requested ), max_nos ) );
+    return nos;
+}
+
+} // namespace
+
 Geometry::Geometry(
     const std::vector<Vector3> & bravais_vectors, intfield n_cells, const std::vector<Vector3> & cell_atoms,
     const Basis_Cell_Composition & cell_composition, scalar lattice_constant, const Pinning & pinning,
@@ -29,9 +64,9 @@ Geometry::Geometry(
           cell_atoms( cell_atoms ),
           cell_composition( cell_composition ),
           lattice_constant( lattice_constant ),
-          nos( cell_atoms.size() * n_cells[0] * n_cells[1] * n_cells[2] ),
-          nos_nonvacant( cell_atoms.size() * n_cells[0] * n_cells[1] * n_cells[2] ),
-          n_cells_total( n_cells[0] * n_cells[1] * n_cells[2] ),
+          nos( count_sites( n_cells, cell_atoms.size() ) ),
+          nos_nonvacant( nos ),
+          n_cells_total( spirit_index( n_cells[0] ) * n_cells[1] * n_cells[2] ),
           pinning( pinning ),
           defects( defects )
 {
@@ -84,6 +119,10 @@ Geometry::Geometry(
     // Calculate the type of geometry
     this->calculateGeometryType();
 
+    // The topological charge density is only defined for planar systems
+    if( this->dimensionality == 2 )
+        this->calculateChargeStencil();
+
     // For updates of triangulation and tetrahedra
     this->last_update_n_cell_step = -1;
     this->last_update_n_cells     = intfield( 3, -1 );
@@ -224,6 +263,225 @@ catch( ... )
     return std::vector<triangle_t>( 0 );
 }
 
+namespace
+{
+
+// Number of cells at each boundary of an extended direction, which are triangulated differently from the interior
+constexpr int stencil_margin = 2;
+
+// Number of cells of the block, from which the stencil is taken. The simplices of the cell in its center are the
+// ones of the interior of a large lattice and the simplices of the other cells are the ones near its boundaries.
+std::array<int, 3> stencil_block( const std::array<bool, 3> & extended )
+{
+    std::array<int, 3> n_block;
+    for( int dim = 0; dim < 3; ++dim )
+        n_block[dim] = extended[dim] ? 2 * stencil_margin + 1 : 1;
+    return n_block;
+}
+
+std::vector<triangle_t> delaunay_simplices( const std::vector<Vector3> & points, triangle_t )
+{
+    std::vector<vector2_t> points_2d( points.size() );
+    for( std::size_t i = 0; i < points.size(); ++i )
+        points_2d[i] = { double( points[i][0] ), double( points[i][1] ) };
+    return compute_delaunay_triangulation_2D( points_2d );
+}
+
+std::vector<tetrahedron_t> delaunay_simplices( const std::vector<Vector3> & points, tetrahedron_t )
+{
+    std::vector<vector3_t> points_3d( points.size() );
+    for( std::size_t i = 0; i < points.size(); ++i )
+        points_3d[i] = { double( points[i][0] ), double( points[i][1] ), double( points[i][2] ) };
+    return compute_delaunay_triangulation_3D( points_3d );
+}
+
+// Delaunay simplices of a block of n_block cells, given as sites of the block
+template<std::size_t n_corners>
+std::vector<std::array<Site, n_corners>> delaunay_block(
+    const std::vector<Vector3> & basis, const std::array<Vector3, 3> & translations, const std::array<int, 3> & n_block )
+{
+    const int n_basis = basis.size();
+    std::vector<Vector3> points;
+    for( int c = 0; c < n_block[2]; ++c )
+    {
+        for( int b = 0; b < n_block[1]; ++b )
+        {
+            for( int a = 0; a < n_block[0]; ++a )
+            {
+                for( int i = 0; i < n_basis; ++i )
+                    points.push_back( basis[i] + a * translations[0] + b * translations[1] + c * translations[2] );
+            }
+        }
+    }
+
+    std::vector<std::array<Site, n_corners>> simplices;
+    for( const auto & simplex : delaunay_simplices( points, std::array<int, n_corners>() ) )
+    {
+        std::array<Site, n_corners> corners;
+        for( std::size_t k = 0; k < n_corners; ++k )
+        {
+            const spirit_index icell = simplex[k] / n_basis;
+            corners[k]               = Site{ simplex[k] % n_basis,
+                                        { icell % n_block[0], ( icell / n_block[0] ) % n_block[1],
+                                          icell / ( n_block[0] * n_block[1] ) } };
+        }
+        simplices.push_back( corners );
+    }
+    return simplices;
+}
+
+/*
+ * Replicates a stencil, taken from a block of n_block cells, across a grid of n[0] x n[1] x n[2] cells with
+ * n_cell_atoms points each. A simplex belongs to the cell from which its corners are reached by non-negative
+ * translations. The simplices of the central cell of the block are replicated across the interior of the grid and
+ * the ones of the other cells are placed at the same distance to the boundaries of the grid.
+ * Returns false if the grid is smaller than the block.
+ */
+template<std::size_t n_corners>
+bool replicate_stencil(
+    const std::vector<std::array<Site, n_corners>> & stencil, const std::array<int, 3> & n_block, int n_cell_atoms,
+    const std::array<std::int64_t, 3> & n, std::vector<std::array<int, n_corners>> & simplices )
+{
+    for( int dim = 0; dim < 3; ++dim )
+    {
+        if( n[dim] < n_block[dim] )
+            return false;
+    }
+
+    // The cells, to which each simplex of the stencil is copied, form a box given by its first cell and its size
+    std::vector<std::array<std::int64_t, 3>> box_begin( stencil.size() ), box_size( stencil.size() );
+    std::vector<std::int64_t> offsets( stencil.size() + 1, 0 );
+    for( std::size_t i = 0; i < stencil.size(); ++i )
+    {
+        for( int dim = 0; dim < 3; ++dim )
+        {
+            const int center = ( n_block[dim] - 1 ) / 2;
+            int anchor       = n_block[dim];
+            for( const auto & site : stencil[i] )
+                anchor = std::min( anchor, site.translations[dim] );
+
+            if( anchor < center )
+            {
+                box_begin[i][dim] = 0;
+                box_size[i][dim]  = 1;
+            }
+            else if( anchor == center )
+            {
+                box_begin[i][dim] = 0;
+                box_size[i][dim]  = n[dim] - n_block[dim] + 1;
+            }
+            else
+            {
+                box_begin[i][dim] = n[dim] - n_block[dim];
+                box_size[i][dim]  = 1;
+            }
+        }
+        offsets[i + 1] = offsets[i] + box_size[i][0] * box_size[i][1] * box_size[i][2];
+    }
+
+    simplices.resize( offsets.back() );
+    for( std::size_t i = 0; i < stencil.size(); ++i )
+    {
+        const auto & simplex   = stencil[i];
+        const auto & begin     = box_begin[i];
+        const auto & size      = box_size[i];
+        const auto n_simplices = offsets[i + 1] - offsets[i];
+#pragma omp parallel for
+        for( std::int64_t icell = 0; icell < n_simplices; ++icell )
+        {
+            const std::int64_t a = begin[0] + icell % size[0];
+            const std::int64_t b = begin[1] + ( icell / size[0] ) % size[1];
+            const std::int64_t c = begin[2] + icell / ( size[0] * size[1] );
+            for( std::size_t k = 0; k < n_corners; ++k )
+            {
+                const auto & site = simplex[k];
+                simplices[offsets[i] + icell][k] = static_cast<int>(
+                    site.i
+                    + n_cell_atoms
+                          * ( ( a + site.translations[0] )
+                              + n[0] * ( ( b + site.translations[1] ) + n[1] * ( c + site.translations[2] ) ) ) );
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * Calculates the stencil of the Delaunay triangulation of a lattice from a block of cells (see `stencil_block`).
+ *
+ * The basis atoms and translations are perturbed slightly, but in the same way in every cell, so that degenerate
+ * lattices (e.g. with four sites on a circle) are triangulated the same way in every cell. The stencil is checked
+ * by comparing its replication to a block, which is larger by one cell in each direction, with the triangulation
+ * of that block. If they differ, e.g. because the triangulation of the lattice is not local, an empty stencil is
+ * returned.
+ */
+template<std::size_t n_corners>
+std::vector<std::array<Site, n_corners>> compute_delaunay_stencil(
+    const std::vector<Vector3> & basis, const std::array<Vector3, 3> & translations,
+    const std::array<bool, 3> & extended )
+{
+    using stencil_t = std::vector<std::array<Site, n_corners>>;
+
+    // A triangle needs two and a tetrahedron three directions of translation
+    if( std::count( extended.begin(), extended.end(), true ) != int( n_corners ) - 1 )
+        return stencil_t( 0 );
+
+    scalar length = 0;
+    for( int dim = 0; dim < 3; ++dim )
+    {
+        if( extended[dim] )
+            length = std::max( length, translations[dim].norm() );
+    }
+    const scalar epsilon = 1e-6 * length;
+
+    // A fixed, irregular direction for each index
+    auto perturbation = []( int index )
+    { return Vector3{ std::sin( 1.7 * index + 0.3 ), std::sin( 2.9 * index + 1.1 ), std::sin( 4.3 * index + 2.3 ) }; };
+
+    std::vector<Vector3> basis_perturbed( basis.size() );
+    for( std::size_t i = 0; i < basis.size(); ++i )
+        basis_perturbed[i] = basis[i] + epsilon * perturbation( i );
+    std::array<Vector3, 3> translations_perturbed;
+    for( int dim = 0; dim < 3; ++dim )
+        translations_perturbed[dim] = translations[dim] + epsilon * perturbation( -1 - dim );
+
+    const auto n_block = stencil_block( extended );
+    auto stencil       = delaunay_block<n_corners>( basis_perturbed, translations_perturbed, n_block );
+
+    // Check against the triangulation of a larger block
+    std::array<int, 3> n_check = n_block;
+    for( int dim = 0; dim < 3; ++dim )
+    {
+        if( extended[dim] )
+            ++n_check[dim];
+    }
+    const int n_basis = basis.size();
+    std::vector<std::array<int, n_corners>> replicated, expected;
+    replicate_stencil( stencil, n_block, n_basis, { n_check[0], n_check[1], n_check[2] }, replicated );
+    for( const auto & simplex : delaunay_block<n_corners>( basis_perturbed, translations_perturbed, n_check ) )
+    {
+        std::array<int, n_corners> indices;
+        for( std::size_t k = 0; k < n_corners; ++k )
+        {
+            const auto & t = simplex[k].translations;
+            indices[k]     = simplex[k].i + n_basis * ( t[0] + n_check[0] * ( t[1] + n_check[1] * t[2] ) );
+        }
+        expected.push_back( indices );
+    }
+    for( auto * simplices : { &replicated, &expected } )
+    {
+        for( auto & simplex : *simplices )
+            std::sort( simplex.begin(), simplex.end() );
+        std::sort( simplices->begin(), simplices->end() );
+    }
+    if( replicated != expected )
+        return stencil_t( 0 );
+
+    return stencil;
+}
+
+} // namespace
+
 const std::vector<triangle_t> & Geometry::triangulation( int n_cell_step, std::array<int, 6> ranges )
 {
     // Only every n_cell_step'th cell is used. So we check if there is still enough cells in all
@@ -281,6 +539,16 @@ const std::vector<triangle_t> & Geometry::triangulation( int n_cell_step, std::a
                 _triangulation.clear();
                 return _triangulation;
             }
+
+            // Triangulate a block of cells once and replicate it, unless the lattice has no local triangulation
+            // or is too small
+            const std::array<bool, 3> extended{ n_a > 1, n_b > 1, n_c > 1 };
+            const auto & stencil = this->triangleStencil( n_cell_step, extended );
+            if( !stencil.empty()
+                && replicate_stencil(
+                    stencil, stencil_block( extended ), n_cell_atoms, { n_a, n_b, n_c }, _triangulation ) )
+                return _triangulation;
+
             points.resize( n_points );
 
             // TODO: it seems the following is effectively just vec<vector3_t> (double) = vec<Vector3> (scalar)
@@ -372,75 +640,116 @@ const std::vector<tetrahedron_t> & Geometry::tetrahedra( int n_cell_step, std::a
             return _tetrahedra;
         }
 
-        // If we have only one spin in the basis our lattice is a simple regular geometry meaning everything can be
-        // calculated by hand
-        if( n_cell_atoms == 1 )
+        // Tetrahedralise a block of cells once and replicate it, unless the lattice has no local tetrahedralisation
+        // or is too small
+        const std::array<bool, 3> extended{ true, true, true };
+        const auto & stencil = this->tetrahedronStencil( n_cell_step, extended );
+        if( !stencil.empty()
+            && replicate_stencil( stencil, stencil_block( extended ), n_cell_atoms, { n_a, n_b, n_c }, _tetrahedra ) )
+            return _tetrahedra;
+
+        // Otherwise we calculate the Delaunay tetrahedra of all points
+        // TODO: it seems the following is effectively just vec<vector3_t> (double) = vec<Vector3> (scalar)
+        std::vector<vector3_t> points( n_points );
+        std::int64_t icell = 0, idx = 0;
+        for( std::int64_t cell_c = c_min; cell_c < c_max; cell_c += n_cell_step )
         {
-            _tetrahedra.clear();
-            std::array<int, 24> cell_indices{ 0, 1, 5, 3, 1, 3, 2, 5, 3, 2, 5, 6, 7, 6, 5, 3, 4, 7, 5, 3, 0, 4, 3, 5 };
-            int x_offset = 1;
-            int y_offset = n_a;
-            int z_offset = n_a * n_b;
-            std::array<int, 8> offsets{
-                0,
-                x_offset,
-                x_offset + y_offset,
-                y_offset,
-                z_offset,
-                x_offset + z_offset,
-                x_offset + y_offset + z_offset,
-                y_offset + z_offset,
-            };
-
-            for( int ix = 0; ix < n_a - 1; ix++ )
+            for( std::int64_t cell_b = b_min; cell_b < b_max; cell_b += n_cell_step )
             {
-                for( int iy = 0; iy < n_b - 1; iy++ )
+                for( std::int64_t cell_a = a_min; cell_a < a_max; cell_a += n_cell_step )
                 {
-                    for( int iz = 0; iz < n_c - 1; iz++ )
+                    for( std::int64_t ibasis = 0; ibasis < n_cell_atoms; ++ibasis )
                     {
-                        int base_index = ix * x_offset + iy * y_offset + iz * z_offset;
-                        for( std::uint8_t j = 0; j < 6; j++ )
-                        {
-                            tetrahedron_t tetrahedron;
-                            for( std::uint8_t k = 0; k < 4; k++ )
-                            {
-                                tetrahedron[k] = base_index + offsets[cell_indices[j * 4 + k]];
-                            }
-                            _tetrahedra.push_back( tetrahedron );
-                        }
+                        idx = ibasis + n_cell_atoms * cell_a + n_cell_atoms * n_cells[0] * cell_b
+                              + n_cell_atoms * n_cells[0] * n_cells[1] * cell_c;
+                        points[icell].x = static_cast<double>( positions[idx][0] );
+                        points[icell].y = static_cast<double>( positions[idx][1] );
+                        points[icell].z = static_cast<double>( positions[idx][2] );
+                        ++icell;
                     }
                 }
             }
         }
-        // For general basis cells we calculate the Delaunay tetrahedra
-        else
+        _tetrahedra = compute_delaunay_triangulation_3D( points );
+    }
+
+    return _tetrahedra;
+}
+
+const std::vector<triangle_stencil_t> & Geometry::triangleStencil( int n_cell_step, std::array<bool, 3> extended )
+{
+    if( this->triangle_stencil_n_cell_step != n_cell_step || this->triangle_stencil_extended != extended )
+    {
+        this->triangle_stencil_n_cell_step = n_cell_step;
+        this->triangle_stencil_extended    = extended;
+
+        const std::vector<Vector3> basis( positions.begin(), positions.begin() + n_cell_atoms );
+        const std::array<Vector3, 3> translations{ n_cell_step * lattice_constant * bravais_vectors[0],
+                                                   n_cell_step * lattice_constant * bravais_vectors[1],
+                                                   n_cell_step * lattice_constant * bravais_vectors[2] };
+        _triangle_stencil = compute_delaunay_stencil<3>( basis, translations, extended );
+    }
+    return _triangle_stencil;
+}
+
+const std::vector<tetrahedron_stencil_t> &
+Geometry::tetrahedronStencil( int n_cell_step, std::array<bool, 3> extended )
+{
+    if( this->tetrahedron_stencil_n_cell_step != n_cell_step || this->tetrahedron_stencil_extended != extended )
+    {
+        this->tetrahedron_stencil_n_cell_step = n_cell_step;
+        this->tetrahedron_stencil_extended    = extended;
+
+        // If we have only one spin in the basis our lattice is a simple regular geometry meaning everything can be
+        // decomposed into 6 tetrahedra per cell, spanning the corners of the cell, in every cell of the block
+        // which is not at its upper boundaries
+        if( n_cell_atoms == 1 && extended == std::array<bool, 3>{ true, true, true } )
         {
-            // TODO: it seems the following is effectively just vec<vector3_t> (double) = vec<Vector3> (scalar)
-            std::vector<vector3_t> points( n_points );
-            std::int64_t icell = 0, idx = 0;
-            for( std::int64_t cell_c = c_min; cell_c < c_max; cell_c += n_cell_step )
+            // Translations of the corners of the cell
+            const std::array<std::array<int, 3>, 8> cell_corners{ { { 0, 0, 0 },
+                                                                    { 1, 0, 0 },
+                                                                    { 1, 1, 0 },
+                                                                    { 0, 1, 0 },
+                                                                    { 0, 0, 1 },
+                                                                    { 1, 0, 1 },
+                                                                    { 1, 1, 1 },
+                                                                    { 0, 1, 1 } } };
+            const std::array<int, 24> cell_indices
+                = { 0, 1, 5, 3, 1, 3, 2, 5, 3, 2, 5, 6, 7, 6, 5, 3, 4, 7, 5, 3, 0, 4, 3, 5 };
+
+            const auto n_block = stencil_block( extended );
+            _tetrahedron_stencil.clear();
+            for( int c = 0; c < n_block[2] - 1; ++c )
             {
-                for( std::int64_t cell_b = b_min; cell_b < b_max; cell_b += n_cell_step )
+                for( int b = 0; b < n_block[1] - 1; ++b )
                 {
-                    for( std::int64_t cell_a = a_min; cell_a < a_max; cell_a += n_cell_step )
+                    for( int a = 0; a < n_block[0] - 1; ++a )
                     {
-                        for( std::int64_t ibasis = 0; ibasis < n_cell_atoms; ++ibasis )
+                        for( int j = 0; j < 6; ++j )
                         {
-                            idx = ibasis + n_cell_atoms * cell_a + n_cell_atoms * n_cells[0] * cell_b
-                                  + n_cell_atoms * n_cells[0] * n_cells[1] * cell_c;
-                            points[icell].x = static_cast<double>( positions[idx][0] );
-                            points[icell].y = static_cast<double>( positions[idx][1] );
-                            points[icell].z = static_cast<double>( positions[idx][2] );
-                            ++icell;
+                            tetrahedron_stencil_t tetrahedron;
+                            for( int k = 0; k < 4; ++k )
+                            {
+                                const auto & t = cell_corners[cell_indices[4 * j + k]];
+                                tetrahedron[k] = Site{ 0, { a + t[0], b + t[1], c + t[2] } };
+                            }
+                            _tetrahedron_stencil.push_back( tetrahedron );
                         }
                     }
                 }
             }
-            _tetrahedra = compute_delaunay_triangulation_3D( points );
+        }
+        // For general basis cells we calculate the Delaunay tetrahedra of a block of cells
+        else
+        {
+            const std::vector<Vector3> basis( positions.begin(), positions.begin() + n_cell_atoms );
+            const std::array<Vector3, 3> translations{ n_cell_step * lattice_constant * bravais_vectors[0],
+                                                       n_cell_step * lattice_constant * bravais_vectors[1],
+                                                       n_cell_step * lattice_constant * bravais_vectors[2] };
+            _tetrahedron_stencil = compute_delaunay_stencil<4>( basis, translations, extended );
         }
     }
-
-    return _tetrahedra;
+    return _tetrahedron_stencil;
 }
 
 std::vector<Vector3> Geometry::BravaisVectorsSC()
@@ -804,6 +1113,68 @@ void Geometry::calculateGeometryType()
     }
 }
 
+void Geometry::calculateChargeStencil()
+{
+    this->charge_stencil.clear();
+    this->charge_stencil_signs.clear();
+
+    // This implementations assumes
+    // 1. No basis atom lies outside the cell spanned by the basis vectors of the lattice
+    // 2. The geometry is a plane in x and y and spanned by the first 2 basis_vectors of the lattice
+    // 3. The first basis atom lies at (0,0)
+
+    // Compute Delaunay for unitcell + basis with neighbouring lattice sites in directions a, b, and a+b
+    std::vector<vector2_t> basis_cell_points( n_cell_atoms + 3 );
+    for( int i = 0; i < n_cell_atoms; i++ )
+    {
+        basis_cell_points[i].x = double( positions[i][0] );
+        basis_cell_points[i].y = double( positions[i][1] );
+    }
+
+    // To avoid cases where the basis atoms lie on the boundary of the convex hull the corners of the parallelogram
+    // spanned by the lattice sites 0, a, b and a+b are stretched away from the center for the triangulation
+    scalar stretch_factor = 0.1;
+
+    Vector3 ta = lattice_constant * bravais_vectors[0];
+    Vector3 tb = lattice_constant * bravais_vectors[1];
+
+    // basis_cell_points[0] coincides with the '0' lattice site
+    basis_cell_points[0].x -= stretch_factor * ( ta + tb )[0];
+    basis_cell_points[0].y -= stretch_factor * ( ta + tb )[1];
+
+    // a+b
+    basis_cell_points[n_cell_atoms].x = double( ( ta + tb + positions[0] + stretch_factor * ( ta + tb ) )[0] );
+    basis_cell_points[n_cell_atoms].y = double( ( ta + tb + positions[0] + stretch_factor * ( ta + tb ) )[1] );
+    // b
+    basis_cell_points[n_cell_atoms + 1].x = double( ( tb + positions[0] - stretch_factor * ( ta - tb ) )[0] );
+    basis_cell_points[n_cell_atoms + 1].y = double( ( tb + positions[0] - stretch_factor * ( ta - tb ) )[1] );
+    // a
+    basis_cell_points[n_cell_atoms + 2].x = double( ( ta + positions[0] + stretch_factor * ( ta - tb ) )[0] );
+    basis_cell_points[n_cell_atoms + 2].y = double( ( ta + positions[0] + stretch_factor * ( ta - tb ) )[1] );
+
+    // The sites of the points, relative to the cell
+    std::vector<Site> sites( n_cell_atoms + 3 );
+    for( int i = 0; i < n_cell_atoms; i++ )
+        sites[i] = Site{ i, { 0, 0, 0 } };
+    sites[n_cell_atoms]     = Site{ 0, { 1, 1, 0 } };
+    sites[n_cell_atoms + 1] = Site{ 0, { 0, 1, 0 } };
+    sites[n_cell_atoms + 2] = Site{ 0, { 1, 0, 0 } };
+
+    for( const triangle_t & tri : compute_delaunay_triangulation_2D( basis_cell_points ) )
+    {
+        // Compute the sign of this triangle
+        std::array<Vector3, 3> tri_positions;
+        for( int i = 0; i < 3; i++ )
+            tri_positions[i]
+                = { scalar( basis_cell_points[tri[i]].x ), scalar( basis_cell_points[tri[i]].y ), scalar( 0 ) };
+        Vector3 triangle_normal = ( tri_positions[0] - tri_positions[1] ).cross( tri_positions[0] - tri_positions[2] );
+        triangle_normal.normalize();
+
+        this->charge_stencil.push_back( { sites[tri[0]], sites[tri[1]], sites[tri[2]] } );
+        this->charge_stencil_signs.push_back( triangle_normal[2] / std::abs( triangle_normal[2] ) );
+    }
+}
+
 void Geometry::Apply_Pinning( vectorfield & vf )
 {
 #if defined( SPIRIT_ENABLE_PINNING )
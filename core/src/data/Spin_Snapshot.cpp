@@ -0,0 +1,139 @@
+#include <data/Spin_Snapshot.hpp>
+#include <engine/Backend_par.hpp>
+#include <engine/Backend_seq.hpp>
+
+#include <algorithm>
+
+namespace Data
+{
+
+namespace
+{
+
+#ifdef SPIRIT_USE_CUDA
+// The snapshots are copied into memory of the host
+namespace backend = Engine::Backend::seq;
+#else
+namespace backend = Engine::Backend::par;
+#endif
+
+// Calls copy( i_target, i_source ) for every spin of every `n_cell_step`-th cell, with the target index
+// running over the subsampled cells in the same order as the source index
+template<typename F>
+void for_each_subsampled( const Geometry & geometry, int n_cell_step, const F & copy )
+{
+    const int n_cell_atoms      = geometry.n_cell_atoms;
+    const spirit_index na       = geometry.n_cells[0];
+    const spirit_index nb       = geometry.n_cells[1];
+    const int na_draw           = std::max( 1, geometry.n_cells[0] / n_cell_step );
+    const int nb_draw           = std::max( 1, geometry.n_cells[1] / n_cell_step );
+    const spirit_index nos_draw = Spin_Snapshot::Subsampled_NOS( geometry, n_cell_step );
+
+    backend::apply(
+        nos_draw,
+        [&]( spirit_index i_target )
+        {
+            const int ibasis         = i_target % n_cell_atoms;
+            const spirit_index icell = i_target / n_cell_atoms;
+            const int a              = icell % na_draw;
+            const int b              = ( icell / na_draw ) % nb_draw;
+            const int c              = icell / ( spirit_index( na_draw ) * nb_draw );
+            copy( i_target, ibasis + n_cell_atoms * n_cell_step * ( a + na * ( b + nb * c ) ) );
+        } );
+}
+
+} // namespace
+
+void Spin_Snapshot::Publish( const vectorfield & spins, bool force )
+{
+    if( !this->requested.exchange( false ) && !force )
+        return;
+
+    const std::size_t size = 3 * spins.size();
+    if( this->buffers->directions[0].size() != size )
+    {
+        // Readers may still copy from the previous buffers, which they keep alive
+        auto resized = std::make_shared<Buffers>();
+        resized->directions[0].resize( size );
+        resized->directions[1].resize( size );
+        resized->n_started  = this->buffers->n_finished.load();
+        resized->n_finished = this->buffers->n_finished.load();
+        std::atomic_store( &this->buffers, resized );
+    }
+
+    Buffers & buffers = *this->buffers;
+    const std::uint64_t n = buffers.n_finished.load( std::memory_order_relaxed ) + 1;
+    buffers.n_started.store( n, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+
+    float * directions = buffers.directions[n % 2].data();
+    const Vector3 * s  = spins.data();
+    Engine::Backend::par::apply(
+        spins.size(),
+        [directions, s] SPIRIT_LAMBDA( spirit_index idx )
+        {
+            directions[3 * idx]     = float( s[idx][0] );
+            directions[3 * idx + 1] = float( s[idx][1] );
+            directions[3 * idx + 2] = float( s[idx][2] );
+        } );
+
+    buffers.n_finished.store( n, std::memory_order_release );
+}
+
+std::uint64_t Spin_Snapshot::Read( const Geometry & geometry, int n_cell_step, float * directions )
+{
+    this->requested = true;
+
+    // Keeps the buffers alive while they are copied, even if the writer replaces them
+    const std::shared_ptr<Buffers> buffers = std::atomic_load( &this->buffers );
+    if( buffers->directions[0].size() != std::size_t( 3 * geometry.nos ) )
+        return 0;
+
+    // If the writer is faster than the copy, give up after a few attempts instead of making the reader wait
+    for( int attempt = 0; attempt < 4; ++attempt )
+    {
+        const std::uint64_t n = buffers->n_finished.load( std::memory_order_acquire );
+        if( n == 0 )
+            return 0;
+
+        const float * source   = buffers->directions[n % 2].data();
+        const int * atom_types = geometry.atom_types.data();
+        for_each_subsampled(
+            geometry, n_cell_step,
+            [&]( spirit_index i_target, spirit_index i_source )
+            {
+                const bool vacancy           = atom_types[i_source] < 0;
+                directions[3 * i_target]     = vacancy ? 0 : source[3 * i_source];
+                directions[3 * i_target + 1] = vacancy ? 0 : source[3 * i_source + 1];
+                directions[3 * i_target + 2] = vacancy ? 0 : source[3 * i_source + 2];
+            } );
+
+        // Publication n + 2 is the next one to write into the buffer which was copied
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if( buffers->n_started.load( std::memory_order_relaxed ) < n + 2 )
+            return n;
+    }
+    return 0;
+}
+
+spirit_index Spin_Snapshot::Subsampled_NOS( const Geometry & geometry, int n_cell_step )
+{
+    return spirit_index( geometry.n_cell_atoms ) * std::max( 1, geometry.n_cells[0] / n_cell_step )
+           * std::max( 1, geometry.n_cells[1] / n_cell_step ) * std::max( 1, geometry.n_cells[2] / n_cell_step );
+}
+
+void Spin_Snapshot::Export( const vectorfield & spins, const Geometry & geometry, int n_cell_step, float * directions )
+{
+    const int * atom_types = geometry.atom_types.data();
+    for_each_subsampled(
+        geometry, n_cell_step,
+        [&]( spirit_index i_target, spirit_index i_source )
+        {
+            const bool vacancy           = atom_types[i_source] < 0;
+            directions[3 * i_target]     = vacancy ? 0 : float( spins[i_source][0] );
+            directions[3 * i_target + 1] = vacancy ? 0 : float( spins[i_source][1] );
+            directions[3 * i_target + 2] = vacancy ? 0 : float( spins[i_source][2] );
+        } );
+}
+
+} // namespace Data
@@ -32,6 +32,13 @@ try : iteration_allowed( iteration_allowed ), singleshot_allowed( false ), hamil
     // Initialize Eigenvalues vector
     this->eigenvalues = std::vector<scalar>( this->modes.size(), 0 );
 
+    // No observables are recorded by default
+    this->observables = std::make_shared<Engine::Observables>();
+
+    this->snapshot = std::make_shared<Spin_Snapshot>();
+
+    this->hamiltonian_mutex = std::make_shared<std::mutex>();
+
     // ...
     this->E               = 0;
     this->E_array         = std::vector<std::pair<std::string, scalar>>( 0 );
@@ -61,23 +68,19 @@ try
     this->E_array         = other.E_array;
     this->effective_field = other.effective_field;
 
-    this->geometry = std::make_shared<Data::Geometry>( *other.geometry );
-
-    if( other.hamiltonian->Name() == "Heisenberg" )
-    {
-        this->hamiltonian = std::make_shared<Engine::Hamiltonian_Heisenberg>(
-            static_cast<Engine::Hamiltonian_Heisenberg &>( *other.hamiltonian ) );
-    }
-    else if( other.hamiltonian->Name() == "Gaussian" )
-    {
-        this->hamiltonian = std::make_shared<Engine::Hamiltonian_Gaussian>(
-            static_cast<Engine::Hamiltonian_Gaussian &>( *other.hamiltonian ) );
-    }
+    // The interactions and the lattice are only copied when one of the systems needs them for itself
+    this->geometry          = other.geometry;
+    this->hamiltonian       = other.hamiltonian;
+    this->hamiltonian_mutex = other.hamiltonian_mutex;
 
     this->llg_parameters = std::make_shared<Data::Parameters_Method_LLG>( *other.llg_parameters );
     this->mc_parameters  = std::make_shared<Data::Parameters_Method_MC>( *other.mc_parameters );
     this->ema_parameters = std::make_shared<Data::Parameters_Method_EMA>( *other.ema_parameters );
     this->mmf_parameters = std::make_shared<Data::Parameters_Method_MMF>( *other.mmf_parameters );
+    this->observables    = std::make_shared<Engine::Observables>( *other.observables );
+
+    // Snapshots are only published for the spins of this system
+    this->snapshot = std::make_shared<Spin_Snapshot>();
 
     this->iteration_allowed = false;
 }
@@ -106,23 +109,15 @@ try
         this->E_array         = other.E_array;
         this->effective_field = other.effective_field;
 
-        this->geometry = std::make_shared<Data::Geometry>( *other.geometry );
-
-        if( other.hamiltonian->Name() == "Heisenberg" )
-        {
-            this->hamiltonian = std::make_shared<Engine::Hamiltonian_Heisenberg>(
-                *(Engine::Hamiltonian_Heisenberg *)( other.hamiltonian.get() ) );
-        }
-        else if( other.hamiltonian->Name() == "Gaussian" )
-        {
-            this->hamiltonian = std::make_shared<Engine::Hamiltonian_Gaussian>(
-                *(Engine::Hamiltonian_Gaussian *)( other.hamiltonian.get() ) );
-        }
+        this->geometry          = other.geometry;
+        this->hamiltonian       = other.hamiltonian;
+        this->hamiltonian_mutex = other.hamiltonian_mutex;
 
         this->llg_parameters = std::make_shared<Data::Parameters_Method_LLG>( *other.llg_parameters );
         this->mc_parameters  = std::make_shared<Data::Parameters_Method_MC>( *other.mc_parameters );
         this->ema_parameters = std::make_shared<Data::Parameters_Method_EMA>( *other.ema_parameters );
         this->mmf_parameters = std::make_shared<Data::Parameters_Method_MMF>( *other.mmf_parameters );
+        this->observables    = std::make_shared<Engine::Observables>( *other.observables );
 
         this->iteration_allowed = false;
     }
@@ -138,8 +133,14 @@ catch( ... )
 void Spin_System::UpdateEnergy()
 try
 {
-    this->E_array = this->hamiltonian->Energy_Contributions( *this->spins );
-    scalar sum    = 0;
+    std::lock_guard<std::mutex> guard( *this->hamiltonian_mutex );
+
+    // While a method records the energy contributions, they are available from its last gradient calculation
+    if( const auto * record = this->hamiltonian->Recorded_Energy_Contributions() )
+        this->E_array = record->energies;
+    else
+        this->E_array = this->hamiltonian->Energy_Contributions( *this->spins );
+    scalar sum = 0;
     for( auto & E : E_array )
         sum += E.second;
     this->E = sum;
@@ -152,6 +153,8 @@ catch( ... )
 void Spin_System::UpdateEffectiveField()
 try
 {
+    std::lock_guard<std::mutex> guard( *this->hamiltonian_mutex );
+
     this->hamiltonian->Gradient( *this->spins, this->effective_field );
     Engine::Vectormath::scale( this->effective_field, -1 );
 }
@@ -160,6 +163,52 @@ catch( ... )
     spirit_rethrow( "Spin_System::UpdateEffectiveField failed" );
 }
 
+void Spin_System::Unshare_Hamiltonian()
+try
+{
+    if( !this->Hamiltonian_Is_Shared() )
+        return;
+
+    // The other systems may be using the Hamiltonian while it is copied
+    std::shared_ptr<Geometry> geometry;
+    std::shared_ptr<Engine::Hamiltonian> hamiltonian;
+    {
+        std::lock_guard<std::mutex> guard( *this->hamiltonian_mutex );
+
+        geometry = std::make_shared<Geometry>( *this->geometry );
+        if( this->hamiltonian->Name() == "Heisenberg" )
+        {
+            auto copy = std::make_shared<Engine::Hamiltonian_Heisenberg>(
+                static_cast<Engine::Hamiltonian_Heisenberg &>( *this->hamiltonian ) );
+            copy->geometry = geometry;
+            hamiltonian    = copy;
+        }
+        else if( this->hamiltonian->Name() == "Gaussian" )
+        {
+            hamiltonian = std::make_shared<Engine::Hamiltonian_Gaussian>(
+                static_cast<Engine::Hamiltonian_Gaussian &>( *this->hamiltonian ) );
+        }
+        else
+            spirit_throw(
+                Utility::Exception_Classifier::Unknown_Exception, Utility::Log_Level::Error,
+                "Cannot copy the " + this->hamiltonian->Name() + " Hamiltonian" );
+    }
+
+    this->geometry          = geometry;
+    this->hamiltonian       = hamiltonian;
+    this->hamiltonian_mutex = std::make_shared<std::mutex>();
+}
+catch( ... )
+{
+    spirit_rethrow( "Spin_System::Unshare_Hamiltonian failed" );
+}
+
+bool Spin_System::Hamiltonian_Is_Shared() const
+{
+    // Only the systems hold on to the mutex, while e.g. the IO functions may hold on to the Hamiltonian temporarily
+    return this->hamiltonian_mutex.use_count() > 1;
+}
+
 void Spin_System::Lock() noexcept
 try
 {
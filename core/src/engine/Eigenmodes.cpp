@@ -256,7 +256,9 @@ bool Sparse_Hessian_Partial_Spectrum(
     SpMatrixX hessian_constrained_3N = SpMatrixX( 3 * nos, 3 * nos );
     Manifoldmath::sparse_hessian_bordered_3N( spins, gradient, hessian, hessian_constrained_3N );
 
-    hessian_constrained = tangent_basis.transpose() * hessian_constrained_3N * tangent_basis;
+    field<Manifoldmath::Matrix3x2> basis;
+    Manifoldmath::tangent_basis_spherical( spins, basis );
+    Manifoldmath::change_basis( basis, hessian_constrained_3N, hessian_constrained );
 
     // TODO: Pinning (see non-sparse function for)
 
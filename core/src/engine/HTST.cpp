@@ -156,7 +156,7 @@ void Calculate( Data::HTST_Info & htst_info, int n_eigenmodes_keep )
              "Calculating perpendicular velocity at saddle point ('a' factors)..." );
         // Calculation of the 'a' parameters...
         htst_info.perpendicular_velocity = VectorX::Zero( 2 * nos );
-        MatrixX basis_sp                 = MatrixX::Zero( 3 * nos, 2 * nos );
+        field<Manifoldmath::Matrix3x2> basis_sp;
         Manifoldmath::tangent_basis_spherical( image_sp, basis_sp );
         // Manifoldmath::tangent_basis(image_sp, basis_sp);
         // Calculate_Perpendicular_Velocity_2N(image_sp, hessian_geodesic_sp_2N, basis_sp, htst_info.eigenvectors_sp,
@@ -385,8 +385,8 @@ scalar Calculate_Zero_Volume( const std::shared_ptr<Data::Spin_System> system )
 }
 
 void Calculate_Perpendicular_Velocity(
-    const vectorfield & spins, const scalarfield & mu_s, const MatrixX & hessian, const MatrixX & basis,
-    const MatrixX & eigenbasis, VectorX & perpendicular_velocity )
+    const vectorfield & spins, const scalarfield & mu_s, const MatrixX & hessian,
+    const field<Manifoldmath::Matrix3x2> & basis, const MatrixX & eigenbasis, VectorX & perpendicular_velocity )
 {
     int nos = spins.size();
 
@@ -402,12 +402,13 @@ void Calculate_Perpendicular_Velocity(
 
     // Project the velocity matrix into the 2N tangent space
     MatrixX velocity_projected( 2 * nos, 2 * nos );
-    velocity_projected = basis.transpose() * velocity * basis;
+    Manifoldmath::change_basis( basis, velocity, velocity_projected );
 
     Log( Utility::Log_Level::Info, Utility::Log_Sender::HTST, "  Calculate_Perpendicular_Velocity: calculate a" );
 
     // The velocity components orthogonal to the dividing surface
-    perpendicular_velocity = eigenbasis.col( 0 ).transpose() * ( velocity_projected * eigenbasis );
+    // Multiplying from the left first avoids the 2N x 2N matrix-matrix product
+    perpendicular_velocity = ( eigenbasis.col( 0 ).transpose() * velocity_projected ) * eigenbasis;
 
     // std::cerr << "  Calculate_Perpendicular_Velocity: sorting" << std::endl;
     // std::sort(perpendicular_velocity.data(),perpendicular_velocity.data()+perpendicular_velocity.size());
@@ -552,10 +553,10 @@ void Geodesic_Eigen_Decomposition(
     // Manifoldmath::hessian_covariant(image, gradient, hessian, hessian_geodesic_2N);
 
     // Do this manually
-    MatrixX basis = MatrixX::Zero( 3 * nos, 2 * nos );
+    field<Manifoldmath::Matrix3x2> basis;
     Manifoldmath::tangent_basis_spherical( image, basis );
     // Manifoldmath::tangent_basis(image, basis);
-    hessian_geodesic_2N = basis.transpose() * hessian_geodesic_3N * basis;
+    Manifoldmath::change_basis( basis, hessian_geodesic_3N, hessian_geodesic_2N );
 
     // Calculate full eigenspectrum
     Log( Utility::Log_Level::Info, Utility::Log_Sender::HTST, "    Calculation of full eigenspectrum..." );
@@ -100,7 +100,45 @@ void Hamiltonian::Gradient( const vectorfield & spins, vectorfield & gradient )
 void Hamiltonian::Gradient_and_Energy( const vectorfield & spins, vectorfield & gradient, scalar & energy )
 {
     this->Gradient( spins, gradient );
-    energy = this->Energy( spins );
+
+    if( !this->recording.active )
+    {
+        energy = this->Energy( spins );
+        return;
+    }
+
+    // The energy is calculated from its contributions anyway, so they can be recorded at no cost.
+    // Inclinations are not known for the contributions of a general Hamiltonian.
+    auto & record   = this->recording.record;
+    record.version  = this->recording.version;
+    record.energies = this->Energy_Contributions( spins );
+    record.dE_dRx   = std::vector<scalar>( 0 );
+    this->recording.valid = true;
+
+    energy = 0;
+    for( const auto & E : record.energies )
+        energy += E.second;
+}
+
+void Hamiltonian::Record_Energy_Contributions( std::uint64_t version, const vectorfield * tangent )
+{
+    this->recording.active  = true;
+    this->recording.version = version;
+    this->recording.tangent = tangent;
+}
+
+void Hamiltonian::Stop_Recording_Energy_Contributions()
+{
+    this->recording.active  = false;
+    this->recording.valid   = false;
+    this->recording.tangent = nullptr;
+}
+
+const Hamiltonian::Energy_Record * Hamiltonian::Recorded_Energy_Contributions() const
+{
+    if( this->recording.active && this->recording.valid )
+        return &this->recording.record;
+    return nullptr;
 }
 
 void Hamiltonian::Gradient_FD( const vectorfield & spins, vectorfield & gradient )
@@ -164,12 +202,17 @@ void Hamiltonian::Energy_Contributions_per_Spin(
         "Tried to use  Hamiltonian::Energy_Contributions_per_Spin() of the Hamiltonian base class!" );
 }
 
+void Hamiltonian::Stiffness( scalarfield & stiffness )
+{
+    Vectormath::fill( stiffness, 1 );
+}
+
 std::size_t Hamiltonian::Number_of_Interactions()
 {
     return energy_contributions_per_spin.size();
 }
 
-scalar Hamiltonian::Energy_Single_Spin( int ispin, const vectorfield & spins )
+scalar Hamiltonian::Energy_Single_Spin( spirit_index ispin, const vectorfield & spins )
 {
     // Not Implemented!
     spirit_throw(
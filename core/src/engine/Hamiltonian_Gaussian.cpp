@@ -106,7 +106,7 @@ void Hamiltonian_Gaussian::Energy_Contributions_per_Spin(
     }
 }
 
-scalar Hamiltonian_Gaussian::Energy_Single_Spin( int ispin, const vectorfield & spins )
+scalar Hamiltonian_Gaussian::Energy_Single_Spin( spirit_index ispin, const vectorfield & spins )
 {
     scalar Energy = 0;
     for( int i = 0; i < this->n_gaussians; ++i )
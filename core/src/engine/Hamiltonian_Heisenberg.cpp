@@ -11,6 +11,13 @@
 #include <engine/Neighbours.hpp>
 #include <engine/Vectormath.hpp>
 #include <utility/Constants.hpp>
+#include <utility/Exception.hpp>
+#include <utility/Profiling.hpp>
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <limits>
 
 using namespace Data;
 using namespace Utility;
@@ -100,14 +107,18 @@ Hamiltonian_Heisenberg::Hamiltonian_Heisenberg(
 
 void Hamiltonian_Heisenberg::Update_Interactions()
 {
-#if defined( SPIRIT_USE_OPENMP )
-    // When parallelising (cuda or openmp), we need all neighbours per spin
+#if defined( SPIRIT_USE_OPENMP ) || defined( SPIRIT_USE_THREADS )
+    // When parallelising (cuda, openmp or threads), we need all neighbours per spin
     const bool use_redundant_neighbours = true;
 #else
     // When running on a single thread, we can ignore redundant neighbours
     const bool use_redundant_neighbours = false;
 #endif
 
+    // The neighbour shells of exchange and DMI are built together and only rebuilt if the lattice changed
+    const auto & neighbour_shells = this->neighbour_shell_cache.Get(
+        *geometry, std::max( exchange_shell_magnitudes.size(), dmi_shell_magnitudes.size() ) );
+
     // Exchange
     this->exchange_pairs      = pairfield( 0 );
     this->exchange_magnitudes = scalarfield( 0 );
@@ -116,7 +127,8 @@ void Hamiltonian_Heisenberg::Update_Interactions()
         // Generate Exchange neighbours
         intfield exchange_shells( 0 );
         Neighbours::Get_Neighbours_in_Shells(
-            *geometry, exchange_shell_magnitudes.size(), exchange_pairs, exchange_shells, use_redundant_neighbours );
+            neighbour_shells, exchange_shell_magnitudes.size(), exchange_pairs, exchange_shells,
+            use_redundant_neighbours );
         for( std::size_t ipair = 0; ipair < exchange_pairs.size(); ++ipair )
         {
             this->exchange_magnitudes.push_back( exchange_shell_magnitudes[exchange_shells[ipair]] );
@@ -148,7 +160,7 @@ void Hamiltonian_Heisenberg::Update_Interactions()
         // Generate DMI neighbours and normals
         intfield dmi_shells( 0 );
         Neighbours::Get_Neighbours_in_Shells(
-            *geometry, dmi_shell_magnitudes.size(), dmi_pairs, dmi_shells, use_redundant_neighbours );
+            neighbour_shells, dmi_shell_magnitudes.size(), dmi_pairs, dmi_shells, use_redundant_neighbours );
         for( std::size_t ineigh = 0; ineigh < dmi_pairs.size(); ++ineigh )
         {
             this->dmi_normals.push_back(
@@ -193,10 +205,65 @@ void Hamiltonian_Heisenberg::Update_Interactions()
     // Dipole-dipole
     this->Prepare_DDI();
 
+    // Per-site tables of exchange and DMI, only used if there are vacancies
+    this->Update_Site_Pairs( true );
+
     // Update, which terms still contribute
     this->Update_Energy_Contributions();
 }
 
+Hamiltonian_Heisenberg::Site_Pairs Hamiltonian_Heisenberg::Get_Site_Pairs( const pairfield & pairs ) const
+{
+    Site_Pairs site_pairs;
+    site_pairs.offsets.push_back( 0 );
+    for( spirit_index ispin = 0; ispin < geometry->nos; ++ispin )
+    {
+        if( !check_atom_type( geometry->atom_types[ispin] ) )
+            continue;
+
+        site_pairs.sites.push_back( ispin );
+        for( unsigned int i_pair = 0; i_pair < pairs.size(); ++i_pair )
+        {
+            spirit_index jspin = idx_from_pair(
+                ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
+                pairs[i_pair] );
+            if( jspin >= 0 )
+            {
+                site_pairs.partners.push_back( jspin );
+                site_pairs.pair_indices.push_back( i_pair );
+            }
+        }
+        site_pairs.offsets.push_back( site_pairs.partners.size() );
+    }
+    return site_pairs;
+}
+
+bool Hamiltonian_Heisenberg::Update_Site_Pairs( bool force )
+{
+#ifdef SPIRIT_ENABLE_DEFECTS
+    // Vacancies may also be set after the interactions were updated, e.g. when reading a spin configuration
+    if( !force && this->site_pairs_atom_types == geometry->atom_types )
+        return this->use_site_pairs;
+
+    this->site_pairs_atom_types = geometry->atom_types;
+    this->use_site_pairs        = std::any_of(
+        geometry->atom_types.begin(), geometry->atom_types.end(),
+        []( int atom_type ) { return !check_atom_type( atom_type ); } );
+
+    if( this->use_site_pairs )
+    {
+        this->exchange_site_pairs = Get_Site_Pairs( this->exchange_pairs );
+        this->dmi_site_pairs      = Get_Site_Pairs( this->dmi_pairs );
+    }
+    else
+    {
+        this->exchange_site_pairs = Site_Pairs();
+        this->dmi_site_pairs      = Site_Pairs();
+    }
+#endif
+    return this->use_site_pairs;
+}
+
 void Hamiltonian_Heisenberg::Update_Energy_Contributions()
 {
     this->energy_contributions_per_spin = std::vector<std::pair<std::string, scalarfield>>( 0 );
@@ -267,7 +334,7 @@ void Hamiltonian_Heisenberg::Energy_Contributions_per_Spin(
         contributions = this->energy_contributions_per_spin;
     }
 
-    int nos = spins.size();
+    spirit_index nos = spins.size();
     for( auto & contrib : contributions )
     {
         // Allocate if not already allocated
@@ -309,98 +376,133 @@ void Hamiltonian_Heisenberg::E_Zeeman( const vectorfield & spins, scalarfield &
     const int N = geometry->n_cell_atoms;
     auto & mu_s = this->geometry->mu_s;
 
-#pragma omp parallel for
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
-    {
-        for( int ibasis = 0; ibasis < N; ++ibasis )
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = icell * N + ibasis;
-            if( check_atom_type( this->geometry->atom_types[ispin] ) )
-                Energy[ispin]
-                    -= mu_s[ispin] * this->external_field_magnitude * this->external_field_normal.dot( spins[ispin] );
-        }
-    }
+            for( int ibasis = 0; ibasis < N; ++ibasis )
+            {
+                spirit_index ispin = icell * N + ibasis;
+                if( check_atom_type( this->geometry->atom_types[ispin] ) )
+                    Energy[ispin] -= mu_s[ispin] * this->external_field_magnitude
+                                     * this->external_field_normal.dot( spins[ispin] );
+            }
+        } );
 }
 
 void Hamiltonian_Heisenberg::E_Anisotropy( const vectorfield & spins, scalarfield & Energy )
 {
     const int N = geometry->n_cell_atoms;
 
-#pragma omp parallel for
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
-    {
-        for( int iani = 0; iani < anisotropy_indices.size(); ++iani )
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = icell * N + anisotropy_indices[iani];
-            if( check_atom_type( this->geometry->atom_types[ispin] ) )
-                Energy[ispin] -= this->anisotropy_magnitudes[iani]
-                                 * std::pow( anisotropy_normals[iani].dot( spins[ispin] ), 2.0 );
-        }
-    }
+            for( int iani = 0; iani < anisotropy_indices.size(); ++iani )
+            {
+                spirit_index ispin = icell * N + anisotropy_indices[iani];
+                if( check_atom_type( this->geometry->atom_types[ispin] ) )
+                    Energy[ispin] -= this->anisotropy_magnitudes[iani]
+                                     * std::pow( anisotropy_normals[iani].dot( spins[ispin] ), 2.0 );
+            }
+        } );
 }
 
 void Hamiltonian_Heisenberg::E_Cubic_Anisotropy( const vectorfield & spins, scalarfield & Energy )
 {
     const int N = geometry->n_cell_atoms;
 
-#pragma omp parallel for
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
-    {
-        for( int iani = 0; iani < cubic_anisotropy_indices.size(); ++iani )
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = icell * N + cubic_anisotropy_indices[iani];
-            if( check_atom_type( this->geometry->atom_types[ispin] ) )
-                Energy[ispin] -= this->cubic_anisotropy_magnitudes[iani] / 2
-                                 * ( std::pow( spins[ispin][0], 4.0 ) + std::pow( spins[ispin][1], 4.0 )
-                                     + std::pow( spins[ispin][2], 4.0 ) );
-        }
-    }
+            for( int iani = 0; iani < cubic_anisotropy_indices.size(); ++iani )
+            {
+                spirit_index ispin = icell * N + cubic_anisotropy_indices[iani];
+                if( check_atom_type( this->geometry->atom_types[ispin] ) )
+                    Energy[ispin] -= this->cubic_anisotropy_magnitudes[iani] / 2
+                                     * ( std::pow( spins[ispin][0], 4.0 ) + std::pow( spins[ispin][1], 4.0 )
+                                         + std::pow( spins[ispin][2], 4.0 ) );
+            }
+        } );
 }
 
 void Hamiltonian_Heisenberg::E_Exchange( const vectorfield & spins, scalarfield & Energy )
 {
-#pragma omp parallel for
-    for( unsigned int icell = 0; icell < geometry->n_cells_total; ++icell )
+    auto energy_pair = [&]( spirit_index ispin, spirit_index jspin, int i_pair )
     {
-        for( unsigned int i_pair = 0; i_pair < exchange_pairs.size(); ++i_pair )
+        Energy[ispin] -= 0.5 * exchange_magnitudes[i_pair] * spins[ispin].dot( spins[jspin] );
+#if !defined( SPIRIT_USE_OPENMP ) && !defined( SPIRIT_USE_THREADS )
+        Energy[jspin] -= 0.5 * exchange_magnitudes[i_pair] * spins[ispin].dot( spins[jspin] );
+#endif
+    };
+
+    if( this->Update_Site_Pairs() )
+    {
+        const auto & site_pairs = this->exchange_site_pairs;
+        Backend::par::apply(
+            site_pairs.sites.size(),
+            [&]( int isite )
+            {
+                for( int k = site_pairs.offsets[isite]; k < site_pairs.offsets[isite + 1]; ++k )
+                    energy_pair( site_pairs.sites[isite], site_pairs.partners[k], site_pairs.pair_indices[k] );
+            } );
+        return;
+    }
+
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = exchange_pairs[i_pair].i + icell * geometry->n_cell_atoms;
-            int jspin = idx_from_pair(
-                ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
-                exchange_pairs[i_pair] );
-            if( jspin >= 0 )
+            for( unsigned int i_pair = 0; i_pair < exchange_pairs.size(); ++i_pair )
             {
-                Energy[ispin] -= 0.5 * exchange_magnitudes[i_pair] * spins[ispin].dot( spins[jspin] );
-#ifndef SPIRIT_USE_OPENMP
-                Energy[jspin] -= 0.5 * exchange_magnitudes[i_pair] * spins[ispin].dot( spins[jspin] );
-#endif
+                spirit_index ispin = exchange_pairs[i_pair].i + icell * geometry->n_cell_atoms;
+                spirit_index jspin = idx_from_pair(
+                    ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
+                    exchange_pairs[i_pair] );
+                if( jspin >= 0 )
+                    energy_pair( ispin, jspin, i_pair );
             }
-        }
-    }
+        } );
 }
 
 void Hamiltonian_Heisenberg::E_DMI( const vectorfield & spins, scalarfield & Energy )
 {
-#pragma omp parallel for
-    for( unsigned int icell = 0; icell < geometry->n_cells_total; ++icell )
+    auto energy_pair = [&]( spirit_index ispin, spirit_index jspin, int i_pair )
     {
-        for( unsigned int i_pair = 0; i_pair < dmi_pairs.size(); ++i_pair )
+        Energy[ispin] -= 0.5 * dmi_magnitudes[i_pair] * dmi_normals[i_pair].dot( spins[ispin].cross( spins[jspin] ) );
+#if !defined( SPIRIT_USE_OPENMP ) && !defined( SPIRIT_USE_THREADS )
+        Energy[jspin] -= 0.5 * dmi_magnitudes[i_pair] * dmi_normals[i_pair].dot( spins[ispin].cross( spins[jspin] ) );
+#endif
+    };
+
+    if( this->Update_Site_Pairs() )
+    {
+        const auto & site_pairs = this->dmi_site_pairs;
+        Backend::par::apply(
+            site_pairs.sites.size(),
+            [&]( int isite )
+            {
+                for( int k = site_pairs.offsets[isite]; k < site_pairs.offsets[isite + 1]; ++k )
+                    energy_pair( site_pairs.sites[isite], site_pairs.partners[k], site_pairs.pair_indices[k] );
+            } );
+        return;
+    }
+
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = dmi_pairs[i_pair].i + icell * geometry->n_cell_atoms;
-            int jspin = idx_from_pair(
-                ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
-                dmi_pairs[i_pair] );
-            if( jspin >= 0 )
+            for( unsigned int i_pair = 0; i_pair < dmi_pairs.size(); ++i_pair )
             {
-                Energy[ispin]
-                    -= 0.5 * dmi_magnitudes[i_pair] * dmi_normals[i_pair].dot( spins[ispin].cross( spins[jspin] ) );
-#ifndef SPIRIT_USE_OPENMP
-                Energy[jspin]
-                    -= 0.5 * dmi_magnitudes[i_pair] * dmi_normals[i_pair].dot( spins[ispin].cross( spins[jspin] ) );
-#endif
+                spirit_index ispin = dmi_pairs[i_pair].i + icell * geometry->n_cell_atoms;
+                spirit_index jspin = idx_from_pair(
+                    ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
+                    dmi_pairs[i_pair] );
+                if( jspin >= 0 )
+                    energy_pair( ispin, jspin, i_pair );
             }
-        }
-    }
+        } );
 }
 
 void Hamiltonian_Heisenberg::E_DDI( const vectorfield & spins, scalarfield & Energy )
@@ -424,9 +526,9 @@ void Hamiltonian_Heisenberg::E_DDI_Direct( const vectorfield & spins, scalarfiel
     Vectormath::fill( gradients_temp, { 0, 0, 0 } );
     this->Gradient_DDI_Direct( spins, gradients_temp );
 
-#pragma omp parallel for
-    for( int ispin = 0; ispin < geometry->nos; ispin++ )
-        Energy[ispin] += 0.5 * spins[ispin].dot( gradients_temp[ispin] );
+    Backend::par::apply(
+        geometry->nos,
+        [&]( spirit_index ispin ) { Energy[ispin] += 0.5 * spins[ispin].dot( gradients_temp[ispin] ); } );
 }
 
 void Hamiltonian_Heisenberg::E_DDI_Cutoff( const vectorfield & spins, scalarfield & Energy )
@@ -450,10 +552,10 @@ void Hamiltonian_Heisenberg::E_DDI_Cutoff( const vectorfield & spins, scalarfiel
                         std::array<int, 3> translations = { da, db, dc };
                         int i                           = ddi_pairs[i_pair].i;
                         int j                           = ddi_pairs[i_pair].j;
-                        int ispin                       = i
+                        spirit_index ispin              = i
                                     + Vectormath::idx_from_translations(
                                         geometry->n_cells, geometry->n_cell_atoms, translations );
-                        int jspin = idx_from_pair(
+                        spirit_index jspin = idx_from_pair(
                             ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                             ddi_pairs[i_pair] );
                         if( jspin >= 0 )
@@ -502,12 +604,9 @@ void Hamiltonian_Heisenberg::E_DDI_FFT( const vectorfield & spins, scalarfield &
 //==== DEBUG: end gradient comparison ====
 
 // TODO: add dot_scaled to Vectormath and use that
-#pragma omp parallel for
-    for( int ispin = 0; ispin < geometry->nos; ispin++ )
-    {
-        Energy[ispin] += 0.5 * spins[ispin].dot( gradients_temp[ispin] );
-        // Energy_DDI    += 0.5 * spins[ispin].dot(gradients_temp[ispin]);
-    }
+    Backend::par::apply(
+        geometry->nos,
+        [&]( spirit_index ispin ) { Energy[ispin] += 0.5 * spins[ispin].dot( gradients_temp[ispin] ); } );
 }
 
 void Hamiltonian_Heisenberg::E_Quadruplet( const vectorfield & spins, scalarfield & Energy )
@@ -526,16 +625,16 @@ void Hamiltonian_Heisenberg::E_Quadruplet( const vectorfield & spins, scalarfiel
             {
                 for( int dc = 0; dc < geometry->n_cells[2]; ++dc )
                 {
-                    int ispin = i
+                    spirit_index ispin = i
                                 + Vectormath::idx_from_translations(
                                     geometry->n_cells, geometry->n_cell_atoms, { da, db, dc } );
-                    int jspin = idx_from_pair(
+                    spirit_index jspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         { i, j, quad.d_j } );
-                    int kspin = idx_from_pair(
+                    spirit_index kspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         { i, k, quad.d_k } );
-                    int lspin = idx_from_pair(
+                    spirit_index lspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         { i, l, quad.d_l } );
 
@@ -556,14 +655,63 @@ void Hamiltonian_Heisenberg::E_Quadruplet( const vectorfield & spins, scalarfiel
     }
 }
 
-scalar Hamiltonian_Heisenberg::Energy_Single_Spin( int ispin, const vectorfield & spins )
+void Hamiltonian_Heisenberg::Stiffness( scalarfield & stiffness )
+{
+    const int N = geometry->n_cell_atoms;
+    Vectormath::fill( stiffness, 0 );
+
+    for( spirit_index icell = 0; icell < geometry->n_cells_total; ++icell )
+    {
+        // External field
+        for( int ibasis = 0; ibasis < N; ++ibasis )
+        {
+            spirit_index ispin = icell * N + ibasis;
+            stiffness[ispin] += std::abs( geometry->mu_s[ispin] * external_field_magnitude );
+        }
+
+        // Anisotropies
+        for( int iani = 0; iani < anisotropy_indices.size(); ++iani )
+            stiffness[icell * N + anisotropy_indices[iani]] += 2 * std::abs( anisotropy_magnitudes[iani] );
+        for( int iani = 0; iani < cubic_anisotropy_indices.size(); ++iani )
+            stiffness[icell * N + cubic_anisotropy_indices[iani]] += 2 * std::abs( cubic_anisotropy_magnitudes[iani] );
+
+        // Exchange and DMI
+        auto add_pairs = [&]( const pairfield & pairs, const scalarfield & magnitudes )
+        {
+            for( unsigned int i_pair = 0; i_pair < pairs.size(); ++i_pair )
+            {
+                spirit_index ispin = pairs[i_pair].i + icell * N;
+                spirit_index jspin = idx_from_pair(
+                    ispin, boundary_conditions, geometry->n_cells, N, geometry->atom_types, pairs[i_pair] );
+                if( jspin >= 0 )
+                {
+                    stiffness[ispin] += std::abs( magnitudes[i_pair] );
+#if !defined( SPIRIT_USE_OPENMP ) && !defined( SPIRIT_USE_THREADS )
+                    stiffness[jspin] += std::abs( magnitudes[i_pair] );
+#endif
+                }
+            }
+        };
+        add_pairs( exchange_pairs, exchange_magnitudes );
+        add_pairs( dmi_pairs, dmi_magnitudes );
+    }
+
+    // Vacancies are not held by anything
+    for( spirit_index ispin = 0; ispin < geometry->nos; ++ispin )
+    {
+        if( !check_atom_type( geometry->atom_types[ispin] ) )
+            stiffness[ispin] = 0;
+    }
+}
+
+scalar Hamiltonian_Heisenberg::Energy_Single_Spin( spirit_index ispin, const vectorfield & spins )
 {
     scalar Energy = 0;
     if( check_atom_type( this->geometry->atom_types[ispin] ) )
     {
-        int icell   = ispin / this->geometry->n_cell_atoms;
-        int ibasis  = ispin - icell * this->geometry->n_cell_atoms;
-        auto & mu_s = this->geometry->mu_s;
+        spirit_index icell = ispin / this->geometry->n_cell_atoms;
+        int ibasis         = ispin - icell * this->geometry->n_cell_atoms;
+        auto & mu_s        = this->geometry->mu_s;
         Pair pair_inv;
 
         // External field
@@ -607,18 +755,18 @@ scalar Hamiltonian_Heisenberg::Energy_Single_Spin( int ispin, const vectorfield
                 const auto & pair = exchange_pairs[ipair];
                 if( pair.i == ibasis )
                 {
-                    int jspin = idx_from_pair(
+                    spirit_index jspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         pair );
                     if( jspin >= 0 )
                         Energy -= this->exchange_magnitudes[ipair] * spins[ispin].dot( spins[jspin] );
                 }
-#ifndef SPIRIT_USE_OPENMP
+#if !defined( SPIRIT_USE_OPENMP ) && !defined( SPIRIT_USE_THREADS )
                 if( pair.j == ibasis )
                 {
-                    const auto & t = pair.translations;
-                    pair_inv       = Pair{ pair.j, pair.i, { -t[0], -t[1], -t[2] } };
-                    int jspin      = idx_from_pair(
+                    const auto & t     = pair.translations;
+                    pair_inv           = Pair{ pair.j, pair.i, { -t[0], -t[1], -t[2] } };
+                    spirit_index jspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         pair_inv );
                     if( jspin >= 0 )
@@ -636,19 +784,19 @@ scalar Hamiltonian_Heisenberg::Energy_Single_Spin( int ispin, const vectorfield
                 const auto & pair = dmi_pairs[ipair];
                 if( pair.i == ibasis )
                 {
-                    int jspin = idx_from_pair(
+                    spirit_index jspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         pair );
                     if( jspin >= 0 )
                         Energy -= this->dmi_magnitudes[ipair]
                                   * this->dmi_normals[ipair].dot( spins[ispin].cross( spins[jspin] ) );
                 }
-#ifndef SPIRIT_USE_OPENMP
+#if !defined( SPIRIT_USE_OPENMP ) && !defined( SPIRIT_USE_THREADS )
                 if( pair.j == ibasis )
                 {
-                    const auto & t = pair.translations;
-                    pair_inv       = Pair{ pair.j, pair.i, { -t[0], -t[1], -t[2] } };
-                    int jspin      = idx_from_pair(
+                    const auto & t     = pair.translations;
+                    pair_inv           = Pair{ pair.j, pair.i, { -t[0], -t[1], -t[2] } };
+                    spirit_index jspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         pair_inv );
                     if( jspin >= 0 )
@@ -669,6 +817,8 @@ scalar Hamiltonian_Heisenberg::Energy_Single_Spin( int ispin, const vectorfield
 
 void Hamiltonian_Heisenberg::Gradient( const vectorfield & spins, vectorfield & gradient )
 {
+    SPIRIT_PROFILE( Gradient );
+
     // Set to zero
     Vectormath::fill( gradient, { 0, 0, 0 } );
 
@@ -703,168 +853,272 @@ void Hamiltonian_Heisenberg::Gradient( const vectorfield & spins, vectorfield &
 
 void Hamiltonian_Heisenberg::Gradient_and_Energy( const vectorfield & spins, vectorfield & gradient, scalar & energy )
 {
+    SPIRIT_PROFILE( Gradient );
 
     // Set to zero
     Vectormath::fill( gradient, { 0, 0, 0 } );
     energy = 0;
 
-    auto N    = spins.size();
-    auto s    = spins.data();
-    auto mu_s = geometry->mu_s.data();
-    auto g    = gradient.data();
+    // Each interaction is homogeneous in the spins, so its energy follows from its gradient as E = s*g/p, where p is
+    // the degree of the interaction. The gradients are summed up one interaction after the other and the energy is
+    // obtained from the change of s*g, which takes one reduction instead of a separate energy sweep.
+    auto & record        = this->recording.record;
+    const auto * tangent = this->recording.active ? this->recording.tangent : nullptr;
+    if( this->recording.active )
+    {
+        record.version = this->recording.version;
+        if( record.energies.size() != this->energy_contributions_per_spin.size() )
+        {
+            record.energies = std::vector<std::pair<std::string, scalar>>( this->energy_contributions_per_spin.size() );
+            for( std::size_t i = 0; i < record.energies.size(); ++i )
+                record.energies[i].first = this->energy_contributions_per_spin[i].first;
+        }
+        record.dE_dRx = std::vector<scalar>( tangent != nullptr ? record.energies.size() : 0, 0 );
+    }
+
+    // The interactions which were added since the last reduction
+    scalar s_dot_g        = 0;
+    scalar t_dot_g        = 0;
+    int idx_pending       = -1;
+    scalar degree_pending = 0;
+
+    auto reduce_pending = [&]()
+    {
+        if( idx_pending < 0 )
+            return;
+
+        const scalar s_dot_g_new = Vectormath::dot( spins, gradient );
+        const scalar E           = ( s_dot_g_new - s_dot_g ) / degree_pending;
+        s_dot_g                  = s_dot_g_new;
+        energy += E;
+
+        if( this->recording.active )
+        {
+            record.energies[idx_pending].second = E;
+            if( tangent != nullptr )
+            {
+                const scalar t_dot_g_new    = Vectormath::dot( *tangent, gradient );
+                record.dE_dRx[idx_pending] = t_dot_g - t_dot_g_new;
+                t_dot_g                     = t_dot_g_new;
+            }
+        }
+        idx_pending = -1;
+    };
+
+    // Has to be called before the gradient of an interaction is added. Unless the energies are recorded,
+    // consecutive interactions of the same degree share one reduction.
+    auto next_interaction = [&]( int idx, scalar degree )
+    {
+        if( this->recording.active || degree != degree_pending )
+            reduce_pending();
+        idx_pending    = idx;
+        degree_pending = degree;
+    };
 
     // Anisotropy
     if( idx_anisotropy >= 0 )
+    {
+        next_interaction( idx_anisotropy, 2 );
         this->Gradient_Anisotropy( spins, gradient );
+    }
 
     // Exchange
     if( idx_exchange >= 0 )
+    {
+        next_interaction( idx_exchange, 2 );
         this->Gradient_Exchange( spins, gradient );
+    }
 
     // DMI
     if( idx_dmi >= 0 )
+    {
+        next_interaction( idx_dmi, 2 );
         this->Gradient_DMI( spins, gradient );
+    }
 
     // DDI
     if( idx_ddi >= 0 )
-        this->Gradient_DDI( spins, gradient );
-
-    energy += Backend::par::reduce( N, [s, g] SPIRIT_LAMBDA( int idx ) { return 0.5 * g[idx].dot( s[idx] ); } );
-
-    // Cubic Anisotropy
-    if( idx_cubic_anisotropy >= 0 )
     {
-        this->Gradient_Cubic_Anisotropy( spins, gradient );
-
-        scalarfield energy_cubic( N );
-        this->E_Cubic_Anisotropy( spins, energy_cubic );
-        energy += Vectormath::sum( energy_cubic );
+        next_interaction( idx_ddi, 2 );
+        this->Gradient_DDI( spins, gradient );
     }
 
     // External field
     if( idx_zeeman >= 0 )
     {
-        Vector3 ext_field = external_field_normal * external_field_magnitude;
+        next_interaction( idx_zeeman, 1 );
         this->Gradient_Zeeman( gradient );
-        energy += Backend::par::reduce(
-            N, [s, ext_field, mu_s] SPIRIT_LAMBDA( int idx ) { return -mu_s[idx] * ext_field.dot( s[idx] ); } );
+    }
+
+    // Cubic Anisotropy
+    if( idx_cubic_anisotropy >= 0 )
+    {
+        next_interaction( idx_cubic_anisotropy, 4 );
+        this->Gradient_Cubic_Anisotropy( spins, gradient );
     }
 
     // Quadruplets
-    if( idx_quadruplet > 0 )
+    if( idx_quadruplet >= 0 )
     {
-        // Kind of a bandaid fix
+        next_interaction( idx_quadruplet, 4 );
         this->Gradient_Quadruplet( spins, gradient );
-        if( energy_contributions_per_spin[idx_quadruplet].second.size() != spins.size() )
-        {
-            energy_contributions_per_spin[idx_quadruplet].second.resize( spins.size() );
-        };
-        Vectormath::fill( energy_contributions_per_spin[idx_quadruplet].second, 0 );
-        E_Quadruplet( spins, energy_contributions_per_spin[idx_quadruplet].second );
-        energy += Vectormath::sum( energy_contributions_per_spin[idx_quadruplet].second );
     }
+
+    reduce_pending();
+
+    if( this->recording.active )
+        this->recording.valid = true;
 }
 
 void Hamiltonian_Heisenberg::Gradient_Zeeman( vectorfield & gradient )
 {
+    SPIRIT_PROFILE( Zeeman );
+
     const int N = geometry->n_cell_atoms;
     auto & mu_s = this->geometry->mu_s;
 
-#pragma omp parallel for
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
-    {
-        for( int ibasis = 0; ibasis < N; ++ibasis )
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = icell * N + ibasis;
-            if( check_atom_type( this->geometry->atom_types[ispin] ) )
-                gradient[ispin] -= mu_s[ispin] * this->external_field_magnitude * this->external_field_normal;
-        }
-    }
+            for( int ibasis = 0; ibasis < N; ++ibasis )
+            {
+                spirit_index ispin = icell * N + ibasis;
+                if( check_atom_type( this->geometry->atom_types[ispin] ) )
+                    gradient[ispin] -= mu_s[ispin] * this->external_field_magnitude * this->external_field_normal;
+            }
+        } );
 }
 
 void Hamiltonian_Heisenberg::Gradient_Anisotropy( const vectorfield & spins, vectorfield & gradient )
 {
+    SPIRIT_PROFILE( Anisotropy );
+
     const int N = geometry->n_cell_atoms;
 
-#pragma omp parallel for
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
-    {
-        for( int iani = 0; iani < anisotropy_indices.size(); ++iani )
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = icell * N + anisotropy_indices[iani];
-            if( check_atom_type( this->geometry->atom_types[ispin] ) )
-                gradient[ispin] -= 2.0 * this->anisotropy_magnitudes[iani] * this->anisotropy_normals[iani]
-                                   * anisotropy_normals[iani].dot( spins[ispin] );
-        }
-    }
+            for( int iani = 0; iani < anisotropy_indices.size(); ++iani )
+            {
+                spirit_index ispin = icell * N + anisotropy_indices[iani];
+                if( check_atom_type( this->geometry->atom_types[ispin] ) )
+                    gradient[ispin] -= 2.0 * this->anisotropy_magnitudes[iani] * this->anisotropy_normals[iani]
+                                       * anisotropy_normals[iani].dot( spins[ispin] );
+            }
+        } );
 }
 
 void Hamiltonian_Heisenberg::Gradient_Cubic_Anisotropy( const vectorfield & spins, vectorfield & gradient )
 {
+    SPIRIT_PROFILE( Cubic_Anisotropy );
+
     const int N = geometry->n_cell_atoms;
 
-#pragma omp parallel for
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
-    {
-        for( int iani = 0; iani < cubic_anisotropy_indices.size(); ++iani )
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = icell * N + cubic_anisotropy_indices[iani];
-            if( check_atom_type( this->geometry->atom_types[ispin] ) )
-                for( int icomp = 0; icomp < 3; ++icomp )
-                {
-                    gradient[ispin][icomp]
-                        -= 2.0 * this->cubic_anisotropy_magnitudes[iani] * std::pow( spins[ispin][icomp], 3.0 );
-                }
-        }
-    }
+            for( int iani = 0; iani < cubic_anisotropy_indices.size(); ++iani )
+            {
+                spirit_index ispin = icell * N + cubic_anisotropy_indices[iani];
+                if( check_atom_type( this->geometry->atom_types[ispin] ) )
+                    for( int icomp = 0; icomp < 3; ++icomp )
+                    {
+                        gradient[ispin][icomp]
+                            -= 2.0 * this->cubic_anisotropy_magnitudes[iani] * std::pow( spins[ispin][icomp], 3.0 );
+                    }
+            }
+        } );
 }
 
 void Hamiltonian_Heisenberg::Gradient_Exchange( const vectorfield & spins, vectorfield & gradient )
 {
-#pragma omp parallel for
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
+    SPIRIT_PROFILE( Exchange );
+
+    auto gradient_pair = [&]( spirit_index ispin, spirit_index jspin, int i_pair )
     {
-        for( unsigned int i_pair = 0; i_pair < exchange_pairs.size(); ++i_pair )
+        gradient[ispin] -= exchange_magnitudes[i_pair] * spins[jspin];
+#if !defined( SPIRIT_USE_OPENMP ) && !defined( SPIRIT_USE_THREADS )
+        gradient[jspin] -= exchange_magnitudes[i_pair] * spins[ispin];
+#endif
+    };
+
+    if( this->Update_Site_Pairs() )
+    {
+        const auto & site_pairs = this->exchange_site_pairs;
+        Backend::par::apply(
+            site_pairs.sites.size(),
+            [&]( int isite )
+            {
+                for( int k = site_pairs.offsets[isite]; k < site_pairs.offsets[isite + 1]; ++k )
+                    gradient_pair( site_pairs.sites[isite], site_pairs.partners[k], site_pairs.pair_indices[k] );
+            } );
+        return;
+    }
+
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = exchange_pairs[i_pair].i + icell * geometry->n_cell_atoms;
-            int jspin = idx_from_pair(
-                ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
-                exchange_pairs[i_pair] );
-            if( jspin >= 0 )
+            for( unsigned int i_pair = 0; i_pair < exchange_pairs.size(); ++i_pair )
             {
-                gradient[ispin] -= exchange_magnitudes[i_pair] * spins[jspin];
-#ifndef SPIRIT_USE_OPENMP
-                gradient[jspin] -= exchange_magnitudes[i_pair] * spins[ispin];
-#endif
+                spirit_index ispin = exchange_pairs[i_pair].i + icell * geometry->n_cell_atoms;
+                spirit_index jspin = idx_from_pair(
+                    ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
+                    exchange_pairs[i_pair] );
+                if( jspin >= 0 )
+                    gradient_pair( ispin, jspin, i_pair );
             }
-        }
-    }
+        } );
 }
 
 void Hamiltonian_Heisenberg::Gradient_DMI( const vectorfield & spins, vectorfield & gradient )
 {
-#pragma omp parallel for
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
+    SPIRIT_PROFILE( DMI );
+
+    auto gradient_pair = [&]( spirit_index ispin, spirit_index jspin, int i_pair )
     {
-        for( unsigned int i_pair = 0; i_pair < dmi_pairs.size(); ++i_pair )
+        gradient[ispin] -= dmi_magnitudes[i_pair] * spins[jspin].cross( dmi_normals[i_pair] );
+#if !defined( SPIRIT_USE_OPENMP ) && !defined( SPIRIT_USE_THREADS )
+        gradient[jspin] += dmi_magnitudes[i_pair] * spins[ispin].cross( dmi_normals[i_pair] );
+#endif
+    };
+
+    if( this->Update_Site_Pairs() )
+    {
+        const auto & site_pairs = this->dmi_site_pairs;
+        Backend::par::apply(
+            site_pairs.sites.size(),
+            [&]( int isite )
+            {
+                for( int k = site_pairs.offsets[isite]; k < site_pairs.offsets[isite + 1]; ++k )
+                    gradient_pair( site_pairs.sites[isite], site_pairs.partners[k], site_pairs.pair_indices[k] );
+            } );
+        return;
+    }
+
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = dmi_pairs[i_pair].i + icell * geometry->n_cell_atoms;
-            int jspin = idx_from_pair(
-                ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
-                dmi_pairs[i_pair] );
-            if( jspin >= 0 )
+            for( unsigned int i_pair = 0; i_pair < dmi_pairs.size(); ++i_pair )
             {
-                gradient[ispin] -= dmi_magnitudes[i_pair] * spins[jspin].cross( dmi_normals[i_pair] );
-#ifndef SPIRIT_USE_OPENMP
-                gradient[jspin] += dmi_magnitudes[i_pair] * spins[ispin].cross( dmi_normals[i_pair] );
-#endif
+                spirit_index ispin = dmi_pairs[i_pair].i + icell * geometry->n_cell_atoms;
+                spirit_index jspin = idx_from_pair(
+                    ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
+                    dmi_pairs[i_pair] );
+                if( jspin >= 0 )
+                    gradient_pair( ispin, jspin, i_pair );
             }
-        }
-    }
+        } );
 }
 
 void Hamiltonian_Heisenberg::Gradient_DDI( const vectorfield & spins, vectorfield & gradient )
 {
+    SPIRIT_PROFILE( DDI );
+
     if( this->ddi_method == DDI_Method::FFT )
         this->Gradient_DDI_FFT( spins, gradient );
     else if( this->ddi_method == DDI_Method::Cutoff )
@@ -896,12 +1150,12 @@ void Hamiltonian_Heisenberg::Gradient_DDI_Cutoff( const vectorfield & spins, vec
                         scalar skalar_contrib           = mult / std::pow( ddi_magnitudes[i_pair], 3.0 );
                         std::array<int, 3> translations = { da, db, dc };
 
-                        int i     = ddi_pairs[i_pair].i;
-                        int j     = ddi_pairs[i_pair].j;
-                        int ispin = i
+                        int i              = ddi_pairs[i_pair].i;
+                        int j              = ddi_pairs[i_pair].j;
+                        spirit_index ispin = i
                                     + Vectormath::idx_from_translations(
                                         geometry->n_cells, geometry->n_cell_atoms, translations );
-                        int jspin = idx_from_pair(
+                        spirit_index jspin = idx_from_pair(
                             ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                             ddi_pairs[i_pair] );
                         if( jspin >= 0 )
@@ -936,57 +1190,64 @@ void Hamiltonian_Heisenberg::Gradient_DDI_FFT( const vectorfield & spins, vector
     const int c_n_cell_atoms               = geometry->n_cell_atoms;
     const int * c_it_bounds_pointwise_mult = it_bounds_pointwise_mult.data();
 
-// Loop over basis atoms (i.e sublattices)
-#pragma omp parallel for collapse( 4 )
-    for( int i_b1 = 0; i_b1 < c_n_cell_atoms; ++i_b1 )
     {
-        for( int c = 0; c < c_it_bounds_pointwise_mult[2]; ++c )
-        {
-            for( int b = 0; b < c_it_bounds_pointwise_mult[1]; ++b )
+        SPIRIT_PROFILE( DDI_Multiply );
+
+        // Loop over basis atoms (i.e sublattices) and the padded lattice cells
+        const int n_a = c_it_bounds_pointwise_mult[0];
+        const int n_b = c_it_bounds_pointwise_mult[1];
+        const int n_c = c_it_bounds_pointwise_mult[2];
+        Backend::par::apply(
+            spirit_index( c_n_cell_atoms ) * n_c * n_b * n_a,
+            [&]( spirit_index idx_loop )
             {
-                for( int a = 0; a < c_it_bounds_pointwise_mult[0]; ++a )
+                int a    = idx_loop % n_a;
+                int b    = ( idx_loop / n_a ) % n_b;
+                int c    = ( idx_loop / ( n_a * n_b ) ) % n_c;
+                int i_b1 = idx_loop / ( spirit_index( n_a ) * n_b * n_c );
+
+                // Collect the intersublattice contributions
+                for( int i_b2 = 0; i_b2 < c_n_cell_atoms; ++i_b2 )
                 {
-                    // Collect the intersublattice contributions
-                    for( int i_b2 = 0; i_b2 < c_n_cell_atoms; ++i_b2 )
-                    {
-                        // Look up at which position the correct D-matrices are saved
-                        int & b_inter = inter_sublattice_lookup[i_b1 + i_b2 * geometry->n_cell_atoms];
-
-                        int idx_b2
-                            = i_b2 * spin_stride.basis + a * spin_stride.a + b * spin_stride.b + c * spin_stride.c;
-                        int idx_b1
-                            = i_b1 * spin_stride.basis + a * spin_stride.a + b * spin_stride.b + c * spin_stride.c;
-                        int idx_d = b_inter * dipole_stride.basis + a * dipole_stride.a + b * dipole_stride.b
-                                    + c * dipole_stride.c;
-
-                        auto & fs_x = ft_spins[idx_b2];
-                        auto & fs_y = ft_spins[idx_b2 + 1 * spin_stride.comp];
-                        auto & fs_z = ft_spins[idx_b2 + 2 * spin_stride.comp];
-
-                        auto & fD_xx = ft_D_matrices[idx_d];
-                        auto & fD_xy = ft_D_matrices[idx_d + 1 * dipole_stride.comp];
-                        auto & fD_xz = ft_D_matrices[idx_d + 2 * dipole_stride.comp];
-                        auto & fD_yy = ft_D_matrices[idx_d + 3 * dipole_stride.comp];
-                        auto & fD_yz = ft_D_matrices[idx_d + 4 * dipole_stride.comp];
-                        auto & fD_zz = ft_D_matrices[idx_d + 5 * dipole_stride.comp];
-
-                        FFT::addTo(
-                            res_mult[idx_b1 + 0 * spin_stride.comp],
-                            FFT::mult3D( fD_xx, fD_xy, fD_xz, fs_x, fs_y, fs_z ), i_b2 == 0 );
-                        FFT::addTo(
-                            res_mult[idx_b1 + 1 * spin_stride.comp],
-                            FFT::mult3D( fD_xy, fD_yy, fD_yz, fs_x, fs_y, fs_z ), i_b2 == 0 );
-                        FFT::addTo(
-                            res_mult[idx_b1 + 2 * spin_stride.comp],
-                            FFT::mult3D( fD_xz, fD_yz, fD_zz, fs_x, fs_y, fs_z ), i_b2 == 0 );
-                    }
+                    // Look up at which position the correct D-matrices are saved
+                    int & b_inter = inter_sublattice_lookup[i_b1 + i_b2 * geometry->n_cell_atoms];
+
+                    spirit_index idx_b2
+                        = i_b2 * spin_stride.basis + a * spin_stride.a + b * spin_stride.b + c * spin_stride.c;
+                    spirit_index idx_b1
+                        = i_b1 * spin_stride.basis + a * spin_stride.a + b * spin_stride.b + c * spin_stride.c;
+                    spirit_index idx_d = b_inter * dipole_stride.basis + a * dipole_stride.a + b * dipole_stride.b
+                                         + c * dipole_stride.c;
+
+                    auto & fs_x = ft_spins[idx_b2];
+                    auto & fs_y = ft_spins[idx_b2 + 1 * spin_stride.comp];
+                    auto & fs_z = ft_spins[idx_b2 + 2 * spin_stride.comp];
+
+                    auto & fD_xx = ft_D_matrices[idx_d];
+                    auto & fD_xy = ft_D_matrices[idx_d + 1 * dipole_stride.comp];
+                    auto & fD_xz = ft_D_matrices[idx_d + 2 * dipole_stride.comp];
+                    auto & fD_yy = ft_D_matrices[idx_d + 3 * dipole_stride.comp];
+                    auto & fD_yz = ft_D_matrices[idx_d + 4 * dipole_stride.comp];
+                    auto & fD_zz = ft_D_matrices[idx_d + 5 * dipole_stride.comp];
+
+                    FFT::addTo(
+                        res_mult[idx_b1 + 0 * spin_stride.comp],
+                        FFT::mult3D( fD_xx, fD_xy, fD_xz, fs_x, fs_y, fs_z ), i_b2 == 0 );
+                    FFT::addTo(
+                        res_mult[idx_b1 + 1 * spin_stride.comp],
+                        FFT::mult3D( fD_xy, fD_yy, fD_yz, fs_x, fs_y, fs_z ), i_b2 == 0 );
+                    FFT::addTo(
+                        res_mult[idx_b1 + 2 * spin_stride.comp],
+                        FFT::mult3D( fD_xz, fD_yz, fD_zz, fs_x, fs_y, fs_z ), i_b2 == 0 );
                 }
-            } // end iteration over padded lattice cells
-        }     // end iteration over second sublattice
+            } );
     }
 
     // Inverse Fourier Transform
-    FFT::batch_iFour_3D( fft_plan_reverse );
+    {
+        SPIRIT_PROFILE( DDI_FFT_Inverse );
+        FFT::batch_iFour_3D( fft_plan_reverse );
+    }
 
     // Workaround for compability with intel compiler
     const int * c_n_cells = geometry->n_cells.data();
@@ -1000,8 +1261,10 @@ void Hamiltonian_Heisenberg::Gradient_DDI_FFT( const vectorfield & spins, vector
             {
                 for( int i_b1 = 0; i_b1 < c_n_cell_atoms; ++i_b1 )
                 {
-                    int idx_orig = i_b1 + geometry->n_cell_atoms * ( a + Na * ( b + Nb * c ) );
-                    int idx      = i_b1 * spin_stride.basis + a * spin_stride.a + b * spin_stride.b + c * spin_stride.c;
+                    spirit_index idx_orig
+                        = i_b1 + geometry->n_cell_atoms * ( a + Na * ( b + spirit_index( Nb ) * c ) );
+                    spirit_index idx
+                        = i_b1 * spin_stride.basis + a * spin_stride.a + b * spin_stride.b + c * spin_stride.c;
                     gradient[idx_orig][0] -= geometry->mu_s[idx_orig] * res_iFFT[idx] / sublattice_size;
                     gradient[idx_orig][1]
                         -= geometry->mu_s[idx_orig] * res_iFFT[idx + 1 * spin_stride.comp] / sublattice_size;
@@ -1024,9 +1287,9 @@ void Hamiltonian_Heisenberg::Gradient_DDI_Direct( const vectorfield & spins, vec
     int img_b = boundary_conditions[1] == 0 ? 0 : ddi_n_periodic_images[1];
     int img_c = boundary_conditions[2] == 0 ? 0 : ddi_n_periodic_images[2];
 
-    for( int idx1 = 0; idx1 < geometry->nos; idx1++ )
+    for( spirit_index idx1 = 0; idx1 < geometry->nos; idx1++ )
     {
-        for( int idx2 = 0; idx2 < geometry->nos; idx2++ )
+        for( spirit_index idx2 = 0; idx2 < geometry->nos; idx2++ )
         {
             auto & m2 = spins[idx2];
 
@@ -1072,6 +1335,8 @@ void Hamiltonian_Heisenberg::Gradient_DDI_Direct( const vectorfield & spins, vec
 
 void Hamiltonian_Heisenberg::Gradient_Quadruplet( const vectorfield & spins, vectorfield & gradient )
 {
+    SPIRIT_PROFILE( Quadruplets );
+
     for( unsigned int iquad = 0; iquad < quadruplets.size(); ++iquad )
     {
         const auto & quad = quadruplets[iquad];
@@ -1086,16 +1351,16 @@ void Hamiltonian_Heisenberg::Gradient_Quadruplet( const vectorfield & spins, vec
             {
                 for( int dc = 0; dc < geometry->n_cells[2]; ++dc )
                 {
-                    int ispin = i
+                    spirit_index ispin = i
                                 + Vectormath::idx_from_translations(
                                     geometry->n_cells, geometry->n_cell_atoms, { da, db, dc } );
-                    int jspin = idx_from_pair(
+                    spirit_index jspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         { i, j, quad.d_j } );
-                    int kspin = idx_from_pair(
+                    spirit_index kspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         { i, k, quad.d_k } );
-                    int lspin = idx_from_pair(
+                    spirit_index lspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         { i, l, quad.d_l } );
 
@@ -1118,104 +1383,107 @@ void Hamiltonian_Heisenberg::Gradient_Quadruplet( const vectorfield & spins, vec
 
 void Hamiltonian_Heisenberg::Hessian( const vectorfield & spins, MatrixX & hessian )
 {
-    int nos     = spins.size();
-    const int N = geometry->n_cell_atoms;
+    spirit_index nos = spins.size();
+    const int N      = geometry->n_cell_atoms;
 
     // --- Set to zero
     hessian.setZero();
 
 // --- Single Spin elements
-#pragma omp parallel for
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
-    {
-        for( int iani = 0; iani < anisotropy_indices.size(); ++iani )
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = icell * N + anisotropy_indices[iani];
-            if( check_atom_type( this->geometry->atom_types[ispin] ) )
+            for( int iani = 0; iani < anisotropy_indices.size(); ++iani )
             {
-                for( int alpha = 0; alpha < 3; ++alpha )
+                spirit_index ispin = icell * N + anisotropy_indices[iani];
+                if( check_atom_type( this->geometry->atom_types[ispin] ) )
                 {
-                    for( int beta = 0; beta < 3; ++beta )
+                    for( int alpha = 0; alpha < 3; ++alpha )
                     {
-                        int i = 3 * ispin + alpha;
-                        int j = 3 * ispin + alpha;
-                        hessian( i, j ) += -2.0 * this->anisotropy_magnitudes[iani]
-                                           * this->anisotropy_normals[iani][alpha]
-                                           * this->anisotropy_normals[iani][beta];
+                        for( int beta = 0; beta < 3; ++beta )
+                        {
+                            int i = 3 * ispin + alpha;
+                            int j = 3 * ispin + alpha;
+                            hessian( i, j ) += -2.0 * this->anisotropy_magnitudes[iani]
+                                               * this->anisotropy_normals[iani][alpha]
+                                               * this->anisotropy_normals[iani][beta];
+                        }
                     }
                 }
             }
-        }
-    }
+        } );
 
 // --- Spin Pair elements
 // Exchange
-#pragma omp parallel for
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
-    {
-        for( unsigned int i_pair = 0; i_pair < exchange_pairs.size(); ++i_pair )
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = exchange_pairs[i_pair].i + icell * geometry->n_cell_atoms;
-            int jspin = idx_from_pair(
-                ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
-                exchange_pairs[i_pair] );
-            if( jspin >= 0 )
+            for( unsigned int i_pair = 0; i_pair < exchange_pairs.size(); ++i_pair )
             {
-                for( int alpha = 0; alpha < 3; ++alpha )
+                spirit_index ispin = exchange_pairs[i_pair].i + icell * geometry->n_cell_atoms;
+                spirit_index jspin = idx_from_pair(
+                    ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
+                    exchange_pairs[i_pair] );
+                if( jspin >= 0 )
                 {
-                    int i = 3 * ispin + alpha;
-                    int j = 3 * jspin + alpha;
+                    for( int alpha = 0; alpha < 3; ++alpha )
+                    {
+                        int i = 3 * ispin + alpha;
+                        int j = 3 * jspin + alpha;
 
-                    hessian( i, j ) += -exchange_magnitudes[i_pair];
-#ifndef SPIRIT_USE_OPENMP
-                    hessian( j, i ) += -exchange_magnitudes[i_pair];
+                        hessian( i, j ) += -exchange_magnitudes[i_pair];
+#if !defined( SPIRIT_USE_OPENMP ) && !defined( SPIRIT_USE_THREADS )
+                        hessian( j, i ) += -exchange_magnitudes[i_pair];
 #endif
+                    }
                 }
             }
-        }
-    }
+        } );
 
 // DMI
-#pragma omp parallel for
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
-    {
-        for( unsigned int i_pair = 0; i_pair < dmi_pairs.size(); ++i_pair )
+    Backend::par::apply(
+        geometry->n_cells_total,
+        [&]( spirit_index icell )
         {
-            int ispin = dmi_pairs[i_pair].i + icell * geometry->n_cell_atoms;
-            int jspin = idx_from_pair(
-                ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
-                dmi_pairs[i_pair] );
-            if( jspin >= 0 )
+            for( unsigned int i_pair = 0; i_pair < dmi_pairs.size(); ++i_pair )
             {
-                int i = 3 * ispin;
-                int j = 3 * jspin;
-
-                hessian( i + 2, j + 1 ) += dmi_magnitudes[i_pair] * dmi_normals[i_pair][0];
-                hessian( i + 1, j + 2 ) += -dmi_magnitudes[i_pair] * dmi_normals[i_pair][0];
-                hessian( i, j + 2 ) += dmi_magnitudes[i_pair] * dmi_normals[i_pair][1];
-                hessian( i + 2, j ) += -dmi_magnitudes[i_pair] * dmi_normals[i_pair][1];
-                hessian( i + 1, j ) += dmi_magnitudes[i_pair] * dmi_normals[i_pair][2];
-                hessian( i, j + 1 ) += -dmi_magnitudes[i_pair] * dmi_normals[i_pair][2];
-
-#ifndef SPIRIT_USE_OPENMP
-                hessian( j + 1, i + 2 ) += dmi_magnitudes[i_pair] * dmi_normals[i_pair][0];
-                hessian( j + 2, i + 1 ) += -dmi_magnitudes[i_pair] * dmi_normals[i_pair][0];
-                hessian( j + 2, i ) += dmi_magnitudes[i_pair] * dmi_normals[i_pair][1];
-                hessian( j, i + 2 ) += -dmi_magnitudes[i_pair] * dmi_normals[i_pair][1];
-                hessian( j, i + 1 ) += dmi_magnitudes[i_pair] * dmi_normals[i_pair][2];
-                hessian( j + 1, i ) += -dmi_magnitudes[i_pair] * dmi_normals[i_pair][2];
+                spirit_index ispin = dmi_pairs[i_pair].i + icell * geometry->n_cell_atoms;
+                spirit_index jspin = idx_from_pair(
+                    ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
+                    dmi_pairs[i_pair] );
+                if( jspin >= 0 )
+                {
+                    int i = 3 * ispin;
+                    int j = 3 * jspin;
+
+                    hessian( i + 2, j + 1 ) += dmi_magnitudes[i_pair] * dmi_normals[i_pair][0];
+                    hessian( i + 1, j + 2 ) += -dmi_magnitudes[i_pair] * dmi_normals[i_pair][0];
+                    hessian( i, j + 2 ) += dmi_magnitudes[i_pair] * dmi_normals[i_pair][1];
+                    hessian( i + 2, j ) += -dmi_magnitudes[i_pair] * dmi_normals[i_pair][1];
+                    hessian( i + 1, j ) += dmi_magnitudes[i_pair] * dmi_normals[i_pair][2];
+                    hessian( i, j + 1 ) += -dmi_magnitudes[i_pair] * dmi_normals[i_pair][2];
+
+#if !defined( SPIRIT_USE_OPENMP ) && !defined( SPIRIT_USE_THREADS )
+                    hessian( j + 1, i + 2 ) += dmi_magnitudes[i_pair] * dmi_normals[i_pair][0];
+                    hessian( j + 2, i + 1 ) += -dmi_magnitudes[i_pair] * dmi_normals[i_pair][0];
+                    hessian( j + 2, i ) += dmi_magnitudes[i_pair] * dmi_normals[i_pair][1];
+                    hessian( j, i + 2 ) += -dmi_magnitudes[i_pair] * dmi_normals[i_pair][1];
+                    hessian( j, i + 1 ) += dmi_magnitudes[i_pair] * dmi_normals[i_pair][2];
+                    hessian( j + 1, i ) += -dmi_magnitudes[i_pair] * dmi_normals[i_pair][2];
 #endif
+                }
             }
-        }
-    }
+        } );
 
     // Tentative Dipole-Dipole (only works for open boundary conditions)
     if( ddi_method != DDI_Method::None )
     {
         scalar mult = C::mu_0 * C::mu_B * C::mu_B / ( 4 * C::Pi * 1e-30 );
-        for( int idx1 = 0; idx1 < geometry->nos; idx1++ )
+        for( spirit_index idx1 = 0; idx1 < geometry->nos; idx1++ )
         {
-            for( int idx2 = 0; idx2 < geometry->nos; idx2++ )
+            for( spirit_index idx2 = 0; idx2 < geometry->nos; idx2++ )
             {
                 auto diff  = this->geometry->positions[idx2] - this->geometry->positions[idx1];
                 scalar d   = diff.norm(), d3, d5;
@@ -1276,8 +1544,8 @@ void Hamiltonian_Heisenberg::Hessian( const vectorfield & spins, MatrixX & hessi
 
 void Hamiltonian_Heisenberg::Sparse_Hessian( const vectorfield & spins, SpMatrixX & hessian )
 {
-    int nos     = spins.size();
-    const int N = geometry->n_cell_atoms;
+    spirit_index nos = spins.size();
+    const int N      = geometry->n_cell_atoms;
 
     typedef Eigen::Triplet<scalar> T;
     std::vector<T> tripletList;
@@ -1286,11 +1554,11 @@ void Hamiltonian_Heisenberg::Sparse_Hessian( const vectorfield & spins, SpMatrix
         * ( anisotropy_indices.size() * 9 + exchange_pairs.size() * 2 + dmi_pairs.size() * 3 ) );
 
     // --- Single Spin elements
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
+    for( spirit_index icell = 0; icell < geometry->n_cells_total; ++icell )
     {
         for( int iani = 0; iani < anisotropy_indices.size(); ++iani )
         {
-            int ispin = icell * N + anisotropy_indices[iani];
+            spirit_index ispin = icell * N + anisotropy_indices[iani];
             if( check_atom_type( this->geometry->atom_types[ispin] ) )
             {
                 for( int alpha = 0; alpha < 3; ++alpha )
@@ -1310,12 +1578,12 @@ void Hamiltonian_Heisenberg::Sparse_Hessian( const vectorfield & spins, SpMatrix
 
     // --- Spin Pair elements
     // Exchange
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
+    for( spirit_index icell = 0; icell < geometry->n_cells_total; ++icell )
     {
         for( unsigned int i_pair = 0; i_pair < exchange_pairs.size(); ++i_pair )
         {
-            int ispin = exchange_pairs[i_pair].i + icell * geometry->n_cell_atoms;
-            int jspin = idx_from_pair(
+            spirit_index ispin = exchange_pairs[i_pair].i + icell * geometry->n_cell_atoms;
+            spirit_index jspin = idx_from_pair(
                 ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                 exchange_pairs[i_pair] );
             if( jspin >= 0 )
@@ -1326,7 +1594,7 @@ void Hamiltonian_Heisenberg::Sparse_Hessian( const vectorfield & spins, SpMatrix
                     int j = 3 * jspin + alpha;
 
                     tripletList.push_back( T( i, j, -exchange_magnitudes[i_pair] ) );
-#ifndef SPIRIT_USE_OPENMP
+#if !defined( SPIRIT_USE_OPENMP ) && !defined( SPIRIT_USE_THREADS )
                     tripletList.push_back( T( j, i, -exchange_magnitudes[i_pair] ) );
 #endif
                 }
@@ -1335,12 +1603,12 @@ void Hamiltonian_Heisenberg::Sparse_Hessian( const vectorfield & spins, SpMatrix
     }
 
     // DMI
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
+    for( spirit_index icell = 0; icell < geometry->n_cells_total; ++icell )
     {
         for( unsigned int i_pair = 0; i_pair < dmi_pairs.size(); ++i_pair )
         {
-            int ispin = dmi_pairs[i_pair].i + icell * geometry->n_cell_atoms;
-            int jspin = idx_from_pair(
+            spirit_index ispin = dmi_pairs[i_pair].i + icell * geometry->n_cell_atoms;
+            spirit_index jspin = idx_from_pair(
                 ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                 dmi_pairs[i_pair] );
             if( jspin >= 0 )
@@ -1355,7 +1623,7 @@ void Hamiltonian_Heisenberg::Sparse_Hessian( const vectorfield & spins, SpMatrix
                 tripletList.push_back( T( i + 1, j, dmi_magnitudes[i_pair] * dmi_normals[i_pair][2] ) );
                 tripletList.push_back( T( i, j + 1, -dmi_magnitudes[i_pair] * dmi_normals[i_pair][2] ) );
 
-#ifndef SPIRIT_USE_OPENMP
+#if !defined( SPIRIT_USE_OPENMP ) && !defined( SPIRIT_USE_THREADS )
                 tripletList.push_back( T( j + 1, i + 2, dmi_magnitudes[i_pair] * dmi_normals[i_pair][0] ) );
                 tripletList.push_back( T( j + 2, i + 1, -dmi_magnitudes[i_pair] * dmi_normals[i_pair][0] ) );
                 tripletList.push_back( T( j + 2, i, dmi_magnitudes[i_pair] * dmi_normals[i_pair][1] ) );
@@ -1372,6 +1640,8 @@ void Hamiltonian_Heisenberg::Sparse_Hessian( const vectorfield & spins, SpMatrix
 
 void Hamiltonian_Heisenberg::FFT_Spins( const vectorfield & spins )
 {
+    SPIRIT_PROFILE( DDI_FFT_Forward );
+
     // size of original geometry
     int Na           = geometry->n_cells[0];
     int Nb           = geometry->n_cells[1];
@@ -1380,26 +1650,22 @@ void Hamiltonian_Heisenberg::FFT_Spins( const vectorfield & spins )
 
     auto & fft_spin_inputs = fft_plan_spins.real_ptr;
 
-// iterate over the **original** system
-#pragma omp parallel for collapse( 4 )
-    for( int c = 0; c < Nc; ++c )
-    {
-        for( int b = 0; b < Nb; ++b )
+    // iterate over the **original** system
+    Backend::par::apply(
+        geometry->nos,
+        [&]( spirit_index idx_orig )
         {
-            for( int a = 0; a < Na; ++a )
-            {
-                for( int bi = 0; bi < n_cell_atoms; ++bi )
-                {
-                    int idx_orig = bi + n_cell_atoms * ( a + Na * ( b + Nb * c ) );
-                    int idx      = bi * spin_stride.basis + a * spin_stride.a + b * spin_stride.b + c * spin_stride.c;
-
-                    fft_spin_inputs[idx]                        = spins[idx_orig][0] * geometry->mu_s[idx_orig];
-                    fft_spin_inputs[idx + 1 * spin_stride.comp] = spins[idx_orig][1] * geometry->mu_s[idx_orig];
-                    fft_spin_inputs[idx + 2 * spin_stride.comp] = spins[idx_orig][2] * geometry->mu_s[idx_orig];
-                }
-            }
-        }
-    } // end iteration over basis
+            int bi            = idx_orig % n_cell_atoms;
+            spirit_index cell = idx_orig / n_cell_atoms;
+            int a             = cell % Na;
+            int b             = ( cell / Na ) % Nb;
+            int c             = cell / ( Na * Nb );
+            spirit_index idx  = bi * spin_stride.basis + a * spin_stride.a + b * spin_stride.b + c * spin_stride.c;
+
+            fft_spin_inputs[idx]                        = spins[idx_orig][0] * geometry->mu_s[idx_orig];
+            fft_spin_inputs[idx + 1 * spin_stride.comp] = spins[idx_orig][1] * geometry->mu_s[idx_orig];
+            fft_spin_inputs[idx + 2 * spin_stride.comp] = spins[idx_orig][2] * geometry->mu_s[idx_orig];
+        } );
     FFT::batch_Four_3D( fft_plan_spins );
 }
 
@@ -1481,8 +1747,8 @@ void Hamiltonian_Heisenberg::FFT_Dipole_Matrices( FFT::FFT_Plan & fft_plan_dipol
                             }
                         }
 
-                        int idx = b_inter * dipole_stride.basis + a * dipole_stride.a + b * dipole_stride.b
-                                  + c * dipole_stride.c;
+                        spirit_index idx = b_inter * dipole_stride.basis + a * dipole_stride.a + b * dipole_stride.b
+                                           + c * dipole_stride.c;
 
                         fft_dipole_inputs[idx]                          = Dxx;
                         fft_dipole_inputs[idx + 1 * dipole_stride.comp] = Dxy;
@@ -1516,7 +1782,6 @@ void Hamiltonian_Heisenberg::Prepare_DDI()
         if( perform_zero_padding )
             n_cells_padded[i] *= 2;
     }
-    sublattice_size = n_cells_padded[0] * n_cells_padded[1] * n_cells_padded[2];
 
     FFT::FFT_Init();
 
@@ -1529,8 +1794,6 @@ void Hamiltonian_Heisenberg::Prepare_DDI()
             n_cells_padded[i] = 2;
 #endif
 
-    sublattice_size = n_cells_padded[0] * n_cells_padded[1] * n_cells_padded[2];
-
     inter_sublattice_lookup.resize( geometry->n_cell_atoms * geometry->n_cell_atoms );
 
     // We dont need to transform over length 1 dims
@@ -1553,14 +1816,33 @@ void Hamiltonian_Heisenberg::Prepare_DDI()
         }
     }
 
+    // The zero-padding makes the arrays of the FFTs up to eight times larger than the spin arrays, so their
+    // length is checked before it is computed in the index type
+    const std::int64_t max_length = std::numeric_limits<spirit_index>::max();
+    std::int64_t length           = std::max( 6 * n_inter_sublattice, 3 * geometry->n_cell_atoms );
+    for( int i = 0; i < 3; ++i )
+    {
+        if( length > max_length / n_cells_padded[i] )
+            spirit_throw(
+                Utility::Exception_Classifier::Input_parse_failed, Utility::Log_Level::Severe,
+                fmt::format(
+                    "The FFT of the dipolar interaction on {}x{}x{} padded cells with {} atoms each needs longer "
+                    "arrays than this build of Spirit can index. Build Spirit with SPIRIT_USE_64BIT_INDICES=ON or "
+                    "use a different ddi_method.",
+                    n_cells_padded[0], n_cells_padded[1], n_cells_padded[2], geometry->n_cell_atoms ) );
+        length *= n_cells_padded[i];
+    }
+    sublattice_size = spirit_index( n_cells_padded[0] ) * n_cells_padded[1] * n_cells_padded[2];
+
     // Create FFT plans
     FFT::FFT_Plan fft_plan_dipole = FFT::FFT_Plan( fft_dims, false, 6 * n_inter_sublattice, sublattice_size );
     fft_plan_spins                = FFT::FFT_Plan( fft_dims, false, 3 * geometry->n_cell_atoms, sublattice_size );
     fft_plan_reverse              = FFT::FFT_Plan( fft_dims, true, 3 * geometry->n_cell_atoms, sublattice_size );
 
 #ifdef SPIRIT_USE_FFTW
-    field<int *> temp_s = { &spin_stride.comp, &spin_stride.basis, &spin_stride.a, &spin_stride.b, &spin_stride.c };
-    field<int *> temp_d
+    field<spirit_index *> temp_s
+        = { &spin_stride.comp, &spin_stride.basis, &spin_stride.a, &spin_stride.b, &spin_stride.c };
+    field<spirit_index *> temp_d
         = { &dipole_stride.comp, &dipole_stride.basis, &dipole_stride.a, &dipole_stride.b, &dipole_stride.c };
     ;
     FFT::get_strides(
@@ -1569,8 +1851,9 @@ void Hamiltonian_Heisenberg::Prepare_DDI()
     it_bounds_pointwise_mult = { ( n_cells_padded[0] / 2 + 1 ), // due to redundancy in real fft
                                  n_cells_padded[1], n_cells_padded[2] };
 #else
-    field<int *> temp_s = { &spin_stride.a, &spin_stride.b, &spin_stride.c, &spin_stride.comp, &spin_stride.basis };
-    field<int *> temp_d
+    field<spirit_index *> temp_s
+        = { &spin_stride.a, &spin_stride.b, &spin_stride.c, &spin_stride.comp, &spin_stride.basis };
+    field<spirit_index *> temp_d
         = { &dipole_stride.a, &dipole_stride.b, &dipole_stride.c, &dipole_stride.comp, &dipole_stride.basis };
     ;
     FFT::get_strides(
@@ -105,6 +105,10 @@ void Hamiltonian_Heisenberg::Update_Interactions()
     // When parallelising (cuda or openmp), we need all neighbours per spin
     const bool use_redundant_neighbours = true;
 
+    // The neighbour shells of exchange and DMI are built together and only rebuilt if the lattice changed
+    const auto & neighbour_shells = this->neighbour_shell_cache.Get(
+        *geometry, std::max( exchange_shell_magnitudes.size(), dmi_shell_magnitudes.size() ) );
+
     // Exchange
     this->exchange_pairs      = pairfield( 0 );
     this->exchange_magnitudes = scalarfield( 0 );
@@ -113,7 +117,8 @@ void Hamiltonian_Heisenberg::Update_Interactions()
         // Generate Exchange neighbours
         intfield exchange_shells( 0 );
         Neighbours::Get_Neighbours_in_Shells(
-            *geometry, exchange_shell_magnitudes.size(), exchange_pairs, exchange_shells, use_redundant_neighbours );
+            neighbour_shells, exchange_shell_magnitudes.size(), exchange_pairs, exchange_shells,
+            use_redundant_neighbours );
         for( unsigned int ipair = 0; ipair < exchange_pairs.size(); ++ipair )
         {
             this->exchange_magnitudes.push_back( exchange_shell_magnitudes[exchange_shells[ipair]] );
@@ -145,7 +150,7 @@ void Hamiltonian_Heisenberg::Update_Interactions()
         // Generate DMI neighbours and normals
         intfield dmi_shells( 0 );
         Neighbours::Get_Neighbours_in_Shells(
-            *geometry, dmi_shell_magnitudes.size(), dmi_pairs, dmi_shells, use_redundant_neighbours );
+            neighbour_shells, dmi_shell_magnitudes.size(), dmi_pairs, dmi_shells, use_redundant_neighbours );
         for( unsigned int ineigh = 0; ineigh < dmi_pairs.size(); ++ineigh )
         {
             this->dmi_normals.push_back(
@@ -263,7 +268,7 @@ void Hamiltonian_Heisenberg::Energy_Contributions_per_Spin(
     {
         contributions = this->energy_contributions_per_spin;
     }
-    int nos = spins.size();
+    spirit_index nos = spins.size();
     for( auto & pair : contributions )
     {
         // Allocate if not already allocated
@@ -310,7 +315,7 @@ __global__ void CU_E_Zeeman(
     {
         for( int ibasis = 0; ibasis < n_cell_atoms; ++ibasis )
         {
-            int ispin = n_cell_atoms * icell + ibasis;
+            spirit_index ispin = n_cell_atoms * icell + ibasis;
             if( cu_check_atom_type( atom_types[ispin] ) )
                 Energy[ispin] -= mu_s[ispin] * external_field_magnitude * external_field_normal.dot( spins[ispin] );
         }
@@ -318,7 +323,7 @@ __global__ void CU_E_Zeeman(
 }
 void Hamiltonian_Heisenberg::E_Zeeman( const vectorfield & spins, scalarfield & Energy )
 {
-    int size = geometry->n_cells_total;
+    spirit_index size = geometry->n_cells_total;
     CU_E_Zeeman<<<( size + 1023 ) / 1024, 1024>>>(
         spins.data(), this->geometry->atom_types.data(), geometry->n_cell_atoms, geometry->mu_s.data(),
         this->external_field_magnitude, this->external_field_normal, Energy.data(), size );
@@ -334,7 +339,7 @@ __global__ void CU_E_Anisotropy(
     {
         for( int iani = 0; iani < n_anisotropies; ++iani )
         {
-            int ispin = icell * n_cell_atoms + anisotropy_indices[iani];
+            spirit_index ispin = icell * n_cell_atoms + anisotropy_indices[iani];
             if( cu_check_atom_type( atom_types[ispin] ) )
                 Energy[ispin] -= anisotropy_magnitude[iani] * pow( anisotropy_normal[iani].dot( spins[ispin] ), 2 );
         }
@@ -342,7 +347,7 @@ __global__ void CU_E_Anisotropy(
 }
 void Hamiltonian_Heisenberg::E_Anisotropy( const vectorfield & spins, scalarfield & Energy )
 {
-    int size = geometry->n_cells_total;
+    spirit_index size = geometry->n_cells_total;
     CU_E_Anisotropy<<<( size + 1023 ) / 1024, 1024>>>(
         spins.data(), this->geometry->atom_types.data(), this->geometry->n_cell_atoms, this->anisotropy_indices.size(),
         this->anisotropy_indices.data(), this->anisotropy_magnitudes.data(), this->anisotropy_normals.data(),
@@ -358,7 +363,7 @@ __global__ void CU_E_Cubic_Anisotropy(
     {
         for( int iani = 0; iani < n_anisotropies; ++iani )
         {
-            int ispin = icell * n_cell_atoms + anisotropy_indices[iani];
+            spirit_index ispin = icell * n_cell_atoms + anisotropy_indices[iani];
             if( cu_check_atom_type( atom_types[ispin] ) )
                 Energy[ispin]
                     -= anisotropy_magnitude[iani] / 2
@@ -368,7 +373,7 @@ __global__ void CU_E_Cubic_Anisotropy(
 }
 void Hamiltonian_Heisenberg::E_Cubic_Anisotropy( const vectorfield & spins, scalarfield & Energy )
 {
-    int size = geometry->n_cells_total;
+    spirit_index size = geometry->n_cells_total;
     CU_E_Cubic_Anisotropy<<<( size + 1023 ) / 1024, 1024>>>(
         spins.data(), this->geometry->atom_types.data(), this->geometry->n_cell_atoms,
         this->cubic_anisotropy_indices.size(), this->cubic_anisotropy_indices.data(),
@@ -387,8 +392,8 @@ __global__ void CU_E_Exchange(
     {
         for( auto ipair = 0; ipair < n_pairs; ++ipair )
         {
-            int ispin = pairs[ipair].i + icell * n_cell_atoms;
-            int jspin = cu_idx_from_pair( ispin, bc, nc, n_cell_atoms, atom_types, pairs[ipair] );
+            spirit_index ispin = pairs[ipair].i + icell * n_cell_atoms;
+            spirit_index jspin = cu_idx_from_pair( ispin, bc, nc, n_cell_atoms, atom_types, pairs[ipair] );
             if( jspin >= 0 )
             {
                 Energy[ispin] -= 0.5 * magnitudes[ipair] * spins[ispin].dot( spins[jspin] );
@@ -398,7 +403,7 @@ __global__ void CU_E_Exchange(
 }
 void Hamiltonian_Heisenberg::E_Exchange( const vectorfield & spins, scalarfield & Energy )
 {
-    int size = geometry->n_cells_total;
+    spirit_index size = geometry->n_cells_total;
     CU_E_Exchange<<<( size + 1023 ) / 1024, 1024>>>(
         spins.data(), this->geometry->atom_types.data(), boundary_conditions.data(), geometry->n_cells.data(),
         geometry->n_cell_atoms, this->exchange_pairs.size(), this->exchange_pairs.data(),
@@ -418,8 +423,8 @@ __global__ void CU_E_DMI(
     {
         for( auto ipair = 0; ipair < n_pairs; ++ipair )
         {
-            int ispin = pairs[ipair].i + icell * n_cell_atoms;
-            int jspin = cu_idx_from_pair( ispin, bc, nc, n_cell_atoms, atom_types, pairs[ipair] );
+            spirit_index ispin = pairs[ipair].i + icell * n_cell_atoms;
+            spirit_index jspin = cu_idx_from_pair( ispin, bc, nc, n_cell_atoms, atom_types, pairs[ipair] );
             if( jspin >= 0 )
             {
                 Energy[ispin] -= 0.5 * magnitudes[ipair] * normals[ipair].dot( spins[ispin].cross( spins[jspin] ) );
@@ -429,7 +434,7 @@ __global__ void CU_E_DMI(
 }
 void Hamiltonian_Heisenberg::E_DMI( const vectorfield & spins, scalarfield & Energy )
 {
-    int size = geometry->n_cells_total;
+    spirit_index size = geometry->n_cells_total;
     CU_E_DMI<<<( size + 1023 ) / 1024, 1024>>>(
         spins.data(), this->geometry->atom_types.data(), boundary_conditions.data(), geometry->n_cells.data(),
         geometry->n_cell_atoms, this->dmi_pairs.size(), this->dmi_pairs.data(), this->dmi_magnitudes.data(),
@@ -459,7 +464,7 @@ void Hamiltonian_Heisenberg::E_DDI_Direct( const vectorfield & spins, scalarfiel
     this->Gradient_DDI_Direct( spins, gradients_temp );
 
 #pragma omp parallel for
-    for( int ispin = 0; ispin < geometry->nos; ispin++ )
+    for( spirit_index ispin = 0; ispin < geometry->nos; ispin++ )
     {
         Energy[ispin] += 0.5 * spins[ispin].dot( gradients_temp[ispin] );
     }
@@ -563,9 +568,9 @@ void Hamiltonian_Heisenberg::Gradient_DDI_Direct( const vectorfield & spins, vec
     int img_b = boundary_conditions[1] == 0 ? 0 : ddi_n_periodic_images[1];
     int img_c = boundary_conditions[2] == 0 ? 0 : ddi_n_periodic_images[2];
 
-    for( int idx1 = 0; idx1 < geometry->nos; idx1++ )
+    for( spirit_index idx1 = 0; idx1 < geometry->nos; idx1++ )
     {
-        for( int idx2 = 0; idx2 < geometry->nos; idx2++ )
+        for( spirit_index idx2 = 0; idx2 < geometry->nos; idx2++ )
         {
             auto & m2 = spins[idx2];
 
@@ -632,16 +637,16 @@ void Hamiltonian_Heisenberg::E_Quadruplet( const vectorfield & spins, scalarfiel
             {
                 for( int dc = 0; dc < geometry->n_cells[2]; ++dc )
                 {
-                    int ispin = i
+                    spirit_index ispin = i
                                 + Vectormath::idx_from_translations(
                                     geometry->n_cells, geometry->n_cell_atoms, { da, db, dc } );
-                    int jspin = idx_from_pair(
+                    spirit_index jspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         { i, j, { d_j[0], d_j[1], d_j[2] } } );
-                    int kspin = idx_from_pair(
+                    spirit_index kspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         { i, k, { d_k[0], d_k[1], d_k[2] } } );
-                    int lspin = idx_from_pair(
+                    spirit_index lspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         { i, l, { d_l[0], d_l[1], d_l[2] } } );
 
@@ -662,14 +667,60 @@ void Hamiltonian_Heisenberg::E_Quadruplet( const vectorfield & spins, scalarfiel
     }
 }
 
-scalar Hamiltonian_Heisenberg::Energy_Single_Spin( int ispin, const vectorfield & spins )
+void Hamiltonian_Heisenberg::Stiffness( scalarfield & stiffness )
+{
+    const int N = geometry->n_cell_atoms;
+    Vectormath::fill( stiffness, 0 );
+
+    for( spirit_index icell = 0; icell < geometry->n_cells_total; ++icell )
+    {
+        // External field
+        for( int ibasis = 0; ibasis < N; ++ibasis )
+        {
+            spirit_index ispin = icell * N + ibasis;
+            stiffness[ispin] += std::abs( geometry->mu_s[ispin] * external_field_magnitude );
+        }
+
+        // Anisotropies
+        for( int iani = 0; iani < anisotropy_indices.size(); ++iani )
+            stiffness[icell * N + anisotropy_indices[iani]] += 2 * std::abs( anisotropy_magnitudes[iani] );
+        for( int iani = 0; iani < cubic_anisotropy_indices.size(); ++iani )
+            stiffness[icell * N + cubic_anisotropy_indices[iani]] += 2 * std::abs( cubic_anisotropy_magnitudes[iani] );
+
+        // Exchange and DMI
+        auto add_pairs = [&]( const pairfield & pairs, const scalarfield & magnitudes )
+        {
+            for( unsigned int i_pair = 0; i_pair < pairs.size(); ++i_pair )
+            {
+                spirit_index ispin = pairs[i_pair].i + icell * N;
+                spirit_index jspin = Vectormath::idx_from_pair(
+                    ispin, boundary_conditions, geometry->n_cells, N, geometry->atom_types, pairs[i_pair] );
+                if( jspin >= 0 )
+                {
+                    stiffness[ispin] += std::abs( magnitudes[i_pair] );
+                }
+            }
+        };
+        add_pairs( exchange_pairs, exchange_magnitudes );
+        add_pairs( dmi_pairs, dmi_magnitudes );
+    }
+
+    // Vacancies are not held by anything
+    for( spirit_index ispin = 0; ispin < geometry->nos; ++ispin )
+    {
+        if( !check_atom_type( geometry->atom_types[ispin] ) )
+            stiffness[ispin] = 0;
+    }
+}
+
+scalar Hamiltonian_Heisenberg::Energy_Single_Spin( spirit_index ispin, const vectorfield & spins )
 {
     scalar Energy = 0;
     if( check_atom_type( this->geometry->atom_types[ispin] ) )
     {
-        int icell   = ispin / this->geometry->n_cell_atoms;
-        int ibasis  = ispin - icell * this->geometry->n_cell_atoms;
-        auto & mu_s = this->geometry->mu_s;
+        spirit_index icell = ispin / this->geometry->n_cell_atoms;
+        int ibasis         = ispin - icell * this->geometry->n_cell_atoms;
+        auto & mu_s        = this->geometry->mu_s;
         Pair pair_inv;
 
         // External field
@@ -713,7 +764,7 @@ scalar Hamiltonian_Heisenberg::Energy_Single_Spin( int ispin, const vectorfield
                 const auto & pair = exchange_pairs[ipair];
                 if( pair.i == ibasis )
                 {
-                    int jspin = idx_from_pair(
+                    spirit_index jspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         pair );
                     if( jspin >= 0 )
@@ -730,7 +781,7 @@ scalar Hamiltonian_Heisenberg::Energy_Single_Spin( int ispin, const vectorfield
                 const auto & pair = dmi_pairs[ipair];
                 if( pair.i == ibasis )
                 {
-                    int jspin = idx_from_pair(
+                    spirit_index jspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         pair );
                     if( jspin >= 0 )
@@ -788,61 +839,115 @@ void Hamiltonian_Heisenberg::Gradient_and_Energy( const vectorfield & spins, vec
     Vectormath::fill( gradient, { 0, 0, 0 } );
     energy = 0;
 
-    auto N    = spins.size();
-    auto s    = spins.data();
-    auto mu_s = geometry->mu_s.data();
-    auto g    = gradient.data();
+    // Each interaction is homogeneous in the spins, so its energy follows from its gradient as E = s*g/p, where p is
+    // the degree of the interaction. The gradients are summed up one interaction after the other and the energy is
+    // obtained from the change of s*g, which takes one reduction instead of a separate energy sweep.
+    auto & record        = this->recording.record;
+    const auto * tangent = this->recording.active ? this->recording.tangent : nullptr;
+    if( this->recording.active )
+    {
+        record.version = this->recording.version;
+        if( record.energies.size() != this->energy_contributions_per_spin.size() )
+        {
+            record.energies = std::vector<std::pair<std::string, scalar>>( this->energy_contributions_per_spin.size() );
+            for( std::size_t i = 0; i < record.energies.size(); ++i )
+                record.energies[i].first = this->energy_contributions_per_spin[i].first;
+        }
+        record.dE_dRx = std::vector<scalar>( tangent != nullptr ? record.energies.size() : 0, 0 );
+    }
+
+    // The interactions which were added since the last reduction
+    scalar s_dot_g        = 0;
+    scalar t_dot_g        = 0;
+    int idx_pending       = -1;
+    scalar degree_pending = 0;
+
+    auto reduce_pending = [&]()
+    {
+        if( idx_pending < 0 )
+            return;
+
+        const scalar s_dot_g_new = Vectormath::dot( spins, gradient );
+        const scalar E           = ( s_dot_g_new - s_dot_g ) / degree_pending;
+        s_dot_g                  = s_dot_g_new;
+        energy += E;
+
+        if( this->recording.active )
+        {
+            record.energies[idx_pending].second = E;
+            if( tangent != nullptr )
+            {
+                const scalar t_dot_g_new    = Vectormath::dot( *tangent, gradient );
+                record.dE_dRx[idx_pending] = t_dot_g - t_dot_g_new;
+                t_dot_g                     = t_dot_g_new;
+            }
+        }
+        idx_pending = -1;
+    };
+
+    // Has to be called before the gradient of an interaction is added. Unless the energies are recorded,
+    // consecutive interactions of the same degree share one reduction.
+    auto next_interaction = [&]( int idx, scalar degree )
+    {
+        if( this->recording.active || degree != degree_pending )
+            reduce_pending();
+        idx_pending    = idx;
+        degree_pending = degree;
+    };
 
     // Anisotropy
     if( idx_anisotropy >= 0 )
+    {
+        next_interaction( idx_anisotropy, 2 );
         this->Gradient_Anisotropy( spins, gradient );
+    }
 
     // Exchange
     if( idx_exchange >= 0 )
+    {
+        next_interaction( idx_exchange, 2 );
         this->Gradient_Exchange( spins, gradient );
+    }
 
     // DMI
     if( idx_dmi >= 0 )
+    {
+        next_interaction( idx_dmi, 2 );
         this->Gradient_DMI( spins, gradient );
+    }
 
     // DDI
     if( idx_ddi >= 0 )
-        this->Gradient_DDI( spins, gradient );
-
-    energy += Backend::par::reduce( N, [s, g] SPIRIT_LAMBDA( int idx ) { return 0.5 * g[idx].dot( s[idx] ); } );
-
-    // Cubic Anisotropy
-    if( idx_cubic_anisotropy >= 0 )
     {
-        this->Gradient_Cubic_Anisotropy( spins, gradient );
-
-        scalarfield energy_cubic( N );
-        this->E_Cubic_Anisotropy( spins, energy_cubic );
-        energy += Vectormath::sum( energy_cubic );
+        next_interaction( idx_ddi, 2 );
+        this->Gradient_DDI( spins, gradient );
     }
 
     // External field
     if( idx_zeeman >= 0 )
     {
-        Vector3 ext_field = external_field_normal * external_field_magnitude;
+        next_interaction( idx_zeeman, 1 );
         this->Gradient_Zeeman( gradient );
-        energy += Backend::par::reduce(
-            N, [s, ext_field, mu_s] SPIRIT_LAMBDA( int idx ) { return -mu_s[idx] * ext_field.dot( s[idx] ); } );
+    }
+
+    // Cubic Anisotropy
+    if( idx_cubic_anisotropy >= 0 )
+    {
+        next_interaction( idx_cubic_anisotropy, 4 );
+        this->Gradient_Cubic_Anisotropy( spins, gradient );
     }
 
     // Quadruplets
-    if( idx_quadruplet > 0 )
+    if( idx_quadruplet >= 0 )
     {
-        // Kind of a bandaid fix
+        next_interaction( idx_quadruplet, 4 );
         this->Gradient_Quadruplet( spins, gradient );
-        if( energy_contributions_per_spin[idx_quadruplet].second.size() != spins.size() )
-        {
-            energy_contributions_per_spin[idx_quadruplet].second.resize( spins.size() );
-        };
-        Vectormath::fill( energy_contributions_per_spin[idx_quadruplet].second, 0 );
-        E_Quadruplet( spins, energy_contributions_per_spin[idx_quadruplet].second );
-        energy += Vectormath::sum( energy_contributions_per_spin[idx_quadruplet].second );
     }
+
+    reduce_pending();
+
+    if( this->recording.active )
+        this->recording.valid = true;
 }
 
 __global__ void CU_Gradient_Zeeman(
@@ -853,7 +958,7 @@ __global__ void CU_Gradient_Zeeman(
     {
         for( int ibasis = 0; ibasis < n_cell_atoms; ++ibasis )
         {
-            int ispin = n_cell_atoms * icell + ibasis;
+            spirit_index ispin = n_cell_atoms * icell + ibasis;
             if( cu_check_atom_type( atom_types[ispin] ) )
                 gradient[ispin] -= mu_s[ispin] * external_field_magnitude * external_field_normal;
         }
@@ -861,7 +966,7 @@ __global__ void CU_Gradient_Zeeman(
 }
 void Hamiltonian_Heisenberg::Gradient_Zeeman( vectorfield & gradient )
 {
-    int size = geometry->n_cells_total;
+    spirit_index size = geometry->n_cells_total;
     CU_Gradient_Zeeman<<<( size + 1023 ) / 1024, 1024>>>(
         this->geometry->atom_types.data(), geometry->n_cell_atoms, geometry->mu_s.data(),
         this->external_field_magnitude, this->external_field_normal, gradient.data(), size );
@@ -877,7 +982,7 @@ __global__ void CU_Gradient_Anisotropy(
     {
         for( int iani = 0; iani < n_anisotropies; ++iani )
         {
-            int ispin = icell * n_cell_atoms + anisotropy_indices[iani];
+            spirit_index ispin = icell * n_cell_atoms + anisotropy_indices[iani];
             if( cu_check_atom_type( atom_types[ispin] ) )
             {
                 scalar sc = -2 * anisotropy_magnitude[iani] * anisotropy_normal[iani].dot( spins[ispin] );
@@ -888,7 +993,7 @@ __global__ void CU_Gradient_Anisotropy(
 }
 void Hamiltonian_Heisenberg::Gradient_Anisotropy( const vectorfield & spins, vectorfield & gradient )
 {
-    int size = geometry->n_cells_total;
+    spirit_index size = geometry->n_cells_total;
     CU_Gradient_Anisotropy<<<( size + 1023 ) / 1024, 1024>>>(
         spins.data(), this->geometry->atom_types.data(), this->geometry->n_cell_atoms, this->anisotropy_indices.size(),
         this->anisotropy_indices.data(), this->anisotropy_magnitudes.data(), this->anisotropy_normals.data(),
@@ -904,7 +1009,7 @@ __global__ void CU_Gradient_Cubic_Anisotropy(
     {
         for( int iani = 0; iani < n_anisotropies; ++iani )
         {
-            int ispin = icell * n_cell_atoms + anisotropy_indices[iani];
+            spirit_index ispin = icell * n_cell_atoms + anisotropy_indices[iani];
             if( cu_check_atom_type( atom_types[ispin] ) )
             {
                 for( int icomp = 0; icomp < 3; ++icomp )
@@ -917,7 +1022,7 @@ __global__ void CU_Gradient_Cubic_Anisotropy(
 }
 void Hamiltonian_Heisenberg::Gradient_Cubic_Anisotropy( const vectorfield & spins, vectorfield & gradient )
 {
-    int size = geometry->n_cells_total;
+    spirit_index size = geometry->n_cells_total;
     CU_Gradient_Cubic_Anisotropy<<<( size + 1023 ) / 1024, 1024>>>(
         spins.data(), this->geometry->atom_types.data(), this->geometry->n_cell_atoms,
         this->cubic_anisotropy_indices.size(), this->cubic_anisotropy_indices.data(),
@@ -936,8 +1041,8 @@ __global__ void CU_Gradient_Exchange(
     {
         for( auto ipair = 0; ipair < n_pairs; ++ipair )
         {
-            int ispin = pairs[ipair].i + icell * n_cell_atoms;
-            int jspin = cu_idx_from_pair( ispin, bc, nc, n_cell_atoms, atom_types, pairs[ipair] );
+            spirit_index ispin = pairs[ipair].i + icell * n_cell_atoms;
+            spirit_index jspin = cu_idx_from_pair( ispin, bc, nc, n_cell_atoms, atom_types, pairs[ipair] );
             if( jspin >= 0 )
             {
                 gradient[ispin] -= magnitudes[ipair] * spins[jspin];
@@ -947,7 +1052,7 @@ __global__ void CU_Gradient_Exchange(
 }
 void Hamiltonian_Heisenberg::Gradient_Exchange( const vectorfield & spins, vectorfield & gradient )
 {
-    int size = geometry->n_cells_total;
+    spirit_index size = geometry->n_cells_total;
     CU_Gradient_Exchange<<<( size + 1023 ) / 1024, 1024>>>(
         spins.data(), this->geometry->atom_types.data(), boundary_conditions.data(), geometry->n_cells.data(),
         geometry->n_cell_atoms, this->exchange_pairs.size(), this->exchange_pairs.data(),
@@ -967,8 +1072,8 @@ __global__ void CU_Gradient_DMI(
     {
         for( auto ipair = 0; ipair < n_pairs; ++ipair )
         {
-            int ispin = pairs[ipair].i + icell * n_cell_atoms;
-            int jspin = cu_idx_from_pair( ispin, bc, nc, n_cell_atoms, atom_types, pairs[ipair] );
+            spirit_index ispin = pairs[ipair].i + icell * n_cell_atoms;
+            spirit_index jspin = cu_idx_from_pair( ispin, bc, nc, n_cell_atoms, atom_types, pairs[ipair] );
             if( jspin >= 0 )
             {
                 gradient[ispin] -= magnitudes[ipair] * spins[jspin].cross( normals[ipair] );
@@ -978,7 +1083,7 @@ __global__ void CU_Gradient_DMI(
 }
 void Hamiltonian_Heisenberg::Gradient_DMI( const vectorfield & spins, vectorfield & gradient )
 {
-    int size = geometry->n_cells_total;
+    spirit_index size = geometry->n_cells_total;
     CU_Gradient_DMI<<<( size + 1023 ) / 1024, 1024>>>(
         spins.data(), this->geometry->atom_types.data(), boundary_conditions.data(), geometry->n_cells.data(),
         geometry->n_cell_atoms, this->dmi_pairs.size(), this->dmi_pairs.data(), this->dmi_magnitudes.data(),
@@ -1010,10 +1115,10 @@ __global__ void CU_FFT_Pointwise_Mult(
     int * iteration_bounds, int * inter_sublattice_lookup, FFT::StrideContainer dipole_stride,
     FFT::StrideContainer spin_stride )
 {
-    int nos = iteration_bounds[0] * iteration_bounds[1] * iteration_bounds[2] * iteration_bounds[3];
+    spirit_index nos = iteration_bounds[0] * iteration_bounds[1] * iteration_bounds[2] * iteration_bounds[3];
     int tupel[4];
 
-    for( int ispin = blockIdx.x * blockDim.x + threadIdx.x; ispin < nos; ispin += blockDim.x * gridDim.x )
+    for( spirit_index ispin = blockIdx.x * blockDim.x + threadIdx.x; ispin < nos; ispin += blockDim.x * gridDim.x )
     {
         cu_tupel_from_idx( ispin, tupel, iteration_bounds, 4 ); // tupel now is {i_b1, a, b, c}
         int i_b1 = tupel[0], a = tupel[1], b = tupel[2], c = tupel[3];
@@ -1061,11 +1166,12 @@ __global__ void CU_Write_FFT_Gradients(
     FFT::FFT_real_type * resiFFT, Vector3 * gradient, FFT::StrideContainer spin_stride, int * iteration_bounds,
     int n_cell_atoms, scalar * mu_s, int sublattice_size )
 {
-    int nos = iteration_bounds[0] * iteration_bounds[1] * iteration_bounds[2] * iteration_bounds[3];
+    spirit_index nos = iteration_bounds[0] * iteration_bounds[1] * iteration_bounds[2] * iteration_bounds[3];
     int tupel[4];
     int idx_pad;
 
-    for( int idx_orig = blockIdx.x * blockDim.x + threadIdx.x; idx_orig < nos; idx_orig += blockDim.x * gridDim.x )
+    for( spirit_index idx_orig = blockIdx.x * blockDim.x + threadIdx.x; idx_orig < nos;
+         idx_orig += blockDim.x * gridDim.x )
     {
         cu_tupel_from_idx( idx_orig, tupel, iteration_bounds, 4 ); // tupel now is {ib, a, b, c}
         idx_pad = tupel[0] * spin_stride.basis + tupel[1] * spin_stride.a + tupel[2] * spin_stride.b
@@ -1129,16 +1235,16 @@ void Hamiltonian_Heisenberg::Gradient_Quadruplet( const vectorfield & spins, vec
             {
                 for( int dc = 0; dc < geometry->n_cells[2]; ++dc )
                 {
-                    int ispin = i
+                    spirit_index ispin = i
                                 + Vectormath::idx_from_translations(
                                     geometry->n_cells, geometry->n_cell_atoms, { da, db, dc } );
-                    int jspin = idx_from_pair(
+                    spirit_index jspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         { i, j, { d_j[0], d_j[1], d_j[2] } } );
-                    int kspin = idx_from_pair(
+                    spirit_index kspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         { i, k, { d_k[0], d_k[1], d_k[2] } } );
-                    int lspin = idx_from_pair(
+                    spirit_index lspin = idx_from_pair(
                         ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                         { i, l, { d_l[0], d_l[1], d_l[2] } } );
 
@@ -1161,18 +1267,18 @@ void Hamiltonian_Heisenberg::Gradient_Quadruplet( const vectorfield & spins, vec
 
 void Hamiltonian_Heisenberg::Hessian( const vectorfield & spins, MatrixX & hessian )
 {
-    int nos     = spins.size();
-    const int N = geometry->n_cell_atoms;
+    spirit_index nos = spins.size();
+    const int N      = geometry->n_cell_atoms;
 
     // --- Set to zero
     hessian.setZero();
 
     // --- Single Spin elements
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
+    for( spirit_index icell = 0; icell < geometry->n_cells_total; ++icell )
     {
         for( int iani = 0; iani < anisotropy_indices.size(); ++iani )
         {
-            int ispin = icell * N + anisotropy_indices[iani];
+            spirit_index ispin = icell * N + anisotropy_indices[iani];
             if( check_atom_type( this->geometry->atom_types[ispin] ) )
             {
                 for( int alpha = 0; alpha < 3; ++alpha )
@@ -1192,12 +1298,12 @@ void Hamiltonian_Heisenberg::Hessian( const vectorfield & spins, MatrixX & hessi
 
     // --- Spin Pair elements
     // Exchange
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
+    for( spirit_index icell = 0; icell < geometry->n_cells_total; ++icell )
     {
         for( unsigned int i_pair = 0; i_pair < exchange_pairs.size(); ++i_pair )
         {
-            int ispin = exchange_pairs[i_pair].i + icell * geometry->n_cell_atoms;
-            int jspin = idx_from_pair(
+            spirit_index ispin = exchange_pairs[i_pair].i + icell * geometry->n_cell_atoms;
+            spirit_index jspin = idx_from_pair(
                 ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                 exchange_pairs[i_pair] );
             if( jspin >= 0 )
@@ -1214,12 +1320,12 @@ void Hamiltonian_Heisenberg::Hessian( const vectorfield & spins, MatrixX & hessi
     }
 
     // DMI
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
+    for( spirit_index icell = 0; icell < geometry->n_cells_total; ++icell )
     {
         for( unsigned int i_pair = 0; i_pair < dmi_pairs.size(); ++i_pair )
         {
-            int ispin = dmi_pairs[i_pair].i + icell * geometry->n_cell_atoms;
-            int jspin = idx_from_pair(
+            spirit_index ispin = dmi_pairs[i_pair].i + icell * geometry->n_cell_atoms;
+            spirit_index jspin = idx_from_pair(
                 ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                 dmi_pairs[i_pair] );
             if( jspin >= 0 )
@@ -1241,9 +1347,9 @@ void Hamiltonian_Heisenberg::Hessian( const vectorfield & spins, MatrixX & hessi
     if( ddi_method != DDI_Method::None )
     {
         scalar mult = C::mu_0 * C::mu_B * C::mu_B / ( 4 * C::Pi * 1e-30 );
-        for( int idx1 = 0; idx1 < geometry->nos; idx1++ )
+        for( spirit_index idx1 = 0; idx1 < geometry->nos; idx1++ )
         {
-            for( int idx2 = 0; idx2 < geometry->nos; idx2++ )
+            for( spirit_index idx2 = 0; idx2 < geometry->nos; idx2++ )
             {
                 auto diff  = this->geometry->positions[idx2] - this->geometry->positions[idx1];
                 scalar d   = diff.norm(), d3, d5;
@@ -1304,8 +1410,8 @@ void Hamiltonian_Heisenberg::Hessian( const vectorfield & spins, MatrixX & hessi
 
 void Hamiltonian_Heisenberg::Sparse_Hessian( const vectorfield & spins, SpMatrixX & hessian )
 {
-    int nos     = spins.size();
-    const int N = geometry->n_cell_atoms;
+    spirit_index nos = spins.size();
+    const int N      = geometry->n_cell_atoms;
 
     typedef Eigen::Triplet<scalar> T;
     std::vector<T> tripletList;
@@ -1314,11 +1420,11 @@ void Hamiltonian_Heisenberg::Sparse_Hessian( const vectorfield & spins, SpMatrix
         * ( anisotropy_indices.size() * 9 + exchange_pairs.size() * 2 + dmi_pairs.size() * 3 ) );
 
     // --- Single Spin elements
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
+    for( spirit_index icell = 0; icell < geometry->n_cells_total; ++icell )
     {
         for( int iani = 0; iani < anisotropy_indices.size(); ++iani )
         {
-            int ispin = icell * N + anisotropy_indices[iani];
+            spirit_index ispin = icell * N + anisotropy_indices[iani];
             if( check_atom_type( this->geometry->atom_types[ispin] ) )
             {
                 for( int alpha = 0; alpha < 3; ++alpha )
@@ -1338,12 +1444,12 @@ void Hamiltonian_Heisenberg::Sparse_Hessian( const vectorfield & spins, SpMatrix
 
     // --- Spin Pair elements
     // Exchange
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
+    for( spirit_index icell = 0; icell < geometry->n_cells_total; ++icell )
     {
         for( unsigned int i_pair = 0; i_pair < exchange_pairs.size(); ++i_pair )
         {
-            int ispin = exchange_pairs[i_pair].i + icell * geometry->n_cell_atoms;
-            int jspin = idx_from_pair(
+            spirit_index ispin = exchange_pairs[i_pair].i + icell * geometry->n_cell_atoms;
+            spirit_index jspin = idx_from_pair(
                 ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                 exchange_pairs[i_pair] );
             if( jspin >= 0 )
@@ -1363,12 +1469,12 @@ void Hamiltonian_Heisenberg::Sparse_Hessian( const vectorfield & spins, SpMatrix
     }
 
     // DMI
-    for( int icell = 0; icell < geometry->n_cells_total; ++icell )
+    for( spirit_index icell = 0; icell < geometry->n_cells_total; ++icell )
     {
         for( unsigned int i_pair = 0; i_pair < dmi_pairs.size(); ++i_pair )
         {
-            int ispin = dmi_pairs[i_pair].i + icell * geometry->n_cell_atoms;
-            int jspin = idx_from_pair(
+            spirit_index ispin = dmi_pairs[i_pair].i + icell * geometry->n_cell_atoms;
+            spirit_index jspin = idx_from_pair(
                 ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types,
                 dmi_pairs[i_pair] );
             if( jspin >= 0 )
@@ -1402,10 +1508,11 @@ __global__ void CU_Write_FFT_Spin_Input(
     FFT::FFT_real_type * fft_spin_inputs, const Vector3 * spins, int * iteration_bounds,
     FFT::StrideContainer spin_stride, scalar * mu_s )
 {
-    int nos = iteration_bounds[0] * iteration_bounds[1] * iteration_bounds[2] * iteration_bounds[3];
+    spirit_index nos = iteration_bounds[0] * iteration_bounds[1] * iteration_bounds[2] * iteration_bounds[3];
     int tupel[4];
     int idx_pad;
-    for( int idx_orig = blockIdx.x * blockDim.x + threadIdx.x; idx_orig < nos; idx_orig += blockDim.x * gridDim.x )
+    for( spirit_index idx_orig = blockIdx.x * blockDim.x + threadIdx.x; idx_orig < nos;
+         idx_orig += blockDim.x * gridDim.x )
     {
         cu_tupel_from_idx( idx_orig, tupel, iteration_bounds, 4 ); // tupel now is {ib, a, b, c}
         idx_pad = tupel[0] * spin_stride.basis + tupel[1] * spin_stride.a + tupel[2] * spin_stride.b
@@ -5,12 +5,18 @@
 #include <utility/Exception.hpp>
 #include <utility/Logging.hpp>
 
+#if defined( SPIRIT_USE_THREADS ) && !defined( SPIRIT_USE_CUDA )
+#include <utility/Thread_Pool.hpp>
+#endif
+
 #include <Eigen/Dense>
 
 #include <GenEigsRealShiftSolver.h>
 #include <GenEigsSolver.h> // Also includes <MatOp/DenseGenMatProd.h>
 
+#include <algorithm>
 #include <array>
+#include <vector>
 
 namespace C = Utility::Constants;
 
@@ -25,7 +31,7 @@ void project_parallel( vectorfield & vf1, const vectorfield & vf2 )
     scalar proj = Vectormath::dot( vf1, vf2 );
     Backend::par::apply(
         vf1.size(),
-        [vf1 = vf1.data(), vf2 = vf2.data(), proj] SPIRIT_LAMBDA( int idx ) { vf1[idx] = proj * vf2[idx]; } );
+        [vf1 = vf1.data(), vf2 = vf2.data(), proj] SPIRIT_LAMBDA( spirit_index idx ) { vf1[idx] = proj * vf2[idx]; } );
 }
 
 void project_orthogonal( vectorfield & vf1, const vectorfield & vf2 )
@@ -63,6 +69,63 @@ void project_tangential( vectorfield & vf1, const vectorfield & vf2 )
         vf1[i] -= vf1[i].dot( vf2[i] ) * vf2[i];
 }
 
+namespace
+{
+
+// Largest value of f( idx ) over [0, n), where f may also write to the fields it captures
+template<typename F>
+scalar reduce_max( spirit_index n, const F & f )
+{
+#if defined( SPIRIT_USE_THREADS )
+    auto & pool = Utility::Thread_Pool::Get();
+    std::vector<scalar> partial_max( pool.N_Chunks( n ), 0 );
+    pool.Parallel_For(
+        n,
+        [&]( int i_chunk, spirit_index begin, spirit_index end )
+        {
+            scalar res = 0;
+            for( spirit_index idx = begin; idx < end; ++idx )
+                res = std::max( res, f( idx ) );
+            partial_max[i_chunk] = res;
+        } );
+    return *std::max_element( partial_max.begin(), partial_max.end() );
+#else
+    scalar res = 0;
+#pragma omp parallel for reduction( max : res )
+    for( spirit_index idx = 0; idx < n; ++idx )
+        res = std::max( res, f( idx ) );
+    return res;
+#endif
+}
+
+} // namespace
+
+scalar project_tangential_max_norm( vectorfield & vf1, const vectorfield & vf2 )
+{
+    scalar max_norm2 = reduce_max(
+        vf1.size(),
+        [&]( spirit_index idx )
+        {
+            vf1[idx] -= vf1[idx].dot( vf2[idx] ) * vf2[idx];
+            return vf1[idx].squaredNorm();
+        } );
+    return std::sqrt( max_norm2 );
+}
+
+scalar project_tangential_max_norm(
+    vectorfield & vf1, const vectorfield & vf2, const vectorfield & vf3, vectorfield & vf3_tangential )
+{
+    scalar max_norm2 = reduce_max(
+        vf1.size(),
+        [&]( spirit_index idx )
+        {
+            vf3_tangential[idx] = vf3[idx] - vf3[idx].dot( vf2[idx] ) * vf2[idx];
+            vf1[idx] -= vf1[idx].dot( vf2[idx] ) * vf2[idx];
+            return vf1[idx].squaredNorm();
+        } );
+    return std::sqrt( max_norm2 );
+}
+
 scalar dist_geodesic( const vectorfield & v1, const vectorfield & v2 )
 {
     scalar dist = 0;
@@ -86,7 +149,7 @@ void Geodesic_Tangent(
             image_plus  = image_2.data(),
             image_mid   = image_mid.data(),
             tangent     = tangent.data()
-        ] SPIRIT_LAMBDA (int idx)
+        ] SPIRIT_LAMBDA (spirit_index idx)
         {
             const Vector3 ex = { 1, 0, 0 };
             const Vector3 ey = { 0, 1, 0 };
@@ -116,8 +179,8 @@ void Tangents(
     std::vector<std::shared_ptr<vectorfield>> configurations, const std::vector<scalar> & energies,
     std::vector<vectorfield> & tangents )
 {
-    int noi = configurations.size();
-    int nos = ( *configurations[0] ).size();
+    int noi          = configurations.size();
+    spirit_index nos = ( *configurations[0] ).size();
 
     for( int idx_img = 0; idx_img < noi; ++idx_img )
     {
@@ -188,7 +251,7 @@ void Tangents(
             {
                 Vectormath::set_c_a( 1, t_minus, tangents[idx_img] );
                 // tangents = t_minus;
-                for( int i = 0; i < nos; ++i )
+                for( spirit_index i = 0; i < nos; ++i )
                 {
                     tangents[idx_img][i] = t_minus[i];
                 }
@@ -230,12 +293,12 @@ void normalize( vectorfield & vf )
 
 MatrixX tangential_projector( const vectorfield & image )
 {
-    int nos  = image.size();
-    int size = 3 * nos;
+    spirit_index nos = image.size();
+    int size         = 3 * nos;
 
     // Get projection matrix M=1-S, blockwise S=x*x^T
     MatrixX proj = MatrixX::Identity( size, size );
-    for( int i = 0; i < nos; ++i )
+    for( spirit_index i = 0; i < nos; ++i )
     {
         proj.block<3, 3>( 3 * i, 3 * i ) -= image[i] * image[i].transpose();
     }
@@ -243,6 +306,52 @@ MatrixX tangential_projector( const vectorfield & image )
     return proj;
 }
 
+void tangential_projector( const vectorfield & image, field<Matrix3> & projector )
+{
+    projector.resize( image.size() );
+#pragma omp parallel for
+    for( unsigned int i = 0; i < image.size(); ++i )
+        projector[i] = Matrix3::Identity() - image[i] * image[i].transpose();
+}
+
+namespace
+{
+
+// The (3x2) block of the spherical tangent basis for a single unit vector, see below
+Matrix3x2 tangent_basis_spherical_block( const Vector3 & v )
+{
+    Matrix3x2 block;
+    if( v[2] > 1 - 1e-8 )
+    {
+        Vector3 tmp    = Vector3{ 1, 0, 0 };
+        block.col( 0 ) = ( tmp - tmp.dot( v ) * v ).normalized();
+        tmp            = Vector3{ 0, 1, 0 };
+        block.col( 1 ) = ( tmp - tmp.dot( v ) * v ).normalized();
+    }
+    else if( v[2] < -1 + 1e-8 )
+    {
+        Vector3 tmp    = Vector3{ 1, 0, 0 };
+        block.col( 0 ) = ( tmp - tmp.dot( v ) * v ).normalized();
+        tmp            = Vector3{ 0, -1, 0 };
+        block.col( 1 ) = ( tmp - tmp.dot( v ) * v ).normalized();
+    }
+    else
+    {
+        scalar rxy   = std::sqrt( 1 - v[2] * v[2] );
+        scalar z_rxy = v[2] / rxy;
+
+        // Note: these are not unit vectors, but derivatives!
+        Vector3 etheta = Vector3{ v[0] * z_rxy, v[1] * z_rxy, -rxy };
+        Vector3 ephi   = Vector3{ -v[1] / rxy, v[0] / rxy, 0 };
+
+        block.col( 0 ) = ( etheta - etheta.dot( v ) * v ).normalized();
+        block.col( 1 ) = ( ephi - ephi.dot( v ) * v ).normalized();
+    }
+    return block;
+}
+
+} // namespace
+
 // This gives an orthogonal matrix of shape (3N, 2N), meaning M^T=M^-1 or M^T*M=1.
 // This assumes that the vectors of vf are normalized and that basis is 3N x 2N
 // It can be used to transform a vector into or back from the tangent space of a
@@ -253,97 +362,150 @@ MatrixX tangential_projector( const vectorfield & image )
 //      of a unit sphere, represented in 3N, as the two columns of the matrix.
 void tangent_basis_spherical( const vectorfield & vf, MatrixX & basis )
 {
-    Vector3 tmp, etheta, ephi;
     basis.setZero();
+    for( unsigned int i = 0; i < vf.size(); ++i )
+        basis.block<3, 2>( 3 * i, 2 * i ) = tangent_basis_spherical_block( vf[i] );
+}
+
+void tangent_basis_spherical( const vectorfield & vf, field<Matrix3x2> & basis )
+{
+    basis.resize( vf.size() );
+#pragma omp parallel for
+    for( unsigned int i = 0; i < vf.size(); ++i )
+        basis[i] = tangent_basis_spherical_block( vf[i] );
+}
+
+void sparse_tangent_basis_spherical( const vectorfield & vf, SpMatrixX & basis )
+{
+    typedef Eigen::Triplet<scalar> T;
+    std::vector<T> triplet_list;
+    triplet_list.reserve( vf.size() * 6 );
+
     for( unsigned int i = 0; i < vf.size(); ++i )
     {
-        if( vf[i][2] > 1 - 1e-8 )
+        const Matrix3x2 block = tangent_basis_spherical_block( vf[i] );
+        for( int col = 0; col < 2; ++col )
         {
-            tmp                                   = Vector3{ 1, 0, 0 };
-            basis.block<3, 1>( 3 * i, 2 * i )     = ( tmp - tmp.dot( vf[i] ) * vf[i] ).normalized();
-            tmp                                   = Vector3{ 0, 1, 0 };
-            basis.block<3, 1>( 3 * i, 2 * i + 1 ) = ( tmp - tmp.dot( vf[i] ) * vf[i] ).normalized();
+            for( int row = 0; row < 3; ++row )
+                triplet_list.push_back( T( 3 * i + row, 2 * i + col, block( row, col ) ) );
         }
-        else if( vf[i][2] < -1 + 1e-8 )
-        {
-            tmp                                   = Vector3{ 1, 0, 0 };
-            basis.block<3, 1>( 3 * i, 2 * i )     = ( tmp - tmp.dot( vf[i] ) * vf[i] ).normalized();
-            tmp                                   = Vector3{ 0, -1, 0 };
-            basis.block<3, 1>( 3 * i, 2 * i + 1 ) = ( tmp - tmp.dot( vf[i] ) * vf[i] ).normalized();
-        }
-        else
-        {
-            scalar rxy   = std::sqrt( 1 - vf[i][2] * vf[i][2] );
-            scalar z_rxy = vf[i][2] / rxy;
+    }
+    basis.setFromTriplets( triplet_list.begin(), triplet_list.end() );
+}
 
-            // Note: these are not unit vectors, but derivatives!
-            etheta = Vector3{ vf[i][0] * z_rxy, vf[i][1] * z_rxy, -rxy };
-            ephi   = Vector3{ -vf[i][1] / rxy, vf[i][0] / rxy, 0 };
+void project_blockwise( const field<Matrix3> & projector, const MatrixX & matrix, MatrixX & matrix_out )
+{
+    const spirit_index nos = projector.size();
+    matrix_out.resize( 3 * nos, 3 * nos );
 
-            basis.block<3, 1>( 3 * i, 2 * i )     = ( etheta - etheta.dot( vf[i] ) * vf[i] ).normalized();
-            basis.block<3, 1>( 3 * i, 2 * i + 1 ) = ( ephi - ephi.dot( vf[i] ) * vf[i] ).normalized();
+    // Each (3x3) block (i,j) of the result is P_i * M_ij * P_j
+#pragma omp parallel for
+    for( spirit_index j = 0; j < nos; ++j )
+    {
+        for( spirit_index i = 0; i < nos; ++i )
+        {
+            matrix_out.block<3, 3>( 3 * i, 3 * j ) = projector[i] * matrix.block<3, 3>( 3 * i, 3 * j ) * projector[j];
         }
     }
 }
 
-void sparse_tangent_basis_spherical( const vectorfield & vf, SpMatrixX & basis )
+void project_blockwise( const field<Matrix3> & projector, const SpMatrixX & matrix, SpMatrixX & matrix_out )
 {
+    const spirit_index nos = projector.size();
+
+    // Every non-zero entry M(3i+a, 3j+b) contributes to the (3x3) block (i,j) of the result
     typedef Eigen::Triplet<scalar> T;
     std::vector<T> triplet_list;
-    triplet_list.reserve( vf.size() * 3 );
-
-    Vector3 tmp, etheta, ephi, res;
-    for( unsigned int i = 0; i < vf.size(); ++i )
+    triplet_list.reserve( 9 * matrix.nonZeros() );
+    for( int k = 0; k < matrix.outerSize(); ++k )
     {
-        if( vf[i][2] > 1 - 1e-8 )
+        for( SpMatrixX::InnerIterator it( matrix, k ); it; ++it )
         {
-            tmp = Vector3{ 1, 0, 0 };
-            res = ( tmp - tmp.dot( vf[i] ) * vf[i] ).normalized();
-
-            triplet_list.push_back( T( 3 * i, 2 * i, res[0] ) );
-            triplet_list.push_back( T( 3 * i + 1, 2 * i, res[1] ) );
-            triplet_list.push_back( T( 3 * i + 2, 2 * i, res[2] ) );
-
-            tmp = Vector3{ 0, 1, 0 };
-            res = ( tmp - tmp.dot( vf[i] ) * vf[i] ).normalized();
-            triplet_list.push_back( T( 3 * i, 2 * i + 1, res[0] ) );
-            triplet_list.push_back( T( 3 * i + 1, 2 * i + 1, res[1] ) );
-            triplet_list.push_back( T( 3 * i + 2, 2 * i + 1, res[2] ) );
+            const int i = it.row() / 3, a = it.row() % 3;
+            const int j = it.col() / 3, b = it.col() % 3;
+            for( int p = 0; p < 3; ++p )
+            {
+                for( int q = 0; q < 3; ++q )
+                {
+                    triplet_list.push_back(
+                        T( 3 * i + p, 3 * j + q, projector[i]( p, a ) * it.value() * projector[j]( b, q ) ) );
+                }
+            }
         }
-        else if( vf[i][2] < -1 + 1e-8 )
+    }
+    matrix_out.resize( 3 * nos, 3 * nos );
+    matrix_out.setFromTriplets( triplet_list.begin(), triplet_list.end() );
+}
+
+void change_basis( const field<Matrix3x2> & basis, const MatrixX & matrix_3N, MatrixX & matrix_2N )
+{
+    const spirit_index nos = basis.size();
+    matrix_2N.resize( 2 * nos, 2 * nos );
+
+    // Each (2x2) block (i,j) of the result is B_i^T * M_ij * B_j
+#pragma omp parallel for
+    for( spirit_index j = 0; j < nos; ++j )
+    {
+        for( spirit_index i = 0; i < nos; ++i )
         {
-            tmp = Vector3{ 1, 0, 0 };
-            res = ( tmp - tmp.dot( vf[i] ) * vf[i] ).normalized();
-            triplet_list.push_back( T( 3 * i, 2 * i, res[0] ) );
-            triplet_list.push_back( T( 3 * i + 1, 2 * i, res[1] ) );
-            triplet_list.push_back( T( 3 * i + 2, 2 * i, res[2] ) );
-
-            tmp = Vector3{ 0, -1, 0 };
-            res = ( tmp - tmp.dot( vf[i] ) * vf[i] ).normalized();
-            triplet_list.push_back( T( 3 * i, 2 * i + 1, res[0] ) );
-            triplet_list.push_back( T( 3 * i + 1, 2 * i + 1, res[1] ) );
-            triplet_list.push_back( T( 3 * i + 2, 2 * i + 1, res[2] ) );
+            matrix_2N.block<2, 2>( 2 * i, 2 * j )
+                = basis[i].transpose() * matrix_3N.block<3, 3>( 3 * i, 3 * j ) * basis[j];
         }
-        else
-        {
-            scalar rxy   = std::sqrt( 1 - vf[i][2] * vf[i][2] );
-            scalar z_rxy = vf[i][2] / rxy;
+    }
+}
 
-            // Note: these are not unit vectors, but derivatives!
-            etheta = Vector3{ vf[i][0] * z_rxy, vf[i][1] * z_rxy, -rxy };
-            ephi   = Vector3{ -vf[i][1] / rxy, vf[i][0] / rxy, 0 };
-
-            res = ( etheta - etheta.dot( vf[i] ) * vf[i] ).normalized();
-            triplet_list.push_back( T( 3 * i, 2 * i, res[0] ) );
-            triplet_list.push_back( T( 3 * i + 1, 2 * i, res[1] ) );
-            triplet_list.push_back( T( 3 * i + 2, 2 * i, res[2] ) );
-            res = ( ephi - ephi.dot( vf[i] ) * vf[i] ).normalized();
-            triplet_list.push_back( T( 3 * i, 2 * i + 1, res[0] ) );
-            triplet_list.push_back( T( 3 * i + 1, 2 * i + 1, res[1] ) );
-            triplet_list.push_back( T( 3 * i + 2, 2 * i + 1, res[2] ) );
+void change_basis( const field<Matrix3x2> & basis, const SpMatrixX & matrix_3N, SpMatrixX & matrix_2N )
+{
+    const spirit_index nos = basis.size();
+
+    // Every non-zero entry M(3i+a, 3j+b) contributes to the (2x2) block (i,j) of the result
+    typedef Eigen::Triplet<scalar> T;
+    std::vector<T> triplet_list;
+    triplet_list.reserve( 4 * matrix_3N.nonZeros() );
+    for( int k = 0; k < matrix_3N.outerSize(); ++k )
+    {
+        for( SpMatrixX::InnerIterator it( matrix_3N, k ); it; ++it )
+        {
+            const int i = it.row() / 3, a = it.row() % 3;
+            const int j = it.col() / 3, b = it.col() % 3;
+            for( int p = 0; p < 2; ++p )
+            {
+                for( int q = 0; q < 2; ++q )
+                {
+                    triplet_list.push_back(
+                        T( 2 * i + p, 2 * j + q, basis[i]( a, p ) * it.value() * basis[j]( b, q ) ) );
+                }
+            }
         }
     }
-    basis.setFromTriplets( triplet_list.begin(), triplet_list.end() );
+    matrix_2N.resize( 2 * nos, 2 * nos );
+    matrix_2N.setFromTriplets( triplet_list.begin(), triplet_list.end() );
+}
+
+void to_tangent_basis( const field<Matrix3x2> & basis, const VectorX & vector_3N, VectorX & vector_2N )
+{
+    const spirit_index nos = basis.size();
+    vector_2N.resize( 2 * nos );
+#pragma omp parallel for
+    for( spirit_index i = 0; i < nos; ++i )
+        vector_2N.segment<2>( 2 * i ) = basis[i].transpose() * vector_3N.segment<3>( 3 * i );
+}
+
+void from_tangent_basis( const field<Matrix3x2> & basis, const VectorX & vector_2N, VectorX & vector_3N )
+{
+    const spirit_index nos = basis.size();
+    vector_3N.resize( 3 * nos );
+#pragma omp parallel for
+    for( spirit_index i = 0; i < nos; ++i )
+        vector_3N.segment<3>( 3 * i ) = basis[i] * vector_2N.segment<2>( 2 * i );
+}
+
+void dense_basis( const field<Matrix3x2> & basis, MatrixX & basis_dense )
+{
+    const spirit_index nos = basis.size();
+    basis_dense            = MatrixX::Zero( 3 * nos, 2 * nos );
+    for( spirit_index i = 0; i < nos; ++i )
+        basis_dense.block<3, 2>( 3 * i, 2 * i ) = basis[i];
 }
 
 // This calculates the basis via calculation of cross products
@@ -460,12 +622,12 @@ void spherical_to_cartesian_jacobian( const vectorfield & vf, MatrixX & jacobian
 // The Hessian matrix of the transformation from spherical to euclidean coordinates
 void spherical_to_cartesian_hessian( const vectorfield & vf, MatrixX & gamma_x, MatrixX & gamma_y, MatrixX & gamma_z )
 {
-    int nos = vf.size();
+    spirit_index nos = vf.size();
     gamma_x.setZero();
     gamma_y.setZero();
     gamma_z.setZero();
 
-    for( unsigned int i = 0; i < nos; ++i )
+    for( spirit_index i = 0; i < nos; ++i )
     {
         scalar z_rxy = vf[i][2] / std::sqrt( 1 + 1e-6 - vf[i][2] * vf[i][2] );
 
@@ -486,11 +648,11 @@ void spherical_to_cartesian_christoffel_symbols( const vectorfield & vf, MatrixX
     using std::sin;
     using std::tan;
 
-    int nos     = vf.size();
-    gamma_theta = MatrixX::Zero( 2 * nos, 2 * nos );
-    gamma_phi   = MatrixX::Zero( 2 * nos, 2 * nos );
+    spirit_index nos = vf.size();
+    gamma_theta      = MatrixX::Zero( 2 * nos, 2 * nos );
+    gamma_phi        = MatrixX::Zero( 2 * nos, 2 * nos );
 
-    for( unsigned int i = 0; i < nos; ++i )
+    for( spirit_index i = 0; i < nos; ++i )
     {
         scalar theta = acos( vf[i][2] );
         scalar phi   = atan2( vf[i][1], vf[i][0] );
@@ -511,9 +673,9 @@ void sparse_hessian_bordered_3N(
     // Calculates a 3Nx3N matrix in the bordered Hessian approach and transforms it into the tangent basis,
     // making the result a 2Nx2N matrix. The bordered Hessian's Lagrange multipliers assume a local extremum.
 
-    int nos = image.size();
+    spirit_index nos = image.size();
     VectorX lambda( nos );
-    for( int i = 0; i < nos; ++i )
+    for( spirit_index i = 0; i < nos; ++i )
         lambda[i] = image[i].normalized().dot( gradient[i] );
 
     // Construct hessian_out
@@ -542,14 +704,14 @@ void hessian_bordered(
     // Calculates a 3Nx3N matrix in the bordered Hessian approach and transforms it into the tangent basis,
     // making the result a 2Nx2N matrix. The bordered Hessian's Lagrange multipliers assume a local extremum.
 
-    int nos        = image.size();
-    MatrixX tmp_3N = hessian;
+    spirit_index nos = image.size();
+    MatrixX tmp_3N   = hessian;
 
     VectorX lambda( nos );
-    for( int i = 0; i < nos; ++i )
+    for( spirit_index i = 0; i < nos; ++i )
         lambda[i] = image[i].dot( gradient[i] );
 
-    for( int i = 0; i < nos; ++i )
+    for( spirit_index i = 0; i < nos; ++i )
     {
         for( int j = 0; j < 3; ++j )
         {
@@ -558,11 +720,12 @@ void hessian_bordered(
     }
 
     // Calculate the basis transformation matrix
-    tangent_basis = MatrixX::Zero( 3 * nos, 2 * nos );
-    tangent_basis_spherical( image, tangent_basis );
+    field<Matrix3x2> basis;
+    tangent_basis_spherical( image, basis );
+    dense_basis( basis, tangent_basis );
 
     // Result is a 2Nx2N matrix
-    hessian_out = tangent_basis.transpose() * tmp_3N * tangent_basis;
+    change_basis( basis, tmp_3N, hessian_out );
 }
 
 void hessian_projected(
@@ -572,29 +735,30 @@ void hessian_projected(
     // Calculates a 3Nx3N matrix in the projector approach and transforms it into the tangent basis,
     // making the result a 2Nx2N matrix
 
-    int nos = image.size();
-    hessian_out.setZero();
+    spirit_index nos = image.size();
 
     // Calculate projector matrix
-    auto P = tangential_projector( image );
+    field<Matrix3> P;
+    tangential_projector( image, P );
 
     // Calculate tangential projection of Hessian
-    hessian_out = P * hessian * P;
+    MatrixX tmp_3N;
+    project_blockwise( P, hessian, tmp_3N );
 
     // Calculate correction terms
-    for( unsigned int i = 0; i < nos; ++i )
+    for( spirit_index i = 0; i < nos; ++i )
     {
-        hessian_out.block<3, 3>( 3 * i, 3 * i )
-            -= P.block<3, 3>( 3 * i, 3 * i ) * ( image[i].dot( gradient[i] ) )
-               + ( P.block<3, 3>( 3 * i, 3 * i ) * gradient[i] ) * image[i].transpose();
+        tmp_3N.block<3, 3>( 3 * i, 3 * i )
+            -= P[i] * ( image[i].dot( gradient[i] ) ) + ( P[i] * gradient[i] ) * image[i].transpose();
     }
 
     // Calculate the basis transformation matrix
-    tangent_basis = MatrixX::Zero( 3 * nos, 2 * nos );
-    tangent_basis_spherical( image, tangent_basis );
+    field<Matrix3x2> basis;
+    tangent_basis_spherical( image, basis );
+    dense_basis( basis, tangent_basis );
 
     // Result is a 2Nx2N matrix
-    hessian_out = tangent_basis.transpose() * hessian_out * tangent_basis;
+    change_basis( basis, tmp_3N, hessian_out );
 }
 
 void hessian_weingarten(
@@ -604,28 +768,34 @@ void hessian_weingarten(
     // Calculates a 3Nx3N matrix in the Weingarten map approach and transforms it into the tangent basis,
     // making the result a 2Nx2N matrix
 
-    int nos = image.size();
-    hessian_out.setZero();
+    spirit_index nos = image.size();
 
     // Calculate projector matrix
-    auto P = tangential_projector( image );
+    field<Matrix3> P;
+    tangential_projector( image, P );
 
-    // Calculate tangential projection of Hessian
-    hessian_out = P * hessian;
+    // Calculate tangential projection of Hessian, i.e. P * hessian, blockwise
+    MatrixX tmp_3N( 3 * nos, 3 * nos );
+#pragma omp parallel for
+    for( spirit_index j = 0; j < nos; ++j )
+    {
+        for( spirit_index i = 0; i < nos; ++i )
+            tmp_3N.block<3, 3>( 3 * i, 3 * j ) = P[i] * hessian.block<3, 3>( 3 * i, 3 * j );
+    }
 
     // Add the Weingarten map
-    for( unsigned int i = 0; i < nos; ++i )
+    for( spirit_index i = 0; i < nos; ++i )
     {
-        MatrixX proj = MatrixX::Identity( 3, 3 );
-        hessian_out.block<3, 3>( 3 * i, 3 * i ) -= MatrixX::Identity( 3, 3 ) * image[i].dot( gradient[i] );
+        tmp_3N.block<3, 3>( 3 * i, 3 * i ) -= Matrix3::Identity() * image[i].dot( gradient[i] );
     }
 
     // Calculate the basis transformation matrix
-    tangent_basis = MatrixX::Zero( 3 * nos, 2 * nos );
-    tangent_basis_spherical( image, tangent_basis );
+    field<Matrix3x2> basis;
+    tangent_basis_spherical( image, basis );
+    dense_basis( basis, tangent_basis );
 
     // Result is a 2Nx2N matrix
-    hessian_out = tangent_basis.transpose() * hessian_out * tangent_basis;
+    change_basis( basis, tmp_3N, hessian_out );
 }
 
 void hessian_spherical(
@@ -633,7 +803,7 @@ void hessian_spherical(
 {
     // Calculates a 2Nx2N hessian matrix containing second order spherical derivatives
 
-    int nos = image.size();
+    spirit_index nos = image.size();
 
     MatrixX jacobian   = MatrixX::Zero( 3 * nos, 2 * nos );
     MatrixX sph_hess_x = MatrixX::Zero( 2 * nos, 2 * nos );
@@ -648,7 +818,7 @@ void hessian_spherical(
 
     // Calculate transformed Hessian
     hessian_out = jacobian.transpose() * hessian * jacobian;
-    for( int i = 0; i < nos; ++i )
+    for( spirit_index i = 0; i < nos; ++i )
     {
         hessian_out.block<2, 2>( 2 * i, 2 * i ) += gradient[i][0] * sph_hess_x.block<2, 2>( 2 * i, 2 * i )
                                                    + gradient[i][1] * sph_hess_y.block<2, 2>( 2 * i, 2 * i )
@@ -662,7 +832,7 @@ void hessian_covariant(
     // Calculates a 2Nx2N covariant hessian matrix containing second order spherical derivatives
     // and correction terms (containing Christoffel symbols)
 
-    int nos = image.size();
+    spirit_index nos = image.size();
 
     // Calculate coordinate transformation jacobian
     MatrixX jacobian( 3 * nos, 2 * nos );
@@ -681,7 +851,7 @@ void hessian_covariant(
     Engine::Manifoldmath::spherical_to_cartesian_christoffel_symbols( image, christoffel_theta, christoffel_phi );
 
     // Calculate the covariant Hessian
-    for( int i = 0; i < nos; ++i )
+    for( spirit_index i = 0; i < nos; ++i )
     {
         hessian_out.block<2, 2>( 2 * i, 2 * i )
             -= gradient_spherical[2 * i] * christoffel_theta.block<2, 2>( 2 * i, 2 * i )
@@ -23,7 +23,7 @@ void project_parallel( vectorfield & vf1, const vectorfield & vf2 )
     scalar proj = Vectormath::dot( vf1, vf2 );
     Backend::par::apply(
         vf1.size(),
-        [vf1 = vf1.data(), vf2 = vf2.data(), proj] SPIRIT_LAMBDA( int idx ) { vf1[idx] = proj * vf2[idx]; } );
+        [vf1 = vf1.data(), vf2 = vf2.data(), proj] SPIRIT_LAMBDA( spirit_index idx ) { vf1[idx] = proj * vf2[idx]; } );
 }
 
 __global__ void cu_project_orthogonal( Vector3 * vf1, const Vector3 * vf2, scalar proj, size_t N )
@@ -76,6 +76,26 @@ void project_tangential( vectorfield & vf1, const vectorfield & vf2 )
     CU_CHECK_AND_SYNC();
 }
 
+scalar project_tangential_max_norm( vectorfield & vf1, const vectorfield & vf2 )
+{
+    project_tangential( vf1, vf2 );
+    return Vectormath::max_norm( vf1 );
+}
+
+scalar project_tangential_max_norm(
+    vectorfield & vf1, const vectorfield & vf2, const vectorfield & vf3, vectorfield & vf3_tangential )
+{
+    Backend::par::apply(
+        vf1.size(),
+        [vf1 = vf1.data(), vf2 = vf2.data(), vf3 = vf3.data(), vf3_tangential = vf3_tangential.data()] SPIRIT_LAMBDA(
+            spirit_index idx )
+        {
+            vf3_tangential[idx] = vf3[idx] - vf3[idx].dot( vf2[idx] ) * vf2[idx];
+            vf1[idx] -= vf1[idx].dot( vf2[idx] ) * vf2[idx];
+        } );
+    return Vectormath::max_norm( vf1 );
+}
+
 __inline__ __device__ scalar cu_dist_greatcircle( const Vector3 v1, const Vector3 v2 )
 {
     scalar r = v1.dot( v2 );
@@ -126,8 +146,8 @@ void Tangents(
     std::vector<std::shared_ptr<vectorfield>> configurations, const std::vector<scalar> & energies,
     std::vector<vectorfield> & tangents )
 {
-    int noi = configurations.size();
-    int nos = ( *configurations[0] ).size();
+    int noi          = configurations.size();
+    spirit_index nos = ( *configurations[0] ).size();
 
     for( int idx_img = 0; idx_img < noi; ++idx_img )
     {
@@ -196,7 +216,7 @@ void Tangents(
             {
                 Vectormath::set_c_a( 1, t_minus, tangents[idx_img] );
                 // tangents = t_minus;
-                for( int i = 0; i < nos; ++i )
+                for( spirit_index i = 0; i < nos; ++i )
                 {
                     tangents[idx_img][i] = t_minus[i];
                 }
@@ -1,12 +1,19 @@
 #include <engine/Manifoldmath.hpp>
 #include <engine/Method.hpp>
 #include <engine/Vectormath.hpp>
+#include <io/Checkpoint.hpp>
 #include <utility/Constants.hpp>
 #include <utility/Exception.hpp>
 #include <utility/Logging.hpp>
+#include <utility/Profiling.hpp>
+#include <utility/Stop_Control.hpp>
+#include <utility/Thread_Pool.hpp>
 #include <utility/Timing.hpp>
 
+#include <fmt/format.h>
+
 #include <algorithm>
+#include <cstdint>
 
 using namespace Utility;
 
@@ -27,6 +34,9 @@ Method::Method( std::shared_ptr<Data::Parameters_Method> parameters, int idx_img
     this->history_iteration  = std::vector<int>();
     this->history_max_torque = std::vector<scalar>();
     this->history_energy     = std::vector<scalar>();
+    this->max_torque         = 0;
+
+    this->force_max_abs_component = 0;
 
     // TODO: is this a good idea?
     this->n_iterations     = std::max( long( 1 ), this->parameters->n_iterations );
@@ -56,24 +66,31 @@ Method::Method( std::shared_ptr<Data::Parameters_Method> parameters, int idx_img
 
 void Method::Iterate()
 {
+    // Share the threads of the pool with the other simulations running at the same time
+    Thread_Budget thread_budget;
+    // Look for a STOP file in the background while iterating
+    Stop_Watch stop_watch;
+
     //---- Start timings
     this->starttime = Timing::CurrentDateTime();
     this->t_start   = std::chrono::system_clock::now();
-    auto t_current  = std::chrono::system_clock::now();
     this->t_last    = std::chrono::system_clock::now();
+    this->Start_Stop_Checks();
+    if( Profiling::enabled() )
+        this->timings_start = Profiling::Get_Timings();
 
     //---- Log messages
     this->Message_Start();
 
     //---- Initial save
-    this->Save_Current( this->starttime, this->iteration, true, false );
-
-    //---- Iteration loop
-    for( this->iteration = 0; this->ContinueIterating() && !this->Walltime_Expired( t_current - t_start );
-         this->iteration += n_iterations_amortize )
     {
-        t_current = std::chrono::system_clock::now();
+        SPIRIT_PROFILE( IO );
+        this->Save_Current( this->starttime, this->iteration, true, false );
+    }
 
+    //---- Iteration loop, which continues from the iteration of a resumed checkpoint
+    while( this->ContinueIterating() && !this->Walltime_Expired() )
+    {
         // Lock Systems
         this->Lock();
 
@@ -81,9 +98,18 @@ void Method::Iterate()
         this->Hook_Pre_Iteration();
         // Do n_iterations_amortize iterations
         for( int i = 0; i < n_iterations_amortize; i++ )
+        {
+            SPIRIT_PROFILE( Iteration );
             this->Iteration();
+        }
         // Post-iteration hook
-        this->Hook_Post_Iteration();
+        {
+            SPIRIT_PROFILE( Convergence );
+            this->Hook_Post_Iteration();
+        }
+        // Observables, using the quantities updated by the post-iteration hook
+        this->Sample_Observables();
+        this->Publish_Snapshots();
 
         // Recalculate FPS
         this->t_iterations.pop_front();
@@ -94,13 +120,27 @@ void Method::Iterate()
         {
             ++this->step;
             this->Message_Step();
+            SPIRIT_PROFILE( IO );
             this->Save_Current( this->starttime, this->iteration, false, false );
         }
 
+        this->iteration += n_iterations_amortize;
+        if( this->Checkpoint_Due( n_iterations_amortize ) )
+        {
+            SPIRIT_PROFILE( IO );
+            this->Save_Checkpoint();
+        }
+
         // Unlock systems
         this->Unlock();
     }
 
+    //---- Checkpoint of the final state, e.g. when the walltime has run out
+    {
+        SPIRIT_PROFILE( IO );
+        this->Save_Final_Checkpoint();
+    }
+
     //---- Finalize (set iterations_allowed to false etc.)
     this->Finalize();
 
@@ -109,6 +149,7 @@ void Method::Iterate()
     this->Message_End();
 
     //---- Final save
+    SPIRIT_PROFILE( IO );
     this->Save_Current( this->starttime, this->iteration, false, true );
 }
 
@@ -167,6 +208,26 @@ std::vector<scalar> Method::getTorqueMaxNorm_All()
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////// Protected functions
 
+void Method::Sample_Observables()
+{
+    const auto max_torque_all = this->getTorqueMaxNorm_All();
+    for( std::size_t img = 0; img < this->systems.size(); ++img )
+    {
+        auto & observables = *this->systems[img]->observables;
+        if( observables.Due( this->iteration, this->n_iterations_amortize ) )
+        {
+            const scalar max_torque = img < max_torque_all.size() ? max_torque_all[img] : this->max_torque;
+            observables.Sample( *this->systems[img], this->iteration, 0, max_torque );
+        }
+    }
+}
+
+void Method::Publish_Snapshots( bool force )
+{
+    for( auto & system : this->systems )
+        system->snapshot->Publish( *system->spins, force );
+}
+
 void Method::Initialize() {}
 
 void Method::Message_Start() {}
@@ -177,7 +238,8 @@ void Method::Iteration() {}
 
 bool Method::ContinueIterating()
 {
-    return this->iteration < this->n_iterations && this->Iterations_Allowed() && !this->StopFile_Present();
+    return this->iteration < this->n_iterations && this->Iterations_Allowed() && !this->StopFile_Present()
+           && !this->Stop_Requested();
 }
 
 bool Method::Iterations_Allowed()
@@ -185,18 +247,29 @@ bool Method::Iterations_Allowed()
     return this->systems[0]->iteration_allowed;
 }
 
-bool Method::Walltime_Expired( std::chrono::duration<scalar> dt_seconds )
+bool Method::Walltime_Expired()
 {
     if( this->parameters->max_walltime_sec <= 0 )
         return false;
-    else
-        return dt_seconds.count() > this->parameters->max_walltime_sec;
+
+    std::chrono::duration<scalar> dt_seconds = std::chrono::steady_clock::now() - this->t_start_monotonic;
+    return dt_seconds.count() > this->parameters->max_walltime_sec;
 }
 
 bool Method::StopFile_Present()
 {
-    std::ifstream f( "STOP" );
-    return f.good();
+    return Stop_Control::Stop_File_Present();
+}
+
+bool Method::Stop_Requested()
+{
+    return Stop_Control::N_Stop_Requests() != this->n_stop_requests_start;
+}
+
+void Method::Start_Stop_Checks()
+{
+    this->t_start_monotonic     = std::chrono::steady_clock::now();
+    this->n_stop_requests_start = Stop_Control::N_Stop_Requests();
 }
 
 void Method::Save_Current( std::string starttime, int iteration, bool initial, bool final )
@@ -207,6 +280,105 @@ void Method::Save_Current( std::string starttime, int iteration, bool initial, b
         "Tried to use Method::Save_Current() of the Method base class!" );
 }
 
+void Method::Checkpoint_Write( IO::Checkpoint_Writer & checkpoint )
+{
+    checkpoint.write( std::int64_t( this->iteration ) );
+    checkpoint.write( std::int64_t( this->step ) );
+    checkpoint.write( this->max_torque );
+    checkpoint.write( this->max_torque_all );
+    checkpoint.write( this->force_max_abs_component );
+    checkpoint.write( this->force_max_abs_component_all );
+    checkpoint.write( this->history_iteration );
+    checkpoint.write( this->history_max_torque );
+    checkpoint.write( this->history_energy );
+    for( auto & system : this->systems )
+        checkpoint.write( *system->spins );
+}
+
+void Method::Checkpoint_Read( IO::Checkpoint_Reader & checkpoint )
+{
+    const auto & header = checkpoint.header();
+    if( header.method != this->Name() || header.solver != this->SolverType() || header.noi != this->noi
+        || header.nos != this->nos )
+    {
+        spirit_throw(
+            Exception_Classifier::Bad_File_Content, Log_Level::Error,
+            fmt::format(
+                "Checkpoint \"{}\" of a {} calculation (solver {}, {} image(s) of {} spins) cannot be resumed by a {} "
+                "calculation (solver {}, {} image(s) of {} spins)",
+                checkpoint.filename, header.method, header.solver, header.noi, header.nos, this->Name(),
+                this->SolverType(), this->noi, this->nos ) );
+    }
+
+    std::int64_t iteration = 0, step = 0;
+    checkpoint.read( iteration );
+    checkpoint.read( step );
+    this->iteration            = iteration;
+    this->step                 = step;
+    this->iteration_checkpoint = iteration;
+    checkpoint.read( this->max_torque );
+    checkpoint.read( this->max_torque_all );
+    checkpoint.read( this->force_max_abs_component );
+    checkpoint.read( this->force_max_abs_component_all );
+    checkpoint.read( this->history_iteration );
+    checkpoint.read( this->history_max_torque );
+    checkpoint.read( this->history_energy );
+    for( auto & system : this->systems )
+        checkpoint.read( *system->spins );
+}
+
+void Method::Write_Checkpoint( const std::string & filename )
+{
+    IO::Checkpoint_Writer checkpoint( { this->Name(), this->SolverType(), this->noi, this->nos } );
+    this->Checkpoint_Write( checkpoint );
+    checkpoint.commit( filename );
+}
+
+void Method::Save_Checkpoint()
+{
+    const std::string filename = this->Checkpoint_Filename();
+    try
+    {
+        this->Write_Checkpoint( filename );
+        this->iteration_checkpoint = this->iteration;
+        Log( Log_Level::Debug, this->SenderName,
+             fmt::format( "Wrote checkpoint \"{}\" at iteration {}", filename, this->iteration ), this->idx_image,
+             this->idx_chain );
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_core( fmt::format( "Could not write checkpoint \"{}\"", filename ) );
+    }
+}
+
+void Method::Save_Final_Checkpoint()
+{
+    if( this->parameters->checkpoint_interval <= 0 || this->iteration_checkpoint == this->iteration )
+        return;
+    this->Lock();
+    this->Save_Checkpoint();
+    this->Unlock();
+}
+
+bool Method::Checkpoint_Due( int n_iterations_step ) const
+{
+    const long interval = this->parameters->checkpoint_interval;
+    return interval > 0 && this->iteration > 0 && this->iteration % interval < std::max( 1, n_iterations_step );
+}
+
+std::string Method::Checkpoint_Filename()
+{
+    if( !this->parameters->checkpoint_file.empty() )
+        return this->parameters->checkpoint_file;
+
+    // Not tagged with the start time, so that a resumed calculation keeps writing to the same file
+    std::string tag = this->parameters->output_file_tag;
+    tag             = ( tag.empty() || tag == "<time>" ) ? "" : tag + "_";
+    if( this->Name() == "GNEB" )
+        return fmt::format( "{}/{}Chain-{:0>2}_Checkpoint.bin", this->parameters->output_folder, tag, this->idx_chain );
+    return fmt::format( "{}/{}Image-{:0>2}_Checkpoint.bin", this->parameters->output_folder, tag, this->idx_image );
+}
+
 void Method::Hook_Pre_Iteration()
 {
     // Not Implemented!
@@ -269,4 +441,9 @@ std::string Method::SolverFullName()
     return "--";
 }
 
+int Method::SolverType()
+{
+    return -1;
+}
+
 } // namespace Engine
@@ -67,7 +67,7 @@ void Method_EMA::Iteration()
         this->mode = *this->systems[0]->modes[following_mode];
 
         // Find the axes of rotation for the mode to visualize
-        for( int idx = 0; idx < this->nos; idx++ )
+        for( spirit_index idx = 0; idx < this->nos; idx++ )
         {
             this->angle_initial[idx] = this->mode[idx].norm();
             this->axis[idx]          = this->spins_initial[idx].cross( this->mode[idx] ).normalized();
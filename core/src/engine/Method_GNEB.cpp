@@ -8,6 +8,7 @@
 #include <engine/Vectormath.hpp>
 #include <io/IO.hpp>
 #include <io/OVF_File.hpp>
+#include <io/Trajectory_File.hpp>
 #include <iostream>
 #include <utility/Cubic_Hermite_Spline.hpp>
 #include <utility/Logging.hpp>
@@ -49,6 +50,7 @@ Method_GNEB<solver>::Method_GNEB( std::shared_ptr<Data::Spin_System_Chain> chain
     this->tangents = std::vector<vectorfield>( this->noi, vectorfield( this->nos, { 0, 0, 0 } ) ); // [noi][nos]
     this->tangent_endpoints_left  = vectorfield( this->nos, { 0, 0, 0 } );                         // [nos]
     this->tangent_endpoints_right = vectorfield( this->nos, { 0, 0, 0 } );                         // [nos]
+    this->gradient_interpolation  = vectorfield( this->nos, { 0, 0, 0 } );                         // [nos]
 
     // We assume that the chain is not converged before the first iteration
     this->max_torque     = this->chain->gneb_parameters->force_convergence + 1.0;
@@ -96,7 +98,8 @@ void Method_GNEB<solver>::Calculate_Force(
     {
         auto & image = *configurations[img];
 
-        // Calculate the Gradient and Energy of the image
+        // Calculate the Gradient and Energy of the image, recording the energy contributions along the way
+        this->chain->images[img]->hamiltonian->Record_Energy_Contributions( this->iteration );
         this->chain->images[img]->hamiltonian->Gradient_and_Energy(
             image, this->chain->images[img]->effective_field, energies[img] );
 
@@ -107,7 +110,7 @@ void Method_GNEB<solver>::Calculate_Force(
         auto f_grad    = F_gradient[img].data();
         Backend::par::apply(
             image.size(),
-            [eff_field, f_grad] SPIRIT_LAMBDA( int idx )
+            [eff_field, f_grad] SPIRIT_LAMBDA( spirit_index idx )
             {
                 eff_field[idx] *= -1;
                 f_grad[idx] = eff_field[idx];
@@ -276,7 +279,7 @@ void Method_GNEB<solver>::Calculate_Force(
                     F_gradient_right    = F_gradient[noi-1].data(),
                     spins_left  = this->chain->images[0]->spins->data(),
                     spins_right = this->chain->images[noi-1]->spins->data()
-                ] SPIRIT_LAMBDA ( int idx)
+                ] SPIRIT_LAMBDA ( spirit_index idx)
                 {
                     const Vector3 axis = spins_left[idx].cross(spins_right[idx]);
                     const scalar angle = acos(spins_left[idx].dot(spins_right[idx]));
@@ -340,7 +343,7 @@ void Method_GNEB<solver>::Calculate_Force(
                     F_translation,
                     projection,
                     rotational_coeff
-                ] SPIRIT_LAMBDA ( int idx )
+                ] SPIRIT_LAMBDA ( spirit_index idx )
                 {
                     forces[idx] =   rotational_coeff * (F_gradient[idx] - projection * tangents[idx])
                                     + tangent_coeff * tangents[idx]
@@ -422,10 +425,7 @@ void Method_GNEB<solver>::Hook_Post_Iteration()
         // Set maximum overall
         if( fmax > this->max_torque )
             this->max_torque = fmax;
-
-        // Set the effective fields
-        Manifoldmath::project_tangential( this->forces[img], *this->systems[img]->spins );
-        // Vectormath::set_c_a(1, this->forces[img], this->systems[img]->effective_field);
+        // The effective fields are set in Calculate_Force
     }
 
     // --- Chain Data Update
@@ -448,7 +448,11 @@ void Method_GNEB<solver>::Hook_Post_Iteration()
     chain->Rx = this->Rx;
     //      E
     for( int img = 0; img < chain->noi; ++img )
+    {
         chain->images[img]->E = this->energies[img];
+        if( const auto * record = chain->images[img]->hamiltonian->Recorded_Energy_Contributions() )
+            chain->images[img]->E_array = record->energies;
+    }
     //      Rx interpolated
     chain->Rx_interpolated = interp[0];
     //      E interpolated
@@ -458,135 +462,48 @@ void Method_GNEB<solver>::Hook_Post_Iteration()
 template<Solver solver>
 void Method_GNEB<solver>::Calculate_Interpolated_Energy_Contributions()
 {
-    // This whole method could be made faster by calculating the energies from the gradients and not allocating the
-    // temporaries eacht time the method is called, but since this method should be called rather sparingly it should
-    // not matter very much.
-
     Log( Utility::Log_Level::Debug, Utility::Log_Sender::GNEB,
          std::string( "Calculating interpolated energy contributions" ), -1, -1 );
 
-    std::size_t nos = this->configurations[0]->size();
-    int noi         = this->chain->noi;
-
-    if( chain->images[0]->hamiltonian->Name() != "Heisenberg" )
-    {
-        Log( Utility::Log_Level::Error, Utility::Log_Sender::GNEB,
-             std::string( "Cannot calculate interpolated energy contribution for non-Heisenberg Hamiltonian!" ), -1,
-             -1 );
-        return;
-    }
-    auto & ham                 = (Engine::Hamiltonian_Heisenberg &)*( chain->images[0]->hamiltonian );
-    std::size_t n_interactions = ham.Number_of_Interactions();
+    int noi                    = this->chain->noi;
+    std::size_t n_interactions = this->chain->images[0]->hamiltonian->Number_of_Interactions();
 
-    // Allocate temporaries
-    field<Vector3> temp_field( nos, { 0, 0, 0 } );
-    field<scalar> temp_energy( nos, 0 );
+    std::vector<std::vector<scalar>> dE_dRx( n_interactions, std::vector<scalar>( noi, 0 ) );
+    std::vector<std::vector<scalar>> energies( n_interactions, std::vector<scalar>( noi, 0 ) );
 
-    std::vector<std::vector<scalar>> temp_dE_dRx( n_interactions, std::vector<scalar>( noi, 0 ) );
-    std::vector<std::vector<scalar>> temp_energies( n_interactions, std::vector<scalar>( noi, 0 ) );
-
-    // Calculate the energies and the inclinations
-    // TODO: Find a better way to do this without so much code duplication. Probably requires extension of the
-    // Hamiltonian in a way that allows to request information about the different contributions.
+    // The energies and their inclinations along the tangent are recorded in one gradient calculation per image
     for( int img = 0; img < noi; img++ )
     {
-        auto & image = *this->configurations[img];
-        if( ham.Idx_Exchange() >= 0 )
-        {
-            Vectormath::fill( temp_field, Vector3::Zero() );
-            Vectormath::fill( temp_energy, 0 );
-            ham.E_Exchange( image, temp_energy );
-            temp_energies[ham.Idx_Exchange()][img] = Vectormath::sum( temp_energy );
-            ham.Gradient_Exchange( image, temp_field );
-            temp_dE_dRx[ham.Idx_Exchange()][img] = -Vectormath::dot( temp_field, this->tangents[img] );
-        }
-        if( ham.Idx_Zeeman() >= 0 )
-        {
-            Vectormath::fill( temp_field, Vector3::Zero() );
-            Vectormath::fill( temp_energy, 0 );
-            ham.E_Zeeman( image, temp_energy );
-            temp_energies[ham.Idx_Zeeman()][img] = Vectormath::sum( temp_energy );
-            ham.Gradient_Zeeman( temp_field );
-            temp_dE_dRx[ham.Idx_Zeeman()][img] = -Vectormath::dot( temp_field, this->tangents[img] );
-        }
-        if( ham.Idx_Anisotropy() >= 0 )
-        {
-            Vectormath::fill( temp_field, Vector3::Zero() );
-            Vectormath::fill( temp_energy, 0 );
-            ham.E_Anisotropy( image, temp_energy );
-            temp_energies[ham.Idx_Anisotropy()][img] = Vectormath::sum( temp_energy );
-            ham.Gradient_Anisotropy( image, temp_field );
-            temp_dE_dRx[ham.Idx_Anisotropy()][img] = -Vectormath::dot( temp_field, this->tangents[img] );
-        }
-        if( ham.Idx_DMI() >= 0 )
-        {
-            Vectormath::fill( temp_field, Vector3::Zero() );
-            Vectormath::fill( temp_energy, 0 );
-            ham.E_DMI( image, temp_energy );
-            temp_energies[ham.Idx_DMI()][img] = Vectormath::sum( temp_energy );
-            ham.Gradient_DMI( image, temp_field );
-            temp_dE_dRx[ham.Idx_DMI()][img] = -Vectormath::dot( temp_field, this->tangents[img] );
-        }
-        if( ham.Idx_DDI() >= 0 )
+        auto & hamiltonian = *this->chain->images[img]->hamiltonian;
+        scalar energy      = 0;
+        hamiltonian.Record_Energy_Contributions( this->iteration, &this->tangents[img] );
+        hamiltonian.Gradient_and_Energy( *this->configurations[img], this->gradient_interpolation, energy );
+
+        const auto * record = hamiltonian.Recorded_Energy_Contributions();
+        if( record == nullptr || record->dE_dRx.size() != n_interactions )
         {
-            Vectormath::fill( temp_field, Vector3::Zero() );
-            Vectormath::fill( temp_energy, 0 );
-            ham.E_DDI( image, temp_energy );
-            temp_energies[ham.Idx_DDI()][img] = Vectormath::sum( temp_energy );
-            ham.Gradient_DDI( image, temp_field );
-            temp_dE_dRx[ham.Idx_DDI()][img] = -Vectormath::dot( temp_field, this->tangents[img] );
+            hamiltonian.Stop_Recording_Energy_Contributions();
+            Log( Utility::Log_Level::Error, Utility::Log_Sender::GNEB,
+                 fmt::format(
+                     "Cannot calculate interpolated energy contributions for the {} Hamiltonian!", hamiltonian.Name() ),
+                 -1, -1 );
+            return;
         }
-        if( ham.Idx_Quadruplet() >= 0 )
+        for( std::size_t i = 0; i < n_interactions; ++i )
         {
-            Vectormath::fill( temp_field, Vector3::Zero() );
-            Vectormath::fill( temp_energy, 0 );
-            ham.E_Quadruplet( image, temp_energy );
-            temp_energies[ham.Idx_Quadruplet()][img] = Vectormath::sum( temp_energy );
-            ham.Gradient_Quadruplet( image, temp_field );
-            temp_dE_dRx[ham.Idx_Quadruplet()][img] = -Vectormath::dot( temp_field, this->tangents[img] );
+            energies[i][img] = record->energies[i].second;
+            dE_dRx[i][img]   = record->dE_dRx[i];
         }
+
+        // The tangent is only valid for this calculation
+        hamiltonian.Stop_Recording_Energy_Contributions();
     }
-    if( ham.Idx_Exchange() >= 0 )
-    {
-        auto interp = Utility::Cubic_Hermite_Spline::Interpolate(
-            this->Rx, temp_energies[ham.Idx_Exchange()], temp_dE_dRx[ham.Idx_Exchange()],
-            this->chain->gneb_parameters->n_E_interpolations );
-        this->chain->E_array_interpolated[ham.Idx_Exchange()] = interp[1];
-    }
-    if( ham.Idx_Zeeman() >= 0 )
-    {
-        auto interp = Utility::Cubic_Hermite_Spline::Interpolate(
-            this->Rx, temp_energies[ham.Idx_Zeeman()], temp_dE_dRx[ham.Idx_Zeeman()],
-            this->chain->gneb_parameters->n_E_interpolations );
-        this->chain->E_array_interpolated[ham.Idx_Zeeman()] = interp[1];
-    }
-    if( ham.Idx_Anisotropy() >= 0 )
-    {
-        auto interp = Utility::Cubic_Hermite_Spline::Interpolate(
-            this->Rx, temp_energies[ham.Idx_Anisotropy()], temp_dE_dRx[ham.Idx_Anisotropy()],
-            this->chain->gneb_parameters->n_E_interpolations );
-        this->chain->E_array_interpolated[ham.Idx_Anisotropy()] = interp[1];
-    }
-    if( ham.Idx_DMI() >= 0 )
-    {
-        auto interp = Utility::Cubic_Hermite_Spline::Interpolate(
-            this->Rx, temp_energies[ham.Idx_DMI()], temp_dE_dRx[ham.Idx_DMI()],
-            this->chain->gneb_parameters->n_E_interpolations );
-        this->chain->E_array_interpolated[ham.Idx_DMI()] = interp[1];
-    }
-    if( ham.Idx_DDI() >= 0 )
-    {
-        auto interp = Utility::Cubic_Hermite_Spline::Interpolate(
-            this->Rx, temp_energies[ham.Idx_DDI()], temp_dE_dRx[ham.Idx_DDI()],
-            this->chain->gneb_parameters->n_E_interpolations );
-        this->chain->E_array_interpolated[ham.Idx_DDI()] = interp[1];
-    }
-    if( ham.Idx_Quadruplet() >= 0 )
+
+    for( std::size_t i = 0; i < n_interactions && i < this->chain->E_array_interpolated.size(); ++i )
     {
         auto interp = Utility::Cubic_Hermite_Spline::Interpolate(
-            this->Rx, temp_energies[ham.Idx_Quadruplet()], temp_dE_dRx[ham.Idx_Quadruplet()],
-            this->chain->gneb_parameters->n_E_interpolations );
-        this->chain->E_array_interpolated[ham.Idx_Quadruplet()] = interp[1];
+            this->Rx, energies[i], dE_dRx[i], this->chain->gneb_parameters->n_E_interpolations );
+        this->chain->E_array_interpolated[i] = interp[1];
     }
 }
 
@@ -594,6 +511,8 @@ template<Solver solver>
 void Method_GNEB<solver>::Finalize()
 {
     this->chain->iteration_allowed = false;
+    for( auto & image : this->chain->images )
+        image->hamiltonian->Stop_Recording_Energy_Contributions();
 }
 
 template<Solver solver>
@@ -630,12 +549,23 @@ void Method_GNEB<solver>::Save_Current( std::string starttime, int iteration, bo
         {
             try
             {
-                // File name
-                std::string chainFile = preChainFile + suffix + ".ovf";
-
                 // File format
                 IO::VF_FileFormat format = this->chain->gneb_parameters->output_vf_filetype;
 
+                // File name
+                std::string chainFile = preChainFile + suffix + IO::extension( format );
+
+                // Each image is stored as a frame, labelled by its index in the chain
+                if( IO::is_trajectory( format ) )
+                {
+                    auto file     = IO::Trajectory_File( chainFile );
+                    auto encoding = IO::trajectory_encoding( format );
+                    file.write_frame( *this->chain->images[0]->spins, 0, encoding );
+                    for( int i = 1; i < this->chain->noi; i++ )
+                        file.append_frame( *this->chain->images[i]->spins, i, encoding );
+                    return;
+                }
+
                 // Chain
                 std::string output_comment_base = fmt::format(
                     "{} simulation ({} solver)\n"
@@ -735,6 +665,24 @@ void Method_GNEB<solver>::Unlock()
     this->chain->Unlock();
 }
 
+template<Solver solver>
+void Method_GNEB<solver>::Checkpoint_Write( IO::Checkpoint_Writer & checkpoint )
+{
+    Method_Solver<solver>::Checkpoint_Write( checkpoint );
+    checkpoint.write( this->energies );
+    checkpoint.write( this->Rx );
+}
+
+template<Solver solver>
+void Method_GNEB<solver>::Checkpoint_Read( IO::Checkpoint_Reader & checkpoint )
+{
+    Method_Solver<solver>::Checkpoint_Read( checkpoint );
+    checkpoint.read( this->energies );
+    checkpoint.read( this->Rx );
+    for( int img = 0; img < this->noi; ++img )
+        this->chain->images[img]->E = this->energies[img];
+}
+
 // Method name as string
 template<Solver solver>
 std::string Method_GNEB<solver>::Name()
@@ -751,5 +699,7 @@ template class Method_GNEB<Solver::LBFGS_OSO>;
 template class Method_GNEB<Solver::LBFGS_Atlas>;
 template class Method_GNEB<Solver::VP>;
 template class Method_GNEB<Solver::VP_OSO>;
+template class Method_GNEB<Solver::NCG>;
+template class Method_GNEB<Solver::Newton>;
 
 } // namespace Engine
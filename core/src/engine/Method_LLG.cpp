@@ -5,7 +5,9 @@
 #include <engine/Vectormath.hpp>
 #include <io/IO.hpp>
 #include <io/OVF_File.hpp>
+#include <io/Trajectory_File.hpp>
 #include <utility/Logging.hpp>
+#include <utility/Profiling.hpp>
 #include <utility/Version.hpp>
 
 #include <ctime>
@@ -34,8 +36,6 @@ Method_LLG<solver>::Method_LLG( std::shared_ptr<Data::Spin_System> system, int i
     this->forces_virtual = std::vector<vectorfield>( this->noi, vectorfield( this->nos ) );
     this->Gradient       = std::vector<vectorfield>( this->noi, vectorfield( this->nos ) );
     this->xi             = vectorfield( this->nos, { 0, 0, 0 } );
-    this->s_c_grad       = vectorfield( this->nos, { 0, 0, 0 } );
-    this->jacobians      = field<Matrix3>( this->nos, Matrix3::Zero() );
 
     this->temperature_distribution = scalarfield( this->nos, 0 );
 
@@ -65,6 +65,8 @@ Method_LLG<solver>::Method_LLG( std::shared_ptr<Data::Spin_System> system, int i
 template<Solver solver>
 void Method_LLG<solver>::Prepare_Thermal_Field()
 {
+    SPIRIT_PROFILE( Thermal_Noise );
+
     auto & parameters = *this->systems[0]->llg_parameters;
     auto & geometry   = *this->systems[0]->geometry;
     auto & damping    = parameters.damping;
@@ -116,7 +118,9 @@ void Method_LLG<solver>::Calculate_Force(
     // Loop over images to calculate the total force on each Image
     for( std::size_t img = 0; img < this->systems.size(); ++img )
     {
-        // Minus the gradient is the total Force here
+        // Minus the gradient is the total Force here. The energy contributions are recorded along the way, so that
+        // they do not have to be recalculated for the output
+        this->systems[img]->hamiltonian->Record_Energy_Contributions( this->iteration );
         this->systems[img]->hamiltonian->Gradient_and_Energy( *configurations[img], Gradient[img], current_energy );
 
 #ifdef SPIRIT_ENABLE_PINNING
@@ -160,7 +164,8 @@ void Method_LLG<solver>::Calculate_Force_Virtual(
 
         // This is the force calculation as it should be for direct minimization
         // TODO: Also calculate force for VP solvers without additional scaling
-        if( solver == Solver::LBFGS_OSO || solver == Solver::LBFGS_Atlas )
+        if( solver == Solver::LBFGS_OSO || solver == Solver::LBFGS_Atlas || solver == Solver::NCG
+            || solver == Solver::Newton )
         {
             Vectormath::set_c_cross( 1.0, image, force, force_virtual );
         }
@@ -183,24 +188,37 @@ void Method_LLG<solver>::Calculate_Force_Virtual(
             {
                 if( parameters.stt_use_gradient )
                 {
-                    auto & boundary_conditions = this->systems[0]->hamiltonian->boundary_conditions;
+                    // Gradient approximation for in-plane currents. The stencil is built on first use, as the
+                    // geometry does not change while the method exists
+                    if( stt_stencil.factors.size() != 3 * image.size() )
+                    {
+                        Vectormath::finite_difference_stencil(
+                            geometry, this->systems[0]->hamiltonian->boundary_conditions, stt_stencil );
+                    }
 
-                    // Gradient approximation for in-plane currents
-                    Vectormath::jacobian( image, geometry, boundary_conditions, jacobians );
+                    // The directional derivative (je . nabla) m and both torques it enters are calculated in
+                    // a single pass. TODO: a_j durch b_j ersetzen
+                    const Vector3 weights       = stt_stencil.inverse_bravais * je;
+                    const scalar c_adiabatic    = dtg * a_j * ( damping - beta );
+                    const scalar c_nonadiabatic = dtg * a_j * ( 1 + beta * damping );
 
                     // clang-format off
-                    Backend::par::apply(image.size(), [s_c_grad = s_c_grad.data(), jacobians=jacobians.data(), direction=je] SPIRIT_LAMBDA (int idx) 
+                    Backend::par::apply( image.size(),
+                        [image = image.data(), neighbours = stt_stencil.neighbours.data(),
+                         factors = stt_stencil.factors.data(), weights, c_adiabatic, c_nonadiabatic,
+                         force_virtual = force_virtual.data()] SPIRIT_LAMBDA ( spirit_index idx )
+                        {
+                            Vector3 s_c_grad = Vector3::Zero();
+                            for( int k = 0; k < 3; ++k )
                             {
-                                s_c_grad[idx] = jacobians[idx] * direction;
+                                const spirit_index forward  = neighbours[6 * idx + 2 * k];
+                                const spirit_index backward = neighbours[6 * idx + 2 * k + 1];
+                                s_c_grad += weights[k] * factors[3 * idx + k] * ( image[forward] - image[backward] );
                             }
-                        );
+                            force_virtual[idx]
+                                += c_adiabatic * s_c_grad + c_nonadiabatic * s_c_grad.cross( image[idx] );
+                        } );
                     // clang-format on
-
-                    Vectormath::add_c_a(
-                        dtg * a_j * ( damping - beta ), s_c_grad, force_virtual ); // TODO: a_j durch b_j ersetzen
-                    Vectormath::add_c_cross(
-                        dtg * a_j * ( 1 + beta * damping ), s_c_grad, image,
-                        force_virtual ); // TODO: a_j durch b_j ersetzen
                     // Gradient in current richtung, daher => *(-1)
                 }
                 else
@@ -238,6 +256,14 @@ bool Method_LLG<solver>::Converged()
     return std::all_of( this->force_converged.begin(), this->force_converged.end(), []( bool b ) { return b; } );
 }
 
+template<Solver solver>
+void Method_LLG<solver>::Iteration()
+{
+    Method_Solver<solver>::Iteration();
+    // Increment the time counter (picoseconds)
+    this->picoseconds_passed += this->systems[0]->llg_parameters->dt;
+}
+
 template<Solver solver>
 void Method_LLG<solver>::Hook_Pre_Iteration()
 {
@@ -246,16 +272,19 @@ void Method_LLG<solver>::Hook_Pre_Iteration()
 template<Solver solver>
 void Method_LLG<solver>::Hook_Post_Iteration()
 {
-    // Increment the time counter (picoseconds)
-    this->picoseconds_passed += this->systems[0]->llg_parameters->dt;
-
     // --- Convergence Parameter Update
-    // Loop over images to calculate the maximum torques
+    // Loop over images to calculate the maximum torques. The effective field of the first image is updated in the
+    // same pass over its spins
     for( std::size_t img = 0; img < this->systems.size(); ++img )
     {
         this->force_converged[img] = false;
         // auto fmax = this->Force_on_Image_MaxAbsComponent(*(this->systems[img]->spins), this->forces_virtual[img]);
-        auto fmax = this->MaxTorque_on_Image( *( this->systems[img]->spins ), this->forces_virtual[img] );
+        scalar fmax;
+        if( img == 0 )
+            fmax = Manifoldmath::project_tangential_max_norm(
+                this->forces_virtual[0], *this->systems[0]->spins, this->forces[0], this->systems[0]->effective_field );
+        else
+            fmax = this->MaxTorque_on_Image( *( this->systems[img]->spins ), this->forces_virtual[img] );
 
         if( fmax > 0 )
             this->max_torque = fmax;
@@ -267,16 +296,11 @@ void Method_LLG<solver>::Hook_Post_Iteration()
 
     // --- Image Data Update
     // Update the system's Energy
-    // ToDo: copy instead of recalculating
-
     this->systems[0]->E = current_energy;
+    if( const auto * record = this->systems[0]->hamiltonian->Recorded_Energy_Contributions() )
+        this->systems[0]->E_array = record->energies;
 
-    // ToDo: How to update eff_field without numerical overhead?
-    // systems[0]->effective_field = Gradient[0];
-    // Vectormath::scale(systems[0]->effective_field, -1);
-    Manifoldmath::project_tangential( this->forces[0], *this->systems[0]->spins );
-    Vectormath::set_c_a( 1, this->forces[0], this->systems[0]->effective_field );
-    // systems[0]->UpdateEffectiveField();
+    // The effective field was updated together with the torques above
 
     // TODO: In order to update Rx with the neighbouring images etc., we need the state -> how to do this?
 
@@ -304,6 +328,17 @@ template<Solver solver>
 void Method_LLG<solver>::Finalize()
 {
     this->systems[0]->iteration_allowed = false;
+    this->systems[0]->hamiltonian->Stop_Recording_Energy_Contributions();
+}
+
+template<Solver solver>
+void Method_LLG<solver>::Sample_Observables()
+{
+    for( auto & system : this->systems )
+    {
+        if( system->observables->Due( this->iteration, this->n_iterations_amortize ) )
+            system->observables->Sample( *system, this->iteration, this->picoseconds_passed, this->max_torque );
+    }
 }
 
 template<Solver solver>
@@ -317,7 +352,8 @@ void Method_LLG<solver>::Save_Current( std::string starttime, int iteration, boo
     // this->history["max_torque"].push_back( this->max_torque );
     // this->systems[0]->UpdateEnergy();
     // this->history["E"].push_back( this->systems[0]->E );
-    // Removed magnetization, since at the moment it required a temporary allocation to compute
+    // Removed magnetization, since at the moment it required a temporary allocation to compute.
+    // Time series of the magnetization and other observables are recorded by the system's observables instead
     // auto mag = Engine::Vectormath::Magnetization( *this->systems[0]->spins );
     // this->history["M_z"].push_back( mag[2] );
 
@@ -349,17 +385,27 @@ void Method_LLG<solver>::Save_Current( std::string starttime, int iteration, boo
         {
             try
             {
+                // File format
+                IO::VF_FileFormat format = this->systems[0]->llg_parameters->output_vf_filetype;
+
                 // File name and comment
-                std::string spinsFile      = preSpinsFile + suffix + ".ovf";
+                std::string spinsFile      = preSpinsFile + suffix + IO::extension( format );
                 std::string output_comment = fmt::format(
                     "{} simulation ({} solver)\n# Desc:      Iteration: {}\n# Desc:      Maximum torque: {}",
                     this->Name(), this->SolverFullName(), iteration, this->max_torque );
 
-                // File format
-                IO::VF_FileFormat format = this->systems[0]->llg_parameters->output_vf_filetype;
-
                 // Spin Configuration
-                auto & spins        = *this->systems[0]->spins;
+                auto & spins = *this->systems[0]->spins;
+                if( IO::is_trajectory( format ) )
+                {
+                    auto file = IO::Trajectory_File( spinsFile );
+                    if( append )
+                        file.append_frame( spins, iteration, IO::trajectory_encoding( format ) );
+                    else
+                        file.write_frame( spins, iteration, IO::trajectory_encoding( format ) );
+                    return;
+                }
+
                 auto segment        = IO::OVF_Segment( *this->systems[0] );
                 std::string title   = fmt::format( "SPIRIT Version {}", Utility::version_full );
                 segment.title       = strdup( title.c_str() );
@@ -408,12 +454,21 @@ void Method_LLG<solver>::Save_Current( std::string starttime, int iteration, boo
                 {
                     // Gather the data
                     std::vector<std::pair<std::string, scalarfield>> contributions_spins( 0 );
-                    this->systems[0]->UpdateEnergy();
                     this->systems[0]->hamiltonian->Energy_Contributions_per_Spin(
                         *this->systems[0]->spins, contributions_spins );
+
+                    // The energy of the current spins follows from the contributions per spin
+                    this->systems[0]->E = 0;
+                    this->systems[0]->E_array.resize( contributions_spins.size() );
+                    for( std::size_t i = 0; i < contributions_spins.size(); ++i )
+                    {
+                        this->systems[0]->E_array[i]
+                            = { contributions_spins[i].first, Vectormath::sum( contributions_spins[i].second ) };
+                        this->systems[0]->E += this->systems[0]->E_array[i].second;
+                    }
                     int datasize = ( 1 + contributions_spins.size() ) * this->systems[0]->nos;
                     scalarfield data( datasize, 0 );
-                    for( int ispin = 0; ispin < this->systems[0]->nos; ++ispin )
+                    for( spirit_index ispin = 0; ispin < this->systems[0]->nos; ++ispin )
                     {
                         scalar E_spin = 0;
                         int j         = 1;
@@ -449,6 +504,10 @@ void Method_LLG<solver>::Save_Current( std::string starttime, int iteration, boo
                     // File format
                     IO::VF_FileFormat format = this->systems[0]->llg_parameters->output_vf_filetype;
 
+                    // Trajectory files only hold spin directions, so per-spin energies are written as OVF
+                    if( IO::is_trajectory( format ) )
+                        format = IO::VF_FileFormat::OVF_BIN;
+
                     // open and write
                     IO::OVF_File( energyFilePerSpin ).write_segment( segment, data.data(), static_cast<int>( format ) );
 
@@ -499,6 +558,22 @@ void Method_LLG<solver>::Save_Current( std::string starttime, int iteration, boo
     }
 }
 
+template<Solver solver>
+void Method_LLG<solver>::Checkpoint_Write( IO::Checkpoint_Writer & checkpoint )
+{
+    Method_Solver<solver>::Checkpoint_Write( checkpoint );
+    checkpoint.write( this->picoseconds_passed );
+    checkpoint.write( this->systems[0]->llg_parameters->prng );
+}
+
+template<Solver solver>
+void Method_LLG<solver>::Checkpoint_Read( IO::Checkpoint_Reader & checkpoint )
+{
+    Method_Solver<solver>::Checkpoint_Read( checkpoint );
+    checkpoint.read( this->picoseconds_passed );
+    checkpoint.read( this->systems[0]->llg_parameters->prng );
+}
+
 // Method name as string
 template<Solver solver>
 std::string Method_LLG<solver>::Name()
@@ -515,5 +590,7 @@ template class Method_LLG<Solver::LBFGS_OSO>;
 template class Method_LLG<Solver::LBFGS_Atlas>;
 template class Method_LLG<Solver::VP>;
 template class Method_LLG<Solver::VP_OSO>;
+template class Method_LLG<Solver::NCG>;
+template class Method_LLG<Solver::Newton>;
 
 } // namespace Engine
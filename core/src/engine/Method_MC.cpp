@@ -3,6 +3,7 @@
 #include <data/Spin_System_Chain.hpp>
 #include <engine/Method_MC.hpp>
 #include <engine/Vectormath.hpp>
+#include <io/Checkpoint.hpp>
 #include <io/IO.hpp>
 #include <utility/Constants.hpp>
 #include <utility/Logging.hpp>
@@ -97,9 +98,9 @@ void Method_MC::Metropolis( const vectorfield & spins_old, vectorfield & spins_n
     scalar cos_cone_angle = std::cos( cone_angle );
 
     // Loop over NOS samples (on average every spin should be hit once per Metropolis step)
-    for( int idx = 0; idx < this->nos; ++idx )
+    for( spirit_index idx = 0; idx < this->nos; ++idx )
     {
-        int ispin;
+        spirit_index ispin;
         if( this->parameters_mc->metropolis_random_sample )
             // Better statistics, but additional calculation of random number
             ispin = distribution_idx( this->parameters_mc->prng );
@@ -289,7 +290,9 @@ void Method_MC::Message_End()
     std::string reason = "";
     if( this->StopFile_Present() )
         reason = "A STOP file has been found";
-    else if( this->Walltime_Expired( t_end - this->t_start ) )
+    else if( this->Stop_Requested() )
+        reason = "A stop was requested";
+    else if( this->Walltime_Expired() )
         reason = "The maximum walltime has been reached";
 
     // Update the system's energy
@@ -323,12 +326,36 @@ void Method_MC::Message_End()
         }
     }
     block.emplace_back( fmt::format( "    Total energy:     {:20.10f}", this->systems[0]->E ) );
+    if( Profiling::enabled() )
+    {
+        auto timings = Profiling::Timings_Block( this->timings_start, Profiling::Get_Timings() );
+        block.insert( block.end(), timings.begin(), timings.end() );
+    }
     block.emplace_back( "-----------------------------------------------------" );
     Log.SendBlock( Log_Level::All, this->SenderName, block, this->idx_image, this->idx_chain );
 }
 
 void Method_MC::Save_Current( std::string starttime, int iteration, bool initial, bool final ) {}
 
+void Method_MC::Checkpoint_Write( IO::Checkpoint_Writer & checkpoint )
+{
+    Method::Checkpoint_Write( checkpoint );
+    checkpoint.write( this->cone_angle );
+    checkpoint.write( this->n_rejected );
+    checkpoint.write( this->acceptance_ratio_current );
+    checkpoint.write( this->parameters_mc->prng );
+}
+
+void Method_MC::Checkpoint_Read( IO::Checkpoint_Reader & checkpoint )
+{
+    Method::Checkpoint_Read( checkpoint );
+    checkpoint.read( this->cone_angle );
+    checkpoint.read( this->n_rejected );
+    checkpoint.read( this->acceptance_ratio_current );
+    checkpoint.read( this->parameters_mc->prng );
+    this->parameters_mc->metropolis_cone_angle = this->cone_angle * 180.0 / Constants::Pi;
+}
+
 // Method name as string
 std::string Method_MC::Name()
 {
@@ -5,6 +5,7 @@
 #include <engine/Vectormath.hpp>
 #include <io/IO.hpp>
 #include <io/OVF_File.hpp>
+#include <io/Trajectory_File.hpp>
 #include <utility/Logging.hpp>
 #include <utility/Version.hpp>
 
@@ -183,7 +184,7 @@ void Method_MMF<solver>::Calculate_Force_Spectra_Matrix(
     // auto& force_virtual = forces_virtual[0];
     auto & parameters = *this->systems[0]->mmf_parameters;
 
-    const int nos = this->nos;
+    const spirit_index nos = this->nos;
 
     // Number of lowest modes to be calculated
     int n_modes = parameters.n_modes;
@@ -276,7 +277,7 @@ void Method_MMF<solver>::Calculate_Force_Spectra_Matrix(
 
         // Retrieve the chosen mode as vectorfield
         VectorX mode_3N = basis_3Nx2N * mode_2N;
-        for( int n = 0; n < nos; ++n )
+        for( spirit_index n = 0; n < nos; ++n )
             this->minimum_mode[n] = { mode_3N[3 * n], mode_3N[3 * n + 1], mode_3N[3 * n + 2] };
 
         // Get the scalar product of mode and gradient
@@ -458,17 +459,27 @@ void Method_MMF<solver>::Save_Current( std::string starttime, int iteration, boo
         {
             try
             {
+                // File format
+                IO::VF_FileFormat format = this->systems[0]->mmf_parameters->output_vf_filetype;
+
                 // File name and comment
-                std::string spinsFile      = preSpinsFile + suffix + ".ovf";
+                std::string spinsFile      = preSpinsFile + suffix + IO::extension( format );
                 std::string output_comment = fmt::format(
                     "{} simulation ({} solver)\n# Desc:      Iteration: {}\n# Desc:      Maximum torque: {}",
                     this->Name(), this->SolverFullName(), iteration, this->max_torque );
 
-                // File format
-                IO::VF_FileFormat format = this->systems[0]->mmf_parameters->output_vf_filetype;
-
                 // Spin Configuration
-                auto & spins        = *this->systems[0]->spins;
+                auto & spins = *this->systems[0]->spins;
+                if( IO::is_trajectory( format ) )
+                {
+                    auto file = IO::Trajectory_File( spinsFile );
+                    if( append )
+                        file.append_frame( spins, iteration, IO::trajectory_encoding( format ) );
+                    else
+                        file.write_frame( spins, iteration, IO::trajectory_encoding( format ) );
+                    return;
+                }
+
                 auto segment        = IO::OVF_Segment( *this->systems[0] );
                 std::string title   = fmt::format( "SPIRIT Version {}", Utility::version_full );
                 segment.title       = strdup( title.c_str() );
@@ -522,7 +533,7 @@ void Method_MMF<solver>::Save_Current( std::string starttime, int iteration, boo
                         *this->systems[0]->spins, contributions_spins );
                     int datasize = ( 1 + contributions_spins.size() ) * this->systems[0]->nos;
                     scalarfield data( datasize, 0 );
-                    for( int ispin = 0; ispin < this->systems[0]->nos; ++ispin )
+                    for( spirit_index ispin = 0; ispin < this->systems[0]->nos; ++ispin )
                     {
                         scalar E_spin = 0;
                         int j         = 1;
@@ -558,6 +569,10 @@ void Method_MMF<solver>::Save_Current( std::string starttime, int iteration, boo
                     // File format
                     IO::VF_FileFormat format = this->systems[0]->llg_parameters->output_vf_filetype;
 
+                    // Trajectory files only hold spin directions, so per-spin energies are written as OVF
+                    if( IO::is_trajectory( format ) )
+                        format = IO::VF_FileFormat::OVF_BIN;
+
                     // open and write
                     IO::OVF_File( energyFilePerSpin ).write_segment( segment, data.data(), static_cast<int>( format ) );
 
@@ -614,6 +629,32 @@ void Method_MMF<solver>::Finalize()
     this->systems[0]->iteration_allowed = false;
 }
 
+template<Solver solver>
+void Method_MMF<solver>::Checkpoint_Write( IO::Checkpoint_Writer & checkpoint )
+{
+    Method_Solver<solver>::Checkpoint_Write( checkpoint );
+    checkpoint.write( this->switched1 );
+    checkpoint.write( this->switched2 );
+    checkpoint.write( this->minimum_mode );
+    checkpoint.write( this->mode_follow_previous );
+    checkpoint.write( this->mode_2N_previous );
+    checkpoint.write( this->Rx_last );
+    checkpoint.write( this->spins_last );
+}
+
+template<Solver solver>
+void Method_MMF<solver>::Checkpoint_Read( IO::Checkpoint_Reader & checkpoint )
+{
+    Method_Solver<solver>::Checkpoint_Read( checkpoint );
+    checkpoint.read( this->switched1 );
+    checkpoint.read( this->switched2 );
+    checkpoint.read( this->minimum_mode );
+    checkpoint.read( this->mode_follow_previous );
+    checkpoint.read( this->mode_2N_previous );
+    checkpoint.read( this->Rx_last );
+    checkpoint.read( this->spins_last );
+}
+
 // Method name as string
 template<Solver solver>
 std::string Method_MMF<solver>::Name()
@@ -5,153 +5,354 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
+#include <tuple>
 
 namespace Engine
 {
 namespace Neighbours
 {
 
-std::vector<scalar> Get_Shell_Radii( const Data::Geometry & geometry, const std::size_t n_shells )
+namespace
 {
-    const scalar min_shell_width = 1e-3;
 
-    auto shell_radii = std::vector<scalar>( n_shells );
+// Distances which differ by less than this belong to the same shell
+constexpr scalar min_shell_width = 1e-3;
 
-    Vector3 ta = geometry.lattice_constant * geometry.bravais_vectors[0];
-    Vector3 tb = geometry.lattice_constant * geometry.bravais_vectors[1];
-    Vector3 tc = geometry.lattice_constant * geometry.bravais_vectors[2];
+// A site of the lattice, given by a basis atom and the translation of its cell
+struct Lattice_Site
+{
+    int atom;
+    std::array<int, 3> translations;
+    Vector3 position;
+};
 
-    // The n_shells + 2 is a value that is big enough by experience to produce enough needed shells, but is small enough
-    // to run sufficiently fast
-    int max_n_translations = n_shells + 2;
+// A neighbour of a basis atom in the cell at the origin
+struct Neighbour
+{
+    int atom;
+    std::array<int, 3> translations;
+    scalar distance;
+};
 
-    int i_max = std::min( max_n_translations, geometry.n_cells[0] - 1 );
-    int j_max = std::min( max_n_translations, geometry.n_cells[1] - 1 );
-    int k_max = std::min( max_n_translations, geometry.n_cells[2] - 1 );
+// Translations of the lattice and the largest number of translations in each direction
+struct Lattice_Translations
+{
+    std::array<Vector3, 3> vectors;
+    std::array<int, 3> limits;
+};
 
-    // Abort condidions for all 3 vectors
-    if( ta.norm() == 0.0 )
-        i_max = 0;
-    if( tb.norm() == 0.0 )
-        j_max = 0;
-    if( tc.norm() == 0.0 )
-        k_max = 0;
+Lattice_Translations lattice_translations( const Data::Geometry & geometry )
+{
+    Lattice_Translations translations;
+    for( int dim = 0; dim < 3; ++dim )
+    {
+        translations.vectors[dim] = geometry.lattice_constant * geometry.bravais_vectors[dim];
+        translations.limits[dim]  = std::max( 0, geometry.n_cells[dim] - 1 );
+        if( translations.vectors[dim].norm() == 0.0 )
+            translations.limits[dim] = 0;
+    }
+    return translations;
+}
+
+/*
+ * For every basis atom of the cell at the origin, collects the sites at a distance below `radius`.
+ *
+ * Only the translations which can reach a site within the radius are enumerated. The sites are sorted into
+ * bins with the width of the radius, so that each basis atom only has to look at the 27 bins around it.
+ */
+std::vector<std::vector<Neighbour>>
+neighbours_in_radius( const Data::Geometry & geometry, const Lattice_Translations & translations, scalar radius )
+{
+    const int n_atoms = geometry.n_cell_atoms;
+
+    // Bounding box of the basis atoms
+    Vector3 box_min = geometry.positions[0], box_max = geometry.positions[0];
+    for( int atom = 1; atom < n_atoms; ++atom )
+    {
+        box_min = box_min.cwiseMin( geometry.positions[atom] );
+        box_max = box_max.cwiseMax( geometry.positions[atom] );
+    }
+    const scalar box_diagonal = ( box_max - box_min ).norm();
+
+    // A translation T reaching a site within the radius fulfills |T| < radius + box_diagonal. Its coefficients
+    // along the lattice vectors are bounded via the rows of the pseudo-inverse of the lattice vectors.
+    std::array<int, 3> n_translations = translations.limits;
+    std::vector<int> dims;
+    for( int dim = 0; dim < 3; ++dim )
+    {
+        if( translations.limits[dim] > 0 )
+            dims.push_back( dim );
+    }
+    if( !dims.empty() )
+    {
+        Eigen::Matrix<scalar, 3, Eigen::Dynamic> vectors( 3, dims.size() );
+        for( std::size_t i = 0; i < dims.size(); ++i )
+            vectors.col( i ) = translations.vectors[dims[i]];
+        const MatrixX gram = vectors.transpose() * vectors;
+        if( std::abs( gram.determinant() ) > 1e-12 * std::pow( gram.trace(), scalar( dims.size() ) ) )
+        {
+            const MatrixX pseudo_inverse = gram.inverse() * vectors.transpose();
+            for( std::size_t i = 0; i < dims.size(); ++i )
+            {
+                const scalar bound = ( radius + box_diagonal ) * pseudo_inverse.row( i ).norm();
+                if( bound < translations.limits[dims[i]] )
+                    n_translations[dims[i]] = static_cast<int>( bound ) + 1;
+            }
+        }
+    }
+
+    // Sites near the basis atoms
+    std::vector<Lattice_Site> sites;
+    const Vector3 reach_min = box_min - Vector3{ radius, radius, radius };
+    const Vector3 reach_max = box_max + Vector3{ radius, radius, radius };
+    for( int i = -n_translations[0]; i <= n_translations[0]; ++i )
+    {
+        for( int j = -n_translations[1]; j <= n_translations[1]; ++j )
+        {
+            for( int k = -n_translations[2]; k <= n_translations[2]; ++k )
+            {
+                const Vector3 translation
+                    = i * translations.vectors[0] + j * translations.vectors[1] + k * translations.vectors[2];
+                for( int atom = 0; atom < n_atoms; ++atom )
+                {
+                    const Vector3 position = geometry.positions[atom] + translation;
+                    if( ( position.array() >= reach_min.array() ).all()
+                        && ( position.array() <= reach_max.array() ).all() )
+                        sites.push_back( { atom, { i, j, k }, position } );
+                }
+            }
+        }
+    }
 
-    int atom_one{ 0 }, atom_two{ 0 };
-    int i{ 0 }, j{ 0 }, k{ 0 };
-    scalar outermost_radius = 0, pos_delta = 0, previous_radius = 0;
-    Vector3 pos_one = { 0, 0, 0 }, pos_two = { 0, 0, 0 };
-    for( auto & shell_radius : shell_radii )
+    // Sort the sites into bins
+    std::array<int, 3> n_bins;
+    for( int dim = 0; dim < 3; ++dim )
+        n_bins[dim] = static_cast<int>( ( reach_max[dim] - reach_min[dim] ) / radius ) + 1;
+    auto bin_of = [&]( const Vector3 & position, int dim )
+    { return std::min( n_bins[dim] - 1, std::max( 0, int( ( position[dim] - reach_min[dim] ) / radius ) ) ); };
+    auto bin_index = [&]( int a, int b, int c ) { return a + n_bins[0] * ( b + n_bins[1] * c ); };
+
+    std::vector<int> bin_offsets( n_bins[0] * n_bins[1] * n_bins[2] + 1, 0 );
+    std::vector<int> site_bins( sites.size() );
+    for( std::size_t isite = 0; isite < sites.size(); ++isite )
     {
-        previous_radius = outermost_radius;
-        // Starting from the maximum representable value, determine the smallest shell that is more than min_shell_width
-        // wider than the previous
-        outermost_radius = std::numeric_limits<scalar>::max();
-        for( atom_one = 0; atom_one < geometry.n_cell_atoms; ++atom_one )
+        const auto & position = sites[isite].position;
+        site_bins[isite]      = bin_index( bin_of( position, 0 ), bin_of( position, 1 ), bin_of( position, 2 ) );
+        ++bin_offsets[site_bins[isite] + 1];
+    }
+    for( std::size_t ibin = 1; ibin < bin_offsets.size(); ++ibin )
+        bin_offsets[ibin] += bin_offsets[ibin - 1];
+    std::vector<int> binned_sites( sites.size() );
+    {
+        auto fill = bin_offsets;
+        for( std::size_t isite = 0; isite < sites.size(); ++isite )
+            binned_sites[fill[site_bins[isite]]++] = isite;
+    }
+
+    // Search the bins around each basis atom
+    std::vector<std::vector<Neighbour>> neighbours( n_atoms );
+#pragma omp parallel for schedule( dynamic )
+    for( int atom = 0; atom < n_atoms; ++atom )
+    {
+        const Vector3 & position = geometry.positions[atom];
+        const int a = bin_of( position, 0 ), b = bin_of( position, 1 ), c = bin_of( position, 2 );
+        for( int ic = std::max( 0, c - 1 ); ic <= std::min( n_bins[2] - 1, c + 1 ); ++ic )
         {
-            pos_one = geometry.cell_atoms[atom_one];
-            // Note: due to symmetry we only need to check half the space
-            for( i = i_max; i >= 0; --i )
+            for( int ib = std::max( 0, b - 1 ); ib <= std::min( n_bins[1] - 1, b + 1 ); ++ib )
             {
-                for( j = j_max; j >= -j_max; --j )
+                for( int ia = std::max( 0, a - 1 ); ia <= std::min( n_bins[0] - 1, a + 1 ); ++ia )
                 {
-                    for( k = k_max; k >= -k_max; --k )
+                    const int ibin = bin_index( ia, ib, ic );
+                    for( int idx = bin_offsets[ibin]; idx < bin_offsets[ibin + 1]; ++idx )
                     {
-                        for( atom_two = 0; atom_two < geometry.n_cell_atoms; ++atom_two )
-                        {
-                            if( !( atom_one == atom_two && i == 0 && j == 0 && k == 0 ) )
-                            {
-                                pos_two   = geometry.cell_atoms[atom_two] + i * ta + j * tb + k * tc;
-                                pos_delta = ( pos_one - pos_two ).norm();
-                                if( pos_delta - previous_radius > min_shell_width && pos_delta < outermost_radius )
-                                {
-                                    outermost_radius = pos_delta;
-                                    shell_radius     = pos_delta;
-                                }
-                            }
-                        }
+                        const auto & site = sites[binned_sites[idx]];
+                        if( site.atom == atom && site.translations == std::array<int, 3>{ 0, 0, 0 } )
+                            continue;
+                        const scalar distance = ( position - site.position ).norm();
+                        if( distance < radius )
+                            neighbours[atom].push_back( { site.atom, site.translations, distance } );
                     }
                 }
             }
         }
     }
 
-    return shell_radii;
+    return neighbours;
 }
 
-void Get_Neighbours_in_Shells(
-    const Data::Geometry & geometry, std::size_t n_shells, pairfield & neighbours, intfield & shells,
-    bool use_redundant_neighbours )
+} // namespace
+
+Neighbour_Shells Get_Neighbour_Shells( const Data::Geometry & geometry, std::size_t n_shells )
 {
-    const scalar min_shell_width = 1e-3;
+    Neighbour_Shells neighbour_shells;
+    neighbour_shells.radii = std::vector<scalar>( n_shells, 0 );
+    if( n_shells == 0 || geometry.n_cell_atoms == 0 )
+        return neighbour_shells;
 
-    auto shell_radii = Get_Shell_Radii( geometry, n_shells );
+    const auto translations = lattice_translations( geometry );
 
-    Vector3 ta = geometry.lattice_constant * geometry.bravais_vectors[0];
-    Vector3 tb = geometry.lattice_constant * geometry.bravais_vectors[1];
-    Vector3 tc = geometry.lattice_constant * geometry.bravais_vectors[2];
+    // All sites of the lattice lie within this radius around any basis atom
+    scalar radius_all = 0;
+    for( int i : { -translations.limits[0], translations.limits[0] } )
+    {
+        for( int j : { -translations.limits[1], translations.limits[1] } )
+        {
+            for( int k : { -translations.limits[2], translations.limits[2] } )
+            {
+                radius_all = std::max(
+                    radius_all,
+                    ( i * translations.vectors[0] + j * translations.vectors[1] + k * translations.vectors[2] )
+                        .norm() );
+            }
+        }
+    }
+    Vector3 box_min = geometry.positions[0], box_max = geometry.positions[0];
+    for( int atom = 1; atom < geometry.n_cell_atoms; ++atom )
+    {
+        box_min = box_min.cwiseMin( geometry.positions[atom] );
+        box_max = box_max.cwiseMax( geometry.positions[atom] );
+    }
+    radius_all += ( box_max - box_min ).norm() + 2 * min_shell_width;
+
+    // Start from the shortest translation and widen the search until it contains all requested shells
+    scalar radius = radius_all;
+    for( int dim = 0; dim < 3; ++dim )
+    {
+        if( translations.limits[dim] > 0 )
+            radius = std::min( radius, translations.vectors[dim].norm() + 2 * min_shell_width );
+    }
 
-    // The n_shells + 2 is a value that is big enough by experience to produce enough needed shells, but is small enough
-    // to run sufficiently fast
-    int max_n_translations = n_shells + 2;
+    std::vector<std::vector<Neighbour>> neighbours;
+    std::vector<scalar> radii;
+    while( true )
+    {
+        neighbours = neighbours_in_radius( geometry, translations, radius );
 
-    int i_max = std::min( max_n_translations, geometry.n_cells[0] - 1 );
-    int j_max = std::min( max_n_translations, geometry.n_cells[1] - 1 );
-    int k_max = std::min( max_n_translations, geometry.n_cells[2] - 1 );
+        std::vector<scalar> distances;
+        for( const auto & atom_neighbours : neighbours )
+        {
+            for( const auto & neighbour : atom_neighbours )
+                distances.push_back( neighbour.distance );
+        }
+        std::sort( distances.begin(), distances.end() );
 
-    // If redundant neighbours should not be used, we restrict the search to half of the space
-    int i_min = -i_max;
-    int j_min = -j_max;
-    int k_min = -k_max;
+        // Each shell starts at the smallest distance which is more than min_shell_width beyond the previous shell
+        radii.clear();
+        scalar previous_radius = 0;
+        for( scalar distance : distances )
+        {
+            if( distance - previous_radius > min_shell_width )
+            {
+                radii.push_back( distance );
+                previous_radius = distance;
+                if( radii.size() == n_shells )
+                    break;
+            }
+        }
 
-    // Abort condidions for all 3 vectors
-    if( ta.norm() == 0.0 )
-        i_max = 0;
-    if( tb.norm() == 0.0 )
-        j_max = 0;
-    if( tc.norm() == 0.0 )
-        k_max = 0;
-
-    int second_atom_min = 0;
-    int atom_one{ 0 }, atom_two{ 0 }, i{ 0 }, j{ 0 }, k{ 0 };
-    std::size_t ishell = 0;
-    scalar pos_delta = 0, radius = 0;
-    Vector3 pos_one = { 0, 0, 0 }, pos_two = { 0, 0, 0 };
-    for( atom_one = 0; atom_one < geometry.n_cell_atoms; ++atom_one )
-    {
-        if( !use_redundant_neighbours )
-            second_atom_min = atom_one;
+        // The outermost shell has to be complete, i.e. contain all sites within min_shell_width of its radius
+        const bool found = radii.size() == n_shells && radii.back() + min_shell_width <= radius;
+        if( found || radius >= radius_all )
+            break;
+        radius = std::min( 2 * radius, radius_all );
+    }
+    std::copy( radii.begin(), radii.end(), neighbour_shells.radii.begin() );
 
-        pos_one = geometry.cell_atoms[atom_one];
-        for( ishell = 0; ishell < n_shells; ++ishell )
+    // Assign the neighbours to the shells and order them by shell and descending translations
+    std::vector<std::vector<std::pair<int, Neighbour>>> shell_neighbours( geometry.n_cell_atoms );
+#pragma omp parallel for schedule( dynamic )
+    for( int atom = 0; atom < geometry.n_cell_atoms; ++atom )
+    {
+        auto & atom_shell_neighbours = shell_neighbours[atom];
+        for( const auto & neighbour : neighbours[atom] )
         {
-            radius = shell_radii[ishell];
-            for( i = i_max; i >= i_min; --i )
+            // A distance may be within min_shell_width of two shells
+            auto shell = std::lower_bound( radii.begin(), radii.end(), neighbour.distance - min_shell_width );
+            for( ; shell != radii.end() && *shell < neighbour.distance + min_shell_width; ++shell )
             {
-                for( j = j_max; j >= j_min; --j )
-                {
-                    for( k = k_max; k >= k_min; --k )
-                    {
-                        for( atom_two = second_atom_min; atom_two < geometry.n_cell_atoms; ++atom_two )
-                        {
-                            if( ( atom_two > atom_one )
-                                || ( i > 0 || ( i == 0 && j > 0 ) || ( i == 0 && j == 0 && k > 0 ) )
-                                || use_redundant_neighbours )
-                            {
-                                pos_two   = geometry.cell_atoms[atom_two] + i * ta + j * tb + k * tc;
-                                pos_delta = ( pos_one - pos_two ).norm();
-                                if( std::abs( pos_delta - radius ) < min_shell_width )
-                                {
-                                    neighbours.push_back( { atom_one, atom_two, { i, j, k } } );
-                                    shells.push_back( static_cast<int>( ishell ) );
-                                }
-                            }
-                        }
-                    }
-                }
+                if( std::abs( neighbour.distance - *shell ) < min_shell_width )
+                    atom_shell_neighbours.push_back( { static_cast<int>( shell - radii.begin() ), neighbour } );
             }
         }
+        std::sort(
+            atom_shell_neighbours.begin(), atom_shell_neighbours.end(),
+            []( const std::pair<int, Neighbour> & a, const std::pair<int, Neighbour> & b )
+            {
+                const auto & ta = a.second.translations;
+                const auto & tb = b.second.translations;
+                return std::make_tuple( a.first, -ta[0], -ta[1], -ta[2], a.second.atom )
+                       < std::make_tuple( b.first, -tb[0], -tb[1], -tb[2], b.second.atom );
+            } );
+    }
+
+    for( int atom = 0; atom < geometry.n_cell_atoms; ++atom )
+    {
+        for( const auto & shell_neighbour : shell_neighbours[atom] )
+        {
+            const auto & neighbour = shell_neighbour.second;
+            const auto & t         = neighbour.translations;
+            neighbour_shells.pairs.push_back( { atom, neighbour.atom, { t[0], t[1], t[2] } } );
+            neighbour_shells.shells.push_back( shell_neighbour.first );
+        }
+    }
+
+    return neighbour_shells;
+}
+
+const Neighbour_Shells & Neighbour_Shell_Cache::Get( const Data::Geometry & geometry, std::size_t n_shells )
+{
+    if( !Matches( geometry ) || this->neighbour_shells.radii.size() < n_shells )
+    {
+        this->neighbour_shells = Get_Neighbour_Shells( geometry, n_shells );
+        this->bravais_vectors  = geometry.bravais_vectors;
+        this->lattice_constant = geometry.lattice_constant;
+        this->n_cells          = geometry.n_cells;
+        this->cell_atoms       = geometry.cell_atoms;
+    }
+    return this->neighbour_shells;
+}
+
+bool Neighbour_Shell_Cache::Matches( const Data::Geometry & geometry ) const
+{
+    return this->lattice_constant == geometry.lattice_constant && this->n_cells == geometry.n_cells
+           && this->bravais_vectors == geometry.bravais_vectors && this->cell_atoms == geometry.cell_atoms;
+}
+
+std::vector<scalar> Get_Shell_Radii( const Data::Geometry & geometry, const std::size_t n_shells )
+{
+    return Get_Neighbour_Shells( geometry, n_shells ).radii;
+}
+
+void Get_Neighbours_in_Shells(
+    const Data::Geometry & geometry, std::size_t n_shells, pairfield & neighbours, intfield & shells,
+    bool use_redundant_neighbours )
+{
+    Get_Neighbours_in_Shells(
+        Get_Neighbour_Shells( geometry, n_shells ), n_shells, neighbours, shells, use_redundant_neighbours );
+}
+
+void Get_Neighbours_in_Shells(
+    const Neighbour_Shells & neighbour_shells, std::size_t n_shells, pairfield & neighbours, intfield & shells,
+    bool use_redundant_neighbours )
+{
+    for( std::size_t ipair = 0; ipair < neighbour_shells.pairs.size(); ++ipair )
+    {
+        const auto & pair = neighbour_shells.pairs[ipair];
+        const auto & t    = pair.translations;
+        if( static_cast<std::size_t>( neighbour_shells.shells[ipair] ) >= n_shells )
+            continue;
+        // Without redundant neighbours, only one of the pairs (i, j, t) and (j, i, -t) is kept
+        const bool positive_translation
+            = t[0] > 0 || ( t[0] == 0 && t[1] > 0 ) || ( t[0] == 0 && t[1] == 0 && t[2] > 0 );
+        if( use_redundant_neighbours || pair.j > pair.i || ( pair.j == pair.i && positive_translation ) )
+        {
+            neighbours.push_back( pair );
+            shells.push_back( neighbour_shells.shells[ipair] );
+        }
     }
 }
 
@@ -211,31 +412,27 @@ pairfield Get_Pairs_in_Radius( const Data::Geometry & geometry, scalar radius )
     if( tc.norm() == 0.0 )
         kmax = 0;
 
-    auto pairs = pairfield( 0 );
-
-    int i = 0, j = 0, k = 0;
-    scalar pos_delta   = 0;
-    Vector3 position_i = { 0, 0, 0 };
-    Vector3 position_j = { 0, 0, 0 };
-
+    // The basis atoms are searched in parallel and their pairs are concatenated in order
+    std::vector<pairfield> atom_pairs( geometry.n_cell_atoms );
+#pragma omp parallel for schedule( dynamic )
     for( int iatom = 0; iatom < geometry.n_cell_atoms; ++iatom )
     {
-        position_i = geometry.positions[iatom];
+        const Vector3 position_i = geometry.positions[iatom];
 
-        for( i = -imax; i <= imax; ++i )
+        for( int i = -imax; i <= imax; ++i )
         {
-            for( j = -jmax; j <= jmax; ++j )
+            for( int j = -jmax; j <= jmax; ++j )
             {
-                for( k = -kmax; k <= kmax; ++k )
+                for( int k = -kmax; k <= kmax; ++k )
                 {
                     for( int jatom = 0; jatom < geometry.n_cell_atoms; ++jatom )
                     {
-                        position_j = geometry.positions[jatom] + i * ta + j * tb + k * tc;
-                        pos_delta  = ( position_i - position_j ).norm();
+                        const Vector3 position_j = geometry.positions[jatom] + i * ta + j * tb + k * tc;
+                        const scalar pos_delta   = ( position_i - position_j ).norm();
                         if( pos_delta < radius
                             && pos_delta > std::numeric_limits<scalar>::epsilon() ) // Exclude self-interactions
                         {
-                            pairs.push_back( { iatom, jatom, { i, j, k } } );
+                            atom_pairs[iatom].push_back( { iatom, jatom, { i, j, k } } );
                         }
                     }
                 }
@@ -243,6 +440,10 @@ pairfield Get_Pairs_in_Radius( const Data::Geometry & geometry, scalar radius )
         }
     }
 
+    auto pairs = pairfield( 0 );
+    for( const auto & p : atom_pairs )
+        pairs.insert( pairs.end(), p.begin(), p.end() );
+
     return pairs;
 }
 
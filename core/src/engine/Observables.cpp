@@ -0,0 +1,312 @@
+#include <data/Spin_System.hpp>
+#include <engine/Observables.hpp>
+#include <engine/Vectormath.hpp>
+#include <utility/Exception.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined( SPIRIT_USE_THREADS ) && !defined( SPIRIT_USE_CUDA )
+#include <utility/Thread_Pool.hpp>
+#endif
+
+namespace Engine
+{
+
+namespace
+{
+
+// Number of chunks of the fused reduction, if it is not distributed over the thread pool
+constexpr int n_chunks_max = 64;
+
+/*
+ * Sums several values over [0, n) in a single pass, where f( idx, sums ) adds the contributions of idx to the
+ * n_values sums. The partial sums of the chunks are added up in order, so that the result does not depend on
+ * the number of threads.
+ */
+template<typename F>
+std::vector<scalar> reduce_fused( spirit_index n, int n_values, const F & f )
+{
+#if defined( SPIRIT_USE_THREADS ) && !defined( SPIRIT_USE_CUDA )
+    auto & pool        = Utility::Thread_Pool::Get();
+    const int n_chunks = pool.N_Chunks( n );
+    std::vector<scalar> partial_sums( n_chunks * n_values, 0 );
+    pool.Parallel_For(
+        n,
+        [&]( int i_chunk, spirit_index begin, spirit_index end )
+        {
+            scalar * sums = &partial_sums[i_chunk * n_values];
+            for( spirit_index idx = begin; idx < end; ++idx )
+                f( idx, sums );
+        } );
+#else
+    const int n_chunks = static_cast<int>( std::max<spirit_index>( 1, std::min<spirit_index>( n, n_chunks_max ) ) );
+    std::vector<scalar> partial_sums( n_chunks * n_values, 0 );
+#pragma omp parallel for
+    for( int i_chunk = 0; i_chunk < n_chunks; ++i_chunk )
+    {
+        scalar * sums            = &partial_sums[i_chunk * n_values];
+        const spirit_index begin = static_cast<spirit_index>( static_cast<std::int64_t>( n ) * i_chunk / n_chunks );
+        const spirit_index end
+            = static_cast<spirit_index>( static_cast<std::int64_t>( n ) * ( i_chunk + 1 ) / n_chunks );
+        for( spirit_index idx = begin; idx < end; ++idx )
+            f( idx, sums );
+    }
+#endif
+
+    std::vector<scalar> sums( n_values, 0 );
+    for( int i_chunk = 0; i_chunk < n_chunks; ++i_chunk )
+    {
+        for( int i = 0; i < n_values; ++i )
+            sums[i] += partial_sums[i_chunk * n_values + i];
+    }
+    return sums;
+}
+
+} // namespace
+
+void Observables::Add( Observable observable )
+{
+    if( observable == Observable::Correlation )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::Unknown_Exception, Utility::Log_Level::Error,
+            "The correlation has to be added together with its wave vector" );
+    }
+    if( !Has( observable ) )
+        this->observables.push_back( observable );
+}
+
+void Observables::Add_Correlation( const Vector3 & q )
+{
+    if( !Has( Observable::Correlation ) )
+        this->observables.push_back( Observable::Correlation );
+    this->q_vectors.push_back( q );
+}
+
+void Observables::Clear()
+{
+    this->observables.clear();
+    this->q_vectors.clear();
+    this->labels.clear();
+    this->Reset_Samples();
+}
+
+void Observables::Reset_Samples()
+{
+    this->buffer.clear();
+    this->i_first   = 0;
+    this->n_samples = 0;
+}
+
+bool Observables::Empty() const
+{
+    return this->observables.empty();
+}
+
+void Observables::Set_Step( int n_iterations_step )
+{
+    this->n_iterations_step = std::max( 1, n_iterations_step );
+}
+
+int Observables::Step() const
+{
+    return this->n_iterations_step;
+}
+
+void Observables::Set_Capacity( int n_samples_max )
+{
+    // Keep the most recent samples
+    auto samples          = this->Samples();
+    const int n_columns   = this->labels.size();
+    const int n_keep      = std::min( this->n_samples, std::max( 1, n_samples_max ) );
+    this->n_samples_max   = std::max( 1, n_samples_max );
+    this->Reset_Samples();
+    if( n_keep > 0 )
+    {
+        this->buffer.assign( samples.end() - n_keep * n_columns, samples.end() );
+        this->n_samples = n_keep;
+    }
+}
+
+int Observables::Capacity() const
+{
+    return this->n_samples_max;
+}
+
+bool Observables::Due( long iteration, int n_iterations_amortize ) const
+{
+    if( this->observables.empty() )
+        return false;
+    return iteration % this->n_iterations_step < std::max( 1, n_iterations_amortize );
+}
+
+bool Observables::Has( Observable observable ) const
+{
+    return std::find( this->observables.begin(), this->observables.end(), observable ) != this->observables.end();
+}
+
+void Observables::Sample( const Data::Spin_System & system, long iteration, scalar time, scalar max_torque )
+{
+    if( this->observables.empty() )
+        return;
+
+    const auto & spins     = *system.spins;
+    const auto & geometry  = *system.geometry;
+    const spirit_index nos = spins.size();
+
+    // --- Quantities of the spin directions, summed in a single pass
+    // The magnetization is summed per basis atom and the correlation as the real and imaginary parts of the
+    // Fourier transform of each spin component
+    const bool use_magnetization = Has( Observable::Magnetization ) || Has( Observable::Sublattice_Magnetization );
+    const int n_basis            = use_magnetization ? geometry.n_cell_atoms : 0;
+    const int n_q                = this->q_vectors.size();
+    const int offset_q           = 3 * n_basis;
+    const int n_values           = offset_q + 6 * n_q;
+
+    std::vector<scalar> sums( n_values, 0 );
+    if( n_values > 0 )
+    {
+        const auto & mu_s      = geometry.mu_s;
+        const auto & positions = geometry.positions;
+        const auto & q_vectors = this->q_vectors;
+        sums                   = reduce_fused(
+            nos, n_values,
+            [&]( spirit_index ispin, scalar * s )
+            {
+                if( n_basis > 0 )
+                {
+                    const int ibasis = ispin % n_basis;
+                    for( int dim = 0; dim < 3; ++dim )
+                        s[3 * ibasis + dim] += mu_s[ispin] * spins[ispin][dim];
+                }
+                for( int iq = 0; iq < n_q; ++iq )
+                {
+                    const scalar phase = q_vectors[iq].dot( positions[ispin] );
+                    const scalar c = std::cos( phase ), sn = std::sin( phase );
+                    for( int dim = 0; dim < 3; ++dim )
+                    {
+                        s[offset_q + 6 * iq + 2 * dim] += c * spins[ispin][dim];
+                        s[offset_q + 6 * iq + 2 * dim + 1] -= sn * spins[ispin][dim];
+                    }
+                }
+            } );
+    }
+
+    // --- Assemble the sample in the order in which the observables were added
+    std::vector<std::string> sample_labels{ "iteration", "time" };
+    std::vector<scalar> sample{ scalar( iteration ), time };
+    static const char * components[3] = { "x", "y", "z" };
+
+    for( auto observable : this->observables )
+    {
+        if( observable == Observable::Magnetization )
+        {
+            for( int dim = 0; dim < 3; ++dim )
+            {
+                scalar m = 0;
+                for( int ibasis = 0; ibasis < n_basis; ++ibasis )
+                    m += sums[3 * ibasis + dim];
+                sample_labels.push_back( fmt::format( "m_{}", components[dim] ) );
+                sample.push_back( m / nos );
+            }
+        }
+        else if( observable == Observable::Sublattice_Magnetization )
+        {
+            for( int ibasis = 0; ibasis < n_basis; ++ibasis )
+            {
+                for( int dim = 0; dim < 3; ++dim )
+                {
+                    sample_labels.push_back( fmt::format( "m_{}_{}", components[dim], ibasis ) );
+                    sample.push_back( sums[3 * ibasis + dim] / geometry.n_cells_total );
+                }
+            }
+        }
+        else if( observable == Observable::Topological_Charge )
+        {
+            scalar charge = 0;
+            if( geometry.dimensionality == 2 )
+                charge = Vectormath::TopologicalCharge( spins, geometry, system.hamiltonian->boundary_conditions );
+            sample_labels.push_back( "Q" );
+            sample.push_back( charge );
+        }
+        else if( observable == Observable::Energy )
+        {
+            // Methods which calculate the gradient record the energies along the way
+            std::vector<std::pair<std::string, scalar>> energies;
+            if( const auto * record = system.hamiltonian->Recorded_Energy_Contributions() )
+                energies = record->energies;
+            else
+                energies = system.hamiltonian->Energy_Contributions( spins );
+
+            scalar energy = 0;
+            for( const auto & contribution : energies )
+                energy += contribution.second;
+            sample_labels.push_back( "E" );
+            sample.push_back( energy );
+            for( const auto & contribution : energies )
+            {
+                sample_labels.push_back( "E_" + contribution.first );
+                sample.push_back( contribution.second );
+            }
+        }
+        else if( observable == Observable::Correlation )
+        {
+            for( int iq = 0; iq < n_q; ++iq )
+            {
+                scalar structure_factor = 0;
+                for( int i = 0; i < 6; ++i )
+                    structure_factor += sums[offset_q + 6 * iq + i] * sums[offset_q + 6 * iq + i];
+                sample_labels.push_back( fmt::format(
+                    "S({},{},{})", q_vectors[iq][0], q_vectors[iq][1], q_vectors[iq][2] ) );
+                sample.push_back( structure_factor / nos );
+            }
+        }
+        else if( observable == Observable::Max_Torque )
+        {
+            sample_labels.push_back( "max_torque" );
+            sample.push_back( max_torque );
+        }
+    }
+
+    // --- Store the sample
+    if( sample_labels != this->labels )
+    {
+        this->labels = sample_labels;
+        this->Reset_Samples();
+    }
+
+    const int n_columns = sample.size();
+    if( this->n_samples < this->n_samples_max )
+    {
+        this->buffer.insert( this->buffer.end(), sample.begin(), sample.end() );
+        ++this->n_samples;
+    }
+    else
+    {
+        std::copy( sample.begin(), sample.end(), this->buffer.begin() + this->i_first * n_columns );
+        this->i_first = ( this->i_first + 1 ) % this->n_samples_max;
+    }
+}
+
+const std::vector<std::string> & Observables::Labels() const
+{
+    return this->labels;
+}
+
+int Observables::N_Samples() const
+{
+    return this->n_samples;
+}
+
+std::vector<scalar> Observables::Samples() const
+{
+    const int n_columns = this->labels.size();
+    std::vector<scalar> samples( this->buffer.begin() + this->i_first * n_columns, this->buffer.end() );
+    samples.insert( samples.end(), this->buffer.begin(), this->buffer.begin() + this->i_first * n_columns );
+    return samples;
+}
+
+} // namespace Engine
@@ -22,7 +22,7 @@ void sib_transform( const vectorfield & spins, const vectorfield & force, vector
 
     Backend::par::apply(
         n,
-        [s, f, o] SPIRIT_LAMBDA( int idx )
+        [s, f, o] SPIRIT_LAMBDA( spirit_index idx )
         {
             Vector3 e1, a2, A;
             scalar detAi;
@@ -56,13 +56,13 @@ void oso_calc_gradients( vectorfield & grad, const vectorfield & spins, const ve
     auto f = forces.data();
 
     Backend::par::apply(
-        spins.size(), [g, s, f, t] SPIRIT_LAMBDA( int idx ) { g[idx] = t * ( -s[idx].cross( f[idx] ) ); } );
+        spins.size(), [g, s, f, t] SPIRIT_LAMBDA( spirit_index idx ) { g[idx] = t * ( -s[idx].cross( f[idx] ) ); } );
 }
 
 void oso_rotate( std::vector<std::shared_ptr<vectorfield>> & configurations, std::vector<vectorfield> & searchdir )
 {
-    int noi = configurations.size();
-    int nos = configurations[0]->size();
+    int noi          = configurations.size();
+    spirit_index nos = configurations[0]->size();
     for( int img = 0; img < noi; ++img )
     {
 
@@ -71,7 +71,7 @@ void oso_rotate( std::vector<std::shared_ptr<vectorfield>> & configurations, std
 
         Backend::par::apply(
             nos,
-            [s, sd] SPIRIT_LAMBDA( int idx )
+            [s, sd] SPIRIT_LAMBDA( spirit_index idx )
             {
                 scalar theta = ( sd[idx] ).norm();
                 scalar q = cos( theta ), w = 1 - q, x = -sd[idx][0] / theta, y = -sd[idx][1] / theta,
@@ -92,9 +92,24 @@ void oso_rotate( std::vector<std::shared_ptr<vectorfield>> & configurations, std
     }
 }
 
+void oso_project_tangential( vectorfield & searchdir, const vectorfield & spins )
+{
+    auto sd = searchdir.data();
+    auto s  = spins.data();
+
+    // The rotation axis of `oso_rotate` is (sd_z, -sd_y, sd_x), so a spin is not moved by sd = (s_z, -s_y, s_x)
+    Backend::par::apply(
+        spins.size(),
+        [sd, s] SPIRIT_LAMBDA( spirit_index idx )
+        {
+            const Vector3 n{ s[idx][2], -s[idx][1], s[idx][0] };
+            sd[idx] -= sd[idx].dot( n ) * n;
+        } );
+}
+
 scalar maximum_rotation( const vectorfield & searchdir, scalar maxmove )
 {
-    int nos          = searchdir.size();
+    spirit_index nos = searchdir.size();
     scalar theta_rms = 0;
     theta_rms        = sqrt(
         Backend::par::reduce( searchdir, [] SPIRIT_LAMBDA( const Vector3 & v ) { return v.squaredNorm(); } ) / nos );
@@ -106,8 +121,8 @@ void atlas_rotate(
     std::vector<std::shared_ptr<vectorfield>> & configurations, const std::vector<scalarfield> & a3_coords,
     const std::vector<vector2field> & searchdir )
 {
-    int noi = configurations.size();
-    int nos = configurations[0]->size();
+    int noi          = configurations.size();
+    spirit_index nos = configurations[0]->size();
     for( int img = 0; img < noi; img++ )
     {
         auto spins = configurations[img]->data();
@@ -115,7 +130,7 @@ void atlas_rotate(
         auto a3    = a3_coords[img].data();
         Backend::par::apply(
             nos,
-            [nos, spins, d, a3] SPIRIT_LAMBDA( int idx )
+            [nos, spins, d, a3] SPIRIT_LAMBDA( spirit_index idx )
             {
                 const scalar gamma = ( 1 + spins[idx][2] * a3[idx] );
                 const scalar denom = ( spins[idx].head<2>().squaredNorm() ) / gamma
@@ -137,7 +152,7 @@ void atlas_calc_gradients(
 
     Backend::par::apply(
         spins.size(),
-        [s, a3, g, f] SPIRIT_LAMBDA( int idx )
+        [s, a3, g, f] SPIRIT_LAMBDA( spirit_index idx )
         {
             scalar J00 = s[idx][1] * s[idx][1] + s[idx][2] * ( s[idx][2] + a3[idx] );
             scalar J10 = -s[idx][0] * s[idx][1];
@@ -154,8 +169,8 @@ void atlas_calc_gradients(
 bool ncg_atlas_check_coordinates(
     const std::vector<std::shared_ptr<vectorfield>> & spins, std::vector<scalarfield> & a3_coords, scalar tol )
 {
-    int noi = spins.size();
-    int nos = ( *spins[0] ).size();
+    int noi          = spins.size();
+    spirit_index nos = ( *spins[0] ).size();
 
     // We use `int` instead of `bool`, because somehow cuda does not like pointers to bool
     // TODO: fix in future
@@ -169,7 +184,7 @@ bool ncg_atlas_check_coordinates(
 
         Backend::par::apply(
             nos,
-            [s, a3, tol, res] SPIRIT_LAMBDA( int idx )
+            [s, a3, tol, res] SPIRIT_LAMBDA( spirit_index idx )
             {
                 if( s[idx][2] * a3[idx] < tol && res[0] == int( false ) )
                     res[0] = int( true );
@@ -184,8 +199,8 @@ void lbfgs_atlas_transform_direction(
     std::vector<field<vector2field>> & atlas_updates, std::vector<field<vector2field>> & grad_updates,
     std::vector<vector2field> & searchdir, std::vector<vector2field> & grad_pr, scalarfield & rho )
 {
-    int noi = configurations.size();
-    int nos = configurations[0]->size();
+    int noi          = configurations.size();
+    spirit_index nos = configurations[0]->size();
 
     for( int n = 0; n < atlas_updates[0].size(); n++ )
     {
@@ -214,7 +229,7 @@ void lbfgs_atlas_transform_direction(
 
         Backend::par::apply(
             nos,
-            [s, a3, sd, g_pr, rh, a_up, g_up, n_mem] SPIRIT_LAMBDA( int idx )
+            [s, a3, sd, g_pr, rh, a_up, g_up, n_mem] SPIRIT_LAMBDA( spirit_index idx )
             {
                 scalar factor = 1;
                 if( s[idx][2] * a3[idx] < 0 )
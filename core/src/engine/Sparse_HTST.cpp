@@ -319,8 +319,8 @@ void Calculate( Data::HTST_Info & htst_info )
         Log( Utility::Log_Level::Info, Utility::Log_Sender::HTST, "Calculation for the Saddle Point" );
 
         Log( Utility::Log_Level::Info, Utility::Log_Sender::HTST, "    Evaluate tangent basis ..." );
-        SpMatrixX tangent_basis = SpMatrixX( 3 * nos, 2 * nos );
-        Manifoldmath::sparse_tangent_basis_spherical( image_sp, tangent_basis );
+        field<Manifoldmath::Matrix3x2> tangent_basis;
+        Manifoldmath::tangent_basis_spherical( image_sp, tangent_basis );
 
         // Evaluation of the Hessian...
         Log( Utility::Log_Level::Info, Utility::Log_Sender::HTST, "    Evaluate the Hessian..." );
@@ -331,8 +331,8 @@ void Calculate( Data::HTST_Info & htst_info )
         Log( Utility::Log_Level::Info, Utility::Log_Sender::HTST, "    Transform Hessian into geodesic Hessian..." );
         SpMatrixX sparse_hessian_sp_geodesic_3N( 3 * nos, 3 * nos );
         sparse_hessian_bordered_3N( image_sp, gradient_sp, sparse_hessian_sp, sparse_hessian_sp_geodesic_3N );
-        SpMatrixX sparse_hessian_sp_geodesic_2N
-            = tangent_basis.transpose() * sparse_hessian_sp_geodesic_3N * tangent_basis;
+        SpMatrixX sparse_hessian_sp_geodesic_2N;
+        Manifoldmath::change_basis( tangent_basis, sparse_hessian_sp_geodesic_3N, sparse_hessian_sp_geodesic_2N );
 
         Log( Utility::Log_Level::Info, Utility::Log_Sender::HTST,
              "    Sparse LU Decomposition of geodesic Hessian..." );
@@ -388,7 +388,8 @@ void Calculate( Data::HTST_Info & htst_info )
         SpMatrixX velocity( 3 * nos, 3 * nos );
         Sparse_Calculate_Dynamical_Matrix(
             image_sp, htst_info.saddle_point->geometry->mu_s, sparse_hessian_sp_geodesic_3N, velocity );
-        SpMatrixX projected_velocity = tangent_basis.transpose() * velocity * tangent_basis;
+        SpMatrixX projected_velocity;
+        Manifoldmath::change_basis( tangent_basis, velocity, projected_velocity );
 
         Log( Utility::Log_Level::Info, Utility::Log_Sender::HTST, "    Solving H^-1 V q_1 ..." );
         VectorX x( 2 * nos );
@@ -423,8 +424,8 @@ void Calculate( Data::HTST_Info & htst_info )
         Log( Utility::Log_Level::Info, Utility::Log_Sender::HTST, "Calculation for the Minimum" );
 
         Log( Utility::Log_Level::Info, Utility::Log_Sender::HTST, "    Evaluate tangent basis ..." );
-        SpMatrixX tangent_basis = SpMatrixX( 3 * nos, 2 * nos );
-        Manifoldmath::sparse_tangent_basis_spherical( image_minimum, tangent_basis );
+        field<Manifoldmath::Matrix3x2> tangent_basis;
+        Manifoldmath::tangent_basis_spherical( image_minimum, tangent_basis );
 
         // Evaluation of the Hessian...
         Log( Utility::Log_Level::Info, Utility::Log_Sender::HTST, "    Evaluate the Hessian..." );
@@ -436,8 +437,8 @@ void Calculate( Data::HTST_Info & htst_info )
         SpMatrixX sparse_hessian_geodesic_min_3N = SpMatrixX( 3 * nos, 3 * nos );
         sparse_hessian_bordered_3N(
             image_minimum, gradient_minimum, sparse_hessian_minimum, sparse_hessian_geodesic_min_3N );
-        SpMatrixX sparse_hessian_geodesic_min_2N
-            = tangent_basis.transpose() * sparse_hessian_geodesic_min_3N * tangent_basis;
+        SpMatrixX sparse_hessian_geodesic_min_2N;
+        Manifoldmath::change_basis( tangent_basis, sparse_hessian_geodesic_min_3N, sparse_hessian_geodesic_min_2N );
 
         Log( Utility::Log_Level::Info, Utility::Log_Sender::HTST,
              "    Sparse LU Decomposition of geodesic Hessian..." );
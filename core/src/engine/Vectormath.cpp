@@ -1,3 +1,4 @@
+#include <engine/Backend_par.hpp>
 #include <engine/Manifoldmath.hpp>
 #include <engine/Vectormath.hpp>
 #include <utility/Constants.hpp>
@@ -66,38 +67,26 @@ void get_random_vectorfield_unitsphere( std::mt19937 & prng, vectorfield & xi )
 
 void fill( scalarfield & sf, scalar s )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < sf.size(); ++i )
-        sf[i] = s;
+    Backend::par::apply( sf.size(), [&]( int i ) { sf[i] = s; } );
 }
 void fill( scalarfield & sf, scalar s, const intfield & mask )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < sf.size(); ++i )
-        sf[i] = mask[i] * s;
+    Backend::par::apply( sf.size(), [&]( int i ) { sf[i] = mask[i] * s; } );
 }
 
 void scale( scalarfield & sf, scalar s )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < sf.size(); ++i )
-        sf[i] *= s;
+    Backend::par::apply( sf.size(), [&]( int i ) { sf[i] *= s; } );
 }
 
 void add( scalarfield & sf, scalar s )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < sf.size(); ++i )
-        sf[i] += s;
+    Backend::par::apply( sf.size(), [&]( int i ) { sf[i] += s; } );
 }
 
 scalar sum( const scalarfield & sf )
 {
-    scalar ret = 0;
-#pragma omp parallel for reduction( + : ret )
-    for( unsigned int i = 0; i < sf.size(); ++i )
-        ret += sf[i];
-    return ret;
+    return Backend::par::reduce( sf, [] SPIRIT_LAMBDA( scalar s ) { return s; } );
 }
 
 scalar mean( const scalarfield & sf )
@@ -108,29 +97,21 @@ scalar mean( const scalarfield & sf )
 
 void set_range( scalarfield & sf, scalar sf_min, scalar sf_max )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < sf.size(); ++i )
-        sf[i] = std::min( std::max( sf_min, sf[i] ), sf_max );
+    Backend::par::apply( sf.size(), [&]( int i ) { sf[i] = std::min( std::max( sf_min, sf[i] ), sf_max ); } );
 }
 
 void fill( vectorfield & vf, const Vector3 & v )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < vf.size(); ++i )
-        vf[i] = v;
+    Backend::par::apply( vf.size(), [&]( int i ) { vf[i] = v; } );
 }
 void fill( vectorfield & vf, const Vector3 & v, const intfield & mask )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < vf.size(); ++i )
-        vf[i] = mask[i] * v;
+    Backend::par::apply( vf.size(), [&]( int i ) { vf[i] = mask[i] * v; } );
 }
 
 void normalize_vectors( vectorfield & vf )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < vf.size(); ++i )
-        vf[i].normalize();
+    Backend::par::apply( vf.size(), [&]( int i ) { vf[i].normalize(); } );
 }
 
 void norm( const vectorfield & vf, scalarfield & norm )
@@ -174,24 +155,18 @@ scalar max_abs_component( const vectorfield & vf )
 
 void scale( vectorfield & vf, const scalar & sc )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < vf.size(); ++i )
-        vf[i] *= sc;
+    Backend::par::apply( vf.size(), [&]( int i ) { vf[i] *= sc; } );
 }
 
 void scale( vectorfield & vf, const scalarfield & sf, bool inverse )
 {
     if( inverse )
     {
-#pragma omp parallel for
-        for( unsigned int i = 0; i < vf.size(); ++i )
-            vf[i] /= sf[i];
+        Backend::par::apply( vf.size(), [&]( int i ) { vf[i] /= sf[i]; } );
     }
     else
     {
-#pragma omp parallel for
-        for( unsigned int i = 0; i < vf.size(); ++i )
-            vf[i] *= sf[i];
+        Backend::par::apply( vf.size(), [&]( int i ) { vf[i] *= sf[i]; } );
     }
 }
 
@@ -212,178 +187,131 @@ Vector3 mean( const vectorfield & vf )
 
 void divide( const scalarfield & numerator, const scalarfield & denominator, scalarfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < out.size(); ++i )
-        out[i] = numerator[i] / denominator[i];
+    Backend::par::apply( out.size(), [&]( int i ) { out[i] = numerator[i] / denominator[i]; } );
 }
 
 // computes the inner product of two vectorfields v1 and v2
 scalar dot( const vectorfield & v1, const vectorfield & v2 )
 {
-    scalar ret = 0;
-#pragma omp parallel for reduction( + : ret )
-    for( unsigned int i = 0; i < v1.size(); ++i )
-        ret += v1[i].dot( v2[i] );
-    return ret;
+    return Backend::par::reduce(
+        v1, v2, [] SPIRIT_LAMBDA( const Vector3 & a, const Vector3 & b ) { return a.dot( b ); } );
 }
 
 // computes the inner products of vectors in vf1 and vf2
 // vf1 and vf2 are vectorfields
 void dot( const vectorfield & vf1, const vectorfield & vf2, scalarfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < vf1.size(); ++i )
-        out[i] = vf1[i].dot( vf2[i] );
+    Backend::par::apply( vf1.size(), [&]( int i ) { out[i] = vf1[i].dot( vf2[i] ); } );
 }
 
 // computes the product of scalars in s1 and s2
 // s1 and s2 are scalarfields
 void dot( const scalarfield & s1, const scalarfield & s2, scalarfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < s1.size(); i++ )
-        out[i] = s1[i] * s2[i];
+    Backend::par::apply( s1.size(), [&]( int i ) { out[i] = s1[i] * s2[i]; } );
 }
 
 // computes the vector (cross) products of vectors in v1 and v2
 // v1 and v2 are vector fields
 void cross( const vectorfield & v1, const vectorfield & v2, vectorfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int i = 0; i < v1.size(); ++i )
-        out[i] = v1[i].cross( v2[i] );
+    Backend::par::apply( v1.size(), [&]( int i ) { out[i] = v1[i].cross( v2[i] ); } );
 }
 
 // out[i] += c*a
 void add_c_a( const scalar & c, const Vector3 & vec, vectorfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] += c * vec;
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] += c * vec; } );
 }
 // out[i] += c*a[i]
 void add_c_a( const scalar & c, const vectorfield & vf, vectorfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] += c * vf[idx];
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] += c * vf[idx]; } );
 }
 void add_c_a( const scalar & c, const vectorfield & vf, vectorfield & out, const intfield & mask )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] += mask[idx] * c * vf[idx];
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] += mask[idx] * c * vf[idx]; } );
 }
 // out[i] += c[i]*a[i]
 void add_c_a( const scalarfield & c, const vectorfield & vf, vectorfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] += c[idx] * vf[idx];
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] += c[idx] * vf[idx]; } );
 }
 
 // out[i] = c*a
 void set_c_a( const scalar & c, const Vector3 & vec, vectorfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] = c * vec;
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] = c * vec; } );
 }
 // out[i] = c*a
 void set_c_a( const scalar & c, const Vector3 & vec, vectorfield & out, const intfield & mask )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] = mask[idx] * c * vec;
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] = mask[idx] * c * vec; } );
 }
 
 // out[i] = c*a[i]
 void set_c_a( const scalar & c, const vectorfield & vf, vectorfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] = c * vf[idx];
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] = c * vf[idx]; } );
 }
 // out[i] = c*a[i]
 void set_c_a( const scalar & c, const vectorfield & vf, vectorfield & out, const intfield & mask )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] = mask[idx] * c * vf[idx];
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] = mask[idx] * c * vf[idx]; } );
 }
 // out[i] = c[i]*a[i]
 void set_c_a( const scalarfield & c, const vectorfield & vf, vectorfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] = c[idx] * vf[idx];
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] = c[idx] * vf[idx]; } );
 }
 
 // out[i] += c * a*b[i]
 void add_c_dot( const scalar & c, const Vector3 & vec, const vectorfield & vf, scalarfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] += c * vec.dot( vf[idx] );
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] += c * vec.dot( vf[idx] ); } );
 }
 // out[i] += c * a[i]*b[i]
 void add_c_dot( const scalar & c, const vectorfield & vf1, const vectorfield & vf2, scalarfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] += c * vf1[idx].dot( vf2[idx] );
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] += c * vf1[idx].dot( vf2[idx] ); } );
 }
 
 // out[i] = c * a*b[i]
 void set_c_dot( const scalar & c, const Vector3 & a, const vectorfield & b, scalarfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] = c * a.dot( b[idx] );
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] = c * a.dot( b[idx] ); } );
 }
 // out[i] = c * a[i]*b[i]
 void set_c_dot( const scalar & c, const vectorfield & a, const vectorfield & b, scalarfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] = c * a[idx].dot( b[idx] );
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] = c * a[idx].dot( b[idx] ); } );
 }
 
 // out[i] += c * a x b[i]
 void add_c_cross( const scalar & c, const Vector3 & a, const vectorfield & b, vectorfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] += c * a.cross( b[idx] );
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] += c * a.cross( b[idx] ); } );
 }
 // out[i] += c * a[i] x b[i]
 void add_c_cross( const scalar & c, const vectorfield & a, const vectorfield & b, vectorfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] += c * a[idx].cross( b[idx] );
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] += c * a[idx].cross( b[idx] ); } );
 }
 // out[i] += c[i] * a[i] x b[i]
 void add_c_cross( const scalarfield & c, const vectorfield & a, const vectorfield & b, vectorfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] += c[idx] * a[idx].cross( b[idx] );
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] += c[idx] * a[idx].cross( b[idx] ); } );
 }
 
 // out[i] = c * a x b[i]
 void set_c_cross( const scalar & c, const Vector3 & a, const vectorfield & b, vectorfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] = c * a.cross( b[idx] );
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] = c * a.cross( b[idx] ); } );
 }
 // out[i] = c * a[i] x b[i]
 void set_c_cross( const scalar & c, const vectorfield & a, const vectorfield & b, vectorfield & out )
 {
-#pragma omp parallel for
-    for( unsigned int idx = 0; idx < out.size(); ++idx )
-        out[idx] = c * a[idx].cross( b[idx] );
+    Backend::par::apply( out.size(), [&]( spirit_index idx ) { out[idx] = c * a[idx].cross( b[idx] ); } );
 }
 
 scalar max_norm( const vectorfield & vf )
@@ -501,122 +429,82 @@ std::array<scalar, 3> Magnetization( const vectorfield & vf, const scalarfield &
     return M;
 }
 
-void TopologicalChargeDensity(
-    const vectorfield & vf, const Data::Geometry & geometry, const intfield & boundary_conditions,
-    scalarfield & charge_density, std::vector<int> & triangle_indices )
+namespace
 {
-    charge_density.resize( 0 );
-
-    // This implementations assumes
-    // 1. No basis atom lies outside the cell spanned by the basis vectors of the lattice
-    // 2. The geometry is a plane in x and y and spanned by the first 2 basis_vectors of the lattice
-    // 3. The first basis atom lies at (0,0)
 
-    const auto & positions = geometry.positions;
-    scalar charge          = 0;
+// Number of cells in direction dim, in which a triangle with the given largest translation is allowed, which means
+// that all its corners lie either inside the simulation box or are permitted by periodic boundary conditions
+int n_cells_allowed( const Data::Geometry & geometry, const intfield & boundary_conditions, int dim, int t_max )
+{
+    if( boundary_conditions[dim] )
+        return geometry.n_cells[dim];
+    return std::max( 0, geometry.n_cells[dim] - t_max );
+}
 
-    // Compute Delaunay for unitcell + basis with neighbouring lattice sites in directions a, b, and a+b
-    std::vector<Data::vector2_t> basis_cell_points( geometry.n_cell_atoms + 3 );
-    for( int i = 0; i < geometry.n_cell_atoms; i++ )
+// Number of cells in directions a and b, in which the triangle of the charge stencil is allowed
+std::array<int, 2> charge_stencil_cells(
+    const Data::Geometry & geometry, const intfield & boundary_conditions, const Data::triangle_stencil_t & triangle )
+{
+    std::array<int, 2> n_cells;
+    for( int dim = 0; dim < 2; ++dim )
     {
-        basis_cell_points[i].x = double( positions[i][0] );
-        basis_cell_points[i].y = double( positions[i][1] );
+        int t_max = 0;
+        for( const auto & site : triangle )
+            t_max = std::max( t_max, site.translations[dim] );
+        n_cells[dim] = n_cells_allowed( geometry, boundary_conditions, dim, t_max );
     }
+    return n_cells;
+}
 
-    // To avoid cases where the basis atoms lie on the boundary of the convex hull the corners of the parallelogram
-    // spanned by the lattice sites 0, a, b and a+b are stretched away from the center for the triangulation
-    scalar stretch_factor = 0.1;
-
-    // For the rare case where the first basis atoms does not lie at (0,0,0)
-    Vector3 basis_offset = positions[0];
+// Index of the spin of a site of the charge stencil, applied at the lattice point (a, b)
+int charge_stencil_spin( const Data::Geometry & geometry, const Site & site, int a, int b )
+{
+    return site.i + ( ( a + site.translations[0] ) % geometry.n_cells[0] ) * geometry.n_cell_atoms
+           + ( ( b + site.translations[1] ) % geometry.n_cells[1] ) * geometry.n_cell_atoms * geometry.n_cells[0];
+}
 
-    Vector3 ta = geometry.lattice_constant * geometry.bravais_vectors[0];
-    Vector3 tb = geometry.lattice_constant * geometry.bravais_vectors[1];
-    Vector3 tc = geometry.lattice_constant * geometry.bravais_vectors[2];
+} // namespace
 
-    // basis_cell_points[0] coincides with the '0' lattice site (plus basis_offset)
-    basis_cell_points[0].x -= stretch_factor * ( ta + tb )[0];
-    basis_cell_points[0].y -= stretch_factor * ( ta + tb )[1];
+void TopologicalChargeDensity(
+    const vectorfield & vf, const Data::Geometry & geometry, const intfield & boundary_conditions,
+    scalarfield & charge_density, intfield & triangle_indices )
+{
+    // The triangles of the unit cell and its neighbouring lattice sites in directions a, b, and a+b are calculated
+    // once by the geometry. Each of them is applied at every lattice point, where it is allowed.
+    const auto & stencil = geometry.charge_stencil;
 
-    // a+b
-    basis_cell_points[geometry.n_cell_atoms].x = double( ( ta + tb + positions[0] + stretch_factor * ( ta + tb ) )[0] );
-    basis_cell_points[geometry.n_cell_atoms].y = double( ( ta + tb + positions[0] + stretch_factor * ( ta + tb ) )[1] );
-    // b
-    basis_cell_points[geometry.n_cell_atoms + 1].x = double( ( tb + positions[0] - stretch_factor * ( ta - tb ) )[0] );
-    basis_cell_points[geometry.n_cell_atoms + 1].y = double( ( tb + positions[0] - stretch_factor * ( ta - tb ) )[1] );
-    // a
-    basis_cell_points[geometry.n_cell_atoms + 2].x = double( ( ta + positions[0] + stretch_factor * ( ta - tb ) )[0] );
-    basis_cell_points[geometry.n_cell_atoms + 2].y = double( ( ta + positions[0] + stretch_factor * ( ta - tb ) )[1] );
+    std::vector<std::array<int, 2>> n_cells( stencil.size() );
+    std::vector<int> offsets( stencil.size() + 1, 0 );
+    for( std::size_t itri = 0; itri < stencil.size(); ++itri )
+    {
+        n_cells[itri]      = charge_stencil_cells( geometry, boundary_conditions, stencil[itri] );
+        offsets[itri + 1] = offsets[itri] + n_cells[itri][0] * n_cells[itri][1];
+    }
 
-    std::vector<Data::triangle_t> triangulation;
-    triangulation = Data::compute_delaunay_triangulation_2D( basis_cell_points );
+    charge_density.resize( offsets.back() );
+    triangle_indices.resize( 3 * offsets.back() );
 
-    for( Data::triangle_t tri : triangulation )
+    for( std::size_t itri = 0; itri < stencil.size(); ++itri )
     {
-        // Compute the sign of this triangle
-        Vector3 triangle_normal;
-        vectorfield tri_positions( 3 );
-        for( int i = 0; i < 3; i++ )
-            tri_positions[i]
-                = { scalar( basis_cell_points[tri[i]].x ), scalar( basis_cell_points[tri[i]].y ), scalar( 0 ) };
-        triangle_normal = ( tri_positions[0] - tri_positions[1] ).cross( tri_positions[0] - tri_positions[2] );
-        triangle_normal.normalize();
-        scalar sign = triangle_normal[2] / std::abs( triangle_normal[2] );
-
-        // We try to apply the Delaunay triangulation at each bravais-lattice point
-        // For each corner of the triangle we check wether it is "allowed" (which means either inside the simulation box
-        // or permitted by periodic boundary conditions) Then we can add the top charge for all trios of spins connected
-        // by this triangle
-        for( int b = 0; b < geometry.n_cells[1]; ++b )
+        const auto & tri   = stencil[itri];
+        const scalar sign  = geometry.charge_stencil_signs[itri];
+        const int n_a      = n_cells[itri][0];
+        const int n_points = offsets[itri + 1] - offsets[itri];
+#pragma omp parallel for
+        for( int ipoint = 0; ipoint < n_points; ++ipoint )
         {
-            for( int a = 0; a < geometry.n_cells[0]; ++a )
+            const int a   = ipoint % n_a;
+            const int b   = ipoint / n_a;
+            const int idx = offsets[itri] + ipoint;
+
+            std::array<int, 3> tri_indices;
+            for( int i = 0; i < 3; ++i )
             {
-                std::array<Vector3, 3> tri_spins;
-                std::array<int, 3> tri_indices;
-                // bools to check wether it is allowed to take the next lattice site in direction a, b or a+b
-                bool a_next_allowed = ( a + 1 < geometry.n_cells[0] || boundary_conditions[0] );
-                bool b_next_allowed = ( b + 1 < geometry.n_cells[1] || boundary_conditions[1] );
-                bool valid_triangle = true;
-                for( int i = 0; i < 3; ++i )
-                {
-                    int idx;
-                    if( tri[i] < geometry.n_cell_atoms ) // tri[i] is an index of a basis atom, no wrap around can occur
-                    {
-                        idx = ( tri[i] + a * geometry.n_cell_atoms + b * geometry.n_cell_atoms * geometry.n_cells[0] );
-                    }
-                    else if( tri[i] == geometry.n_cell_atoms + 2 && a_next_allowed ) // Translation by a
-                    {
-                        idx = ( ( a + 1 ) % geometry.n_cells[0] ) * geometry.n_cell_atoms
-                              + b * geometry.n_cell_atoms * geometry.n_cells[0];
-                    }
-                    else if( tri[i] == geometry.n_cell_atoms + 1 && b_next_allowed ) // Translation by b
-                    {
-                        idx = a * geometry.n_cell_atoms
-                              + ( ( b + 1 ) % geometry.n_cells[1] ) * geometry.n_cell_atoms * geometry.n_cells[0];
-                    }
-                    else if(
-                        tri[i] == geometry.n_cell_atoms && a_next_allowed && b_next_allowed ) // Translation by a + b
-                    {
-                        idx = ( ( a + 1 ) % geometry.n_cells[0] ) * geometry.n_cell_atoms
-                              + ( ( b + 1 ) % geometry.n_cells[1] ) * geometry.n_cell_atoms * geometry.n_cells[0];
-                    }
-                    else // Translation not allowed, skip to next triangle
-                    {
-                        valid_triangle = false;
-                        break;
-                    }
-                    tri_spins[i]   = vf[idx];
-                    tri_indices[i] = idx;
-                }
-                if( valid_triangle )
-                {
-                    triangle_indices.push_back( tri_indices[0] );
-                    triangle_indices.push_back( tri_indices[1] );
-                    triangle_indices.push_back( tri_indices[2] );
-                    charge_density.push_back(
-                        sign / ( 4.0 * Pi ) * solid_angle_2( tri_spins[0], tri_spins[1], tri_spins[2] ) );
-                }
+                tri_indices[i]                = charge_stencil_spin( geometry, tri[i], a, b );
+                triangle_indices[3 * idx + i] = tri_indices[i];
             }
+            charge_density[idx]
+                = sign / ( 4.0 * Pi ) * solid_angle_2( vf[tri_indices[0]], vf[tri_indices[1]], vf[tri_indices[2]] );
         }
     }
 }
@@ -624,10 +512,27 @@ void TopologicalChargeDensity(
 // Calculate the topological charge inside a vectorfield
 scalar TopologicalCharge( const vectorfield & vf, const Data::Geometry & geom, const intfield & boundary_conditions )
 {
-    scalarfield charge_density( 0 );
-    std::vector<int> triangle_indices( 0 );
-    TopologicalChargeDensity( vf, geom, boundary_conditions, charge_density, triangle_indices );
-    return sum( charge_density );
+    // Same as summing the charge density, but without storing it
+    scalar charge = 0;
+    for( std::size_t itri = 0; itri < geom.charge_stencil.size(); ++itri )
+    {
+        const auto & tri         = geom.charge_stencil[itri];
+        const scalar sign        = geom.charge_stencil_signs[itri];
+        const auto n_cells       = charge_stencil_cells( geom, boundary_conditions, tri );
+        const int n_points       = n_cells[0] * n_cells[1];
+        scalar solid_angle_total = 0;
+#pragma omp parallel for reduction( + : solid_angle_total )
+        for( int ipoint = 0; ipoint < n_points; ++ipoint )
+        {
+            const int a = ipoint % n_cells[0];
+            const int b = ipoint / n_cells[0];
+            solid_angle_total += solid_angle_2(
+                vf[charge_stencil_spin( geom, tri[0], a, b )], vf[charge_stencil_spin( geom, tri[1], a, b )],
+                vf[charge_stencil_spin( geom, tri[2], a, b )] );
+        }
+        charge += sign / ( 4.0 * Pi ) * solid_angle_total;
+    }
+    return charge;
 }
 
 void get_gradient_distribution(
@@ -651,126 +556,8 @@ void get_gradient_distribution(
     set_range( distribution, range_min, range_max );
 }
 
-void directional_gradient(
-    const vectorfield & vf, const Data::Geometry & geometry, const intfield & boundary_conditions,
-    const Vector3 & direction, vectorfield & gradient )
-{
-    // std::cout << "start gradient" << std::endl;
-    vectorfield translations = { { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 } };
-    auto & n_cells           = geometry.n_cells;
-
-    neighbourfield neigh;
-
-    // TODO: calculate Neighbours outside iterations
-    // Neighbours::get_Neighbours(geometry, neigh);
-
-    // TODO: proper usage of neighbours
-    // Hardcoded neighbours - for spin current in a rectangular lattice
-    neigh = neighbourfield( 0 );
-    Neighbour neigh_tmp;
-    neigh_tmp.i         = 0;
-    neigh_tmp.j         = 0;
-    neigh_tmp.idx_shell = 0;
-
-    neigh_tmp.translations[0] = 1;
-    neigh_tmp.translations[1] = 0;
-    neigh_tmp.translations[2] = 0;
-    neigh.push_back( neigh_tmp );
-
-    neigh_tmp.translations[0] = -1;
-    neigh_tmp.translations[1] = 0;
-    neigh_tmp.translations[2] = 0;
-    neigh.push_back( neigh_tmp );
-
-    neigh_tmp.translations[0] = 0;
-    neigh_tmp.translations[1] = 1;
-    neigh_tmp.translations[2] = 0;
-    neigh.push_back( neigh_tmp );
-
-    neigh_tmp.translations[0] = 0;
-    neigh_tmp.translations[1] = -1;
-    neigh_tmp.translations[2] = 0;
-    neigh.push_back( neigh_tmp );
-
-    neigh_tmp.translations[0] = 0;
-    neigh_tmp.translations[1] = 0;
-    neigh_tmp.translations[2] = 1;
-    neigh.push_back( neigh_tmp );
-
-    neigh_tmp.translations[0] = 0;
-    neigh_tmp.translations[1] = 0;
-    neigh_tmp.translations[2] = -1;
-    neigh.push_back( neigh_tmp );
-
-    // Loop over vectorfield
-    for( unsigned int ispin = 0; ispin < vf.size(); ++ispin )
-    {
-        auto translations_i = translations_from_idx( n_cells, geometry.n_cell_atoms, ispin ); // transVec of spin i
-        // int k = i%geometry.n_cell_atoms; // index within unit cell - k=0 for all cases used in the thesis
-        scalar n = 0;
-
-        gradient[ispin].setZero();
-
-        std::vector<Vector3> euclidean{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
-        std::vector<Vector3> contrib = { { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 } };
-        Vector3 proj                 = { 0, 0, 0 };
-        Vector3 projection_inv       = { 0, 0, 0 };
-
-        // TODO: both loops together.
-
-        // Loop over neighbours of this vector to calculate contributions of finite differences to current direction
-        for( unsigned int j = 0; j < neigh.size(); ++j )
-        {
-            if( boundary_conditions_fulfilled(
-                    geometry.n_cells, boundary_conditions, translations_i, neigh[j].translations ) )
-            {
-                // Index of neighbour
-                int ineigh
-                    = idx_from_translations( n_cells, geometry.n_cell_atoms, translations_i, neigh[j].translations );
-                if( ineigh >= 0 )
-                {
-                    auto d = geometry.positions[ineigh] - geometry.positions[ispin];
-                    for( int dim = 0; dim < 3; ++dim )
-                    {
-                        proj[dim] += std::abs( euclidean[dim].dot( d.normalized() ) );
-                    }
-                }
-            }
-        }
-        for( int dim = 0; dim < 3; ++dim )
-        {
-            if( std::abs( proj[dim] ) > 1e-10 )
-                projection_inv[dim] = 1.0 / proj[dim];
-        }
-        // Loop over neighbours of this vector to calculate finite differences
-        for( unsigned int j = 0; j < neigh.size(); ++j )
-        {
-            if( boundary_conditions_fulfilled(
-                    geometry.n_cells, boundary_conditions, translations_i, neigh[j].translations ) )
-            {
-                // Index of neighbour
-                int ineigh
-                    = idx_from_translations( n_cells, geometry.n_cell_atoms, translations_i, neigh[j].translations );
-                if( ineigh >= 0 )
-                {
-                    auto d = geometry.positions[ineigh] - geometry.positions[ispin];
-                    for( int dim = 0; dim < 3; ++dim )
-                    {
-                        contrib[dim] += euclidean[dim].dot( d ) / d.dot( d ) * ( vf[ineigh] - vf[ispin] );
-                    }
-                }
-            }
-        }
-
-        for( int dim = 0; dim < 3; ++dim )
-        {
-            gradient[ispin] += direction[dim] * projection_inv[dim] * contrib[dim];
-        }
-    }
-}
-
 // Compute the linear index from the lattice position
-inline int linear_idx(
+inline spirit_index linear_idx(
     const int ib, int a, int b, int c, const int n_cell_atoms, const int n_cells[3], const int bc[3],
     const bool disable_checks = false )
 {
@@ -810,7 +597,7 @@ inline int linear_idx(
                 return -1;
         }
     }
-    return ib + n_cell_atoms * ( a + n_cells[0] * ( b + n_cells[1] * c ) );
+    return ib + n_cell_atoms * ( a + n_cells[0] * ( b + spirit_index( n_cells[1] ) * c ) );
 }
 
 void jacobian(
@@ -900,5 +687,97 @@ void jacobian(
     }
 }
 
+void finite_difference_stencil(
+    const Data::Geometry & geometry, const intfield & boundary_conditions, Finite_Difference_Stencil & stencil )
+{
+    const int n_cells[3]         = { geometry.n_cells[0], geometry.n_cells[1], geometry.n_cells[2] };
+    const int bc[3]              = { boundary_conditions[0], boundary_conditions[1], boundary_conditions[2] };
+    const int n_cell_atoms       = geometry.n_cell_atoms;
+    const int translations[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+    Matrix3 bravais_matrix;
+    for( int k = 0; k < 3; ++k )
+        bravais_matrix.col( k ) = geometry.lattice_constant * geometry.bravais_vectors[k];
+    stencil.inverse_bravais = bravais_matrix.inverse();
+
+    stencil.neighbours = indexfield( 6 * std::size_t( geometry.nos ) );
+    stencil.factors    = scalarfield( 3 * geometry.nos );
+
+#pragma omp parallel for collapse( 4 )
+    for( int c = 0; c < n_cells[2]; c++ )
+    {
+        for( int b = 0; b < n_cells[1]; b++ )
+        {
+            for( int a = 0; a < n_cells[0]; a++ )
+            {
+                for( int ib = 0; ib < n_cell_atoms; ib++ )
+                {
+                    const spirit_index idx = linear_idx( ib, a, b, c, n_cell_atoms, n_cells, bc, true );
+                    for( int k = 0; k < 3; ++k )
+                    {
+                        const int * t = translations[k];
+
+                        spirit_index forward
+                            = linear_idx( ib, a + t[0], b + t[1], c + t[2], n_cell_atoms, n_cells, bc );
+                        spirit_index backward
+                            = linear_idx( ib, a - t[0], b - t[1], c - t[2], n_cell_atoms, n_cells, bc );
+
+                        // One-sided differences where a neighbour is missing
+                        scalar factor = 0.5;
+                        if( forward < 0 )
+                        {
+                            forward = idx;
+                            factor *= 2;
+                        }
+                        if( backward < 0 )
+                        {
+                            backward = idx;
+                            factor *= 2;
+                        }
+                        // No difference at all if both are missing
+                        if( forward == backward )
+                            factor = 0;
+
+                        stencil.neighbours[6 * idx + 2 * k]     = forward;
+                        stencil.neighbours[6 * idx + 2 * k + 1] = backward;
+                        stencil.factors[3 * idx + k]            = factor;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void directional_gradient(
+    const vectorfield & vf, const Data::Geometry & geometry, const intfield & boundary_conditions,
+    const Vector3 & direction, vectorfield & gradient )
+{
+    Finite_Difference_Stencil stencil;
+    finite_difference_stencil( geometry, boundary_conditions, stencil );
+    directional_gradient( vf, stencil, direction, gradient );
+}
+
+void directional_gradient(
+    const vectorfield & vf, const Finite_Difference_Stencil & stencil, const Vector3 & direction,
+    vectorfield & gradient )
+{
+    const Vector3 weights = stencil.inverse_bravais * direction;
+
+    // clang-format off
+    Backend::par::apply( vf.size(),
+        [vf = vf.data(), neighbours = stencil.neighbours.data(), factors = stencil.factors.data(), weights,
+         gradient = gradient.data()] SPIRIT_LAMBDA ( spirit_index idx )
+        {
+            Vector3 res = Vector3::Zero();
+            for( int k = 0; k < 3; ++k )
+            {
+                res += weights[k] * factors[3 * idx + k]
+                       * ( vf[neighbours[6 * idx + 2 * k]] - vf[neighbours[6 * idx + 2 * k + 1]] );
+            }
+            gradient[idx] = res;
+        } );
+    // clang-format on
+}
+
 } // namespace Vectormath
 } // namespace Engine
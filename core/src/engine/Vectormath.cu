@@ -314,7 +314,7 @@ scalar max_norm( const vectorfield & vf )
     auto o = temp.data();
     auto v = vf.data();
     Backend::par::apply(
-        N, [o, v] SPIRIT_LAMBDA( int idx )
+        N, [o, v] SPIRIT_LAMBDA( spirit_index idx )
         { o[idx] = v[idx][0] * v[idx][0] + v[idx][1] * v[idx][1] + v[idx][2] * v[idx][2]; } );
 
     void * d_temp_storage     = NULL;
@@ -0,0 +1,193 @@
+#include <io/Checkpoint.hpp>
+#include <utility/Exception.hpp>
+
+#include <fmt/format.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace IO
+{
+
+namespace
+{
+
+const char signature[8] = { 'S', 'P', 'I', 'R', 'I', 'T', 'C', 'P' };
+
+constexpr std::uint32_t format_version = 2;
+// Read back in a different byte order, this would not match
+constexpr std::uint32_t byte_order_mark = 0x01020304;
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+
+Checkpoint_Writer::Checkpoint_Writer( const Checkpoint_Header & header )
+{
+    write_bytes( signature, sizeof( signature ) );
+    write( format_version );
+    write( byte_order_mark );
+    write( std::uint32_t( sizeof( scalar ) ) );
+    write( header.method );
+    write( std::int32_t( header.solver ) );
+    write( std::int32_t( header.noi ) );
+    write( std::int64_t( header.nos ) );
+}
+
+void Checkpoint_Writer::write( const std::string & value )
+{
+    write_size( value.size() );
+    write_bytes( value.data(), value.size() );
+}
+
+void Checkpoint_Writer::write( const std::mt19937 & prng )
+{
+    std::ostringstream stream;
+    stream << prng;
+    write( stream.str() );
+}
+
+void Checkpoint_Writer::commit( const std::string & filename ) const
+{
+    const std::string tmp_filename = filename + ".tmp";
+    {
+        std::ofstream file( tmp_filename, std::ios::binary | std::ios::trunc );
+        file.write( buffer.data(), buffer.size() );
+        file.flush();
+        if( !file )
+        {
+            file.close();
+            std::remove( tmp_filename.c_str() );
+            spirit_throw(
+                Utility::Exception_Classifier::File_not_Found, Utility::Log_Level::Error,
+                fmt::format( "Could not write checkpoint \"{}\"", tmp_filename ) );
+        }
+    }
+
+    // A checkpoint which was written before is only replaced by a complete one
+    if( std::rename( tmp_filename.c_str(), filename.c_str() ) != 0 )
+    {
+        std::remove( tmp_filename.c_str() );
+        spirit_throw(
+            Utility::Exception_Classifier::File_not_Found, Utility::Log_Level::Error,
+            fmt::format( "Could not replace checkpoint \"{}\"", filename ) );
+    }
+}
+
+void Checkpoint_Writer::write_bytes( const void * data, std::size_t size )
+{
+    if( size > 0 )
+        buffer.append( static_cast<const char *>( data ), size );
+}
+
+void Checkpoint_Writer::write_size( std::size_t size )
+{
+    write( std::uint64_t( size ) );
+}
+
+// ------------------------------------------------------------------------------------------------
+
+Checkpoint_Reader::Checkpoint_Reader( const std::string & filename ) : filename( filename )
+{
+    std::ifstream file( filename, std::ios::binary );
+    if( !file )
+        spirit_throw(
+            Utility::Exception_Classifier::File_not_Found, Utility::Log_Level::Error,
+            fmt::format( "Could not open checkpoint \"{}\"", filename ) );
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    buffer = contents.str();
+
+    char file_signature[sizeof( signature )];
+    if( buffer.size() < sizeof( signature ) )
+        std::memset( file_signature, 0, sizeof( signature ) );
+    else
+        read_bytes( file_signature, sizeof( signature ) );
+    if( std::memcmp( file_signature, signature, sizeof( signature ) ) != 0 )
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format( "\"{}\" is not a checkpoint file", filename ) );
+
+    std::uint32_t version = 0, order = 0, scalar_size = 0;
+    read( version );
+    read( order );
+    read( scalar_size );
+    if( version != format_version || order != byte_order_mark || scalar_size != sizeof( scalar ) )
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format(
+                "Checkpoint \"{}\" (version {}, {} byte scalars) was not written by this build of Spirit (version {}, "
+                "{} byte scalars, byte order {})",
+                filename, version, scalar_size, format_version, sizeof( scalar ),
+                order == byte_order_mark ? "matching" : "differing" ) );
+
+    std::int32_t solver = 0, noi = 0;
+    std::int64_t nos    = 0;
+    read( header_.method );
+    read( solver );
+    read( noi );
+    read( nos );
+    header_.solver = solver;
+    header_.noi    = noi;
+    header_.nos    = nos;
+}
+
+const Checkpoint_Header & Checkpoint_Reader::header() const
+{
+    return header_;
+}
+
+void Checkpoint_Reader::read( std::string & value )
+{
+    value.resize( read_size() );
+    read_bytes( &value[0], value.size() );
+}
+
+void Checkpoint_Reader::read( std::mt19937 & prng )
+{
+    std::string state;
+    read( state );
+    std::istringstream stream( state );
+    stream >> prng;
+    if( !stream )
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format( "Checkpoint \"{}\" contains an invalid random number generator state", filename ) );
+}
+
+void Checkpoint_Reader::finish() const
+{
+    if( position != buffer.size() )
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format(
+                "Checkpoint \"{}\" contains {} more bytes than were read. Was it written by a different method?",
+                filename, buffer.size() - position ) );
+}
+
+void Checkpoint_Reader::read_bytes( void * data, std::size_t size )
+{
+    if( size > buffer.size() - position )
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format( "Checkpoint \"{}\" ends unexpectedly after {} bytes", filename, buffer.size() ) );
+    if( size > 0 )
+        std::memcpy( data, buffer.data() + position, size );
+    position += size;
+}
+
+std::size_t Checkpoint_Reader::read_size()
+{
+    std::uint64_t size = 0;
+    read( size );
+    // A corrupted length must not lead to a huge allocation
+    if( size > buffer.size() - position )
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format( "Checkpoint \"{}\" contains an array which is longer than the file", filename ) );
+    return std::size_t( size );
+}
+
+} // namespace IO
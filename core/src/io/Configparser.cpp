@@ -744,6 +744,8 @@ std::unique_ptr<Data::Parameters_Method_LLG> Parameters_Method_LLG_from_Config(
             // Method parameters
             config_file_handle.Read_Single( str_max_walltime, "llg_max_walltime" );
             parameters->max_walltime_sec = (long int)Utility::Timing::DurationFromString( str_max_walltime ).count();
+            config_file_handle.Read_Single( parameters->checkpoint_interval, "llg_checkpoint_interval" );
+            config_file_handle.Read_Single( parameters->checkpoint_file, "llg_checkpoint_file" );
             config_file_handle.Read_Single( parameters->rng_seed, "llg_seed" );
             parameters->prng = std::mt19937( parameters->rng_seed );
             config_file_handle.Read_Single( parameters->n_iterations, "llg_n_iterations" );
@@ -793,6 +795,8 @@ std::unique_ptr<Data::Parameters_Method_LLG> Parameters_Method_LLG_from_Config(
     parameter_log.emplace_back(
         fmt::format( "    {:<17} = {:e}", "force convergence", parameters->force_convergence ) );
     parameter_log.emplace_back( fmt::format( "    {:<17} = {}", "maximum walltime", str_max_walltime ) );
+    parameter_log.emplace_back(
+        fmt::format( "    {:<17} = {}", "checkpoint interval", parameters->checkpoint_interval ) );
     parameter_log.emplace_back( fmt::format( "    {:<17} = {}", "n_iterations", parameters->n_iterations ) );
     parameter_log.emplace_back( fmt::format( "    {:<17} = {}", "n_iterations_log", parameters->n_iterations_log ) );
     parameter_log.emplace_back(
@@ -952,6 +956,8 @@ std::unique_ptr<Data::Parameters_Method_MC> Parameters_Method_MC_from_Config( co
             // Method parameters
             config_file_handle.Read_Single( str_max_walltime, "mc_max_walltime" );
             parameters->max_walltime_sec = (long int)Utility::Timing::DurationFromString( str_max_walltime ).count();
+            config_file_handle.Read_Single( parameters->checkpoint_interval, "mc_checkpoint_interval" );
+            config_file_handle.Read_Single( parameters->checkpoint_file, "mc_checkpoint_file" );
             config_file_handle.Read_Single( parameters->rng_seed, "mc_seed" );
             parameters->prng = std::mt19937( parameters->rng_seed );
             config_file_handle.Read_Single( parameters->n_iterations, "mc_n_iterations" );
@@ -977,6 +983,8 @@ std::unique_ptr<Data::Parameters_Method_MC> Parameters_Method_MC_from_Config( co
     parameter_log.emplace_back(
         fmt::format( "    {:<17} = {}", "acceptance_ratio", parameters->acceptance_ratio_target ) );
     parameter_log.emplace_back( fmt::format( "    {:<17} = {}", "maximum walltime", str_max_walltime ) );
+    parameter_log.emplace_back(
+        fmt::format( "    {:<17} = {}", "checkpoint interval", parameters->checkpoint_interval ) );
     parameter_log.emplace_back( fmt::format( "    {:<17} = {}", "n_iterations", parameters->n_iterations ) );
     parameter_log.emplace_back( fmt::format( "    {:<17} = {}", "n_iterations_log", parameters->n_iterations_log ) );
     parameter_log.emplace_back(
@@ -1045,6 +1053,8 @@ std::unique_ptr<Data::Parameters_Method_GNEB> Parameters_Method_GNEB_from_Config
             // Method parameters
             config_file_handle.Read_Single( str_max_walltime, "gneb_max_walltime" );
             parameters->max_walltime_sec = (long int)Utility::Timing::DurationFromString( str_max_walltime ).count();
+            config_file_handle.Read_Single( parameters->checkpoint_interval, "gneb_checkpoint_interval" );
+            config_file_handle.Read_Single( parameters->checkpoint_file, "gneb_checkpoint_file" );
             config_file_handle.Read_Single( parameters->spring_constant, "gneb_spring_constant" );
             config_file_handle.Read_Single( parameters->force_convergence, "gneb_force_convergence" );
             config_file_handle.Read_Single( parameters->n_iterations, "gneb_n_iterations" );
@@ -1074,6 +1084,8 @@ std::unique_ptr<Data::Parameters_Method_GNEB> Parameters_Method_GNEB_from_Config
     parameter_log.emplace_back(
         fmt::format( "    {:<18} = {:e}", "force convergence", parameters->force_convergence ) );
     parameter_log.emplace_back( fmt::format( "    {:<18} = {}", "maximum walltime", str_max_walltime ) );
+    parameter_log.emplace_back(
+        fmt::format( "    {:<18} = {}", "checkpoint interval", parameters->checkpoint_interval ) );
     parameter_log.emplace_back( fmt::format( "    {:<18} = {}", "n_iterations", parameters->n_iterations ) );
     parameter_log.emplace_back( fmt::format( "    {:<18} = {}", "n_iterations_log", parameters->n_iterations_log ) );
     parameter_log.emplace_back(
@@ -1142,6 +1154,8 @@ std::unique_ptr<Data::Parameters_Method_MMF> Parameters_Method_MMF_from_Config(
             // Method parameters
             config_file_handle.Read_Single( str_max_walltime, "mmf_max_walltime" );
             parameters->max_walltime_sec = (long int)Utility::Timing::DurationFromString( str_max_walltime ).count();
+            config_file_handle.Read_Single( parameters->checkpoint_interval, "mmf_checkpoint_interval" );
+            config_file_handle.Read_Single( parameters->checkpoint_file, "mmf_checkpoint_file" );
             config_file_handle.Read_Single( parameters->force_convergence, "mmf_force_convergence" );
             config_file_handle.Read_Single( parameters->n_iterations, "mmf_n_iterations" );
             config_file_handle.Read_Single( parameters->n_iterations_log, "mmf_n_iterations_log" );
@@ -1164,6 +1178,8 @@ std::unique_ptr<Data::Parameters_Method_MMF> Parameters_Method_MMF_from_Config(
     parameter_log.emplace_back(
         fmt::format( "    {:<17} = {:e}", "force convergence", parameters->force_convergence ) );
     parameter_log.emplace_back( fmt::format( "    {:<17} = {}", "maximum walltime", str_max_walltime ) );
+    parameter_log.emplace_back(
+        fmt::format( "    {:<17} = {}", "checkpoint interval", parameters->checkpoint_interval ) );
     parameter_log.emplace_back( fmt::format( "    {:<17} = {}", "n_iterations", parameters->n_iterations ) );
     parameter_log.emplace_back( fmt::format( "    {:<17} = {}", "n_iterations_log", parameters->n_iterations_log ) );
     parameter_log.emplace_back(
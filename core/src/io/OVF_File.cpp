@@ -1,6 +1,8 @@
 #include <io/OVF_File.hpp>
 #include <utility/Exception.hpp>
 
+#include <limits>
+
 namespace IO
 {
 
@@ -15,6 +17,12 @@ OVF_Segment::OVF_Segment( const Data::Spin_System & system )
 
     auto & geometry = *system.geometry;
 
+    // The OVF library counts the values of a segment with an int
+    if( geometry.nos > std::numeric_limits<int>::max() / 3 )
+        spirit_throw(
+            Utility::Exception_Classifier::Not_Implemented, Utility::Log_Level::Error,
+            fmt::format( "The {} spins of the system are too many to be written to an OVF file", geometry.nos ) );
+
     this->valuedim      = 0;
     this->valuelabels   = const_cast<char *>( "" );
     this->valueunits    = const_cast<char *>( "" );
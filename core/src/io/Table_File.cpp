@@ -0,0 +1,372 @@
+#include <io/Table_File.hpp>
+#include <utility/Exception.hpp>
+#include <utility/Logging.hpp>
+
+#include <fmt/format.h>
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <locale>
+#include <sstream>
+
+namespace IO
+{
+
+namespace
+{
+
+inline bool is_separator( char c )
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == ',' || c == '|' || c == '\v' || c == '\f';
+}
+
+// Exactly representable powers of ten
+const double powers_of_ten[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+/*
+ * Parses a number. Mantissas of up to 15 digits with small exponents are converted exactly (the
+ * result is correctly rounded, as both factors are exactly representable), everything else is
+ * passed on to a stream with the classic locale.
+ */
+bool parse_number( const char * begin, const char * end, double & value )
+{
+    const char * c = begin;
+    bool negative  = false;
+    if( c < end && ( *c == '-' || *c == '+' ) )
+    {
+        negative = *c == '-';
+        ++c;
+    }
+
+    std::uint64_t mantissa = 0;
+    int n_digits           = 0;
+    int exponent           = 0;
+    bool any_digit         = false;
+
+    for( ; c < end && *c >= '0' && *c <= '9'; ++c )
+    {
+        any_digit = true;
+        if( mantissa == 0 && *c == '0' )
+            continue;
+        if( n_digits < 19 )
+        {
+            mantissa = 10 * mantissa + ( *c - '0' );
+            ++n_digits;
+        }
+        else
+            ++exponent;
+    }
+    if( c < end && *c == '.' )
+    {
+        for( ++c; c < end && *c >= '0' && *c <= '9'; ++c )
+        {
+            any_digit = true;
+            if( mantissa == 0 && *c == '0' )
+            {
+                --exponent;
+                continue;
+            }
+            if( n_digits < 19 )
+            {
+                mantissa = 10 * mantissa + ( *c - '0' );
+                ++n_digits;
+                --exponent;
+            }
+        }
+    }
+    if( !any_digit )
+        return false;
+
+    if( c < end && ( *c == 'e' || *c == 'E' ) )
+    {
+        ++c;
+        bool negative_exponent = false;
+        if( c < end && ( *c == '-' || *c == '+' ) )
+        {
+            negative_exponent = *c == '-';
+            ++c;
+        }
+        if( c == end || *c < '0' || *c > '9' )
+            return false;
+        int explicit_exponent = 0;
+        for( ; c < end && *c >= '0' && *c <= '9'; ++c )
+        {
+            if( explicit_exponent < 100000 )
+                explicit_exponent = 10 * explicit_exponent + ( *c - '0' );
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+    if( c != end )
+        return false;
+
+    if( mantissa == 0 )
+    {
+        value = negative ? -0.0 : 0.0;
+        return true;
+    }
+
+    if( n_digits <= 15 && exponent >= -22 && exponent <= 22 )
+    {
+        value = static_cast<double>( mantissa );
+        if( exponent < 0 )
+            value /= powers_of_ten[-exponent];
+        else
+            value *= powers_of_ten[exponent];
+        if( negative )
+            value = -value;
+        return true;
+    }
+
+    // Slow path
+    std::istringstream stream( std::string( begin, end ) );
+    stream.imbue( std::locale::classic() );
+    stream >> value;
+    return !stream.fail();
+}
+
+template<typename F>
+void for_each_word( const char * c, const char * end, F && f )
+{
+    while( c < end )
+    {
+        while( c < end && is_separator( *c ) )
+            ++c;
+        const char * word_begin = c;
+        while( c < end && !is_separator( *c ) )
+            ++c;
+        if( c > word_begin && !f( word_begin, c ) )
+            return;
+    }
+}
+
+} // namespace
+
+Table_File::Table_File( const std::string & filename, const std::string & comment_tag ) : filename( filename )
+{
+    std::ifstream stream( filename, std::ios::in | std::ios::binary );
+    if( !stream.is_open() )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::File_not_Found, Utility::Log_Level::Error,
+            fmt::format( "Could not open file \"{}\"", filename ) );
+    }
+    stream.seekg( 0, std::ios::end );
+    const std::size_t size = stream.tellg();
+    stream.seekg( 0, std::ios::beg );
+    this->contents.resize( size );
+    if( size > 0 && !stream.read( &this->contents[0], size ) )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format( "Could not read file \"{}\"", filename ) );
+    }
+
+    // Split into lines. Each chunk takes the lines which start inside of it.
+    const std::size_t chunk_size = 1 << 22;
+    const std::int64_t n_chunks  = ( size + chunk_size - 1 ) / chunk_size;
+    std::vector<std::vector<Line>> chunk_lines( n_chunks );
+    const char * data = this->contents.data();
+
+#pragma omp parallel for
+    for( std::int64_t ichunk = 0; ichunk < n_chunks; ++ichunk )
+    {
+        const char * chunk_begin = data + ichunk * chunk_size;
+        const char * chunk_end   = data + std::min( size, ( ichunk + 1 ) * chunk_size );
+        const char * file_end    = data + size;
+
+        const char * line_begin = chunk_begin;
+        if( ichunk > 0 && *( chunk_begin - 1 ) != '\n' )
+        {
+            line_begin = static_cast<const char *>( std::memchr( chunk_begin, '\n', file_end - chunk_begin ) );
+            line_begin = line_begin ? line_begin + 1 : file_end;
+        }
+
+        auto & local_lines = chunk_lines[ichunk];
+        while( line_begin < chunk_end )
+        {
+            const char * line_end = static_cast<const char *>( std::memchr( line_begin, '\n', file_end - line_begin ) );
+            if( !line_end )
+                line_end = file_end;
+
+            // Remove comments
+            const char * comment
+                = comment_tag.empty() ? line_end :
+                                        std::search( line_begin, line_end, comment_tag.begin(), comment_tag.end() );
+
+            // Keep only lines containing something other than separators
+            if( comment != line_begin && std::any_of( line_begin, comment, []( char c ) { return !is_separator( c ); } ) )
+                local_lines.push_back( { line_begin, comment } );
+
+            line_begin = line_end + 1;
+        }
+    }
+
+    std::size_t n_lines = 0;
+    for( const auto & local_lines : chunk_lines )
+        n_lines += local_lines.size();
+    this->lines.reserve( n_lines );
+    for( const auto & local_lines : chunk_lines )
+        this->lines.insert( this->lines.end(), local_lines.begin(), local_lines.end() );
+}
+
+std::size_t Table_File::n_lines() const
+{
+    return this->lines.size();
+}
+
+std::ptrdiff_t Table_File::find( const std::string & keyword ) const
+{
+    for( std::size_t iline = 0; iline < this->lines.size(); ++iline )
+    {
+        const auto & line = this->lines[iline];
+        if( std::size_t( line.end - line.begin ) < keyword.size() )
+            continue;
+        if( std::equal(
+                keyword.begin(), keyword.end(), line.begin,
+                []( unsigned char a, unsigned char b ) { return std::tolower( a ) == std::tolower( b ); } ) )
+            return iline;
+    }
+    return -1;
+}
+
+std::vector<std::string> Table_File::words( std::size_t line ) const
+{
+    std::vector<std::string> result;
+    for_each_word(
+        this->lines[line].begin, this->lines[line].end,
+        [&]( const char * begin, const char * end )
+        {
+            std::string word( begin, end );
+            word.erase( std::remove( word.begin(), word.end(), '+' ), word.end() );
+            if( !word.empty() )
+                result.push_back( word );
+            return true;
+        } );
+    return result;
+}
+
+std::size_t Table_File::read_numbers( std::size_t line, std::size_t n_values, double * values ) const
+{
+    std::size_t n_found = 0;
+    for_each_word(
+        this->lines[line].begin, this->lines[line].end,
+        [&]( const char * begin, const char * end )
+        {
+            if( n_found >= n_values )
+                return false;
+            if( !parse_number( begin, end, values[n_found] ) )
+                values[n_found] = 0;
+            ++n_found;
+            return true;
+        } );
+    for( std::size_t i = n_found; i < n_values; ++i )
+        values[i] = 0;
+    return n_found;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+const char cache_signature[8]               = { 'S', 'P', 'I', 'R', 'I', 'T', 'C', 'A' };
+constexpr std::uint32_t cache_format_version = 1;
+
+void fnv1a( std::uint64_t & hash, const void * data, std::size_t n_bytes )
+{
+    const auto * bytes = static_cast<const unsigned char *>( data );
+    for( std::size_t i = 0; i < n_bytes; ++i )
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+} // namespace
+
+Table_Cache::Table_Cache( const std::string & source_file, const std::string & kind, std::uint64_t key )
+        : filename( source_file + "." + kind + ".cache" ), kind( kind ), key( key )
+{
+    struct stat info;
+    this->source_found = stat( source_file.c_str(), &info ) == 0;
+    this->source_size  = this->source_found ? info.st_size : 0;
+    this->source_mtime = this->source_found ? info.st_mtime : 0;
+}
+
+bool Table_Cache::read_header( std::ifstream & stream ) const
+{
+    if( !this->source_found )
+        return false;
+
+    char signature[8];
+    std::uint32_t version = 0, scalar_size = 0, kind_size = 0;
+    std::uint64_t size = 0, key = 0;
+    std::int64_t mtime = 0;
+    if( !stream.read( signature, 8 ) || std::memcmp( signature, cache_signature, 8 ) != 0 )
+        return false;
+    stream.read( reinterpret_cast<char *>( &version ), sizeof( version ) );
+    stream.read( reinterpret_cast<char *>( &scalar_size ), sizeof( scalar_size ) );
+    stream.read( reinterpret_cast<char *>( &size ), sizeof( size ) );
+    stream.read( reinterpret_cast<char *>( &mtime ), sizeof( mtime ) );
+    stream.read( reinterpret_cast<char *>( &key ), sizeof( key ) );
+    stream.read( reinterpret_cast<char *>( &kind_size ), sizeof( kind_size ) );
+    if( !stream.good() || kind_size != this->kind.size() )
+        return false;
+    std::string kind( kind_size, ' ' );
+    stream.read( &kind[0], kind_size );
+
+    return stream.good() && version == cache_format_version && scalar_size == sizeof( scalar )
+           && size == this->source_size && mtime == this->source_mtime && key == this->key && kind == this->kind;
+}
+
+void Table_Cache::write_header( std::ofstream & stream ) const
+{
+    const std::uint32_t version     = cache_format_version;
+    const std::uint32_t scalar_size = sizeof( scalar );
+    const std::uint32_t kind_size   = this->kind.size();
+    stream.write( cache_signature, 8 );
+    stream.write( reinterpret_cast<const char *>( &version ), sizeof( version ) );
+    stream.write( reinterpret_cast<const char *>( &scalar_size ), sizeof( scalar_size ) );
+    stream.write( reinterpret_cast<const char *>( &this->source_size ), sizeof( this->source_size ) );
+    stream.write( reinterpret_cast<const char *>( &this->source_mtime ), sizeof( this->source_mtime ) );
+    stream.write( reinterpret_cast<const char *>( &this->key ), sizeof( this->key ) );
+    stream.write( reinterpret_cast<const char *>( &kind_size ), sizeof( kind_size ) );
+    stream.write( this->kind.data(), kind_size );
+}
+
+void Table_Cache::finish_store( const std::string & tmp_filename ) const
+{
+    // Renaming makes sure that a concurrently running process never sees an incomplete cache
+    std::remove( this->filename.c_str() );
+    if( std::rename( tmp_filename.c_str(), this->filename.c_str() ) != 0 )
+    {
+        std::remove( tmp_filename.c_str() );
+        return;
+    }
+    Log( Utility::Log_Level::Debug, Utility::Log_Sender::IO, fmt::format( "Wrote cache file \"{}\"", this->filename ) );
+}
+
+std::uint64_t Table_Cache::remaining_bytes( std::ifstream & stream )
+{
+    const auto position = stream.tellg();
+    stream.seekg( 0, std::ios::end );
+    const auto end = stream.tellg();
+    stream.seekg( position );
+    return static_cast<std::uint64_t>( end - position );
+}
+
+std::uint64_t cache_key( scalar lattice_constant, const std::vector<Vector3> & bravais_vectors )
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    fnv1a( hash, &lattice_constant, sizeof( lattice_constant ) );
+    for( const auto & vector : bravais_vectors )
+        fnv1a( hash, vector.data(), 3 * sizeof( scalar ) );
+    return hash;
+}
+
+} // namespace IO
@@ -0,0 +1,593 @@
+#include <io/Trajectory_File.hpp>
+#include <utility/Constants.hpp>
+#include <utility/Exception.hpp>
+#include <utility/Logging.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace IO
+{
+
+namespace
+{
+
+const char file_signature[8]  = { 'S', 'P', 'I', 'R', 'I', 'T', 'T', 'R' };
+const char frame_signature[4] = { 'F', 'R', 'M', 'E' };
+
+constexpr std::uint32_t format_version = 1;
+// signature, version, encoding, value size, valuedim, nos
+constexpr std::size_t file_header_size = 8 + 4 + 4 + 4 + 4 + 8;
+// signature, iteration, n_blocks
+constexpr std::size_t frame_header_size = 4 + 8 + 4;
+
+constexpr std::uint8_t block_stored     = 0;
+constexpr std::uint8_t block_compressed = 1;
+
+// ------------------------------------------------------------------------------------------------
+
+bool is_little_endian()
+{
+    const std::uint16_t value = 1;
+    std::uint8_t first_byte;
+    std::memcpy( &first_byte, &value, 1 );
+    return first_byte == 1;
+}
+
+void put_u32( std::string & out, std::uint32_t value )
+{
+    for( int i = 0; i < 4; ++i )
+        out.push_back( static_cast<char>( ( value >> ( 8 * i ) ) & 0xFF ) );
+}
+
+void put_u64( std::string & out, std::uint64_t value )
+{
+    for( int i = 0; i < 8; ++i )
+        out.push_back( static_cast<char>( ( value >> ( 8 * i ) ) & 0xFF ) );
+}
+
+std::uint32_t get_u32( const char * bytes )
+{
+    std::uint32_t value = 0;
+    for( int i = 0; i < 4; ++i )
+        value |= std::uint32_t( static_cast<std::uint8_t>( bytes[i] ) ) << ( 8 * i );
+    return value;
+}
+
+std::uint64_t get_u64( const char * bytes )
+{
+    std::uint64_t value = 0;
+    for( int i = 0; i < 8; ++i )
+        value |= std::uint64_t( static_cast<std::uint8_t>( bytes[i] ) ) << ( 8 * i );
+    return value;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+/*
+ * Byte-shuffle: byte k (in order of significance) of all values is stored contiguously.
+ * The bytes of the exponent and of the upper mantissa of smooth fields are then highly repetitive.
+ */
+void shuffle( const std::uint8_t * in, std::size_t n_values, std::size_t value_size, std::uint8_t * out )
+{
+    const bool little = is_little_endian();
+    for( std::size_t k = 0; k < value_size; ++k )
+    {
+        const std::size_t k_mem = little ? k : value_size - 1 - k;
+        for( std::size_t i = 0; i < n_values; ++i )
+            out[k * n_values + i] = in[i * value_size + k_mem];
+    }
+}
+
+void unshuffle( const std::uint8_t * in, std::size_t n_values, std::size_t value_size, std::uint8_t * out )
+{
+    const bool little = is_little_endian();
+    for( std::size_t k = 0; k < value_size; ++k )
+    {
+        const std::size_t k_mem = little ? k : value_size - 1 - k;
+        for( std::size_t i = 0; i < n_values; ++i )
+            out[i * value_size + k_mem] = in[k * n_values + i];
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+
+constexpr std::size_t lz_min_match  = 4;
+constexpr int lz_hash_bits          = 16;
+constexpr std::size_t lz_max_offset = 65535;
+
+void lz_put_length( std::string & out, std::size_t length )
+{
+    while( length >= 255 )
+    {
+        out.push_back( static_cast<char>( 255 ) );
+        length -= 255;
+    }
+    out.push_back( static_cast<char>( length ) );
+}
+
+void lz_put_sequence(
+    std::string & out, const std::uint8_t * literals, std::size_t n_literals, std::size_t offset,
+    std::size_t match_length )
+{
+    const std::size_t match_code = match_length > 0 ? match_length - lz_min_match : 0;
+    const std::uint8_t token     = static_cast<std::uint8_t>(
+        ( std::min<std::size_t>( n_literals, 15 ) << 4 ) | std::min<std::size_t>( match_code, 15 ) );
+    out.push_back( static_cast<char>( token ) );
+    if( n_literals >= 15 )
+        lz_put_length( out, n_literals - 15 );
+    out.append( reinterpret_cast<const char *>( literals ), n_literals );
+    if( match_length > 0 )
+    {
+        out.push_back( static_cast<char>( offset & 0xFF ) );
+        out.push_back( static_cast<char>( ( offset >> 8 ) & 0xFF ) );
+        if( match_code >= 15 )
+            lz_put_length( out, match_code - 15 );
+    }
+}
+
+// Greedy LZ77 compression with a single-entry hash table, producing an LZ4-style block format
+void lz_compress( const std::uint8_t * in, std::size_t n, std::string & out )
+{
+    std::vector<std::int64_t> table( std::size_t( 1 ) << lz_hash_bits, -1 );
+    std::size_t anchor = 0;
+    std::size_t i      = 0;
+    // As in LZ4, the search step grows while no matches are found, so that incompressible
+    // data (e.g. the low mantissa bytes of noisy values) is skipped quickly
+    std::size_t n_misses = 0;
+
+    while( i + lz_min_match <= n )
+    {
+        std::uint32_t sequence;
+        std::memcpy( &sequence, in + i, 4 );
+        const std::size_t hash = ( sequence * 2654435761u ) >> ( 32 - lz_hash_bits );
+        const std::int64_t ref = table[hash];
+        table[hash]            = i;
+
+        if( ref >= 0 && i - ref <= lz_max_offset && std::memcmp( in + ref, in + i, lz_min_match ) == 0 )
+        {
+            std::size_t length = lz_min_match;
+            while( i + length < n && in[ref + length] == in[i + length] )
+                ++length;
+            lz_put_sequence( out, in + anchor, i - anchor, i - ref, length );
+            i += length;
+            anchor   = i;
+            n_misses = 0;
+        }
+        else
+            i += 1 + ( n_misses++ >> 6 );
+    }
+
+    if( anchor < n )
+        lz_put_sequence( out, in + anchor, n - anchor, 0, 0 );
+}
+
+void lz_decompress( const std::uint8_t * in, std::size_t n_in, std::uint8_t * out, std::size_t n_out )
+{
+    auto corrupt = []()
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            "Compressed trajectory block is corrupt" );
+    };
+
+    auto get_length = [&]( std::size_t & ip, std::size_t length )
+    {
+        std::uint8_t byte = 255;
+        while( byte == 255 )
+        {
+            if( ip >= n_in )
+                corrupt();
+            byte = in[ip++];
+            length += byte;
+        }
+        return length;
+    };
+
+    std::size_t ip = 0;
+    std::size_t op = 0;
+    while( ip < n_in )
+    {
+        const std::uint8_t token = in[ip++];
+
+        std::size_t n_literals = token >> 4;
+        if( n_literals == 15 )
+            n_literals = get_length( ip, n_literals );
+        if( ip + n_literals > n_in || op + n_literals > n_out )
+            corrupt();
+        std::memcpy( out + op, in + ip, n_literals );
+        ip += n_literals;
+        op += n_literals;
+
+        if( ip == n_in )
+            break;
+
+        if( ip + 2 > n_in )
+            corrupt();
+        const std::size_t offset = in[ip] | ( std::size_t( in[ip + 1] ) << 8 );
+        ip += 2;
+        std::size_t length = token & 0x0F;
+        if( length == 15 )
+            length = get_length( ip, length );
+        length += lz_min_match;
+        if( offset == 0 || offset > op || op + length > n_out )
+            corrupt();
+        if( offset >= length )
+        {
+            std::memcpy( out + op, out + op - offset, length );
+            op += length;
+        }
+        else
+        {
+            // The match overlaps the output, so it is copied byte by byte
+            for( std::size_t j = 0; j < length; ++j, ++op )
+                out[op] = out[op - offset];
+        }
+    }
+
+    if( op != n_out )
+        corrupt();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void quantise( const Vector3 * vectors, std::size_t n, std::uint8_t * out )
+{
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        const Vector3 & v       = vectors[i];
+        const scalar norm       = v.norm();
+        std::uint16_t values[2] = { 0, 0 };
+        if( norm > 1e-12 )
+        {
+            const scalar theta = std::acos( std::max<scalar>( -1, std::min<scalar>( 1, v[2] / norm ) ) );
+            const scalar phi   = std::atan2( v[1], v[0] );
+            values[0]          = static_cast<std::uint16_t>( std::lround( theta / Utility::Constants::Pi * 65535 ) );
+            values[1]          = static_cast<std::uint16_t>(
+                std::lround( ( phi + Utility::Constants::Pi ) / ( 2 * Utility::Constants::Pi ) * 65536 ) & 0xFFFF );
+        }
+        std::memcpy( out + 4 * i, values, 4 );
+    }
+}
+
+void dequantise( const std::uint8_t * in, std::size_t n, Vector3 * vectors )
+{
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        std::uint16_t values[2];
+        std::memcpy( values, in + 4 * i, 4 );
+        const scalar theta = values[0] * Utility::Constants::Pi / 65535;
+        const scalar phi   = values[1] * 2 * Utility::Constants::Pi / 65536 - Utility::Constants::Pi;
+        vectors[i] = { std::sin( theta ) * std::cos( phi ), std::sin( theta ) * std::sin( phi ), std::cos( theta ) };
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+
+Trajectory_File::Trajectory_File( const std::string & filename, bool should_exist )
+        : filename( filename ), file_encoding( 0 ), value_size( 0 ), file_nos( 0 )
+{
+    if( is_trajectory_file( filename ) )
+        this->read_index();
+    else if( should_exist )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::File_not_Found, Utility::Log_Level::Error,
+            fmt::format( "Unable to open trajectory file \"{}\", are you sure it exists?", filename ) );
+    }
+}
+
+bool Trajectory_File::is_trajectory_file( const std::string & filename )
+{
+    std::ifstream stream( filename, std::ios::binary );
+    char signature[8];
+    if( !stream.read( signature, 8 ) )
+        return false;
+    return std::memcmp( signature, file_signature, 8 ) == 0;
+}
+
+bool Trajectory_File::found() const
+{
+    return this->file_found;
+}
+
+int Trajectory_File::n_frames() const
+{
+    return static_cast<int>( this->frames.size() );
+}
+
+int Trajectory_File::nos() const
+{
+    return static_cast<int>( this->file_nos );
+}
+
+std::int64_t Trajectory_File::frame_iteration( int index ) const
+{
+    return this->frames.at( index ).iteration;
+}
+
+Trajectory_Encoding Trajectory_File::encoding() const
+{
+    return static_cast<Trajectory_Encoding>( this->file_encoding );
+}
+
+void Trajectory_File::read_index()
+{
+    std::ifstream stream( this->filename, std::ios::binary );
+
+    char header[file_header_size];
+    if( !stream.read( header, file_header_size ) || std::memcmp( header, file_signature, 8 ) != 0 )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format( "File \"{}\" is not a Spirit trajectory file", this->filename ) );
+    }
+
+    std::uint32_t version = get_u32( header + 8 );
+    if( version != format_version )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format( "Trajectory file \"{}\" has unsupported version {}", this->filename, version ) );
+    }
+    this->file_encoding = get_u32( header + 12 );
+    this->value_size    = get_u32( header + 16 );
+    this->file_nos      = get_u64( header + 24 );
+    this->file_found    = true;
+    this->frames.clear();
+
+    // Hop from frame header to frame header. An incomplete frame at the end (e.g. from
+    // a simulation that was killed while writing) is ignored.
+    stream.seekg( 0, std::ios::end );
+    const std::uint64_t file_size = stream.tellg();
+    std::uint64_t offset          = file_header_size;
+    while( offset + frame_header_size <= file_size )
+    {
+        char frame_header[frame_header_size];
+        stream.seekg( offset );
+        if( !stream.read( frame_header, frame_header_size ) || std::memcmp( frame_header, frame_signature, 4 ) != 0 )
+            break;
+
+        Frame_Entry entry;
+        entry.iteration       = static_cast<std::int64_t>( get_u64( frame_header + 4 ) );
+        std::uint32_t n_blocks = get_u32( frame_header + 12 );
+
+        std::vector<char> sizes( 4 * std::size_t( n_blocks ) );
+        if( !stream.read( sizes.data(), sizes.size() ) )
+            break;
+        entry.block_sizes.resize( n_blocks );
+        std::uint64_t frame_size = 0;
+        for( std::uint32_t i = 0; i < n_blocks; ++i )
+        {
+            entry.block_sizes[i] = get_u32( sizes.data() + 4 * i );
+            frame_size += entry.block_sizes[i];
+        }
+        entry.offset = offset + frame_header_size + sizes.size();
+
+        if( entry.offset + frame_size > file_size )
+        {
+            Log( Utility::Log_Level::Warning, Utility::Log_Sender::IO,
+                 fmt::format(
+                     "Trajectory file \"{}\": frame {} is incomplete and will be ignored", this->filename,
+                     this->frames.size() ) );
+            break;
+        }
+
+        offset = entry.offset + frame_size;
+        this->frames.push_back( std::move( entry ) );
+    }
+}
+
+void Trajectory_File::write_frame( const vectorfield & vf, std::int64_t iteration, Trajectory_Encoding encoding )
+{
+    this->write( vf, iteration, encoding, false );
+}
+
+void Trajectory_File::append_frame( const vectorfield & vf, std::int64_t iteration, Trajectory_Encoding encoding )
+{
+    if( !this->file_found )
+    {
+        std::ifstream stream( this->filename, std::ios::binary );
+        if( stream.good() && stream.peek() != std::ifstream::traits_type::eof() )
+        {
+            spirit_throw(
+                Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+                fmt::format( "Cannot append to non-trajectory file \"{}\"", this->filename ) );
+        }
+    }
+    this->write( vf, iteration, encoding, this->file_found );
+}
+
+void Trajectory_File::write(
+    const vectorfield & vf, std::int64_t iteration, Trajectory_Encoding encoding, bool append )
+{
+    const std::uint32_t new_value_size
+        = encoding == Trajectory_Encoding::Quantised ? sizeof( std::uint16_t ) : sizeof( scalar );
+    const std::uint32_t values_per_vector = encoding == Trajectory_Encoding::Quantised ? 2 : 3;
+
+    if( append
+        && ( this->file_encoding != std::uint32_t( encoding ) || this->value_size != new_value_size
+             || this->file_nos != vf.size() ) )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format(
+                "Cannot append to trajectory file \"{}\": encoding or number of vectors does not match",
+                this->filename ) );
+    }
+
+    // Compress the blocks independently
+    const std::size_t nos      = vf.size();
+    const std::size_t n_blocks = ( nos + n_vectors_per_block - 1 ) / n_vectors_per_block;
+    std::vector<std::string> blocks( n_blocks );
+
+#pragma omp parallel for
+    for( std::int64_t iblock = 0; iblock < std::int64_t( n_blocks ); ++iblock )
+    {
+        const std::size_t begin    = iblock * n_vectors_per_block;
+        const std::size_t n        = std::min<std::size_t>( n_vectors_per_block, nos - begin );
+        const std::size_t n_values = n * values_per_vector;
+        const std::size_t n_bytes  = n_values * new_value_size;
+
+        std::vector<std::uint8_t> raw( n_bytes );
+        std::vector<std::uint8_t> shuffled( n_bytes );
+        if( encoding == Trajectory_Encoding::Quantised )
+            quantise( &vf[begin], n, raw.data() );
+        else
+            std::memcpy( raw.data(), vf[begin].data(), n_bytes );
+        shuffle( raw.data(), n_values, new_value_size, shuffled.data() );
+
+        std::string & block = blocks[iblock];
+        block.reserve( n_bytes + n_bytes / 255 + 16 );
+        block.push_back( static_cast<char>( block_compressed ) );
+        lz_compress( shuffled.data(), n_bytes, block );
+        if( block.size() > n_bytes + 1 )
+        {
+            block.clear();
+            block.push_back( static_cast<char>( block_stored ) );
+            block.append( reinterpret_cast<const char *>( shuffled.data() ), n_bytes );
+        }
+    }
+
+    // Assemble the frame header
+    std::string frame_header;
+    frame_header.append( frame_signature, 4 );
+    put_u64( frame_header, static_cast<std::uint64_t>( iteration ) );
+    put_u32( frame_header, static_cast<std::uint32_t>( n_blocks ) );
+    for( auto & block : blocks )
+        put_u32( frame_header, static_cast<std::uint32_t>( block.size() ) );
+
+    std::ofstream stream;
+    std::uint64_t offset = 0;
+    if( append )
+    {
+        stream.open( this->filename, std::ios::binary | std::ios::app );
+        offset = this->frames.empty() ? file_header_size :
+                                        this->frames.back().offset
+                                            + std::accumulate(
+                                                this->frames.back().block_sizes.begin(),
+                                                this->frames.back().block_sizes.end(), std::uint64_t( 0 ) );
+    }
+    else
+    {
+        stream.open( this->filename, std::ios::binary | std::ios::trunc );
+        std::string file_header;
+        file_header.append( file_signature, 8 );
+        put_u32( file_header, format_version );
+        put_u32( file_header, static_cast<std::uint32_t>( encoding ) );
+        put_u32( file_header, new_value_size );
+        put_u32( file_header, 3 );
+        put_u64( file_header, nos );
+        stream.write( file_header.data(), file_header.size() );
+        offset = file_header_size;
+
+        this->frames.clear();
+        this->file_encoding = static_cast<std::uint32_t>( encoding );
+        this->value_size    = new_value_size;
+        this->file_nos      = nos;
+    }
+
+    if( !stream.good() )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::File_not_Found, Utility::Log_Level::Error,
+            fmt::format( "Unable to open trajectory file \"{}\" for writing", this->filename ) );
+    }
+
+    stream.write( frame_header.data(), frame_header.size() );
+    for( auto & block : blocks )
+        stream.write( block.data(), block.size() );
+    stream.close();
+
+    Frame_Entry entry;
+    entry.iteration = iteration;
+    entry.offset    = offset + frame_header.size();
+    for( auto & block : blocks )
+        entry.block_sizes.push_back( static_cast<std::uint32_t>( block.size() ) );
+    this->frames.push_back( std::move( entry ) );
+    this->file_found = true;
+}
+
+void Trajectory_File::read_frame( int index, vectorfield & vf ) const
+{
+    if( index < 0 || index >= this->n_frames() )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format(
+                "Trajectory file \"{}\" contains {} frames, cannot read frame {}", this->filename, this->n_frames(),
+                index ) );
+    }
+
+    const bool quantised = this->encoding() == Trajectory_Encoding::Quantised;
+    if( ( quantised && this->value_size != sizeof( std::uint16_t ) )
+        || ( !quantised && this->value_size != sizeof( scalar ) ) )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format(
+                "Trajectory file \"{}\" contains values of size {}, which does not match the precision of Spirit",
+                this->filename, this->value_size ) );
+    }
+    const std::size_t values_per_vector = quantised ? 2 : 3;
+
+    const auto & entry = this->frames[index];
+    std::uint64_t compressed_size
+        = std::accumulate( entry.block_sizes.begin(), entry.block_sizes.end(), std::uint64_t( 0 ) );
+
+    std::vector<char> compressed( compressed_size );
+    std::ifstream stream( this->filename, std::ios::binary );
+    stream.seekg( entry.offset );
+    if( !stream.read( compressed.data(), compressed.size() ) )
+    {
+        spirit_throw(
+            Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+            fmt::format( "Unable to read frame {} from trajectory file \"{}\"", index, this->filename ) );
+    }
+
+    std::vector<std::uint64_t> block_offsets( entry.block_sizes.size(), 0 );
+    for( std::size_t i = 1; i < block_offsets.size(); ++i )
+        block_offsets[i] = block_offsets[i - 1] + entry.block_sizes[i - 1];
+
+    const std::size_t nos = std::min<std::size_t>( this->file_nos, vf.size() );
+
+#pragma omp parallel for
+    for( std::int64_t iblock = 0; iblock < std::int64_t( entry.block_sizes.size() ); ++iblock )
+    {
+        const std::size_t begin = iblock * n_vectors_per_block;
+        if( begin >= nos )
+            continue;
+        const std::size_t n_file   = std::min<std::size_t>( n_vectors_per_block, this->file_nos - begin );
+        const std::size_t n_values = n_file * values_per_vector;
+        const std::size_t n_bytes  = n_values * this->value_size;
+
+        const auto * block = reinterpret_cast<const std::uint8_t *>( compressed.data() + block_offsets[iblock] );
+        const std::size_t block_size = entry.block_sizes[iblock];
+
+        std::vector<std::uint8_t> shuffled( n_bytes );
+        if( block_size < 1 )
+            continue;
+        if( block[0] == block_stored && block_size == n_bytes + 1 )
+            std::memcpy( shuffled.data(), block + 1, n_bytes );
+        else
+            lz_decompress( block + 1, block_size - 1, shuffled.data(), n_bytes );
+
+        std::vector<std::uint8_t> raw( n_bytes );
+        unshuffle( shuffled.data(), n_values, this->value_size, raw.data() );
+
+        const std::size_t n = std::min<std::size_t>( n_file, nos - begin );
+        if( quantised )
+            dequantise( raw.data(), n, &vf[begin] );
+        else
+            std::memcpy( vf[begin].data(), raw.data(), n * 3 * sizeof( scalar ) );
+    }
+}
+
+} // namespace IO
@@ -25,8 +25,8 @@ namespace Configurations
 
 void filter_to_mask( const vectorfield & spins, const vectorfield & positions, filterfunction filter, intfield & mask )
 {
-    int nos = spins.size();
-    mask    = intfield( nos, 0 );
+    spirit_index nos = spins.size();
+    mask             = intfield( nos, 0 );
 
     for( unsigned int iatom = 0; iatom < mask.size(); ++iatom )
     {
@@ -50,7 +50,7 @@ void Insert( Data::Spin_System & s, const vectorfield & configuration, int shift
 {
     auto & spins     = *s.spins;
     auto & positions = s.geometry->positions;
-    int nos          = s.nos;
+    spirit_index nos = s.nos;
     if( shift < 0 )
         shift += nos;
 
@@ -60,7 +60,7 @@ void Insert( Data::Spin_System & s, const vectorfield & configuration, int shift
         return;
     }
 
-    for( int iatom = 0; iatom < nos; ++iatom )
+    for( spirit_index iatom = 0; iatom < nos; ++iatom )
     {
         if( filter( spins[iatom], positions[iatom] ) )
         {
@@ -87,7 +87,7 @@ void Domain( Data::Spin_System & s, Vector3 v, filterfunction filter )
     auto & spins     = *s.spins;
     auto & positions = s.geometry->positions;
 
-    for( int iatom = 0; iatom < s.nos; ++iatom )
+    for( spirit_index iatom = 0; iatom < s.nos; ++iatom )
     {
         if( filter( spins[iatom], positions[iatom] ) )
         {
@@ -104,7 +104,7 @@ void Random( Data::Spin_System & s, filterfunction filter, bool external )
     auto distribution = std::uniform_real_distribution<scalar>( -1, 1 );
     if( !external )
     {
-        for( int iatom = 0; iatom < s.nos; ++iatom )
+        for( spirit_index iatom = 0; iatom < s.nos; ++iatom )
         {
             if( filter( spins[iatom], positions[iatom] ) )
             {
@@ -115,7 +115,7 @@ void Random( Data::Spin_System & s, filterfunction filter, bool external )
     else
     {
         std::mt19937 prng = std::mt19937( 123456789 );
-        for( int iatom = 0; iatom < s.nos; ++iatom )
+        for( spirit_index iatom = 0; iatom < s.nos; ++iatom )
         {
             if( filter( spins[iatom], positions[iatom] ) )
             {
@@ -173,7 +173,7 @@ void Hopfion( Data::Spin_System & s, Vector3 pos, scalar r, int order, Vector3 n
     {
         scalar tmp;
         scalar d, T, t, F, f;
-        for( int n = 0; n < s.nos; n++ )
+        for( spirit_index n = 0; n < s.nos; n++ )
         {
             // Distance of spin from center
             if( filter( spins[n], positions[n] ) )
@@ -411,7 +411,7 @@ void SpinSpiral(
     {
         Log( Log_Level::Warning, Log_Sender::All, "Got passed invalid type for SS: " + direction_type );
     }
-    for( int iatom = 0; iatom < s.nos; ++iatom )
+    for( spirit_index iatom = 0; iatom < s.nos; ++iatom )
     {
         if( filter( spins[iatom], positions[iatom] ) )
         {
@@ -547,7 +547,7 @@ void SpinSpiral(
         Log( Log_Level::Warning, Log_Sender::All, "Got passed invalid type for SS: " + direction_type );
     }
 
-    for( int iatom = 0; iatom < s.nos; ++iatom )
+    for( spirit_index iatom = 0; iatom < s.nos; ++iatom )
     {
         if( filter( spins[iatom], positions[iatom] ) )
         {
@@ -570,7 +570,7 @@ void Set_Atom_Types( Data::Spin_System & s, int atom_type, filterfunction filter
     auto & geometry  = s.geometry;
     auto & positions = geometry->positions;
 
-    for( int iatom = 0; iatom < s.nos; ++iatom )
+    for( spirit_index iatom = 0; iatom < s.nos; ++iatom )
     {
         if( filter( spins[iatom], positions[iatom] ) )
         {
@@ -588,7 +588,7 @@ void Set_Pinned( Data::Spin_System & s, bool pinned, filterfunction filter )
     auto & positions = geometry->positions;
 
     int unpinned = (int)!pinned;
-    for( int iatom = 0; iatom < s.nos; ++iatom )
+    for( spirit_index iatom = 0; iatom < s.nos; ++iatom )
     {
         if( filter( spins[iatom], positions[iatom] ) )
         {
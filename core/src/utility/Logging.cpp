@@ -11,6 +11,7 @@
 #include <ctime>
 #include <iostream>
 #include <string>
+#include <thread>
 
 namespace Utility
 {
@@ -43,6 +44,17 @@ std::string LogEntryToString( LogEntry entry, bool braces_separators )
     return result;
 }
 
+namespace
+{
+
+// Size of the file buffer above which it is appended to the Log file without waiting for `Append_to_File`
+constexpr std::size_t max_file_buffer_size = 1 << 20;
+
+// Maximum time the sink thread sleeps before checking the queue, in case a notification was missed
+constexpr auto sink_wake_interval = std::chrono::milliseconds( 20 );
+
+} // namespace
+
 LoggingHandler::LoggingHandler()
 {
     if( file_tag == "<time>" )
@@ -51,66 +63,50 @@ LoggingHandler::LoggingHandler()
         file_name = "Log.txt";
     else
         file_name = fmt::format( "Log_{}.txt", file_tag );
+
+#ifdef SPIRIT_USE_THREADS
+    sink_thread = std::thread( &LoggingHandler::Sink_Loop, this );
+#endif
+}
+
+LoggingHandler::~LoggingHandler()
+{
+    if( sink_thread.joinable() )
+    {
+        {
+            std::lock_guard<std::mutex> guard( wake_mutex );
+            stop_sink = true;
+        }
+        wake_condition.notify_one();
+        sink_thread.join();
+    }
+    Process_Queue();
+}
+
+bool LoggingHandler::Accepts( Log_Level level ) const
+{
+    // Error and Severe are always printed
+    return level <= level_console || level <= level_file || level == Log_Level::Error || level == Log_Level::Severe;
 }
 
 void LoggingHandler::Send(
     Log_Level level, Log_Sender sender, const std::string & message, int idx_image, int idx_chain )
 {
-    // Lock mutex because of reallocation (push_back)
-    std::lock_guard<std::mutex> guard( mutex );
+    if( !Accepts( level ) )
+        return;
 
-    // All messages are saved in the Log
     LogEntry entry = { std::chrono::system_clock::now(), sender, level, { message }, idx_image, idx_chain };
-    log_entries.push_back( entry );
-
-    // Increment message count
-    n_entries++;
-    // Increment error count
-    if( level == Log_Level::Error )
-        n_errors++;
-    // Increment warning count
-    if( level == Log_Level::Warning )
-        n_warnings++;
-
-    // Determine message color in console
-    auto color = termcolor::reset;
-    if( level <= Log_Level::Warning )
-        color = termcolor::yellow;
-    if( level <= Log_Level::Error )
-        color = termcolor::red;
-    if( level == Log_Level::All )
-        color = termcolor::reset;
-
-    // If level <= verbosity, we print to console, but Error and Severe are always printed
-    if( ( messages_to_console && level <= level_console ) || level == Log_Level::Error || level == Log_Level::Severe )
-        std::cout << color << LogEntryToString( log_entries.back() ) << termcolor::reset << "\n";
+    Enqueue( entry );
 }
 
 void LoggingHandler::SendBlock(
     Log_Level level, Log_Sender sender, const std::vector<std::string> & messages, int idx_image, int idx_chain )
 {
-    // Lock mutex because of reallocation (push_back)
-    std::lock_guard<std::mutex> guard( mutex );
+    if( !Accepts( level ) )
+        return;
 
-    // All messages are saved in the Log
     LogEntry entry = { std::chrono::system_clock::now(), sender, level, messages, idx_image, idx_chain };
-    log_entries.push_back( entry );
-
-    // Increment message count
-    n_entries++;
-
-    // Determine message color in console
-    auto color = termcolor::reset;
-    if( level <= Log_Level::Warning )
-        color = termcolor::yellow;
-    if( level <= Log_Level::Error )
-        color = termcolor::red;
-    if( level == Log_Level::All )
-        color = termcolor::reset;
-
-    // If level <= verbosity, we print to console, but Error and Severe are always printed
-    if( ( messages_to_console && level <= level_console ) || level == Log_Level::Error || level == Log_Level::Severe )
-        std::cout << color << LogEntryToString( log_entries.back() ) << termcolor::reset << "\n";
+    Enqueue( entry );
 }
 
 void LoggingHandler::operator()(
@@ -125,37 +121,114 @@ void LoggingHandler::operator()(
     SendBlock( level, sender, messages, idx_image, idx_chain );
 }
 
-std::vector<LogEntry> LoggingHandler::GetEntries()
+void LoggingHandler::Enqueue( LogEntry & entry )
 {
-    return log_entries;
+    // Increment message count
+    n_entries++;
+    // Increment error count
+    if( entry.level == Log_Level::Error )
+        n_errors++;
+    // Increment warning count
+    if( entry.level == Log_Level::Warning )
+        n_warnings++;
+
+    // If the queue is full, help processing it, so that no messages are lost
+    while( !queue.try_push( entry ) )
+        Process_Queue();
+
+#ifdef SPIRIT_USE_THREADS
+    wake_condition.notify_one();
+#else
+    Process_Queue();
+#endif
 }
 
-std::vector<LogEntry> LoggingHandler::Filter( Log_Level level, Log_Sender sender, int idx_image, int idx_chain )
+void LoggingHandler::Process_Queue()
 {
-    // Get vector of Log entries
-    auto result = std::vector<LogEntry>();
-    for( const auto & entry : log_entries )
+    std::string file_output;
     {
-        if( ( level == Log_Level::All || level == entry.level )
-            && ( sender == Log_Sender::All || sender == entry.sender )
-            && ( idx_image == -1 || idx_image == entry.idx_image )
-            && ( idx_chain == -1 || idx_chain == entry.idx_chain ) )
+        std::lock_guard<std::mutex> guard( sink_mutex );
+
+        LogEntry entry;
+        while( queue.try_pop( entry ) )
         {
-            if( sender == Log_Sender::All || sender == entry.sender )
+            const auto level = entry.level;
+
+            // If level <= verbosity, we print to console, but Error and Severe are always printed
+            if( ( messages_to_console && level <= level_console ) || level == Log_Level::Error
+                || level == Log_Level::Severe )
             {
-                if( idx_image == -1 || idx_image == entry.idx_image )
-                {
-                    if( idx_chain == -1 || idx_chain == entry.idx_chain )
-                    {
-                        result.push_back( entry );
-                    }
-                }
+                // Determine message color in console
+                auto color = termcolor::reset;
+                if( level <= Log_Level::Warning )
+                    color = termcolor::yellow;
+                if( level <= Log_Level::Error )
+                    color = termcolor::red;
+                if( level == Log_Level::All )
+                    color = termcolor::reset;
+
+                std::cout << color << LogEntryToString( entry ) << termcolor::reset << "\n";
             }
+
+            if( messages_to_file
+                && ( level <= level_file || level == Log_Level::Error || level == Log_Level::Severe ) )
+                file_buffer += fmt::format( "{}\n", LogEntryToString( entry ) );
+
+            history.push_back( std::move( entry ) );
+            while( history.size() > n_entries_max )
+                history.pop_front();
+            ++n_entries_processed;
         }
+
+        // Keep the buffer bounded if the Log is not appended to the file regularly
+        if( file_buffer.size() > max_file_buffer_size )
+            std::swap( file_output, file_buffer );
     }
 
-    // Return
-    return result;
+    // The file is written without holding the lock, as errors during writing are logged
+    if( !file_output.empty() )
+        IO::append_to_file( file_output, output_folder + "/" + file_name );
+}
+
+void LoggingHandler::Sink_Loop()
+{
+    while( true )
+    {
+        bool stop;
+        {
+            std::unique_lock<std::mutex> lock( wake_mutex );
+            wake_condition.wait_for(
+                lock, sink_wake_interval, [&] { return stop_sink || queue.n_popped() != queue.n_pushed(); } );
+            stop = stop_sink;
+        }
+
+        Process_Queue();
+
+        if( stop )
+            return;
+    }
+}
+
+void LoggingHandler::Flush()
+{
+    const std::size_t n_pushed = queue.n_pushed();
+    while( queue.n_popped() < n_pushed )
+    {
+        // Processing is serialised by the sink mutex, so any thread can take part
+        Process_Queue();
+        if( queue.n_popped() < n_pushed )
+            std::this_thread::yield();
+    }
+}
+
+std::vector<LogEntry> LoggingHandler::GetEntries( int * n_entries_total )
+{
+    Flush();
+
+    std::lock_guard<std::mutex> guard( sink_mutex );
+    if( n_entries_total != nullptr )
+        *n_entries_total = n_entries_processed;
+    return std::vector<LogEntry>( history.begin(), history.end() );
 }
 
 void LoggingHandler::Append_to_File()
@@ -167,20 +240,14 @@ void LoggingHandler::Append_to_File()
             Log_Level::Debug, Log_Sender::All,
             fmt::format( "Appending log to file \"{}/{}\"", output_folder, file_name ) );
 
-        // Gather the string
-        std::string logstring = "";
-        int begin_append      = no_dumped;
-        no_dumped             = n_entries;
-        for( int i = begin_append; i < n_entries; ++i )
+        Flush();
+
+        // Append the formatted entries to file
+        std::string logstring;
         {
-            const auto & level = log_entries[i].level;
-            if( level <= level_file || level == Log_Level::Error || level == Log_Level::Severe )
-            {
-                logstring += fmt::format( "{}\n", LogEntryToString( log_entries[i] ) );
-            }
+            std::lock_guard<std::mutex> guard( sink_mutex );
+            std::swap( logstring, file_buffer );
         }
-
-        // Append to file
         IO::append_to_file( logstring, output_folder + "/" + file_name );
     }
     else
@@ -191,7 +258,7 @@ void LoggingHandler::Append_to_File()
     }
 }
 
-// Write the entire Log to file
+// Write the Log entries which are kept in memory to file
 void LoggingHandler::Dump_to_File()
 {
     if( this->messages_to_file )
@@ -201,15 +268,21 @@ void LoggingHandler::Dump_to_File()
             Log_Level::Info, Log_Sender::All,
             fmt::format( "Dumping log to file \"{}/{}\"", output_folder, file_name ) );
 
+        Flush();
+
         // Gather the string
         std::string logstring = "";
-        for( int i = 0; i < n_entries; ++i )
         {
-            auto level = log_entries[i].level;
-            if( level <= level_file || level == Log_Level::Error || level == Log_Level::Severe )
+            std::lock_guard<std::mutex> guard( sink_mutex );
+            for( const auto & entry : history )
             {
-                logstring += fmt::format( "{}\n", LogEntryToString( log_entries[i] ) );
+                auto level = entry.level;
+                if( level <= level_file || level == Log_Level::Error || level == Log_Level::Severe )
+                {
+                    logstring += fmt::format( "{}\n", LogEntryToString( entry ) );
+                }
             }
+            file_buffer.clear();
         }
 
         // Write the string to file
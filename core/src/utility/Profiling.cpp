@@ -0,0 +1,133 @@
+#include <utility/Profiling.hpp>
+
+#include <fmt/format.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace Utility
+{
+namespace Profiling
+{
+
+namespace
+{
+
+// Timings of one thread. Only the owning thread writes to them, so relaxed atomics suffice
+// to read them from other threads without a data race.
+struct Thread_Timings
+{
+    std::array<std::atomic<std::int64_t>, n_sections> nanoseconds{};
+    std::array<std::atomic<std::int64_t>, n_sections> calls{};
+};
+
+// The timings of all threads which have used the profiler. They are kept after a thread has ended,
+// so that its time is not lost.
+std::mutex registry_mutex;
+std::vector<std::unique_ptr<Thread_Timings>> & registry()
+{
+    static std::vector<std::unique_ptr<Thread_Timings>> timings;
+    return timings;
+}
+
+Thread_Timings & thread_timings()
+{
+    thread_local Thread_Timings * timings = nullptr;
+    if( timings == nullptr )
+    {
+        std::lock_guard<std::mutex> guard( registry_mutex );
+        registry().emplace_back( new Thread_Timings() );
+        timings = registry().back().get();
+    }
+    return *timings;
+}
+
+} // namespace
+
+const char * Section_Name( Section section )
+{
+    switch( section )
+    {
+        case Section::Iteration: return "iteration";
+        case Section::Gradient: return "gradient";
+        case Section::Zeeman: return "zeeman";
+        case Section::Anisotropy: return "anisotropy";
+        case Section::Cubic_Anisotropy: return "cubic anisotropy";
+        case Section::Exchange: return "exchange";
+        case Section::DMI: return "dmi";
+        case Section::DDI: return "ddi";
+        case Section::DDI_FFT_Forward: return "ddi fft forward";
+        case Section::DDI_Multiply: return "ddi multiply";
+        case Section::DDI_FFT_Inverse: return "ddi fft inverse";
+        case Section::Quadruplets: return "quadruplets";
+        case Section::Thermal_Noise: return "thermal noise";
+        case Section::Convergence: return "convergence";
+        case Section::IO: return "io";
+        default: return "unknown";
+    }
+}
+
+void Add( Section section, std::chrono::steady_clock::duration duration )
+{
+    auto & timings  = thread_timings();
+    const int index = static_cast<int>( section );
+    const auto ns   = std::chrono::duration_cast<std::chrono::nanoseconds>( duration ).count();
+    timings.nanoseconds[index].store(
+        timings.nanoseconds[index].load( std::memory_order_relaxed ) + ns, std::memory_order_relaxed );
+    timings.calls[index].store( timings.calls[index].load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+}
+
+Timings Get_Timings()
+{
+    Timings result;
+    std::lock_guard<std::mutex> guard( registry_mutex );
+    for( const auto & timings : registry() )
+    {
+        for( int i = 0; i < n_sections; ++i )
+        {
+            result.seconds[i] += 1e-9 * timings->nanoseconds[i].load( std::memory_order_relaxed );
+            result.calls[i] += timings->calls[i].load( std::memory_order_relaxed );
+        }
+    }
+    return result;
+}
+
+void Reset_Timings()
+{
+    std::lock_guard<std::mutex> guard( registry_mutex );
+    for( auto & timings : registry() )
+    {
+        for( int i = 0; i < n_sections; ++i )
+        {
+            timings->nanoseconds[i].store( 0, std::memory_order_relaxed );
+            timings->calls[i].store( 0, std::memory_order_relaxed );
+        }
+    }
+}
+
+std::vector<std::string> Timings_Block( const Timings & start, const Timings & end )
+{
+    std::vector<std::string> block;
+    block.emplace_back( "    Profiled sections (inclusive times):" );
+
+    // Percentages are given relative to the total time of the iterations
+    const int iteration = static_cast<int>( Section::Iteration );
+    const double total  = end.seconds[iteration] - start.seconds[iteration];
+
+    for( int i = 0; i < n_sections; ++i )
+    {
+        const auto calls = end.calls[i] - start.calls[i];
+        if( calls == 0 )
+            continue;
+        const double seconds = end.seconds[i] - start.seconds[i];
+        const double percent = total > 0 ? 100 * seconds / total : 0;
+        block.emplace_back( fmt::format(
+            "        {:<17} {:>10.4f} s  {:>6.2f}%  {:>10} calls  {:>10.3f} us/call",
+            Section_Name( static_cast<Section>( i ) ), seconds, percent, calls, 1e6 * seconds / calls ) );
+    }
+    return block;
+}
+
+} // namespace Profiling
+} // namespace Utility
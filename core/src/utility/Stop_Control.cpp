@@ -0,0 +1,161 @@
+#include <utility/Stop_Control.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+
+#ifdef SPIRIT_USE_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace Utility
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// Lock-free, so that it may be incremented from a signal handler
+std::atomic<int> n_stop_requests{ 0 };
+
+// Result of the last check for a STOP file
+std::atomic<bool> stop_file_present{ false };
+// Time at which the STOP file is looked for again, if no watcher thread is running
+std::atomic<Clock::rep> next_check{ 0 };
+
+Clock::duration Interval_From_Environment()
+{
+    double seconds     = 1;
+    const char * value = std::getenv( "SPIRIT_STOP_FILE_INTERVAL" );
+    if( value != nullptr && std::atof( value ) > 0 )
+        seconds = std::atof( value );
+    return std::chrono::duration_cast<Clock::duration>( std::chrono::duration<double>( seconds ) );
+}
+
+const Clock::duration & Interval()
+{
+    static const Clock::duration interval = Interval_From_Environment();
+    return interval;
+}
+
+void Check_Stop_File()
+{
+    std::ifstream f( "STOP" );
+    stop_file_present = f.good();
+    next_check        = ( Clock::now() + Interval() ).time_since_epoch().count();
+}
+
+#ifdef SPIRIT_USE_THREADS
+
+// Looks for the STOP file in regular intervals while simulations are running
+struct Watcher
+{
+    // Serialises starting and stopping the thread
+    std::mutex registration_mutex;
+    int n_registered = 0;
+    std::atomic<bool> running{ false };
+
+    std::mutex wake_mutex;
+    std::condition_variable wake_condition;
+    bool stop = false;
+    std::thread thread;
+
+    void Loop()
+    {
+        std::unique_lock<std::mutex> lock( wake_mutex );
+        while( !stop )
+        {
+            wake_condition.wait_for( lock, Interval(), [this] { return stop; } );
+            if( !stop )
+                Check_Stop_File();
+        }
+    }
+
+    void Register()
+    {
+        std::lock_guard<std::mutex> guard( registration_mutex );
+        if( n_registered++ > 0 )
+            return;
+
+        // A STOP file placed before the start is found right away
+        Check_Stop_File();
+        stop    = false;
+        thread  = std::thread( &Watcher::Loop, this );
+        running = true;
+    }
+
+    void Unregister()
+    {
+        std::lock_guard<std::mutex> guard( registration_mutex );
+        if( --n_registered > 0 )
+            return;
+
+        running = false;
+        {
+            std::lock_guard<std::mutex> wake_guard( wake_mutex );
+            stop = true;
+        }
+        wake_condition.notify_one();
+        thread.join();
+    }
+};
+
+Watcher & Get_Watcher()
+{
+    static Watcher watcher;
+    return watcher;
+}
+
+#endif
+
+} // namespace
+
+namespace Stop_Control
+{
+
+bool Stop_File_Present()
+{
+#ifdef SPIRIT_USE_THREADS
+    if( Get_Watcher().running )
+        return stop_file_present;
+#endif
+    if( Clock::now().time_since_epoch().count() >= next_check )
+        Check_Stop_File();
+    return stop_file_present;
+}
+
+void Request_Stop() noexcept
+{
+    ++n_stop_requests;
+}
+
+int N_Stop_Requests() noexcept
+{
+    return n_stop_requests;
+}
+
+} // namespace Stop_Control
+
+Stop_Watch::Stop_Watch()
+{
+#ifdef SPIRIT_USE_THREADS
+    Get_Watcher().Register();
+#else
+    // Without a watcher thread, a STOP file placed before the start is only found right away if checked here
+    Check_Stop_File();
+#endif
+}
+
+Stop_Watch::~Stop_Watch()
+{
+#ifdef SPIRIT_USE_THREADS
+    Get_Watcher().Unregister();
+#endif
+}
+
+} // namespace Utility
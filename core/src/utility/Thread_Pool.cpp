@@ -0,0 +1,279 @@
+#include <utility/Thread_Pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+
+#ifdef SPIRIT_USE_THREADS
+#include <thread>
+#endif
+
+namespace Utility
+{
+
+namespace
+{
+
+// Chunks are not made smaller than this, as the overhead of scheduling would dominate
+constexpr int min_chunk_size = 256;
+// Number of chunks per thread, so that threads which finish early can take over work
+constexpr int chunks_per_thread = 4;
+
+// Number of threads registered with a fair share of the pool
+std::atomic<int> n_registered{ 0 };
+// Budget of the current thread: an explicit number of threads or, if zero, a fair share if registered
+thread_local int budget_n_threads   = 0;
+thread_local bool budget_registered = false;
+// Greater than zero while the current thread processes a chunk, so that nested loops run sequentially
+thread_local int loop_depth = 0;
+
+struct Loop_Depth_Guard
+{
+    Loop_Depth_Guard()
+    {
+        ++loop_depth;
+    }
+    ~Loop_Depth_Guard()
+    {
+        --loop_depth;
+    }
+};
+
+int Threads_From_Environment()
+{
+    const char * value = std::getenv( "SPIRIT_NUM_THREADS" );
+    if( value != nullptr && std::atoi( value ) > 0 )
+        return std::atoi( value );
+#ifdef SPIRIT_USE_THREADS
+    return std::max( 1, static_cast<int>( std::thread::hardware_concurrency() ) );
+#else
+    return 1;
+#endif
+}
+
+} // namespace
+
+// A loop which is being executed. Helpers keep it alive until they have seen that no chunks are left.
+struct Thread_Pool::Loop
+{
+    Loop( spirit_index n, int n_chunks, const Chunk_Function & f ) : n( n ), n_chunks( n_chunks ), f( f ) {}
+
+    spirit_index Begin( int i_chunk ) const
+    {
+        return static_cast<spirit_index>( static_cast<std::int64_t>( n ) * i_chunk / n_chunks );
+    }
+
+    // Processes chunks until none are left to claim
+    void Run()
+    {
+        Loop_Depth_Guard depth_guard;
+        int i_chunk;
+        while( ( i_chunk = next_chunk.fetch_add( 1, std::memory_order_relaxed ) ) < n_chunks )
+        {
+            try
+            {
+                f( i_chunk, Begin( i_chunk ), Begin( i_chunk + 1 ) );
+            }
+            catch( ... )
+            {
+                std::lock_guard<std::mutex> guard( exception_mutex );
+                if( !exception )
+                    exception = std::current_exception();
+            }
+            n_done.fetch_add( 1, std::memory_order_acq_rel );
+        }
+    }
+
+    const spirit_index n;
+    const int n_chunks;
+    // Only called for a claimed chunk, while the caller of Parallel_For is still waiting
+    const Chunk_Function & f;
+    std::atomic<int> next_chunk{ 0 };
+    std::atomic<int> n_done{ 0 };
+    std::mutex exception_mutex;
+    std::exception_ptr exception;
+};
+
+struct Thread_Pool::Worker
+{
+    std::mutex mutex;
+    std::deque<std::shared_ptr<Loop>> tasks;
+#ifdef SPIRIT_USE_THREADS
+    std::thread thread;
+#endif
+};
+
+Thread_Pool & Thread_Pool::Get()
+{
+    static Thread_Pool pool( Threads_From_Environment() );
+    return pool;
+}
+
+Thread_Pool::Thread_Pool( int n_threads ) : n_threads( std::max( 1, n_threads ) )
+{
+#ifdef SPIRIT_USE_THREADS
+    for( int i = 0; i < this->n_threads - 1; ++i )
+        workers.emplace_back( new Worker() );
+    for( int i = 0; i < this->n_threads - 1; ++i )
+        workers[i]->thread = std::thread( &Thread_Pool::Work, this, i );
+#else
+    this->n_threads = 1;
+#endif
+}
+
+Thread_Pool::~Thread_Pool()
+{
+    {
+        std::lock_guard<std::mutex> guard( sleep_mutex );
+        stop = true;
+    }
+    wake_condition.notify_all();
+#ifdef SPIRIT_USE_THREADS
+    for( auto & worker : workers )
+        worker->thread.join();
+#endif
+}
+
+int Thread_Pool::N_Threads() const
+{
+    return n_threads;
+}
+
+int Thread_Pool::Budget() const
+{
+    if( budget_n_threads > 0 )
+        return std::min( budget_n_threads, n_threads );
+    if( budget_registered )
+        return std::max( 1, n_threads / std::max( 1, n_registered.load( std::memory_order_relaxed ) ) );
+    return n_threads;
+}
+
+int Thread_Pool::N_Chunks( spirit_index n ) const
+{
+    if( n <= 0 )
+        return 0;
+    const spirit_index n_chunks = ( n + min_chunk_size - 1 ) / min_chunk_size;
+    return static_cast<int>( std::min<spirit_index>( n_chunks, chunks_per_thread * n_threads ) );
+}
+
+void Thread_Pool::Parallel_For( spirit_index n, const Chunk_Function & f )
+{
+    const int n_chunks = N_Chunks( n );
+    if( n_chunks == 0 )
+        return;
+
+    const int n_helpers = std::min( { Budget(), n_chunks, n_threads } ) - 1;
+    if( n_helpers <= 0 || loop_depth > 0 )
+    {
+        Loop loop( n, n_chunks, f );
+        Loop_Depth_Guard depth_guard;
+        for( int i_chunk = 0; i_chunk < n_chunks; ++i_chunk )
+            f( i_chunk, loop.Begin( i_chunk ), loop.Begin( i_chunk + 1 ) );
+        return;
+    }
+
+    auto loop = std::make_shared<Loop>( n, n_chunks, f );
+    Post( loop, n_helpers );
+    loop->Run();
+
+    // Wait for the chunks which were claimed by helpers
+    while( loop->n_done.load( std::memory_order_acquire ) < n_chunks )
+    {
+#ifdef SPIRIT_USE_THREADS
+        std::this_thread::yield();
+#endif
+    }
+
+    if( loop->exception )
+        std::rethrow_exception( loop->exception );
+}
+
+void Thread_Pool::Post( const std::shared_ptr<Loop> & loop, int n_helpers )
+{
+    {
+        std::lock_guard<std::mutex> guard( sleep_mutex );
+        for( int i = 0; i < n_helpers; ++i )
+        {
+            auto & worker = *workers[next_worker];
+            next_worker   = ( next_worker + 1 ) % workers.size();
+            std::lock_guard<std::mutex> worker_guard( worker.mutex );
+            worker.tasks.push_back( loop );
+        }
+        n_pending += n_helpers;
+    }
+    wake_condition.notify_all();
+}
+
+bool Thread_Pool::Take( int i_worker, std::shared_ptr<Loop> & loop )
+{
+    // Take from the front of the own queue or steal from the back of another one
+    const int n_workers = workers.size();
+    for( int k = 0; k < n_workers && !loop; ++k )
+    {
+        auto & worker = *workers[( i_worker + k ) % n_workers];
+        std::lock_guard<std::mutex> guard( worker.mutex );
+        if( worker.tasks.empty() )
+            continue;
+        if( k == 0 )
+        {
+            loop = std::move( worker.tasks.front() );
+            worker.tasks.pop_front();
+        }
+        else
+        {
+            loop = std::move( worker.tasks.back() );
+            worker.tasks.pop_back();
+        }
+    }
+    if( !loop )
+        return false;
+
+    std::lock_guard<std::mutex> guard( sleep_mutex );
+    --n_pending;
+    return true;
+}
+
+void Thread_Pool::Work( int i_worker )
+{
+    while( true )
+    {
+        std::shared_ptr<Loop> loop;
+        if( Take( i_worker, loop ) )
+        {
+            loop->Run();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock( sleep_mutex );
+        wake_condition.wait( lock, [this] { return stop || n_pending > 0; } );
+        if( stop )
+            return;
+    }
+}
+
+Thread_Budget::Thread_Budget( int n_threads )
+        : n_threads_previous( budget_n_threads ), registered_previous( budget_registered )
+{
+    if( n_threads > 0 )
+    {
+        budget_n_threads = n_threads;
+    }
+    else if( !budget_registered )
+    {
+        budget_registered = true;
+        ++n_registered;
+    }
+}
+
+Thread_Budget::~Thread_Budget()
+{
+    if( budget_registered && !registered_previous )
+        --n_registered;
+    budget_n_threads  = n_threads_previous;
+    budget_registered = registered_previous;
+}
+
+} // namespace Utility
@@ -0,0 +1,63 @@
+#pragma once
+#ifndef SPIRIT_CORE_TEST_BENCH_HPP
+#define SPIRIT_CORE_TEST_BENCH_HPP
+
+#include <Spirit/Configurations.h>
+#include <Spirit/Geometry.h>
+#include <Spirit/State.h>
+
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Helpers shared by the benchmarks.
+ *
+ * The systems are square monolayers of N x N spins, where the edge lengths N are read from the environment variable
+ * SPIRIT_BENCH_SIZES as a comma separated list. The number of threads is set as for any other run, i.e. through
+ * SPIRIT_NUM_THREADS or OMP_NUM_THREADS, so that `run_benchmarks.py` can scan it by restarting the executable.
+ */
+namespace Bench
+{
+
+constexpr auto inputfile = "core/test/input/bench.cfg";
+
+// Sizes above `max_size` (if given) are skipped, for benchmarks which would otherwise take too long
+inline std::vector<int> Sizes( const char * fallback = "32,64", int max_size = 0 )
+{
+    const char * value = std::getenv( "SPIRIT_BENCH_SIZES" );
+    std::stringstream stream( value != nullptr ? value : fallback );
+
+    std::vector<int> sizes;
+    std::string item;
+    while( std::getline( stream, item, ',' ) )
+    {
+        const int n = std::atoi( item.c_str() );
+        if( n > 0 && ( max_size <= 0 || n <= max_size ) )
+            sizes.push_back( n );
+    }
+    return sizes;
+}
+
+// A state with N x N spins, in quiet mode so that nothing is written to disk, holding a skyrmion in the center
+inline std::shared_ptr<State> Setup( int n )
+{
+    auto state     = std::shared_ptr<State>( State_Setup( inputfile, true ), State_Delete );
+    int n_cells[3] = { n, n, 1 };
+    Geometry_Set_N_Cells( state.get(), n_cells );
+    Configuration_PlusZ( state.get() );
+    Configuration_Skyrmion( state.get(), n / 8.0f, 1, -90, false, false, false );
+    return state;
+}
+
+// The name of a benchmark, tagged with the system size so that results of different sizes can be told apart
+inline std::string Name( const std::string & name, int n )
+{
+    return name + " [N=" + std::to_string( n ) + "x" + std::to_string( n ) + "]";
+}
+
+} // namespace Bench
+
+#endif
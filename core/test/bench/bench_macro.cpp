@@ -0,0 +1,70 @@
+#include "bench.hpp"
+
+#include <Spirit/Chain.h>
+#include <Spirit/Configurations.h>
+#include <Spirit/Simulation.h>
+#include <Spirit/Transitions.h>
+#include <catch.hpp>
+
+// Whole simulations of a fixed number of iterations, as they are typically run
+
+TEST_CASE( "Skyrmion relaxation with LLG", "[macro][llg]" )
+{
+    const int n_iterations = 200;
+    for( int n : Bench::Sizes() )
+    {
+        auto state = Bench::Setup( n );
+
+        BENCHMARK( Bench::Name( "LLG skyrmion relaxation VP_OSO x200", n ) )
+        {
+            Configuration_PlusZ( state.get() );
+            Configuration_Skyrmion( state.get(), n / 8.0f, 1, -90, false, false, false );
+            Simulation_LLG_Start( state.get(), Solver_VP_OSO, n_iterations );
+        };
+        BENCHMARK( Bench::Name( "LLG skyrmion dynamics Depondt x200", n ) )
+        {
+            Configuration_PlusZ( state.get() );
+            Configuration_Skyrmion( state.get(), n / 8.0f, 1, -90, false, false, false );
+            Simulation_LLG_Start( state.get(), Solver_Depondt, n_iterations );
+        };
+    }
+}
+
+TEST_CASE( "Skyrmion collapse with GNEB", "[macro][gneb]" )
+{
+    const int n_iterations = 50;
+    const int noi          = 7;
+    for( int n : Bench::Sizes( "32" ) )
+    {
+        auto state = Bench::Setup( n );
+        Chain_Image_to_Clipboard( state.get() );
+        for( int i = 1; i < noi; ++i )
+            Chain_Insert_Image_After( state.get() );
+
+        BENCHMARK( Bench::Name( "GNEB chain of 7 images VP_OSO x50", n ) )
+        {
+            Chain_Jump_To_Image( state.get(), noi - 1 );
+            Configuration_PlusZ( state.get() );
+            Chain_Jump_To_Image( state.get(), 0 );
+            Transition_Homogeneous( state.get(), 0, noi - 1 );
+            Simulation_GNEB_Start( state.get(), Solver_VP_OSO, n_iterations );
+        };
+    }
+}
+
+TEST_CASE( "Minimum mode following", "[macro][mmf]" )
+{
+    // The eigenmodes are calculated from the dense Hessian, so only small systems are feasible
+    const int n_iterations = 20;
+    for( int n : Bench::Sizes( "16", 32 ) )
+    {
+        auto state = Bench::Setup( n );
+
+        BENCHMARK( Bench::Name( "MMF skyrmion VP x20", n ) )
+        {
+            Configuration_PlusZ( state.get() );
+            Configuration_Skyrmion( state.get(), n / 8.0f, 1, -90, false, false, false );
+            Simulation_MMF_Start( state.get(), Solver_VP, n_iterations );
+        };
+    }
+}
@@ -0,0 +1,213 @@
+#include "bench.hpp"
+
+#include <Spirit/Hamiltonian.h>
+#include <Spirit/IO.h>
+#include <Spirit/Simulation.h>
+#include <catch.hpp>
+#include <data/State.hpp>
+#include <engine/Hamiltonian_Heisenberg.hpp>
+#include <engine/Vectormath.hpp>
+
+#include <cstdio>
+#include <utility>
+
+using Engine::Hamiltonian_Heisenberg;
+
+namespace
+{
+
+Hamiltonian_Heisenberg & Heisenberg( State * state )
+{
+    return dynamic_cast<Hamiltonian_Heisenberg &>( *state->active_image->hamiltonian );
+}
+
+} // namespace
+
+TEST_CASE( "Interaction terms", "[micro][hamiltonian]" )
+{
+    for( int n : Bench::Sizes() )
+    {
+        auto state   = Bench::Setup( n );
+        auto & ham   = Heisenberg( state.get() );
+        auto & spins = *state->active_image->spins;
+        vectorfield gradient( spins.size(), Vector3::Zero() );
+        scalarfield energy( spins.size(), 0 );
+
+        BENCHMARK( Bench::Name( "Gradient Zeeman", n ) )
+        {
+            ham.Gradient_Zeeman( gradient );
+        };
+        BENCHMARK( Bench::Name( "Gradient Anisotropy", n ) )
+        {
+            ham.Gradient_Anisotropy( spins, gradient );
+        };
+        BENCHMARK( Bench::Name( "Gradient Exchange", n ) )
+        {
+            ham.Gradient_Exchange( spins, gradient );
+        };
+        BENCHMARK( Bench::Name( "Gradient DMI", n ) )
+        {
+            ham.Gradient_DMI( spins, gradient );
+        };
+        BENCHMARK( Bench::Name( "Energy Exchange", n ) )
+        {
+            ham.E_Exchange( spins, energy );
+        };
+        BENCHMARK( Bench::Name( "Energy DMI", n ) )
+        {
+            ham.E_DMI( spins, energy );
+        };
+        BENCHMARK( Bench::Name( "Gradient total", n ) )
+        {
+            ham.Gradient( spins, gradient );
+        };
+        BENCHMARK( Bench::Name( "Energy contributions", n ) )
+        {
+            return ham.Energy( spins );
+        };
+    }
+}
+
+TEST_CASE( "Dipole-dipole interaction via FFT", "[micro][hamiltonian][fft]" )
+{
+    for( int n : Bench::Sizes() )
+    {
+        auto state               = Bench::Setup( n );
+        int n_periodic_images[3] = { 0, 0, 0 };
+        Hamiltonian_Set_DDI( state.get(), SPIRIT_DDI_METHOD_FFT, n_periodic_images );
+
+        auto & ham   = Heisenberg( state.get() );
+        auto & spins = *state->active_image->spins;
+        vectorfield gradient( spins.size(), Vector3::Zero() );
+        scalarfield energy( spins.size(), 0 );
+
+        BENCHMARK( Bench::Name( "Gradient DDI FFT", n ) )
+        {
+            ham.Gradient_DDI( spins, gradient );
+        };
+        BENCHMARK( Bench::Name( "Energy DDI FFT", n ) )
+        {
+            ham.E_DDI( spins, energy );
+        };
+    }
+}
+
+TEST_CASE( "Vectormath primitives", "[micro][vectormath]" )
+{
+    using namespace Engine;
+
+    for( int n : Bench::Sizes() )
+    {
+        const std::size_t nos = std::size_t( n ) * n;
+        vectorfield a( nos, Vector3{ 1, 2, 3 } ), b( nos, Vector3{ 3, 2, 1 } ), c( nos, Vector3::Zero() );
+        scalarfield s( nos, 0 );
+
+        BENCHMARK( Bench::Name( "dot", n ) )
+        {
+            return Vectormath::dot( a, b );
+        };
+        BENCHMARK( Bench::Name( "dot per spin", n ) )
+        {
+            Vectormath::dot( a, b, s );
+        };
+        BENCHMARK( Bench::Name( "cross", n ) )
+        {
+            Vectormath::cross( a, b, c );
+        };
+        BENCHMARK( Bench::Name( "add_c_a", n ) )
+        {
+            Vectormath::add_c_a( 0.5, a, c );
+        };
+        BENCHMARK( Bench::Name( "normalize_vectors", n ) )
+        {
+            Vectormath::normalize_vectors( c );
+        };
+        BENCHMARK( Bench::Name( "max_norm", n ) )
+        {
+            return Vectormath::max_norm( a );
+        };
+    }
+}
+
+TEST_CASE( "Solver iterations", "[micro][solvers]" )
+{
+    const std::vector<std::pair<const char *, int>> solvers{
+        { "SIB", Solver_SIB },
+        { "Depondt", Solver_Depondt },
+        { "Heun", Solver_Heun },
+        { "RK4", Solver_RungeKutta4 },
+        { "VP", Solver_VP },
+        { "VP_OSO", Solver_VP_OSO },
+        { "LBFGS_OSO", Solver_LBFGS_OSO },
+        { "LBFGS_Atlas", Solver_LBFGS_Atlas },
+        { "NCG", Solver_NCG },
+    };
+
+    for( int n : Bench::Sizes() )
+    {
+        auto state = Bench::Setup( n );
+        for( const auto & solver : solvers )
+        {
+            Simulation_LLG_Start( state.get(), solver.second, -1, -1, true );
+            BENCHMARK( Bench::Name( std::string( "LLG iteration " ) + solver.first, n ) )
+            {
+                Simulation_SingleShot( state.get() );
+            };
+            Simulation_Stop( state.get() );
+        }
+    }
+}
+
+TEST_CASE( "Monte Carlo sweep", "[micro][mc]" )
+{
+    for( int n : Bench::Sizes() )
+    {
+        auto state = Bench::Setup( n );
+        Simulation_MC_Start( state.get(), -1, -1, true );
+        BENCHMARK( Bench::Name( "MC sweep", n ) )
+        {
+            Simulation_SingleShot( state.get() );
+        };
+        Simulation_Stop( state.get() );
+    }
+}
+
+TEST_CASE( "OVF files", "[micro][io]" )
+{
+    for( int n : Bench::Sizes() )
+    {
+        auto state       = Bench::Setup( n );
+        const auto file  = "output/bench_" + std::to_string( n ) + ".ovf";
+        const auto file4 = "output/bench_" + std::to_string( n ) + "_bin4.ovf";
+        const auto text  = "output/bench_" + std::to_string( n ) + "_text.ovf";
+
+        BENCHMARK( Bench::Name( "OVF write binary 8", n ) )
+        {
+            IO_Image_Write( state.get(), file.c_str(), IO_Fileformat_OVF_bin8 );
+        };
+        BENCHMARK( Bench::Name( "OVF read binary 8", n ) )
+        {
+            IO_Image_Read( state.get(), file.c_str() );
+        };
+        BENCHMARK( Bench::Name( "OVF write binary 4", n ) )
+        {
+            IO_Image_Write( state.get(), file4.c_str(), IO_Fileformat_OVF_bin4 );
+        };
+        BENCHMARK( Bench::Name( "OVF read binary 4", n ) )
+        {
+            IO_Image_Read( state.get(), file4.c_str() );
+        };
+        BENCHMARK( Bench::Name( "OVF write text", n ) )
+        {
+            IO_Image_Write( state.get(), text.c_str(), IO_Fileformat_OVF_text );
+        };
+        BENCHMARK( Bench::Name( "OVF read text", n ) )
+        {
+            IO_Image_Read( state.get(), text.c_str() );
+        };
+
+        std::remove( file.c_str() );
+        std::remove( file4.c_str() );
+        std::remove( text.c_str() );
+    }
+}
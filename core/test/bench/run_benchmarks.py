@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""
+Runs the Spirit benchmarks and compares their results.
+
+    python3 core/test/bench/run_benchmarks.py run --executable build/core/spirit_bench \\
+        --threads 1,4 --sizes 32,64 --output results.json
+    python3 core/test/bench/run_benchmarks.py compare baseline.json results.json --threshold 0.1
+
+`run` has to be called from the repository root, as the benchmarks read their input file from there. The executable
+is started once per thread count, with SPIRIT_NUM_THREADS and OMP_NUM_THREADS set accordingly. The results are saved
+as JSON, mapping the name of each benchmark, tagged with the thread count, to its mean and standard deviation in
+nanoseconds.
+
+`compare` lists the benchmarks which got slower by more than the threshold (relative change of the mean) and exits
+with a non-zero status if there are any.
+"""
+
+import argparse
+import json
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+import xml.etree.ElementTree as ElementTree
+
+
+def parse_catch_xml(filename):
+    results = {}
+    for benchmark in ElementTree.parse(filename).getroot().iter("BenchmarkResults"):
+        results[benchmark.get("name")] = {
+            "mean": float(benchmark.find("mean").get("value")),
+            "standard_deviation": float(benchmark.find("standardDeviation").get("value")),
+            "samples": int(benchmark.get("samples")),
+        }
+    return results
+
+
+def run(args):
+    results = {}
+    for n_threads in args.threads.split(","):
+        env = dict(os.environ)
+        env["SPIRIT_NUM_THREADS"] = n_threads
+        env["OMP_NUM_THREADS"] = n_threads
+        env["SPIRIT_BENCH_SIZES"] = args.sizes
+
+        with tempfile.TemporaryDirectory() as directory:
+            report = os.path.join(directory, "report.xml")
+            command = [args.executable, "-r", "xml", "-o", report, "--benchmark-samples", str(args.samples)]
+            if args.filter:
+                command.append(args.filter)
+            print("Running with {} thread(s): {}".format(n_threads, " ".join(command)))
+            subprocess.run(command, env=env, check=True)
+
+            for name, result in parse_catch_xml(report).items():
+                results["{} [threads={}]".format(name, n_threads)] = result
+
+    with open(args.output, "w") as f:
+        json.dump(
+            {"machine": platform.node(), "processor": platform.processor(), "benchmarks": results},
+            f,
+            indent=2,
+            sort_keys=True,
+        )
+    print("Wrote {} results to {}".format(len(results), args.output))
+    return 0
+
+
+def compare(args):
+    with open(args.baseline) as f:
+        baseline = json.load(f)["benchmarks"]
+    with open(args.current) as f:
+        current = json.load(f)["benchmarks"]
+
+    regressions = []
+    print("{:<70} {:>14} {:>14} {:>9}".format("benchmark", "baseline [ns]", "current [ns]", "change"))
+    for name in sorted(set(baseline) & set(current)):
+        old = baseline[name]["mean"]
+        new = current[name]["mean"]
+        change = (new - old) / old if old > 0 else 0
+        flag = ""
+        if change > args.threshold:
+            regressions.append(name)
+            flag = "  <-- regression"
+        print("{:<70} {:>14.1f} {:>14.1f} {:>+8.1%}{}".format(name, old, new, change, flag))
+
+    for name in sorted(set(baseline) ^ set(current)):
+        print("{:<70} only in {}".format(name, "baseline" if name in baseline else "current results"))
+
+    if regressions:
+        print("\n{} benchmark(s) slower by more than {:.0%}".format(len(regressions), args.threshold))
+        return 1
+    print("\nNo regressions beyond {:.0%}".format(args.threshold))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run the Spirit benchmarks and compare their results.")
+    subparsers = parser.add_subparsers(dest="command")
+    subparsers.required = True
+
+    parser_run = subparsers.add_parser("run", help="run the benchmarks and save their results")
+    parser_run.add_argument("--executable", default="build/core/spirit_bench", help="path to spirit_bench")
+    parser_run.add_argument("--threads", default="1", help="comma separated thread counts")
+    parser_run.add_argument("--sizes", default="32,64", help="comma separated edge lengths of the systems")
+    parser_run.add_argument("--samples", type=int, default=50, help="samples per benchmark")
+    parser_run.add_argument("--filter", default="", help="Catch test spec, e.g. [micro] or [macro]")
+    parser_run.add_argument("--output", default="benchmarks.json", help="file to save the results in")
+    parser_run.set_defaults(function=run)
+
+    parser_compare = subparsers.add_parser("compare", help="flag regressions between two sets of results")
+    parser_compare.add_argument("baseline", help="results to compare against")
+    parser_compare.add_argument("current", help="results to check")
+    parser_compare.add_argument(
+        "--threshold", type=float, default=0.1, help="relative slow-down above which a benchmark is flagged"
+    )
+    parser_compare.set_defaults(function=compare)
+
+    args = parser.parse_args()
+    return args.function(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
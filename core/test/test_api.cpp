@@ -1,5 +1,10 @@
 #include <Spirit/Chain.h>
 #include <Spirit/Configurations.h>
+#include <Spirit/Geometry.h>
+#include <Spirit/Hamiltonian.h>
+#include <Spirit/Observables.h>
+#include <Spirit/Parameters_LLG.h>
+#include <Spirit/Parameters_MC.h>
 #include <Spirit/Quantities.h>
 #include <Spirit/Simulation.h>
 #include <Spirit/State.h>
@@ -10,6 +15,18 @@
 
 #include <catch.hpp>
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#ifdef SPIRIT_USE_THREADS
+#include <atomic>
+#include <chrono>
+#include <thread>
+#endif
+
 auto inputfile = "core/test/input/api.cfg";
 
 using Catch::Matchers::WithinAbs;
@@ -182,5 +199,431 @@ TEST_CASE( "Quantities", "[quantities]" )
             float charge = Quantity_Get_Topological_Charge( state.get() );
             REQUIRE_THAT( charge, WithinAbs( 1, 1e-12 ) );
         }
+
+        SECTION( "charge density" )
+        {
+            Configuration_PlusZ( state.get() );
+            Configuration_Skyrmion( state.get(), 6.0, 1.0, -90.0, false, false, false );
+            float charge = Quantity_Get_Topological_Charge( state.get() );
+
+            int n_triangles = Quantity_Get_Topological_Charge_Density( state.get(), nullptr, nullptr );
+            std::vector<float> charge_density( n_triangles );
+            std::vector<int> triangle_indices( 3 * n_triangles );
+            Quantity_Get_Topological_Charge_Density( state.get(), charge_density.data(), triangle_indices.data() );
+
+            // Two triangles per basis atom in every cell, except for those reaching beyond the open boundaries
+            REQUIRE( n_triangles > 4 * 49 * 49 );
+            REQUIRE( n_triangles < 4 * 50 * 50 );
+
+            float charge_sum = 0;
+            for( float density : charge_density )
+                charge_sum += density;
+            REQUIRE_THAT( charge_sum, WithinAbs( charge, 1e-5 ) );
+        }
+    }
+}
+
+TEST_CASE( "Geometry", "[geometry]" )
+{
+    // The default geometry is a square lattice of 100x100 cells with a single basis atom
+    auto state = std::shared_ptr<State>( State_Setup(), State_Delete );
+
+    SECTION( "Triangulation" )
+    {
+        const int * indices = nullptr;
+        int n_triangles     = Geometry_Get_Triangulation( state.get(), &indices );
+        REQUIRE( n_triangles == 2 * 99 * 99 );
+
+        n_triangles = Geometry_Get_Triangulation( state.get(), &indices, 2 );
+        REQUIRE( n_triangles == 2 * 49 * 49 );
+
+        // The indices refer to the sites of every second cell
+        for( int i = 0; i < 3 * n_triangles; ++i )
+            REQUIRE( indices[i] < 50 * 50 );
+    }
+
+    SECTION( "Tetrahedra" )
+    {
+        const int * indices = nullptr;
+        REQUIRE( Geometry_Get_Tetrahedra( state.get(), &indices ) == 0 );
+
+        int n_cells[3] = { 10, 10, 10 };
+        Geometry_Set_N_Cells( state.get(), n_cells );
+        REQUIRE( Geometry_Get_Tetrahedra( state.get(), &indices ) == 6 * 9 * 9 * 9 );
+    }
+}
+
+TEST_CASE( "Chain", "[chain]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    Chain_Set_Length( state.get(), 3 );
+    REQUIRE( Chain_Get_NOI( state.get() ) == 3 );
+
+    const auto & images = state->chain->images;
+
+    SECTION( "Copies of an image only share the interactions until they are modified" )
+    {
+        REQUIRE( images[0]->spins != images[2]->spins );
+        REQUIRE( images[0]->hamiltonian == images[2]->hamiltonian );
+        REQUIRE( images[0]->geometry == images[2]->geometry );
+
+        float magnitude = 0, normal[3] = { 0, 0, 0 };
+        Hamiltonian_Get_Field( state.get(), &magnitude, normal, 0 );
+        const float new_normal[3] = { 1, 0, 0 };
+        Hamiltonian_Set_Field( state.get(), magnitude + 1, new_normal, 1 );
+
+        REQUIRE( images[1]->hamiltonian != images[0]->hamiltonian );
+        REQUIRE( images[0]->hamiltonian == images[2]->hamiltonian );
+
+        float magnitude_0 = 0, magnitude_1 = 0;
+        Hamiltonian_Get_Field( state.get(), &magnitude_0, normal, 0 );
+        Hamiltonian_Get_Field( state.get(), &magnitude_1, normal, 1 );
+        REQUIRE_THAT( magnitude_0, WithinAbs( magnitude, 1e-5 ) );
+        REQUIRE_THAT( magnitude_1, WithinAbs( magnitude + 1, 1e-5 ) );
+
+        // The images with the same spins still have the same energy, as long as the interactions are the same
+        Chain_Update_Data( state.get() );
+        REQUIRE( images[0]->E == images[2]->E );
+        REQUIRE( images[0]->E != images[1]->E );
+    }
+
+    SECTION( "A new geometry is applied to every image" )
+    {
+        int n_cells[3] = { 4, 3, 1 };
+        Geometry_Set_N_Cells( state.get(), n_cells );
+
+        const int nos = System_Get_NOS( state.get() );
+        REQUIRE( nos == 4 * 3 * Geometry_Get_N_Cell_Atoms( state.get() ) );
+        for( const auto & image : images )
+        {
+            REQUIRE( image->nos == nos );
+            REQUIRE( image->geometry->nos == nos );
+            REQUIRE( image->spins->size() == nos );
+            REQUIRE( image->effective_field.size() == nos );
+        }
+    }
+}
+
+TEST_CASE( "Observables", "[observables]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+
+    Observables_Add( state.get(), Observable_Magnetization );
+    Observables_Add( state.get(), Observable_Topological_Charge );
+    Observables_Set_Step( state.get(), 3 );
+    REQUIRE( Observables_Get_Step( state.get() ) == 3 );
+
+    // An in-plane field, so that the spins precess
+    float field_direction[3] = { 1, 0, 0 };
+    Hamiltonian_Set_Field( state.get(), 5, field_direction );
+    Configuration_PlusZ( state.get() );
+    Configuration_Skyrmion( state.get(), 6.0, 1.0, -90.0, false, false, false );
+    Simulation_LLG_Start( state.get(), Solver_SIB, 10 );
+
+    // Samples are taken after the iterations 0, 3, 6 and 9
+    const int n_samples = Observables_Get_N_Samples( state.get() );
+    const int n_columns = Observables_Get_N_Columns( state.get() );
+    REQUIRE( n_samples == 4 );
+    REQUIRE( n_columns == 6 );
+
+    std::string labels( Observables_Get_Labels( state.get(), nullptr ), ' ' );
+    Observables_Get_Labels( state.get(), &labels[0] );
+    REQUIRE( labels == "iteration|time|m_x|m_y|m_z|Q" );
+
+    REQUIRE( Observables_Get_Samples( state.get(), nullptr ) == n_samples * n_columns );
+    std::vector<float> samples( n_samples * n_columns );
+    Observables_Get_Samples( state.get(), samples.data() );
+    for( int i = 0; i < n_samples; ++i )
+        REQUIRE( samples[i * n_columns] == 3 * i );
+
+    // The last sample was taken from the final state
+    const float * last = &samples[( n_samples - 1 ) * n_columns];
+    float m[3];
+    Quantity_Get_Magnetization( state.get(), m );
+    for( int dim = 0; dim < 3; ++dim )
+        REQUIRE_THAT( last[2 + dim], WithinAbs( m[dim], 1e-5 ) );
+    REQUIRE_THAT( last[5], WithinAbs( Quantity_Get_Topological_Charge( state.get() ), 1e-5 ) );
+
+    // Only the most recent samples are kept
+    Observables_Set_Capacity( state.get(), 2 );
+    REQUIRE( Observables_Get_N_Samples( state.get() ) == 2 );
+    Observables_Get_Samples( state.get(), samples.data() );
+    REQUIRE( samples[0] == 6 );
+    REQUIRE( samples[n_columns] == 9 );
+
+    Observables_Clear( state.get() );
+    REQUIRE( Observables_Get_N_Samples( state.get() ) == 0 );
+    REQUIRE( Observables_Get_N_Columns( state.get() ) == 0 );
+}
+
+TEST_CASE( "Stop requests", "[simulation]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    Configuration_Random( state.get() );
+    Parameters_LLG_Set_Convergence( state.get(), 0 );
+
+    // Requests made before a simulation started do not stop it
+    Simulation_Request_Stop();
+    Simulation_Run_Info info;
+    Simulation_LLG_Start( state.get(), Solver_SIB, 20, 20, false, &info );
+    REQUIRE( info.total_iterations == 20 );
+    free_run_info( info );
+}
+
+#ifdef SPIRIT_USE_THREADS
+TEST_CASE( "Stop requests from another thread", "[simulation]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    Configuration_Random( state.get() );
+    Parameters_LLG_Set_Convergence( state.get(), 0 );
+
+    const int n_iterations = 100000000;
+    Simulation_Run_Info info;
+    std::atomic<bool> done{ false };
+    std::thread simulation(
+        [&]
+        {
+            Simulation_LLG_Start( state.get(), Solver_SIB, n_iterations, n_iterations, false, &info );
+            done = true;
+        } );
+
+    // The simulation may only take note of the requests made since it started, so keep requesting
+    while( !done )
+    {
+        if( Simulation_Running_On_Image( state.get() ) )
+            Simulation_Request_Stop();
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
     }
-}
\ No newline at end of file
+    simulation.join();
+
+    REQUIRE( info.total_iterations < n_iterations );
+    free_run_info( info );
+}
+#endif
+
+TEST_CASE( "Spin snapshots", "[system]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    Configuration_Random( state.get() );
+    const int nos        = System_Get_NOS( state.get() );
+    const scalar * spins = System_Get_Spin_Directions( state.get() );
+
+    SECTION( "without a running simulation the spins are copied" )
+    {
+        REQUIRE( System_Get_Snapshot_NOS( state.get() ) == nos );
+        std::vector<float> directions( 3 * nos );
+        REQUIRE( System_Get_Spin_Snapshot( state.get(), directions.data() ) == 0 );
+        for( int i = 0; i < 3 * nos; ++i )
+            REQUIRE( directions[i] == float( spins[i] ) );
+    }
+
+    SECTION( "every n_cell_step-th cell" )
+    {
+        // 50 x 50 x 1 cells with two basis atoms
+        REQUIRE( System_Get_Snapshot_NOS( state.get(), 3 ) == 2 * 16 * 16 );
+        std::vector<float> directions( 3 * 2 * 16 * 16 );
+        System_Get_Spin_Snapshot( state.get(), directions.data(), 3 );
+        for( int b = 0; b < 16; ++b )
+        {
+            for( int a = 0; a < 16; ++a )
+            {
+                for( int ibasis = 0; ibasis < 2; ++ibasis )
+                {
+                    const int idx      = ibasis + 2 * ( 3 * a + 50 * 3 * b );
+                    const int idx_draw = ibasis + 2 * ( a + 16 * b );
+                    for( int dim = 0; dim < 3; ++dim )
+                        REQUIRE( directions[3 * idx_draw + dim] == float( spins[3 * idx + dim] ) );
+                }
+            }
+        }
+    }
+
+    SECTION( "snapshots are published while iterating" )
+    {
+        Parameters_LLG_Set_Convergence( state.get(), 0 );
+        Simulation_LLG_Start( state.get(), Solver_SIB, -1, -1, true );
+        std::vector<float> directions( 3 * nos );
+        // The snapshot of the initial spins is published when the simulation starts
+        REQUIRE( System_Get_Spin_Snapshot( state.get(), directions.data() ) == 1 );
+        for( int i = 0; i < 5; ++i )
+        {
+            // The snapshot requested by the previous read is published after the next iteration
+            Simulation_SingleShot( state.get() );
+            REQUIRE( System_Get_Spin_Snapshot( state.get(), directions.data() ) == i + 2 );
+            spins = System_Get_Spin_Directions( state.get() );
+            for( int idx = 0; idx < 3 * nos; ++idx )
+                REQUIRE( directions[idx] == float( spins[idx] ) );
+        }
+        // Without a read in between, no new snapshot is published
+        Simulation_SingleShot( state.get() );
+        Simulation_SingleShot( state.get() );
+        REQUIRE( System_Get_Spin_Snapshot( state.get(), directions.data() ) == 7 );
+        Simulation_Stop( state.get() );
+    }
+}
+
+#ifdef SPIRIT_USE_THREADS
+TEST_CASE( "Spin snapshots are consistent", "[system]" )
+{
+    auto state      = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    auto & image    = *state->active_image;
+    const int nos   = image.nos;
+    auto & snapshot = *image.snapshot;
+
+    // When `continuously` is set, the writer publishes as fast as it can instead of only when a reader requested it
+    auto check = [&]( bool continuously )
+    {
+        // The writer publishes states in which all components are equal to the number of the state, so a reader
+        // which copied parts of different states would find different values
+        std::atomic<bool> done{ false };
+        std::thread writer(
+            [&]
+            {
+                vectorfield spins( nos );
+                for( int n = 1; !done; ++n )
+                {
+                    std::fill( spins.begin(), spins.end(), Vector3{ scalar( n ), scalar( n ), scalar( n ) } );
+                    snapshot.Publish( spins, continuously );
+                    std::this_thread::yield();
+                }
+            } );
+
+        std::vector<float> directions( 3 * nos );
+        std::uint64_t n_previous = 0;
+        int n_consistent         = 0;
+        for( int i = 0; i < 1000; ++i )
+        {
+            const auto n_snapshot = snapshot.Read( *image.geometry, 1, directions.data() );
+            if( n_snapshot == 0 )
+                continue;
+            ++n_consistent;
+            REQUIRE( n_snapshot >= n_previous );
+            n_previous = n_snapshot;
+            REQUIRE( std::all_of(
+                directions.begin(), directions.end(), [&]( float d ) { return d == directions[0]; } ) );
+        }
+        done = true;
+        writer.join();
+        return n_consistent;
+    };
+
+    SECTION( "published on request" )
+    {
+        // At most one publication can happen while a snapshot is read, so no reads fail
+        snapshot.Publish( vectorfield( nos, Vector3{ 0, 0, 0 } ), true );
+        REQUIRE( check( false ) == 1000 );
+    }
+
+    SECTION( "published continuously" )
+    {
+        // Reads may fail, but never return a partly updated state
+        check( true );
+    }
+}
+#endif
+
+// The spin directions of the active image
+std::vector<scalar> Spins( State * state )
+{
+    const scalar * spins = System_Get_Spin_Directions( state );
+    return std::vector<scalar>( spins, spins + 3 * System_Get_NOS( state ) );
+}
+
+TEST_CASE( "Checkpoints", "[simulation]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    Parameters_LLG_Set_Convergence( state.get(), 0 );
+    Parameters_LLG_Set_Temperature( state.get(), 20 );
+    Parameters_MC_Set_Temperature( state.get(), 20 );
+    auto & llg_parameters = *state->active_image->llg_parameters;
+    auto & mc_parameters  = *state->active_image->mc_parameters;
+
+    const std::string file = "output/test_api_checkpoint.bin";
+    const int n_iterations = 40;
+
+    // The same start for every run. The adaptive cone angle of MC is carried over between runs by the parameters
+    const scalar cone_angle = mc_parameters.metropolis_cone_angle;
+    auto reset              = [&]
+    {
+        Configuration_PlusZ( state.get() );
+        Configuration_Skyrmion( state.get(), 5, 1, -90, false, false, false );
+        llg_parameters.prng                 = std::mt19937( 1234 );
+        mc_parameters.prng                  = std::mt19937( 1234 );
+        mc_parameters.metropolis_cone_angle = cone_angle;
+    };
+    // Something else happens to the state before it is resumed
+    auto disturb = [&]
+    {
+        Configuration_Random( state.get() );
+        llg_parameters.prng                 = std::mt19937( 4321 );
+        mc_parameters.prng                  = std::mt19937( 4321 );
+        mc_parameters.metropolis_cone_angle = 2 * cone_angle;
+    };
+
+    SECTION( "LLG resumed from a periodic checkpoint continues bit-identically" )
+    {
+        for( int solver : { Solver_Depondt, Solver_RungeKutta4, Solver_VP, Solver_LBFGS_OSO, Solver_LBFGS_Atlas,
+                            Solver_NCG, Solver_Newton } )
+        {
+            INFO( "Solver " << solver );
+            reset();
+            Simulation_LLG_Start( state.get(), solver, n_iterations );
+            const auto expected = Spins( state.get() );
+
+            reset();
+            llg_parameters.checkpoint_interval = 10;
+            llg_parameters.checkpoint_file     = file;
+            Simulation_LLG_Start( state.get(), solver, n_iterations / 2 );
+            llg_parameters.checkpoint_interval = 0;
+            disturb();
+
+            Simulation_Run_Info info;
+            Simulation_Resume( state.get(), file.c_str(), n_iterations, -1, false, &info );
+            REQUIRE( info.total_iterations == n_iterations );
+            free_run_info( info );
+            REQUIRE( Spins( state.get() ) == expected );
+        }
+    }
+
+    SECTION( "MC resumed from a checkpoint written in single shot mode continues bit-identically" )
+    {
+        reset();
+        Simulation_MC_Start( state.get(), n_iterations );
+        const auto expected = Spins( state.get() );
+
+        reset();
+        Simulation_MC_Start( state.get(), n_iterations, -1, true );
+        Simulation_N_Shot( state.get(), n_iterations / 2 );
+        Simulation_Write_Checkpoint( state.get(), file.c_str() );
+        Simulation_Stop( state.get() );
+        disturb();
+
+        Simulation_Resume( state.get(), file.c_str(), n_iterations );
+        REQUIRE( Spins( state.get() ) == expected );
+    }
+
+    SECTION( "An incomplete checkpoint is rejected" )
+    {
+        reset();
+        Simulation_LLG_Start( state.get(), Solver_VP, n_iterations, -1, true );
+        Simulation_N_Shot( state.get(), 5 );
+        Simulation_Write_Checkpoint( state.get(), file.c_str() );
+        Simulation_Stop( state.get() );
+
+        std::string contents;
+        {
+            std::ifstream in( file, std::ios::binary );
+            contents.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+        }
+        {
+            std::ofstream out( file, std::ios::binary | std::ios::trunc );
+            out.write( contents.data(), contents.size() / 2 );
+        }
+
+        // The image is not left blocked by the failed attempt
+        Simulation_Resume( state.get(), file.c_str(), n_iterations );
+        REQUIRE( !Simulation_Running_On_Image( state.get() ) );
+    }
+
+    std::remove( file.c_str() );
+}
@@ -4,9 +4,15 @@
 #include <Spirit/State.h>
 #include <Spirit/System.h>
 
+#include <io/Dataparser.hpp>
 #include <io/IO.hpp>
+#include <io/Table_File.hpp>
+#include <io/Trajectory_File.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -31,6 +37,8 @@ TEST_CASE( "IO", "[io]" )
         { "core/test/io_test_files/image_ovf_bin_4.ovf", IO_Fileformat_OVF_bin4 },
         { "core/test/io_test_files/image_ovf_bin_8.ovf", IO_Fileformat_OVF_bin8 },
         { "core/test/io_test_files/image_ovf_csv.ovf", IO_Fileformat_OVF_csv },
+        { "core/test/io_test_files/image_trajectory.sptraj", IO_Fileformat_Trajectory },
+        { "core/test/io_test_files/image_trajectory_quantised.sptraj", IO_Fileformat_Trajectory_quantised },
     };
 
     // buffer variables for better readability
@@ -130,6 +138,8 @@ TEST_CASE( "IO-CHAIN-WRITE", "[io-chain]" )
         { "core/test/io_test_files/chain_ovf_bin_4.ovf", IO_Fileformat_OVF_bin4 },
         { "core/test/io_test_files/chain_ovf_bin_8.ovf", IO_Fileformat_OVF_bin8 },
         { "core/test/io_test_files/chain_ovf_csv.ovf", IO_Fileformat_OVF_csv },
+        { "core/test/io_test_files/chain_trajectory.sptraj", IO_Fileformat_Trajectory },
+        { "core/test/io_test_files/chain_trajectory_quantised.sptraj", IO_Fileformat_Trajectory_quantised },
     };
 
     // buffer variables for better readability
@@ -155,7 +165,9 @@ TEST_CASE( "IO-CHAIN-READ", "[io-chain]" )
         { "core/test/io_test_files/chain_ovf_bin_4.ovf", IO_Fileformat_OVF_bin4 },
         { "core/test/io_test_files/chain_ovf_bin_8.ovf", IO_Fileformat_OVF_bin8 },
         { "core/test/io_test_files/chain_ovf_csv.ovf", IO_Fileformat_OVF_csv },
-        { "core/test/io_test_files/chain_ovf_txt.ovf", IO_Fileformat_OVF_text }
+        { "core/test/io_test_files/chain_ovf_txt.ovf", IO_Fileformat_OVF_text },
+        { "core/test/io_test_files/chain_trajectory.sptraj", IO_Fileformat_Trajectory },
+        { "core/test/io_test_files/chain_trajectory_quantised.sptraj", IO_Fileformat_Trajectory_quantised }
     };
 
     // buffer variables for better readability
@@ -210,6 +222,85 @@ TEST_CASE( "IO-CHAIN-READ", "[io-chain]" )
     }
 }
 
+TEST_CASE( "IO-TRAJECTORY", "[io-trajectory]" )
+{
+    const std::string filename = "core/test/io_test_files/trajectory_blocks.sptraj";
+
+    // More vectors than fit into one block, with a smooth texture so that the blocks compress
+    const int nos = 3 * IO::Trajectory_File::n_vectors_per_block / 2;
+    vectorfield frame_0( nos ), frame_1( nos );
+    for( int i = 0; i < nos; ++i )
+    {
+        scalar angle = 1e-4 * i;
+        frame_0[i]   = Vector3{ std::sin( angle ), 0, std::cos( angle ) };
+        frame_1[i]   = Vector3{ 0, std::sin( 2 * angle ), std::cos( 2 * angle ) };
+    }
+
+    SECTION( "Lossless" )
+    {
+        {
+            IO::Trajectory_File file( filename );
+            file.write_frame( frame_0, 10, IO::Trajectory_Encoding::Lossless );
+            file.append_frame( frame_1, 20, IO::Trajectory_Encoding::Lossless );
+        }
+
+        IO::Trajectory_File file( filename, true );
+        REQUIRE( file.n_frames() == 2 );
+        REQUIRE( file.nos() == nos );
+        REQUIRE( file.frame_iteration( 0 ) == 10 );
+        REQUIRE( file.frame_iteration( 1 ) == 20 );
+
+        vectorfield read( nos );
+        file.read_frame( 1, read );
+        for( int i = 0; i < nos; ++i )
+            REQUIRE( read[i] == frame_1[i] );
+        file.read_frame( 0, read );
+        for( int i = 0; i < nos; ++i )
+            REQUIRE( read[i] == frame_0[i] );
+
+        // Appending a frame of different size is not allowed
+        vectorfield other( nos + 1, Vector3{ 0, 0, 1 } );
+        REQUIRE_THROWS( file.append_frame( other, 30, IO::Trajectory_Encoding::Lossless ) );
+    }
+
+    SECTION( "Quantised" )
+    {
+        IO::Trajectory_File( filename ).write_frame( frame_1, 0, IO::Trajectory_Encoding::Quantised );
+
+        IO::Trajectory_File file( filename, true );
+        REQUIRE( file.encoding() == IO::Trajectory_Encoding::Quantised );
+
+        vectorfield read( nos );
+        file.read_frame( 0, read );
+        for( int i = 0; i < nos; ++i )
+            REQUIRE( ( read[i] - frame_1[i] ).norm() < 1e-4 );
+    }
+
+    SECTION( "Incomplete last frame" )
+    {
+        {
+            IO::Trajectory_File file( filename );
+            file.write_frame( frame_0, 0, IO::Trajectory_Encoding::Lossless );
+            file.append_frame( frame_1, 1, IO::Trajectory_Encoding::Lossless );
+        }
+
+        // Cut off the end of the file, as if the simulation had been killed while writing
+        std::ifstream in( filename, std::ios::binary );
+        std::string contents( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+        in.close();
+        std::ofstream out( filename, std::ios::binary | std::ios::trunc );
+        out.write( contents.data(), contents.size() - 100 );
+        out.close();
+
+        IO::Trajectory_File file( filename, true );
+        REQUIRE( file.n_frames() == 1 );
+        vectorfield read( nos );
+        file.read_frame( 0, read );
+        for( int i = 0; i < nos; ++i )
+            REQUIRE( read[i] == frame_0[i] );
+    }
+}
+
 TEST_CASE( "IO-OVF-CAPITALIZATION", "[io-ovf]" )
 {
     // That test is checking that the IO_Image_Read() would deal properly with capitalization for
@@ -372,3 +463,96 @@ TEST_CASE( "IO-INTERACTION-PAIRS", "[io-interactions-pairs]" )
     IO_Image_Write_Neighbours_Exchange( state.get(), "core/test/io_test_files/neighbours_J.dat" );
     IO_Image_Write_Neighbours_DMI( state.get(), "core/test/io_test_files/neighbours_DMI.dat" );
 }
+
+TEST_CASE( "IO-TABLE-FILE", "[io-table]" )
+{
+    const std::string filename = "core/test/io_test_files/table.txt";
+    {
+        std::ofstream file( filename );
+        file << "# header comment\n"
+             << "\n"
+             << "n_interaction_pairs 2\n"
+             << "i j  da db dc  Jij # trailing comment\n"
+             << "0,1, 1 0 0 | 1.5e-1\n"
+             << "1 0 -1 0 0 +2\n"
+             << "0 0 0 1\n";
+    }
+
+    IO::Table_File table( filename );
+    REQUIRE( table.n_lines() == 5 );
+    REQUIRE( table.find( "N_INTERACTION_PAIRS" ) == 0 );
+    REQUIRE( table.find( "dmi" ) == -1 );
+
+    auto columns = table.words( 1 );
+    REQUIRE( columns.size() == 6 );
+    REQUIRE( columns[5] == "Jij" );
+
+    double values[6];
+    REQUIRE( table.read_numbers( 2, 6, values ) == 6 );
+    REQUIRE( values[0] == 0 );
+    REQUIRE( values[2] == 1 );
+    REQUIRE( values[5] == 0.15 );
+    REQUIRE( table.read_numbers( 3, 6, values ) == 6 );
+    REQUIRE( values[2] == -1 );
+    REQUIRE( values[5] == 2 );
+    // Missing values are zero
+    REQUIRE( table.read_numbers( 4, 6, values ) == 4 );
+    REQUIRE( values[3] == 1 );
+    REQUIRE( values[5] == 0 );
+}
+
+TEST_CASE( "IO-PAIRS-CACHE", "[io-table]" )
+{
+    // Large enough for the parsed pairs to be cached
+    const std::string filename = "core/test/io_test_files/pairs_large.txt";
+    const int n_pairs          = 2 * int( IO::Table_Cache::min_lines );
+    {
+        std::ofstream file( filename );
+        file << "n_interaction_pairs " << n_pairs << "\n"
+             << "i j da db dc Jij Dij Dijx Dijy Dijz\n";
+        // Each pair appears twice, the second time inverted, so that the contributions are merged
+        for( int idx = 0; idx < n_pairs / 2; ++idx )
+            file << "0 1 " << idx << " 0 0 1 1 0 0 1\n";
+        for( int idx = 0; idx < n_pairs / 2; ++idx )
+            file << "1 0 " << -idx << " 0 0 " << idx << " 0.5 1 0 0\n";
+    }
+    std::remove( ( filename + ".pairs.cache" ).c_str() );
+
+    auto geometry = std::make_shared<Data::Geometry>(
+        std::vector<Vector3>{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } }, intfield{ 2, 2, 1 },
+        std::vector<Vector3>{ { 0, 0, 0 }, { 0.5, 0.5, 0 } },
+        Data::Basis_Cell_Composition{ false, { 0, 1 }, { 0, 0 }, { 1, 1 }, {} }, 1,
+        Data::Pinning{ 0, 0, 0, 0, 0, 0, vectorfield( 0 ), field<Site>( 0 ), vectorfield( 0 ) }, Data::Defects{} );
+
+    std::vector<int> nop( 2 );
+    std::vector<pairfield> exchange_pairs( 2 ), dmi_pairs( 2 );
+    std::vector<scalarfield> exchange_magnitudes( 2 ), dmi_magnitudes( 2 );
+    std::vector<vectorfield> dmi_normals( 2 );
+
+    // The first read parses the text file and writes the cache, the second one reads the cache
+    for( int i = 0; i < 2; ++i )
+    {
+        IO::Pairs_from_File(
+            filename, geometry, nop[i], exchange_pairs[i], exchange_magnitudes[i], dmi_pairs[i], dmi_magnitudes[i],
+            dmi_normals[i] );
+        if( i == 0 )
+            REQUIRE( std::ifstream( filename + ".pairs.cache" ).good() );
+    }
+
+    for( int i = 0; i < 2; ++i )
+    {
+        REQUIRE( exchange_pairs[i].size() == std::size_t( n_pairs / 2 ) );
+        REQUIRE( dmi_pairs[i].size() == std::size_t( n_pairs / 2 ) );
+        for( int idx = 0; idx < n_pairs / 2; ++idx )
+        {
+            INFO( "read " << i << ", pair " << idx );
+            REQUIRE( exchange_pairs[i][idx].i == 0 );
+            REQUIRE( exchange_pairs[i][idx].j == 1 );
+            REQUIRE( exchange_pairs[i][idx].translations[0] == idx );
+            REQUIRE( exchange_magnitudes[i][idx] == 1 + idx );
+            // The DMI vector of the inverted pair is mirrored before being added
+            REQUIRE_THAT( dmi_magnitudes[i][idx], WithinAbs( std::sqrt( 1.25 ), 1e-12 ) );
+            REQUIRE( dmi_normals[i][idx].isApprox( Vector3{ -0.5, 0, 1 } / std::sqrt( 1.25 ) ) );
+        }
+    }
+}
@@ -0,0 +1,155 @@
+#include <utility/Logging.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch.hpp>
+
+using Utility::Log_Level;
+using Utility::Log_Sender;
+
+namespace
+{
+
+// Restores the settings of the Log when going out of scope
+struct Log_Settings_Guard
+{
+    Log_Settings_Guard()
+            : messages_to_console( Log.messages_to_console ),
+              messages_to_file( Log.messages_to_file ),
+              level_console( Log.level_console ),
+              level_file( Log.level_file ),
+              n_entries_max( Log.n_entries_max ),
+              output_folder( Log.output_folder ),
+              file_name( Log.file_name )
+    {
+    }
+
+    ~Log_Settings_Guard()
+    {
+        Log.Flush();
+        Log.messages_to_console = messages_to_console;
+        Log.messages_to_file    = messages_to_file;
+        Log.level_console       = level_console;
+        Log.level_file          = level_file;
+        Log.n_entries_max       = n_entries_max;
+        Log.output_folder       = output_folder;
+        Log.file_name           = file_name;
+    }
+
+    bool messages_to_console;
+    bool messages_to_file;
+    Log_Level level_console;
+    Log_Level level_file;
+    std::size_t n_entries_max;
+    std::string output_folder;
+    std::string file_name;
+};
+
+} // namespace
+
+TEST_CASE( "Log keeps a bounded number of entries", "[logging]" )
+{
+    Log_Settings_Guard guard;
+    Log.messages_to_console = false;
+    Log.messages_to_file    = false;
+    Log.level_console       = Log_Level::Parameter;
+    Log.level_file          = Log_Level::Info;
+    Log.n_entries_max       = 100;
+
+    int n_before = 0;
+    Log.GetEntries( &n_before );
+
+    const int n_messages = 1000;
+    for( int i = 0; i < n_messages; ++i )
+        Log( Log_Level::Info, Log_Sender::All, "message " + std::to_string( i ) );
+
+    int n_after  = 0;
+    auto entries = Log.GetEntries( &n_after );
+    REQUIRE( n_after - n_before == n_messages );
+    REQUIRE( entries.size() == 100 );
+    REQUIRE( entries.front().message_lines[0] == "message 900" );
+    REQUIRE( entries.back().message_lines[0] == "message 999" );
+
+    SECTION( "Messages of levels which are not printed or written are discarded" )
+    {
+        const int n_entries = Log.n_entries;
+        Log( Log_Level::Debug, Log_Sender::All, "discarded" );
+        Log.SendFormatted( Log_Level::Debug, Log_Sender::All, -1, -1, "discarded {}", 1 );
+        REQUIRE( Log.n_entries == n_entries );
+        REQUIRE_FALSE( Log.Accepts( Log_Level::Debug ) );
+
+        Log.level_file = Log_Level::Debug;
+        REQUIRE( Log.Accepts( Log_Level::Debug ) );
+        Log.SendFormatted( Log_Level::Debug, Log_Sender::All, -1, -1, "accepted {}", 1 );
+        REQUIRE( Log.n_entries == n_entries + 1 );
+        REQUIRE( Log.GetEntries().back().message_lines[0] == "accepted 1" );
+    }
+
+    SECTION( "Appending to the file writes only the new entries" )
+    {
+        Log.messages_to_file = true;
+        Log.output_folder    = "core/test/io_test_files";
+        Log.file_name        = "Log_test_logging.txt";
+        Log.Dump_to_File();
+
+        Log( Log_Level::Info, Log_Sender::All, "appended message" );
+        Log( Log_Level::Debug, Log_Sender::All, "filtered message" );
+        Log.Append_to_File();
+
+        std::ifstream file( "core/test/io_test_files/Log_test_logging.txt" );
+        std::stringstream contents;
+        contents << file.rdbuf();
+        const std::string text = contents.str();
+        REQUIRE( text.find( "message 999" ) != std::string::npos );
+        REQUIRE( text.find( "appended message" ) != std::string::npos );
+        REQUIRE( text.find( "filtered message" ) == std::string::npos );
+        REQUIRE( text.find( "appended message" ) == text.rfind( "appended message" ) );
+    }
+}
+
+#ifdef SPIRIT_USE_THREADS
+TEST_CASE( "Log receives messages from many threads", "[logging]" )
+{
+    Log_Settings_Guard guard;
+    Log.messages_to_console = false;
+    Log.messages_to_file    = false;
+    Log.level_file          = Log_Level::Info;
+    Log.n_entries_max       = 100000;
+
+    int n_before = 0;
+    Log.GetEntries( &n_before );
+
+    // More messages than fit into the queue, so that the producers have to wait for the sink
+    const int n_threads             = 4;
+    const int n_messages_per_thread = 5000;
+    std::vector<std::thread> threads;
+    for( int t = 0; t < n_threads; ++t )
+    {
+        threads.emplace_back(
+            [t, n_messages_per_thread]
+            {
+                for( int i = 0; i < n_messages_per_thread; ++i )
+                    Log( Log_Level::Info, Log_Sender::All, std::to_string( i ), t );
+            } );
+    }
+    for( auto & thread : threads )
+        thread.join();
+
+    int n_after  = 0;
+    auto entries = Log.GetEntries( &n_after );
+    REQUIRE( n_after - n_before == n_threads * n_messages_per_thread );
+
+    // The messages of each thread arrive in order
+    std::vector<int> next( n_threads, 0 );
+    for( std::size_t i = entries.size() - n_threads * n_messages_per_thread; i < entries.size(); ++i )
+    {
+        const auto & entry = entries[i];
+        REQUIRE( entry.message_lines[0] == std::to_string( next[entry.idx_image] ) );
+        ++next[entry.idx_image];
+    }
+}
+#endif
@@ -3,6 +3,8 @@
 #include <engine/Vectormath.hpp>
 #include <engine/Vectormath_Defines.hpp>
 
+#include <random>
+
 using Catch::Matchers::WithinAbs;
 
 TEST_CASE( "Manifold operations", "[manifold]" )
@@ -114,4 +116,114 @@ TEST_CASE( "Manifold operations", "[manifold]" )
         scalar dist_gc = Engine::Vectormath::angle( v3[0], v4[0] );
         REQUIRE_THAT( dist, WithinAbs( sqrt( N * dist_gc * dist_gc ), 1e-8 ) );
     }
-}
\ No newline at end of file
+}
+TEST_CASE( "Block-diagonal tangent space operators", "[manifold]" )
+{
+    using namespace Engine::Manifoldmath;
+
+    // Random unit vectors, including both poles
+    const int N = 20;
+    std::mt19937 prng( 42 );
+    vectorfield image( N );
+    Engine::Vectormath::get_random_vectorfield_unitsphere( prng, image );
+    image[0] = Vector3{ 0, 0, 1 };
+    image[1] = Vector3{ 0, 0, -1 };
+
+    MatrixX hessian = MatrixX::Random( 3 * N, 3 * N );
+    hessian         = 0.5 * ( hessian + hessian.transpose() ).eval();
+    // Sparse version, dropping about half of the (3x3) blocks
+    MatrixX hessian_masked = hessian;
+    for( int i = 0; i < N; ++i )
+    {
+        for( int j = 0; j < N; ++j )
+        {
+            if( ( i * 7 + j * 3 ) % 2 == 1 )
+                hessian_masked.block<3, 3>( 3 * i, 3 * j ).setZero();
+        }
+    }
+    SpMatrixX hessian_sparse = hessian_masked.sparseView();
+
+    field<Matrix3x2> basis;
+    tangent_basis_spherical( image, basis );
+    MatrixX basis_dense = MatrixX::Zero( 3 * N, 2 * N );
+    tangent_basis_spherical( image, basis_dense );
+
+    SECTION( "Basis" )
+    {
+        MatrixX basis_from_blocks;
+        dense_basis( basis, basis_from_blocks );
+        REQUIRE( basis_from_blocks.isApprox( basis_dense ) );
+
+        SpMatrixX basis_sparse( 3 * N, 2 * N );
+        sparse_tangent_basis_spherical( image, basis_sparse );
+        REQUIRE( MatrixX( basis_sparse ).isApprox( basis_dense ) );
+
+        // Orthonormal and tangential
+        REQUIRE( ( basis_dense.transpose() * basis_dense ).isApprox( MatrixX::Identity( 2 * N, 2 * N ) ) );
+        for( int i = 0; i < N; ++i )
+            REQUIRE_THAT( ( image[i].transpose() * basis[i] ).norm(), WithinAbs( 0, 1e-12 ) );
+    }
+
+    SECTION( "Projector" )
+    {
+        field<Matrix3> projector;
+        tangential_projector( image, projector );
+        MatrixX projector_dense = tangential_projector( image );
+
+        MatrixX projected;
+        project_blockwise( projector, hessian, projected );
+        REQUIRE( projected.isApprox( projector_dense * hessian * projector_dense ) );
+
+        SpMatrixX projected_sparse;
+        project_blockwise( projector, hessian_sparse, projected_sparse );
+        REQUIRE( MatrixX( projected_sparse ).isApprox( projector_dense * hessian_masked * projector_dense ) );
+    }
+
+    SECTION( "Change of basis" )
+    {
+        MatrixX hessian_2N;
+        change_basis( basis, hessian, hessian_2N );
+        REQUIRE( hessian_2N.isApprox( basis_dense.transpose() * hessian * basis_dense ) );
+
+        SpMatrixX hessian_sparse_2N;
+        change_basis( basis, hessian_sparse, hessian_sparse_2N );
+        REQUIRE( MatrixX( hessian_sparse_2N ).isApprox( basis_dense.transpose() * hessian_masked * basis_dense ) );
+
+        VectorX vector_3N = VectorX::Random( 3 * N ), vector_2N, vector_back;
+        to_tangent_basis( basis, vector_3N, vector_2N );
+        REQUIRE( vector_2N.isApprox( basis_dense.transpose() * vector_3N ) );
+        from_tangent_basis( basis, vector_2N, vector_back );
+        REQUIRE( vector_back.isApprox( basis_dense * vector_2N ) );
+    }
+
+    SECTION( "Constrained Hessians" )
+    {
+        vectorfield gradient( N );
+        Engine::Vectormath::get_random_vectorfield( prng, gradient );
+        MatrixX projector_dense = tangential_projector( image );
+
+        // Reference values from the dense products
+        MatrixX reference_bordered   = hessian;
+        MatrixX reference_projected  = projector_dense * hessian * projector_dense;
+        MatrixX reference_weingarten = projector_dense * hessian;
+        for( int i = 0; i < N; ++i )
+        {
+            const Matrix3 P = projector_dense.block<3, 3>( 3 * i, 3 * i );
+            reference_bordered.block<3, 3>( 3 * i, 3 * i ) -= Matrix3::Identity() * image[i].dot( gradient[i] );
+            reference_projected.block<3, 3>( 3 * i, 3 * i )
+                -= P * image[i].dot( gradient[i] ) + ( P * gradient[i] ) * image[i].transpose();
+            reference_weingarten.block<3, 3>( 3 * i, 3 * i ) -= Matrix3::Identity() * image[i].dot( gradient[i] );
+        }
+
+        MatrixX tangent_basis, hessian_out;
+        hessian_bordered( image, gradient, hessian, tangent_basis, hessian_out );
+        REQUIRE( tangent_basis.isApprox( basis_dense ) );
+        REQUIRE( hessian_out.isApprox( basis_dense.transpose() * reference_bordered * basis_dense ) );
+
+        hessian_projected( image, gradient, hessian, tangent_basis, hessian_out );
+        REQUIRE( hessian_out.isApprox( basis_dense.transpose() * reference_projected * basis_dense ) );
+
+        hessian_weingarten( image, gradient, hessian, tangent_basis, hessian_out );
+        REQUIRE( hessian_out.isApprox( basis_dense.transpose() * reference_weingarten * basis_dense ) );
+    }
+}
@@ -0,0 +1,194 @@
+#include <data/Geometry.hpp>
+#include <engine/Neighbours.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+using Data::Geometry;
+using Engine::Neighbours::Neighbour_Shells;
+
+namespace
+{
+
+Geometry make_geometry(
+    const std::vector<Vector3> & bravais_vectors, intfield n_cells, const std::vector<Vector3> & cell_atoms,
+    scalar lattice_constant )
+{
+    const int n_atoms = cell_atoms.size();
+    std::vector<int> iatom( n_atoms );
+    for( int i = 0; i < n_atoms; ++i )
+        iatom[i] = i;
+    Data::Basis_Cell_Composition composition{ false, iatom, std::vector<int>( n_atoms, 0 ),
+                                              std::vector<scalar>( n_atoms, 1 ), {} };
+    Data::Pinning pinning{ 0, 0, 0, 0, 0, 0, vectorfield( 0 ), field<Site>( 0 ), vectorfield( 0 ) };
+    return Geometry( bravais_vectors, n_cells, cell_atoms, composition, lattice_constant, pinning, Data::Defects{} );
+}
+
+// Reference: all pairs within the lattice, sorted into shells by brute force
+Neighbour_Shells brute_force_shells( const Geometry & geometry, std::size_t n_shells )
+{
+    const scalar width = 1e-3;
+    std::array<Vector3, 3> t;
+    std::array<int, 3> limits;
+    for( int dim = 0; dim < 3; ++dim )
+    {
+        t[dim]      = geometry.lattice_constant * geometry.bravais_vectors[dim];
+        limits[dim] = t[dim].norm() == 0 ? 0 : geometry.n_cells[dim] - 1;
+    }
+
+    std::vector<std::tuple<int, int, std::array<int, 3>, scalar>> all;
+    for( int a = 0; a < geometry.n_cell_atoms; ++a )
+        for( int i = -limits[0]; i <= limits[0]; ++i )
+            for( int j = -limits[1]; j <= limits[1]; ++j )
+                for( int k = -limits[2]; k <= limits[2]; ++k )
+                    for( int b = 0; b < geometry.n_cell_atoms; ++b )
+                    {
+                        if( a == b && i == 0 && j == 0 && k == 0 )
+                            continue;
+                        const Vector3 d
+                            = geometry.positions[b] + i * t[0] + j * t[1] + k * t[2] - geometry.positions[a];
+                        all.emplace_back( a, b, std::array<int, 3>{ i, j, k }, d.norm() );
+                    }
+
+    std::vector<scalar> distances;
+    for( const auto & p : all )
+        distances.push_back( std::get<3>( p ) );
+    std::sort( distances.begin(), distances.end() );
+
+    Neighbour_Shells reference;
+    reference.radii = std::vector<scalar>( n_shells, 0 );
+    scalar previous = 0;
+    std::size_t n   = 0;
+    for( scalar d : distances )
+    {
+        if( n < n_shells && d - previous > width )
+        {
+            reference.radii[n++] = d;
+            previous             = d;
+        }
+    }
+
+    for( const auto & p : all )
+    {
+        for( std::size_t shell = 0; shell < n; ++shell )
+        {
+            if( std::abs( std::get<3>( p ) - reference.radii[shell] ) < width )
+            {
+                const auto & tr = std::get<2>( p );
+                reference.pairs.push_back( { std::get<0>( p ), std::get<1>( p ), { tr[0], tr[1], tr[2] } } );
+                reference.shells.push_back( shell );
+            }
+        }
+    }
+    return reference;
+}
+
+using Pair_Key = std::tuple<int, int, int, int, int, int>;
+
+std::vector<Pair_Key> sorted_keys( const pairfield & pairs, const intfield & shells )
+{
+    std::vector<Pair_Key> keys;
+    for( std::size_t i = 0; i < pairs.size(); ++i )
+    {
+        const auto & p = pairs[i];
+        keys.emplace_back( p.i, shells[i], p.j, p.translations[0], p.translations[1], p.translations[2] );
+    }
+    std::sort( keys.begin(), keys.end() );
+    return keys;
+}
+
+} // namespace
+
+TEST_CASE( "Neighbour shells of a simple cubic lattice", "[neighbours]" )
+{
+    auto geometry = make_geometry( Geometry::BravaisVectorsSC(), { 10, 10, 10 }, { Vector3{ 0, 0, 0 } }, 1 );
+
+    auto neighbour_shells = Engine::Neighbours::Get_Neighbour_Shells( geometry, 4 );
+    REQUIRE( neighbour_shells.radii.size() == 4 );
+    REQUIRE_THAT( neighbour_shells.radii[0], WithinAbs( 1, 1e-12 ) );
+    REQUIRE_THAT( neighbour_shells.radii[1], WithinAbs( std::sqrt( 2 ), 1e-12 ) );
+    REQUIRE_THAT( neighbour_shells.radii[2], WithinAbs( std::sqrt( 3 ), 1e-12 ) );
+    REQUIRE_THAT( neighbour_shells.radii[3], WithinAbs( 2, 1e-12 ) );
+
+    std::array<int, 4> n_per_shell{ 0, 0, 0, 0 };
+    for( int shell : neighbour_shells.shells )
+        ++n_per_shell[shell];
+    REQUIRE( n_per_shell == std::array<int, 4>{ 6, 12, 8, 6 } );
+
+    // The pairs are ordered by shell
+    REQUIRE( std::is_sorted( neighbour_shells.shells.begin(), neighbour_shells.shells.end() ) );
+
+    // Without redundant neighbours, only half of the pairs are kept
+    pairfield pairs;
+    intfield shells;
+    Engine::Neighbours::Get_Neighbours_in_Shells( geometry, 2, pairs, shells, false );
+    REQUIRE( pairs.size() == 9 );
+}
+
+TEST_CASE( "Neighbour shells of a basis in Cartesian coordinates", "[neighbours]" )
+{
+    // A bcc lattice, given as a simple cubic lattice with two basis atoms
+    auto geometry = make_geometry(
+        Geometry::BravaisVectorsSC(), { 6, 6, 6 }, { Vector3{ 0, 0, 0 }, Vector3{ 0.5, 0.5, 0.5 } }, 2 );
+
+    auto radii = Engine::Neighbours::Get_Shell_Radii( geometry, 2 );
+    REQUIRE_THAT( radii[0], WithinAbs( std::sqrt( 3 ), 1e-12 ) );
+    REQUIRE_THAT( radii[1], WithinAbs( 2, 1e-12 ) );
+
+    pairfield pairs;
+    intfield shells;
+    Engine::Neighbours::Get_Neighbours_in_Shells( geometry, 1, pairs, shells, true );
+    REQUIRE( pairs.size() == 2 * 8 );
+    for( const auto & pair : pairs )
+        REQUIRE( pair.i != pair.j );
+}
+
+TEST_CASE( "Neighbour shells match a brute force search", "[neighbours]" )
+{
+    const std::vector<Vector3> basis{ Vector3{ 0, 0, 0 }, Vector3{ 0.333, 0.333, 0 }, Vector3{ 0.1, 0.6, 0.3 },
+                                      Vector3{ 0.7, 0.2, 0.5 }, Vector3{ 0.45, 0.9, 0.8 } };
+
+    for( const auto & bravais_vectors :
+         { Geometry::BravaisVectorsHex2D60(), Geometry::BravaisVectorsFCC(), Geometry::BravaisVectorsBCC() } )
+    {
+        for( intfield n_cells : { intfield{ 8, 8, 1 }, intfield{ 5, 4, 3 }, intfield{ 2, 1, 1 } } )
+        {
+            auto geometry = make_geometry( bravais_vectors, n_cells, basis, 1.7 );
+
+            for( std::size_t n_shells : { 1, 3, 8 } )
+            {
+                auto neighbour_shells = Engine::Neighbours::Get_Neighbour_Shells( geometry, n_shells );
+                auto reference        = brute_force_shells( geometry, n_shells );
+
+                REQUIRE( neighbour_shells.radii.size() == n_shells );
+                for( std::size_t shell = 0; shell < n_shells; ++shell )
+                    REQUIRE_THAT( neighbour_shells.radii[shell], WithinAbs( reference.radii[shell], 1e-12 ) );
+                REQUIRE(
+                    sorted_keys( neighbour_shells.pairs, neighbour_shells.shells )
+                    == sorted_keys( reference.pairs, reference.shells ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "Neighbour shells are cached until the lattice changes", "[neighbours]" )
+{
+    auto geometry = make_geometry( Geometry::BravaisVectorsSC(), { 10, 10, 10 }, { Vector3{ 0, 0, 0 } }, 1 );
+    Engine::Neighbours::Neighbour_Shell_Cache cache;
+
+    const auto * first = &cache.Get( geometry, 3 );
+    REQUIRE( first->radii.size() == 3 );
+    REQUIRE( cache.Get( geometry, 2 ).radii.size() == 3 );
+    REQUIRE( cache.Get( geometry, 4 ).radii.size() == 4 );
+
+    // Fewer cells in one direction remove the neighbours along it
+    auto thin_geometry = make_geometry( Geometry::BravaisVectorsSC(), { 10, 10, 1 }, { Vector3{ 0, 0, 0 } }, 1 );
+    const auto & thin  = cache.Get( thin_geometry, 1 );
+    REQUIRE( thin.radii.size() == 1 );
+    REQUIRE( thin.pairs.size() == 4 );
+}
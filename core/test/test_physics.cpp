@@ -11,6 +11,8 @@
 #include <Eigen/Dense>
 #include <catch.hpp>
 #include <data/State.hpp>
+#include <engine/Hamiltonian_Heisenberg.hpp>
+#include <engine/Vectormath.hpp>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -179,3 +181,207 @@ TEST_CASE( "Dipole-Dipole Interaction", "[physics]" )
     INFO( "Energy (FFT)    = " << energy_fft << "\n" );
     REQUIRE_THAT( energy_fft, WithinAbs( energy_direct, 1e-7 ) );
 }
+
+TEST_CASE( "Recorded energy contributions", "[physics]" )
+{
+    Catch::StringMaker<float>::precision  = 12;
+    Catch::StringMaker<double>::precision = 12;
+
+    // Reduce precision if float accuracy
+    double epsilon_apprx = 1e-8;
+    if( strcmp( Spirit_Scalar_Type(), "float" ) == 0 )
+    {
+        WARN( "Detected single precision calculation. Reducing precision requirements." );
+        epsilon_apprx = 1e-2;
+    }
+
+    auto state = std::shared_ptr<State>( State_Setup( "core/test/input/fd_pairs.cfg" ), State_Delete );
+
+    // Interactions of all degrees
+    float normal[3] = { 1, 2, 3 };
+    Hamiltonian_Set_Anisotropy( state.get(), 0.5, normal );
+    Hamiltonian_Set_Cubic_Anisotropy( state.get(), 0.3 );
+
+    Configuration_Random( state.get() );
+
+    auto & hamiltonian = *state->active_image->hamiltonian;
+    auto & spins       = *state->active_image->spins;
+    auto gradient      = vectorfield( state->nos );
+
+    // An arbitrary tangent
+    auto tangent = vectorfield( state->nos );
+    for( int i = 0; i < state->nos; i++ )
+        tangent[i] = { std::sin( i ), std::cos( 2 * i ), 0.5 };
+
+    auto energies = hamiltonian.Energy_Contributions( spins );
+    REQUIRE( energies.size() == 5 );
+
+    // Nothing is recorded unless requested
+    scalar energy = 0;
+    hamiltonian.Gradient_and_Energy( spins, gradient, energy );
+    REQUIRE( hamiltonian.Recorded_Energy_Contributions() == nullptr );
+    REQUIRE_THAT( energy, WithinAbs( hamiltonian.Energy( spins ), epsilon_apprx * std::abs( energy ) ) );
+
+    hamiltonian.Record_Energy_Contributions( 42, &tangent );
+    hamiltonian.Gradient_and_Energy( spins, gradient, energy );
+    const auto * record = hamiltonian.Recorded_Energy_Contributions();
+    REQUIRE( record != nullptr );
+    REQUIRE( record->version == 42 );
+    REQUIRE( record->energies.size() == energies.size() );
+    REQUIRE( record->dE_dRx.size() == energies.size() );
+
+    // The inclinations are compared to central differences of the energies along the tangent
+    scalar h         = 1e-4;
+    auto spins_plus  = spins;
+    auto spins_minus = spins;
+    for( int i = 0; i < state->nos; i++ )
+    {
+        spins_plus[i] += h * tangent[i];
+        spins_minus[i] -= h * tangent[i];
+    }
+    auto energies_plus  = hamiltonian.Energy_Contributions( spins_plus );
+    auto energies_minus = hamiltonian.Energy_Contributions( spins_minus );
+
+    scalar sum_energies = 0;
+    scalar sum_dE_dRx   = 0;
+    for( std::size_t i = 0; i < energies.size(); ++i )
+    {
+        INFO( "Contribution " << energies[i].first );
+        REQUIRE( record->energies[i].first == energies[i].first );
+        REQUIRE_THAT(
+            record->energies[i].second,
+            WithinAbs( energies[i].second, epsilon_apprx * std::abs( energies[i].second ) ) );
+
+        // The sign convention of GNEB is used, i.e. the projection of the effective field
+        scalar dE_dRx_fd = -( energies_plus[i].second - energies_minus[i].second ) / ( 2 * h );
+        REQUIRE_THAT( record->dE_dRx[i], WithinAbs( dE_dRx_fd, 1e-5 * std::abs( dE_dRx_fd ) + epsilon_apprx ) );
+
+        sum_energies += record->energies[i].second;
+        sum_dE_dRx += record->dE_dRx[i];
+    }
+    REQUIRE_THAT( energy, WithinAbs( sum_energies, epsilon_apprx * std::abs( energy ) ) );
+
+    scalar dot = 0;
+    for( int i = 0; i < state->nos; i++ )
+        dot -= gradient[i].dot( tangent[i] );
+    REQUIRE_THAT( sum_dE_dRx, WithinAbs( dot, epsilon_apprx * std::abs( dot ) ) );
+
+    // A copy of the Hamiltonian is not recording
+    auto copy = std::make_shared<Engine::Hamiltonian_Heisenberg>(
+        static_cast<Engine::Hamiltonian_Heisenberg &>( hamiltonian ) );
+    REQUIRE( copy->Recorded_Energy_Contributions() == nullptr );
+
+    hamiltonian.Stop_Recording_Energy_Contributions();
+    REQUIRE( hamiltonian.Recorded_Energy_Contributions() == nullptr );
+}
+
+TEST_CASE( "Pair interactions with vacancies", "[physics]" )
+{
+    // Reduce precision if float accuracy
+    double epsilon_apprx = 1e-12;
+    if( strcmp( Spirit_Scalar_Type(), "float" ) == 0 )
+    {
+        WARN( "Detected single precision calculation. Reducing precision requirements." );
+        epsilon_apprx = 1e-5;
+    }
+
+    auto state = std::shared_ptr<State>( State_Setup( "core/test/input/fd_pairs.cfg" ), State_Delete );
+
+    int n_cells[3] = { 6, 5, 3 };
+    Geometry_Set_N_Cells( state.get(), n_cells );
+    bool boundary_conditions[3] = { true, true, false };
+    Hamiltonian_Set_Boundary_Conditions( state.get(), boundary_conditions );
+    Configuration_Random( state.get() );
+
+    auto & hamiltonian = static_cast<Engine::Hamiltonian_Heisenberg &>( *state->active_image->hamiltonian );
+    auto & geometry    = *state->active_image->geometry;
+    auto & spins       = *state->active_image->spins;
+
+    // Remove every third atom. The Hamiltonian has to notice this without updating its interactions.
+    for( int i = 0; i < state->nos; i += 3 )
+        geometry.atom_types[i] = -1;
+
+#if defined( SPIRIT_USE_OPENMP ) || defined( SPIRIT_USE_THREADS )
+    // The pair lists contain both directions of each pair
+    const bool redundant_pairs = true;
+#else
+    const bool redundant_pairs = false;
+#endif
+
+    // Reference: loop over all pairs of all sites
+    auto energy_reference   = scalarfield( state->nos, 0 );
+    auto gradient_reference = vectorfield( state->nos, Vector3::Zero() );
+    for( int ispin = 0; ispin < state->nos; ++ispin )
+    {
+        for( std::size_t i_pair = 0; i_pair < hamiltonian.exchange_pairs.size(); ++i_pair )
+        {
+            int jspin = Engine::Vectormath::idx_from_pair(
+                ispin, hamiltonian.boundary_conditions, geometry.n_cells, geometry.n_cell_atoms, geometry.atom_types,
+                hamiltonian.exchange_pairs[i_pair] );
+            if( jspin < 0 )
+                continue;
+            const scalar J = hamiltonian.exchange_magnitudes[i_pair];
+            energy_reference[ispin] -= 0.5 * J * spins[ispin].dot( spins[jspin] );
+            gradient_reference[ispin] -= J * spins[jspin];
+            if( !redundant_pairs )
+            {
+                energy_reference[jspin] -= 0.5 * J * spins[ispin].dot( spins[jspin] );
+                gradient_reference[jspin] -= J * spins[ispin];
+            }
+        }
+        for( std::size_t i_pair = 0; i_pair < hamiltonian.dmi_pairs.size(); ++i_pair )
+        {
+            int jspin = Engine::Vectormath::idx_from_pair(
+                ispin, hamiltonian.boundary_conditions, geometry.n_cells, geometry.n_cell_atoms, geometry.atom_types,
+                hamiltonian.dmi_pairs[i_pair] );
+            if( jspin < 0 )
+                continue;
+            const scalar D        = hamiltonian.dmi_magnitudes[i_pair];
+            const Vector3 & D_vec = hamiltonian.dmi_normals[i_pair];
+            energy_reference[ispin] -= 0.5 * D * D_vec.dot( spins[ispin].cross( spins[jspin] ) );
+            gradient_reference[ispin] -= D * spins[jspin].cross( D_vec );
+            if( !redundant_pairs )
+            {
+                energy_reference[jspin] -= 0.5 * D * D_vec.dot( spins[ispin].cross( spins[jspin] ) );
+                gradient_reference[jspin] += D * spins[ispin].cross( D_vec );
+            }
+        }
+    }
+
+    auto energy   = scalarfield( state->nos, 0 );
+    auto gradient = vectorfield( state->nos, Vector3::Zero() );
+    hamiltonian.E_Exchange( spins, energy );
+    hamiltonian.E_DMI( spins, energy );
+    hamiltonian.Gradient_Exchange( spins, gradient );
+    hamiltonian.Gradient_DMI( spins, gradient );
+
+    for( int i = 0; i < state->nos; i++ )
+    {
+        INFO( "i = " << i );
+        REQUIRE_THAT( energy[i], WithinAbs( energy_reference[i], epsilon_apprx ) );
+        REQUIRE( ( gradient[i] - gradient_reference[i] ).norm() < epsilon_apprx );
+#ifdef SPIRIT_ENABLE_DEFECTS
+        if( geometry.atom_types[i] < 0 )
+        {
+            REQUIRE( energy[i] == 0 );
+            REQUIRE( gradient[i].norm() == 0 );
+        }
+#endif
+    }
+
+    // Filling the vacancies again restores the full lattice
+    for( int i = 0; i < state->nos; i += 3 )
+        geometry.atom_types[i] = 0;
+    auto energy_full = scalarfield( state->nos, 0 );
+    hamiltonian.E_Exchange( spins, energy_full );
+    scalar energy_sum = 0;
+    for( int i = 0; i < state->nos; i++ )
+        energy_sum += energy_full[i];
+    Hamiltonian_Set_Boundary_Conditions( state.get(), boundary_conditions );
+    energy_full = scalarfield( state->nos, 0 );
+    hamiltonian.E_Exchange( spins, energy_full );
+    scalar energy_sum_updated = 0;
+    for( int i = 0; i < state->nos; i++ )
+        energy_sum_updated += energy_full[i];
+    REQUIRE_THAT( energy_sum, WithinAbs( energy_sum_updated, epsilon_apprx * state->nos ) );
+}
@@ -38,7 +38,8 @@ TEST_CASE( "Solvers testing", "[solvers]" )
 
     // Solvers to be tested
     std::vector<int> solvers{ Solver_LBFGS_Atlas, Solver_LBFGS_OSO, Solver_VP_OSO,  Solver_VP,
-                              Solver_Heun,        Solver_SIB,       Solver_Depondt, Solver_RungeKutta4 };
+                              Solver_NCG,         Solver_Newton,    Solver_Heun,    Solver_SIB,
+                              Solver_Depondt,     Solver_RungeKutta4 };
 
     // Expected values
     float energy_expected = -5849.69140625f;
@@ -79,7 +80,8 @@ TEST_CASE( "Solvers testing", "[solvers]" )
         Chain_Insert_Image_After( state.get() );
 
     // Solvers to be tested
-    solvers = { Solver_LBFGS_Atlas, Solver_LBFGS_OSO, Solver_VP_OSO, Solver_VP, Solver_Heun, Solver_Depondt };
+    solvers = { Solver_LBFGS_Atlas, Solver_LBFGS_OSO, Solver_VP_OSO, Solver_VP,
+                Solver_NCG,         Solver_Newton,    Solver_Heun,   Solver_Depondt };
 
     // Expected values
     float energy_sp_expected = -5811.5244140625f;
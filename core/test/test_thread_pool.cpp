@@ -0,0 +1,136 @@
+#include <utility/Thread_Pool.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#ifdef SPIRIT_USE_THREADS
+#include <thread>
+#endif
+
+#include <catch.hpp>
+
+using Utility::Thread_Budget;
+using Utility::Thread_Pool;
+
+TEST_CASE( "Thread pool covers each index of a loop exactly once", "[thread_pool]" )
+{
+    Thread_Pool pool( 4 );
+
+    for( int n : { 0, 1, 255, 256, 1000, 100003 } )
+    {
+        std::vector<std::atomic<int>> visits( n );
+        for( auto & v : visits )
+            v = 0;
+        std::atomic<int> n_chunks_seen{ 0 };
+
+        pool.Parallel_For(
+            n,
+            [&]( int i_chunk, int begin, int end )
+            {
+                REQUIRE( i_chunk < pool.N_Chunks( n ) );
+                ++n_chunks_seen;
+                for( int i = begin; i < end; ++i )
+                    ++visits[i];
+            } );
+
+        REQUIRE( n_chunks_seen == pool.N_Chunks( n ) );
+        for( int i = 0; i < n; ++i )
+            REQUIRE( visits[i] == 1 );
+    }
+}
+
+TEST_CASE( "Thread pool reductions do not depend on the thread budget", "[thread_pool]" )
+{
+    Thread_Pool pool( 4 );
+    const int n = 50000;
+    std::vector<double> values( n );
+    for( int i = 0; i < n; ++i )
+        values[i] = 1.0 / ( i + 1 );
+
+    auto reduce = [&]()
+    {
+        std::vector<double> partial_sums( pool.N_Chunks( n ), 0 );
+        pool.Parallel_For(
+            n,
+            [&]( int i_chunk, int begin, int end )
+            {
+                for( int i = begin; i < end; ++i )
+                    partial_sums[i_chunk] += values[i];
+            } );
+        return std::accumulate( partial_sums.begin(), partial_sums.end(), 0.0 );
+    };
+
+    const double full = reduce();
+    {
+        Thread_Budget budget( 1 );
+        REQUIRE( pool.Budget() == 1 );
+        REQUIRE( reduce() == full );
+    }
+    {
+        Thread_Budget budget( 2 );
+        REQUIRE( pool.Budget() == std::min( 2, pool.N_Threads() ) );
+        REQUIRE( reduce() == full );
+    }
+    REQUIRE( pool.Budget() == pool.N_Threads() );
+}
+
+TEST_CASE( "Thread pool rethrows exceptions and runs nested loops", "[thread_pool]" )
+{
+    Thread_Pool pool( 4 );
+
+    REQUIRE_THROWS_AS(
+        pool.Parallel_For(
+            10000,
+            []( int i_chunk, int, int )
+            {
+                if( i_chunk == 3 )
+                    throw std::runtime_error( "chunk failed" );
+            } ),
+        std::runtime_error );
+
+    std::atomic<int> n_visits{ 0 };
+    pool.Parallel_For(
+        2000,
+        [&]( int, int begin, int end )
+        {
+            for( int i = begin; i < end; ++i )
+                pool.Parallel_For(
+                    300, [&]( int, int inner_begin, int inner_end ) { n_visits += inner_end - inner_begin; } );
+        } );
+    REQUIRE( n_visits == 2000 * 300 );
+}
+
+TEST_CASE( "Registered threads share the pool", "[thread_pool]" )
+{
+    Thread_Pool pool( 4 );
+    Thread_Budget first;
+    const int n_threads_alone = pool.Budget();
+    REQUIRE( n_threads_alone == pool.N_Threads() );
+    {
+        // A nested budget on the same thread does not register it a second time
+        Thread_Budget nested;
+        REQUIRE( pool.Budget() == n_threads_alone );
+    }
+
+#ifdef SPIRIT_USE_THREADS
+    // A simulation on another thread halves the share of this one
+    std::atomic<bool> registered{ false };
+    std::atomic<bool> done{ false };
+    std::thread other(
+        [&]
+        {
+            Thread_Budget second;
+            registered = true;
+            while( !done )
+                std::this_thread::yield();
+        } );
+    while( !registered )
+        std::this_thread::yield();
+    REQUIRE( pool.Budget() == std::max( 1, pool.N_Threads() / 2 ) );
+    done = true;
+    other.join();
+    REQUIRE( pool.Budget() == n_threads_alone );
+#endif
+}
@@ -2,7 +2,12 @@
 #include <data/Geometry.hpp>
 #include <engine/Vectormath.hpp>
 #include <engine/Vectormath_Defines.hpp>
+#include <utility/Exception.hpp>
+
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <random>
 #include <vector>
 
 using Catch::Matchers::WithinAbs;
@@ -316,4 +321,145 @@ TEST_CASE( "Vectormath operations", "[vectormath]" )
             REQUIRE( j_e.block( 0, 0, 3, 2 ).isApprox( j.block( 0, 0, 3, 2 ), epsilon_apprx ) );
         }
     }
-}
\ No newline at end of file
+
+    SECTION( "directional gradient" )
+    {
+        // Oblique lattice with a basis of two atoms and mixed boundary conditions
+        std::vector<Vector3> bravais_vectors = { { 1, 0.5, 0 }, { -0.2, 1, 0 }, { 0, 0, 1 } };
+        scalar lattice_constant              = 1.2;
+
+        intfield n_cells                = { 12, 9, 3 };
+        std::vector<Vector3> cell_atoms = { { 0, 0, 0 }, { 0.5, 0.5, 0 } };
+        Data::Basis_Cell_Composition cell_composition;
+        Data::Pinning pinning;
+        Data::Defects defects;
+
+        auto test_geometry = Data::Geometry(
+            bravais_vectors, n_cells, cell_atoms, cell_composition, lattice_constant, pinning, defects );
+        intfield boundary_conditions = { 1, 0, 0 };
+
+        std::mt19937 prng( 3 );
+        vectorfield vftest( test_geometry.nos );
+        Engine::Vectormath::get_random_vectorfield_unitsphere( prng, vftest );
+
+        // The stencil has to agree with the jacobians, including at the open boundaries
+        field<Matrix3> jacobians( test_geometry.nos );
+        Engine::Vectormath::jacobian( vftest, test_geometry, boundary_conditions, jacobians );
+
+        Engine::Vectormath::Finite_Difference_Stencil stencil;
+        Engine::Vectormath::finite_difference_stencil( test_geometry, boundary_conditions, stencil );
+
+        Vector3 direction = Vector3{ 0.3, -1, 0.2 };
+        vectorfield gradient( test_geometry.nos ), gradient_direct( test_geometry.nos );
+        Engine::Vectormath::directional_gradient( vftest, stencil, direction, gradient );
+        Engine::Vectormath::directional_gradient(
+            vftest, test_geometry, boundary_conditions, direction, gradient_direct );
+
+        for( int i = 0; i < test_geometry.nos; i++ )
+        {
+            INFO( i );
+            REQUIRE( ( jacobians[i] * direction - gradient[i] ).norm() < 1e-12 );
+            REQUIRE( gradient[i] == gradient_direct[i] );
+        }
+    }
+}
+TEST_CASE( "Index arithmetic near the limit of the index type", "[vectormath]" )
+{
+    using Engine::Vectormath::idx_from_translations;
+    using Engine::Vectormath::idx_from_tupel;
+    using Engine::Vectormath::translations_from_idx;
+
+    // The largest lattices of the two builds: with 64 bit indices there are more spins than an int can count,
+    // otherwise 3*nos is just below the largest int
+    const bool wide_indices = sizeof( spirit_index ) >= 8;
+    const intfield n_cells  = wide_indices ? intfield{ 2000, 2000, 300 } : intfield{ 1000, 1000, 357 };
+    const int n_cell_atoms  = 2;
+    const std::int64_t nos  = std::int64_t( n_cell_atoms ) * n_cells[0] * n_cells[1] * n_cells[2];
+    REQUIRE( 3 * nos <= std::numeric_limits<spirit_index>::max() );
+    if( wide_indices )
+        REQUIRE( nos > std::numeric_limits<int>::max() );
+
+    const std::array<int, 3> last_cell = { n_cells[0] - 1, n_cells[1] - 1, n_cells[2] - 1 };
+
+    SECTION( "Translations" )
+    {
+        REQUIRE( idx_from_translations( n_cells, n_cell_atoms, last_cell ) == nos - n_cell_atoms );
+        REQUIRE( translations_from_idx( n_cells, n_cell_atoms, nos - 1 ) == last_cell );
+        const std::array<int, 3> cell = { 7, n_cells[1] / 2, n_cells[2] / 2 };
+        const spirit_index ispin      = idx_from_translations( n_cells, n_cell_atoms, cell ) + 1;
+        REQUIRE( ispin > nos / 2 );
+        REQUIRE( translations_from_idx( n_cells, n_cell_atoms, ispin ) == cell );
+
+        // Periodic images of the first cell
+        REQUIRE(
+            idx_from_translations( n_cells, n_cell_atoms, { 0, 0, 0 }, std::array<int, 3>{ -1, -1, -1 } )
+            == nos - n_cell_atoms );
+        REQUIRE( idx_from_translations( n_cells, n_cell_atoms, last_cell, std::array<int, 3>{ 1, 1, 1 } ) == 0 );
+    }
+
+    SECTION( "Tupels" )
+    {
+        const field<int> extents = { n_cell_atoms, n_cells[0], n_cells[1], n_cells[2] };
+        field<int> tupel         = { 1, last_cell[0], last_cell[1], last_cell[2] };
+        REQUIRE( idx_from_tupel( tupel, extents ) == nos - 1 );
+
+        field<int> extents_copy = extents;
+        Engine::Vectormath::tupel_from_idx( nos - 1, tupel, extents_copy );
+        REQUIRE( tupel == field<int>{ 1, last_cell[0], last_cell[1], last_cell[2] } );
+    }
+}
+
+TEST_CASE( "Pair indices on a periodic lattice", "[vectormath]" )
+{
+    // idx_from_pair needs the atom types of all sites, so it is checked on a smaller lattice
+    const intfield n_cells             = { 300, 200, 7 };
+    const int n_cell_atoms             = 2;
+    const spirit_index nos             = spirit_index( n_cell_atoms ) * n_cells[0] * n_cells[1] * n_cells[2];
+    const intfield atom_types          = intfield( nos, 0 );
+    const intfield boundary_conditions = { 1, 1, 0 };
+
+    const Pair pair{ 1, 0, { 1, -1, 1 } };
+    for( spirit_index ispin : { spirit_index( 1 ), nos / 2 + 1, nos - 2 * n_cells[0] * n_cells[1] - 1, nos - 1 } )
+    {
+        INFO( ispin );
+        const auto translations = Engine::Vectormath::translations_from_idx( n_cells, n_cell_atoms, ispin );
+        const spirit_index jspin
+            = Engine::Vectormath::idx_from_pair( ispin, boundary_conditions, n_cells, n_cell_atoms, atom_types, pair );
+
+        if( translations[2] == n_cells[2] - 1 )
+        {
+            // The third direction is open
+            REQUIRE( jspin == -1 );
+            continue;
+        }
+        const std::array<int, 3> translations_j = { ( translations[0] + 1 ) % n_cells[0],
+                                                    ( translations[1] - 1 + n_cells[1] ) % n_cells[1],
+                                                    translations[2] + 1 };
+        REQUIRE( jspin == Engine::Vectormath::idx_from_translations( n_cells, n_cell_atoms, translations_j ) );
+        REQUIRE(
+            Engine::Vectormath::idx_from_pair(
+                jspin, boundary_conditions, n_cells, n_cell_atoms, atom_types, Pair{ 0, 1, { 1, -1, 1 } }, true )
+            == ispin );
+    }
+}
+
+TEST_CASE( "Geometries which cannot be indexed are rejected", "[vectormath]" )
+{
+    std::vector<Vector3> bravais_vectors = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    std::vector<Vector3> cell_atoms      = { { 0, 0, 0 }, { 0.5, 0.5, 0.5 } };
+    Data::Basis_Cell_Composition cell_composition;
+    Data::Pinning pinning;
+    Data::Defects defects;
+
+    // 3*nos has to fit into the index type
+    const int n_max = std::numeric_limits<int>::max();
+    REQUIRE_THROWS_AS(
+        Data::Geometry(
+            bravais_vectors, { n_max, n_max, n_max }, cell_atoms, cell_composition, 1, pinning, defects ),
+        Utility::Exception );
+    if( sizeof( spirit_index ) < 8 )
+        REQUIRE_THROWS_AS(
+            Data::Geometry(
+                bravais_vectors, { 1000, 1000, 358 }, cell_atoms, cell_composition, 1, pinning, defects ),
+            Utility::Exception );
+}
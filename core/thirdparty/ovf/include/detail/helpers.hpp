@@ -3,6 +3,7 @@
 #define LIBOVF_DETAIL_HELPERS_H
 
 #include <cstdint>
+#include <cstring>
 
 namespace ovf
 {
@@ -18,16 +19,13 @@ namespace check
 
 namespace endian
 {
-    // union
-    // {
-    //     uint16_t s;
-    //     unsigned char c[2];
-    // } constexpr static  d {1};
-
-    // constexpr bool is_little()
-    // {
-    //     return d.c[0] == 1;
-    // }
+    inline bool is_little()
+    {
+        const uint16_t value = 1;
+        uint8_t first_byte;
+        std::memcpy(&first_byte, &value, 1);
+        return first_byte == 1;
+    }
 
     inline uint32_t from_little_32(const uint8_t * bytes)
     {
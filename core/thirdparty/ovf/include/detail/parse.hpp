@@ -11,6 +11,9 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
@@ -27,6 +30,45 @@ namespace parse
     */
     static const int n_segments_str_digits = 6;
 
+    // Case-insensitive check whether the text at `pos` starts with `word`
+    inline bool starts_with_word(const char * pos, const char * end, const char * word)
+    {
+        for( ; *word != '\0'; ++word, ++pos )
+        {
+            if( pos == end || std::tolower(*pos) != std::tolower(*word) )
+                return false;
+        }
+        return true;
+    }
+
+    inline const char * skip_blanks(const char * pos, const char * end)
+    {
+        while( pos != end && (*pos == ' ' || *pos == '\t') )
+            ++pos;
+        return pos;
+    }
+
+    /*
+    Find the next marker of the form "# Begin: <word>" or "# End: <word>", starting at `pos`.
+    Returns `end` if there is none. Since '#' is searched for with memchr, this is fast
+    even when scanning over large binary data blocks.
+    */
+    inline const char * find_marker(const char * pos, const char * end, const char * marker, const char * word)
+    {
+        const std::size_t marker_length = std::strlen(marker);
+        while( pos != end )
+        {
+            pos = static_cast<const char *>( std::memchr(pos, '#', end-pos) );
+            if( !pos )
+                return end;
+            const char * p = skip_blanks(pos+1, end);
+            if( starts_with_word(p, end, marker) && starts_with_word(skip_blanks(p+marker_length, end), end, word) )
+                return pos;
+            ++pos;
+        }
+        return end;
+    }
+
     /*
     Parse the overall file header and locate the segment count, if present.
     */
@@ -59,21 +101,43 @@ namespace parse
     }
 
     /*
-    Read the overall file header and locate and count segments in the file
-    (the segments are stored in memory!)
+    Read the overall file header and locate and count segments in the file.
+    The file is memory-mapped and only the locations of the segments are stored.
     */
     inline int initial(ovf_file & file)
     try
     {
-        pegtl::file_input<> in( file.file_name );
+        file._state->segment_ranges.clear();
+        file._state->mapped_file.reset( new pegtl::file_input<>( file.file_name ) );
+        auto & in = *file._state->mapped_file;
         bool success = pegtl::parse< ovf_file_header, ovf_file_action >( in, file );
         if( success )
         {
             success = false;
             if( file.version == 2 )
             {
-                success = pegtl::parse< pegtl::until<pegtl::until<pegtl::at< pegtl::seq<v2::begin, TAO_PEGTL_ISTRING("Segment"), pegtl::eol >>>> >( in, file );
-                success = pegtl::parse< pegtl::plus<v2::segment>, v2::ovf_segment_action >( in, file );
+                // Locate the segments, without parsing their contents
+                const char * pos = in.current();
+                const char * end = in.end();
+                while( pos != end )
+                {
+                    const char * segment_begin = find_marker(pos, end, "begin:", "segment");
+                    if( segment_begin == end )
+                        break;
+                    const char * segment_end = find_marker(segment_begin, end, "end:", "segment");
+                    if( segment_end == end )
+                    {
+                        file._state->message_latest = fmt::format(
+                            "libovf initial: segment {} in file \'{}\' is incomplete...",
+                            file._state->segment_ranges.size(), file.file_name);
+                        return OVF_INVALID;
+                    }
+                    const char * eol = static_cast<const char *>( std::memchr(segment_end, '\n', end-segment_end) );
+                    segment_end = eol ? eol+1 : end;
+                    file._state->segment_ranges.push_back( { segment_begin, segment_end } );
+                    pos = segment_end;
+                }
+                success = !file._state->segment_ranges.empty();
             }
             else if( file.version == 1 )
             {
@@ -92,7 +156,7 @@ namespace parse
 
             if( success )
             {
-                int n_located = file._state->file_contents.size();
+                int n_located = file._state->segment_ranges.size();
                 if( file.n_segments != n_located )
                 {
                     file._state->message_latest = fmt::format(
@@ -135,11 +199,73 @@ namespace parse
         return OVF_ERROR;
     }
 
+    /*
+    Make sure the segments of the file are located. Writing to the file releases the
+    mapping, so it may need to be mapped and parsed again.
+    */
+    inline int locate_segments(ovf_file & file, int index)
+    {
+        if( file._state->mapped_file && index < int(file._state->segment_ranges.size()) )
+            return OVF_OK;
+        int retcode = initial(file);
+        if( retcode == OVF_OK && index >= int(file._state->segment_ranges.size()) )
+        {
+            file._state->message_latest = fmt::format(
+                "libovf locate_segments: could not locate segment {} in file \'{}\'...",
+                index, file.file_name);
+            return OVF_ERROR;
+        }
+        return retcode;
+    }
+
+    /*
+    Locate the "# Begin: Data ..." line of a segment. Only the header lines are scanned.
+    Returns `end` if no data block was found.
+    */
+    inline const char * find_data_begin(const char * begin, const char * end)
+    {
+        const char * line = begin;
+        while( line != end )
+        {
+            const char * pos = skip_blanks(line, end);
+            if( pos != end && *pos == '#' )
+            {
+                pos = skip_blanks(pos+1, end);
+                if( starts_with_word(pos, end, "begin:") )
+                {
+                    pos = skip_blanks(pos+6, end);
+                    if( starts_with_word(pos, end, "data") )
+                        return line;
+                }
+            }
+            const char * eol = static_cast<const char *>( std::memchr(line, '\n', end-line) );
+            line = eol ? eol+1 : end;
+        }
+        return end;
+    }
+
+    /*
+    Returns a string containing only the header block of a segment, terminated by "# End: Segment".
+    This way, the header can be parsed without scanning through the data block.
+    */
+    inline std::string segment_header_string(ovf_file & file, int index)
+    {
+        auto & range = file._state->segment_ranges[index];
+        std::string header( range.first, find_data_begin(range.first, range.second) );
+        header += "# End: Segment\n";
+        return header;
+    }
+
     // Reads in the header info into a given segment
     inline int segment_header(ovf_file & file, int index, ovf_segment & segment)
     try
     {
-        pegtl::memory_input<> in( file._state->file_contents[index], "" );
+        int retcode = locate_segments(file, index);
+        if( retcode != OVF_OK )
+            return retcode;
+
+        std::string header = segment_header_string(file, index);
+        pegtl::memory_input<> in( header, "" );
         file._state->found_title        = false;
         file._state->found_meshunit     = false;
         file._state->found_valuedim     = false;
@@ -189,13 +315,13 @@ namespace parse
         else
         {
             file._state->message_latest = "libovf segment_header: no success in parsing";
-            std::cerr << file._state->file_contents[index] << std::endl;
             return OVF_INVALID;
         }
     }
     catch( v2::keyword_value_line_error & err )
     {
-        pegtl::memory_input<> in( file._state->file_contents[index], "" );
+        std::string header = segment_header_string(file, index);
+        pegtl::memory_input<> in( header, "" );
         const auto p = err.positions.front();
         std::string line = in.line_as_string(p);
         file._state->message_latest = fmt::format(
@@ -221,17 +347,136 @@ namespace parse
         return OVF_ERROR;
     }
 
+    // The number of values above which binary data is converted in parallel
+    static const int n_values_parallel = 1<<16;
+
+    /*
+    Returns the size in bytes of the values in a data block, if it is "Binary 4" or
+    "Binary 8", and 0 otherwise.
+    */
+    inline int binary_value_size(const char * data_line, const char * end)
+    {
+        // Skip "# Begin: Data"
+        const char * pos = skip_blanks(skip_blanks(data_line, end)+1, end);
+        pos = skip_blanks(pos+6, end);
+        pos = skip_blanks(pos+4, end);
+        if( !starts_with_word(pos, end, "binary") )
+            return 0;
+        pos = skip_blanks(pos+6, end);
+        if( pos != end && *pos == '4' )
+            return 4;
+        if( pos != end && *pos == '8' )
+            return 8;
+        return 0;
+    }
+
+    template<typename scalar>
+    void convert_bin_4(const char * bytes, int n_values, scalar * data)
+    {
+        #pragma omp parallel for if( n_values > n_values_parallel )
+        for( int i = 0; i < n_values; ++i )
+        {
+            uint32_t ivalue = endian::from_little_32(reinterpret_cast<const uint8_t *>( bytes + 4*i ));
+            float value;
+            std::memcpy(&value, &ivalue, sizeof(float));
+            data[i] = value;
+        }
+    }
+
+    template<typename scalar>
+    void convert_bin_8(const char * bytes, int n_values, scalar * data)
+    {
+        #pragma omp parallel for if( n_values > n_values_parallel )
+        for( int i = 0; i < n_values; ++i )
+        {
+            uint64_t ivalue = endian::from_little_64(reinterpret_cast<const uint8_t *>( bytes + 8*i ));
+            double value;
+            std::memcpy(&value, &ivalue, sizeof(double));
+            data[i] = static_cast<scalar>(value);
+        }
+    }
+
+    /*
+    Reads a binary data block directly from the mapped file into the data array,
+    without passing the values through the parser.
+    */
+    template<typename scalar>
+    int segment_data_binary(ovf_file & file, const char * data_line, const char * end, int value_size,
+        const ovf_segment & segment, scalar * data)
+    {
+        static_assert(
+            !std::is_floating_point<scalar>::value ||
+            (std::is_floating_point<scalar>::value && std::numeric_limits<scalar>::is_iec559),
+            "Portable binary only supports IEEE 754 standardized floating point" );
+
+        const char * eol = static_cast<const char *>( std::memchr(data_line, '\n', end-data_line) );
+        if( !eol || end - (eol+1) < value_size )
+        {
+            file._state->message_latest = "libovf segment_data: binary data block is truncated";
+            return OVF_INVALID;
+        }
+        const char * bytes = eol + 1;
+
+        // Check value
+        bool check_ok = false;
+        if( value_size == 4 )
+            check_ok = endian::from_little_32(reinterpret_cast<const uint8_t *>( bytes )) == check::val_4b;
+        else
+            check_ok = endian::from_little_64(reinterpret_cast<const uint8_t *>( bytes )) == check::val_8b;
+        if( !check_ok )
+        {
+            file._state->message_latest =
+                "libovf segment_data: the expected binary check value could not be parsed!";
+            return OVF_ERROR;
+        }
+        bytes += value_size;
+
+        // The data ends where the "# End: Data" line begins, which is searched for in the tail of the segment
+        const char * tail_begin = end - bytes > 512 ? end - 512 : bytes;
+        std::string tail( tail_begin, end );
+        std::string::size_type pos_end = tail.rfind("End: Data");
+        if( pos_end == std::string::npos || (pos_end = tail.rfind('#', pos_end)) == std::string::npos )
+        {
+            file._state->message_latest = "libovf segment_data: could not find the end of the binary data block";
+            return OVF_INVALID;
+        }
+        const char * bytes_end = tail_begin + pos_end;
+
+        int n_available = int( (bytes_end - bytes) / value_size );
+        int n_values    = std::min( segment.N*segment.valuedim, n_available );
+
+        if( value_size == 4 )
+            convert_bin_4( bytes, n_values, data );
+        else
+            convert_bin_8( bytes, n_values, data );
+
+        return OVF_OK;
+    }
+
     // Reads the data of a segment into a given data array (float)
     template<typename scalar>
     int segment_data(ovf_file & file, int index, const ovf_segment & segment, scalar * data)
     try
     {
-        pegtl::memory_input<> in( file._state->file_contents[index], "" );
-        int retcode = OVF_ERROR;
+        int retcode = locate_segments(file, index);
+        if( retcode != OVF_OK )
+            return retcode;
+
+        auto & range = file._state->segment_ranges[index];
         bool success = false;
 
         if( file.version == 2 )
         {
+            // Binary data is read directly, bypassing the parser
+            const char * data_line = find_data_begin(range.first, range.second);
+            if( data_line != range.second )
+            {
+                int value_size = binary_value_size(data_line, range.second);
+                if( value_size > 0 )
+                    return segment_data_binary(file, data_line, range.second, value_size, segment, data);
+            }
+
+            pegtl::memory_input<> in( range.first, range.second, "" );
             file._state->max_data_index = segment.N*segment.valuedim;
             success = pegtl::parse< v2::segment_data, v2::ovf_segment_data_action >( in, file, segment, data );
             file._state->current_line = 0;
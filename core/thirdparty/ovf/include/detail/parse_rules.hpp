@@ -9,6 +9,8 @@
 #include <fmt/format.h>
 
 #include <array>
+#include <memory>
+#include <utility>
 
 struct max_index_error : public std::runtime_error
 {
@@ -17,8 +19,11 @@ struct max_index_error : public std::runtime_error
 
 struct parser_state
 {
-    // For the segment strings
-    std::vector<std::string> file_contents{};
+    // The memory-mapped file, kept alive as long as segments are being read from it
+    std::unique_ptr<tao::pegtl::file_input<>> mapped_file{};
+
+    // Begin and end of the segments inside the mapped file (the segments are not copied)
+    std::vector<std::pair<const char *, const char *>> segment_ranges{};
 
     // for reading data blocks
     int current_column = 0;
@@ -357,35 +362,6 @@ namespace parse
             >
         {};
 
-        //
-        struct segment
-            : pegtl::seq<
-                pegtl::star<pegtl::seq<empty_line, pegtl::eol>>,
-                pegtl::seq< begin, TAO_PEGTL_ISTRING("Segment"), pegtl::eol>,
-                // pegtl::star<pegtl::seq<empty_line, pegtl::eol>>,
-                // header,
-                // pegtl::star<pegtl::seq<empty_line, pegtl::eol>>,
-                // pegtl::sor<data_text, data_csv, data_binary_8, data_binary_4>,
-                // pegtl::star<pegtl::seq<empty_line, pegtl::eol>>,
-                pegtl::until<pegtl::seq<end, TAO_PEGTL_ISTRING("Segment")>>, pegtl::eol >
-        {};
-
-        // Class template for user-defined actions that does nothing by default.
-        template< typename Rule >
-        struct ovf_segment_action
-            : pegtl::nothing< Rule >
-        {};
-
-        template<>
-        struct ovf_segment_action< segment >
-        {
-            template< typename Input >
-            static void apply( const Input& in, ovf_file & file )
-            {
-                file._state->file_contents.push_back(in.string());
-            }
-        };
-
         //////////////////////////////////////////////
 
         //
@@ -7,6 +7,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <fstream>
@@ -28,6 +30,9 @@ namespace write
     // This is needed so that, when appending, the file does not need to be overwritten
     static const int n_segments_str_digits = 6; // can store 1M modes
 
+    // The number of rows which are converted and written to the file at once
+    static const int n_rows_per_chunk = 4096;
+
     class file_handle
     {
     private:
@@ -35,16 +40,17 @@ namespace write
     public:
         file_handle(const std::string & filename, bool append);
         ~file_handle();
-        void write(const std::vector<std::string> & text);
-        void append(const std::vector<std::string> & text);
+        bool is_open() const;
+        void write(const std::string & text);
+        void write(const char * bytes, std::size_t n_bytes);
     };
 
     inline file_handle::file_handle( const std::string & filename, bool append )
     {
         if( append )
-            myfile.open(filename, std::ofstream::out | std::ofstream::app);
+            myfile.open(filename, std::ofstream::out | std::ofstream::binary | std::ofstream::app);
         else
-            myfile.open(filename);
+            myfile.open(filename, std::ofstream::out | std::ofstream::binary);
     }
 
 
@@ -54,21 +60,21 @@ namespace write
     }
 
 
-    inline void file_handle::write(const std::vector<std::string> & text)
+    inline bool file_handle::is_open() const
     {
-        if( myfile.is_open() )
-        {
-            // Log(Log_Level::Debug, Log_Sender::All, "Started writing " + name);
-            for (int i = 0; i < text.size(); ++i)
-                myfile << text[i];
+        return myfile.is_open();
+    }
 
-            myfile.close();
-            // Log(Log_Level::Debug, Log_Sender::All, "Finished writing " + name);
-        }
-        else
-        {
-            // Log(Log_Level::Error, Log_Sender::All, "Could not open " + name + " to write to file");
-        }
+
+    inline void file_handle::write(const std::string & text)
+    {
+        myfile.write(text.data(), text.size());
+    }
+
+
+    inline void file_handle::write(const char * bytes, std::size_t n_bytes)
+    {
+        myfile.write(bytes, n_bytes);
     }
 
 
@@ -115,79 +121,78 @@ namespace write
     }
 
 
+    /*
+    Writes binary data, converting it chunk by chunk. If the host is little endian
+    and no conversion is needed, the data is written directly from the passed array.
+    */
     template <typename T>
-    void append_data_bin_to_string( std::string & output_to_file, const T * vf, int n_cols, int n_rows, int format)
-    try
+    void write_data_bin( file_handle & handle, const T * vf, int n_cols, int n_rows, int format )
     {
-        if( format == OVF_FORMAT_BIN8 )
-        {
-            auto out_check = std::vector<uint8_t>(8);
-            endian::to_little_64(check::val_8b, out_check.data());
+        const std::size_t value_size = ( format == OVF_FORMAT_BIN8 ) ? sizeof(double) : sizeof(float);
+        const std::size_t n_values   = std::size_t(n_cols) * n_rows;
 
-            output_to_file +=
-                std::string( reinterpret_cast<const char *>(out_check.data()), sizeof(double) );
-
-            std::vector<uint8_t> out(n_cols*8);
-            for (unsigned int i=0; i<n_rows; ++i)
-            {
-                for (int j=0; j<n_cols; ++j)
-                {
-                    double val = static_cast<double>(vf[n_cols*i + j]);
-                    uint64_t in = *reinterpret_cast<uint64_t*>(&val);
+        uint8_t out_check[8];
+        if( format == OVF_FORMAT_BIN8 )
+            endian::to_little_64(check::val_8b, out_check);
+        else
+            endian::to_little_32(check::val_4b, out_check);
+        handle.write( reinterpret_cast<const char *>(out_check), value_size );
 
-                    endian::to_little_64(in, &out[j*8]);
-                }
-                output_to_file +=
-                    std::string( reinterpret_cast<char *>(out.data()), n_cols*sizeof(double) );
-            }
+        if( sizeof(T) == value_size && endian::is_little() )
+        {
+            handle.write( reinterpret_cast<const char *>(vf), n_values * value_size );
         }
-        else if( format == OVF_FORMAT_BIN4 )
+        else
         {
-            auto out_check = std::vector<uint8_t>(4);
-            endian::to_little_32(check::val_4b, out_check.data());
-
-            output_to_file +=
-                std::string( reinterpret_cast<const char *>(out_check.data()), sizeof(float) );
-
-            std::vector<uint8_t> out(n_cols*4);
-            for (unsigned int i=0; i<n_rows; ++i)
+            const std::size_t n_values_chunk = std::size_t(n_cols) * n_rows_per_chunk;
+            std::vector<uint8_t> out( std::min(n_values, n_values_chunk) * value_size );
+            for( std::size_t offset = 0; offset < n_values; offset += n_values_chunk )
             {
-                for (int j=0; j<n_cols; ++j)
+                std::size_t n_chunk = std::min(n_values_chunk, n_values - offset);
+                for( std::size_t i = 0; i < n_chunk; ++i )
                 {
-                    float val = static_cast<float>(vf[n_cols*i + j]);
-                    uint32_t in = *reinterpret_cast<uint32_t*>(&val);
-
-                    endian::to_little_32(in, &out[j*4]);
+                    if( format == OVF_FORMAT_BIN8 )
+                    {
+                        double val = static_cast<double>(vf[offset + i]);
+                        uint64_t in;
+                        std::memcpy(&in, &val, sizeof(double));
+                        endian::to_little_64(in, &out[i*8]);
+                    }
+                    else
+                    {
+                        float val = static_cast<float>(vf[offset + i]);
+                        uint32_t in;
+                        std::memcpy(&in, &val, sizeof(float));
+                        endian::to_little_32(in, &out[i*4]);
+                    }
                 }
-                output_to_file +=
-                    std::string( reinterpret_cast<char *>(out.data()), n_cols*sizeof(float) );
+                handle.write( reinterpret_cast<const char *>(out.data()), n_chunk * value_size );
             }
         }
 
-        output_to_file += "\n";
-    }
-    catch( ... )
-    {
-
+        handle.write( "\n" );
     }
 
 
+    // Writes text data, formatting it chunk by chunk
     template <typename T>
-    void append_data_txt_to_string( std::string & output_to_file, const T * vf, int n_cols, int n_rows,
+    void write_data_txt( file_handle & handle, const T * vf, int n_cols, int n_rows,
         const std::string& delimiter = "" )
-    try
     {
-        for (int row = 0; row < n_rows; ++row)
+        fmt::memory_buffer buffer;
+        for( int row_begin = 0; row_begin < n_rows; row_begin += n_rows_per_chunk )
         {
-            for (int col = 0; col < n_cols; ++col)
-                output_to_file += fmt::format( "{:22.12f}{}", vf[n_cols*row + col], delimiter );
-            output_to_file += "\n";
+            int row_end = std::min(row_begin + n_rows_per_chunk, n_rows);
+            for( int row = row_begin; row < row_end; ++row )
+            {
+                for( int col = 0; col < n_cols; ++col )
+                    fmt::format_to( buffer, "{:22.12f}{}", vf[n_cols*row + col], delimiter );
+                fmt::format_to( buffer, "\n" );
+            }
+            handle.write( buffer.data(), buffer.size() );
+            buffer.clear();
         }
     }
-    catch( ... )
-    {
-
-    }
 
 
     template <typename T>
@@ -195,14 +200,8 @@ namespace write
                 const bool append = false, int format = OVF_FORMAT_BIN8 )
     try
     {
-        if( file->_state->file_contents.size() > 0 && append )
-            file->_state->file_contents.push_back("");
-        else
-            file->_state->file_contents = {""};
-
-        int index = file->_state->file_contents.size()-1;
-        std::string & output_to_file = file->_state->file_contents[index];
-        output_to_file.reserve( int( 0x08000000 ) );  // reserve 128[MByte]
+        // Only the header is assembled in memory, the data is streamed to the file
+        std::string output_to_file = "";
 
         output_to_file += fmt::format( empty_line );
         output_to_file += fmt::format( "# Begin: Segment\n" );
@@ -329,38 +328,50 @@ namespace write
         else if( format == OVF_FORMAT_CSV )
             datatype_out = "CSV";
 
-        // Data
-        output_to_file += fmt::format( "# Begin: Data {}\n", datatype_out );
-
-        if ( format == OVF_FORMAT_BIN || format == OVF_FORMAT_BIN8 || format == OVF_FORMAT_BIN4 )
-            append_data_bin_to_string( output_to_file, vf, n_cols, n_rows, format );
-        else if ( format == OVF_FORMAT_TEXT )
-            append_data_txt_to_string( output_to_file, vf, n_cols, n_rows );
-        else if ( format == OVF_FORMAT_CSV )
-            append_data_txt_to_string( output_to_file, vf, n_cols, n_rows, "," );
-        else
+        if( format != OVF_FORMAT_BIN8 && format != OVF_FORMAT_BIN4 &&
+            format != OVF_FORMAT_TEXT && format != OVF_FORMAT_CSV )
         {
             file->_state->message_latest = fmt::format(
                 "write_segment not writing out any data, because format \"{}\" is invalid. "
                 "You may want to check what you passed in.", format);
             return OVF_ERROR;
         }
-        output_to_file += fmt::format( "# End: Data {}\n", datatype_out );
-        output_to_file += fmt::format( "# End: Segment\n" );
 
-        // Append the #End keywords
-        if( append )
-        {
-            file_handle handle(file->file_name, true);
-            handle.write( {output_to_file} );
-        }
-        else
+        // Data
+        output_to_file += fmt::format( "# Begin: Data {}\n", datatype_out );
+
+        // The file may be mapped for reading, which has to be released before it is modified
+        file->_state->segment_ranges.clear();
+        file->_state->mapped_file.reset();
+
         {
-            file_handle handle(file->file_name, false);
-            file->n_segments = 0;
-            file->version = 2;
-            handle.write( {top_header_string(), output_to_file} );
+            file_handle handle(file->file_name, append);
+            if( !handle.is_open() )
+            {
+                file->_state->message_latest = fmt::format(
+                    "write_segment could not open file \"{}\" for writing.", file->file_name);
+                return OVF_ERROR;
+            }
+
+            if( !append )
+            {
+                file->n_segments = 0;
+                file->version = 2;
+                handle.write( top_header_string() );
+            }
+            handle.write( output_to_file );
+
+            if ( format == OVF_FORMAT_BIN8 || format == OVF_FORMAT_BIN4 )
+                write_data_bin( handle, vf, n_cols, n_rows, format );
+            else if ( format == OVF_FORMAT_TEXT )
+                write_data_txt( handle, vf, n_cols, n_rows );
+            else if ( format == OVF_FORMAT_CSV )
+                write_data_txt( handle, vf, n_cols, n_rows, "," );
+
+            handle.write( fmt::format( "# End: Data {}\n", datatype_out ) );
+            handle.write( "# End: Segment\n" );
         }
+
         file->found  = true;
         file->is_ovf = true;
 
@@ -318,4 +318,60 @@ TEST_CASE( "Mixed binary and CSV", "[mixed]" )
         // close
         ovf_close(file);
     }
-}
\ No newline at end of file
+}
+TEST_CASE( "Large binary", "[large]" )
+{
+    const char * testfile = "testfile_cpp_large.ovf";
+
+    // segment header, large enough that the data is written in several chunks
+    auto segment = ovf_segment_create();
+    segment->valuedim = 3;
+    segment->n_cells[0] = 100;
+    segment->n_cells[1] = 100;
+    segment->n_cells[2] = 3;
+    segment->N = 30000;
+
+    // data
+    std::vector<double> field(3*segment->N);
+    for( int i = 0; i < 3*segment->N; ++i )
+        field[i] = 0.5*i;
+
+    // open
+    auto file = ovf_open(testfile);
+
+    // write double data as single precision
+    int success = ovf_write_segment_8(file, segment, field.data(), OVF_FORMAT_BIN4);
+    if( OVF_OK != success )
+        std::cerr << ovf_latest_message(file) << std::endl;
+    REQUIRE( success == OVF_OK );
+
+    // append double precision data
+    success = ovf_append_segment_8(file, segment, field.data(), OVF_FORMAT_BIN8);
+    if( OVF_OK != success )
+        std::cerr << ovf_latest_message(file) << std::endl;
+    REQUIRE( success == OVF_OK );
+    REQUIRE( file->n_segments == 2 );
+
+    // read back through the same handle
+    for( int index = 0; index < 2; ++index )
+    {
+        auto segment_in = ovf_segment_create();
+        success = ovf_read_segment_header(file, index, segment_in);
+        if( OVF_OK != success )
+            std::cerr << ovf_latest_message(file) << std::endl;
+        REQUIRE( success == OVF_OK );
+        REQUIRE( segment_in->N == 30000 );
+
+        std::vector<double> field_in(3*segment_in->N, -1);
+        success = ovf_read_segment_data_8(file, index, segment_in, field_in.data());
+        if( OVF_OK != success )
+            std::cerr << ovf_latest_message(file) << std::endl;
+        REQUIRE( success == OVF_OK );
+        REQUIRE( field_in[0] == 0 );
+        REQUIRE( field_in[12345] == 0.5*12345 );
+        REQUIRE( field_in[3*segment_in->N-1] == 0.5*(3*segment_in->N-1) );
+    }
+
+    // close
+    ovf_close(file);
+}
@@ -92,6 +92,8 @@ private:
     bool show_boundingbox_      = true;
 
     VFRendering::Geometry geometry;
+    // Directions of the vectorfield, kept to avoid reallocations
+    std::vector<glm::vec3> vf_directions;
     VFRendering::VectorField vectorfield_surf2D = VFRendering::VectorField( {}, {} );
     std::shared_ptr<VFRendering::CombinedRenderer> combined_renderer;
 };
@@ -467,76 +467,18 @@ void RenderingLayer::update_boundingbox()
 
 void RenderingLayer::update_vf_directions()
 {
-    int nos = System_Get_NOS( state.get() );
-    int n_cells[3];
-    Geometry_Get_N_Cells( this->state.get(), n_cells );
-    int n_cell_atoms = Geometry_Get_N_Cell_Atoms( this->state.get() );
+    static_assert( sizeof( glm::vec3 ) == 3 * sizeof( float ), "glm::vec3 has to consist of three packed floats" );
 
-    int n_cells_draw[3] = { std::max( 1, n_cells[0] / n_cell_step ), std::max( 1, n_cells[1] / n_cell_step ),
-                            std::max( 1, n_cells[2] / n_cell_step ) };
-    int nos_draw        = n_cell_atoms * n_cells_draw[0] * n_cells_draw[1] * n_cells_draw[2];
-
-    // Directions of the vectorfield
-    std::vector<glm::vec3> directions = std::vector<glm::vec3>( nos_draw );
-
-    // ToDo: Update the pointer to our Data instead of copying Data?
-    // Directions
-    //        get pointer
-    scalar * spins;
-    int * atom_types;
-    atom_types = Geometry_Get_Atom_Types( state.get() );
-    // if( this->m_source == 0 )
-    spins = System_Get_Spin_Directions( state.get() );
-    // else if( this->m_source == 1 )
-    //     spins = System_Get_Effective_Field( state.get() );
-    // else spins = System_Get_Spin_Directions( state.get() );
-
-    //        copy
-    /*positions.assign(spin_pos, spin_pos + 3*nos);
-    directions.assign(spins, spins + 3*nos);*/
-    int icell = 0;
-    for( int cell_c = 0; cell_c < n_cells_draw[2]; cell_c++ )
-    {
-        for( int cell_b = 0; cell_b < n_cells_draw[1]; cell_b++ )
-        {
-            for( int cell_a = 0; cell_a < n_cells_draw[0]; cell_a++ )
-            {
-                for( int ibasis = 0; ibasis < n_cell_atoms; ++ibasis )
-                {
-                    int idx = ibasis + n_cell_atoms * cell_a * n_cell_step
-                              + n_cell_atoms * n_cells[0] * cell_b * n_cell_step
-                              + n_cell_atoms * n_cells[0] * n_cells[1] * cell_c * n_cell_step;
-                    // std::cerr << idx << " " << icell << std::endl;
-                    directions[icell] = glm::vec3( spins[3 * idx], spins[1 + 3 * idx], spins[2 + 3 * idx] );
-                    if( atom_types[idx] < 0 )
-                        directions[icell] *= 0;
-                    ++icell;
-                }
-            }
-        }
-    }
-    // //        rescale if effective field
-    // if( this->m_source == 1 )
-    // {
-    //     float max_length = 0;
-    //     for( auto direction : directions )
-    //     {
-    //         max_length = std::max( max_length, glm::length( direction ) );
-    //     }
-    //     if( max_length > 0 )
-    //     {
-    //         for( auto & direction : directions )
-    //         {
-    //             direction /= max_length;
-    //         }
-    //     }
-    // }
+    // The snapshot of a running simulation is read without waiting for its current iteration
+    vf_directions.resize( System_Get_Snapshot_NOS( state.get(), n_cell_step ) );
+    if( !vf_directions.empty() )
+        System_Get_Spin_Snapshot( state.get(), &vf_directions[0].x, n_cell_step );
 
     // Update the vectorfield
-    vectorfield.updateVectors( directions );
+    vectorfield.updateVectors( vf_directions );
 
     if( Geometry_Get_Dimensionality( state.get() ) == 2 )
-        vectorfield_surf2D.updateVectors( directions );
+        vectorfield_surf2D.updateVectors( vf_directions );
 }
 
 void RenderingLayer::reset_camera()
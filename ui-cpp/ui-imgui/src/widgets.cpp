@@ -212,6 +212,8 @@ void show_overlay_calculation(
         { Solver_VP_OSO, { "VP (OSO)", "Verlet-like velocity projection (using exponential transformations)" } },
         { Solver_LBFGS_OSO, { "LBFGS (OSO)", "LBFGS (using exponential transformations)" } },
         { Solver_LBFGS_Atlas, { "LBFGS (Atlas)", "LBFGS (using an atlas of coordinate maps)" } },
+        { Solver_NCG, { "NCG", "Preconditioned nonlinear conjugate gradients (using exponential transformations)" } },
+        { Solver_Newton, { "Newton", "Trust-region Newton-Krylov (using exponential transformations)" } },
         { Solver_SIB, { "SIB", "Semi-implicit method B (Heun using approximated exponential transforms)" } },
         { Solver_Depondt, { "Depondt", "Depondt (Heun using rotations)" } },
         { Solver_Heun,
@@ -6,6 +6,8 @@ using Utility::Log_Level;
 using Utility::Log_Sender;
 ///////////////////////////////////
 
+#include <algorithm>
+
 DebugWidget::DebugWidget( std::shared_ptr<State> state )
 {
     this->state = state;
@@ -49,11 +51,16 @@ void DebugWidget::updateData()
 void DebugWidget::UpdateFromLog()
 {
     // Load all new Log messages and apply filters
-    auto entries        = Log_Get_Entries( state.get() );
-    auto n_old_entries  = this->n_log_entries;
-    this->n_log_entries = entries.size();
-    for( int i = n_old_entries; i < this->n_log_entries; ++i )
+    int n_entries      = 0;
+    auto entries       = Log_Get_Entries( state.get(), &n_entries );
+    auto n_old_entries = this->n_log_entries;
+
+    // Only the most recent entries are kept by the Log
+    int idx_first       = n_entries - int( entries.size() );
+    this->n_log_entries = n_entries;
+    for( int idx = std::max( n_old_entries, idx_first ); idx < n_entries; ++idx )
     {
+        int i = idx - idx_first;
         if( (int)entries[i].level <= this->comboBox_ShowLevel->currentIndex() )
         {
             if( ( entries[i].sender == Log_Sender::All )